@@ -1,51 +1,81 @@
-/*
- * The information in this file is
- * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
- * and is subject to the terms and conditions of the
- * GNU Lesser General Public License Version 2.1
- * The license text is available from   
- * http://www.gnu.org/licenses/lgpl.html
- */
-
-#ifndef MATLABINTERPRETER_H
-#define MATLABINTERPRETER_H
-
-#include "ConfigurationSettings.h"
-#include "Interpreter.h"
-
-#include <string>
-#include <vector>
-
-class MatlabInternalCommand;
-
-// Forward declaration of mxArray and its associated struct.
-struct mxArray_tag;
-typedef struct mxArray_tag mxArray;
-
-class MatlabInterpreter : public Interpreter
-{
-public:
-   SETTING(AutomaticConfiguration, MatlabInterpreter, bool, true);
-   SETTING_PTR(DLL, MatlabInterpreter, Filename);
-   SETTING(Version, MatlabInterpreter, std::string, std::string());
-   SETTING(InteractiveAvailable, MatlabInterpreter, bool, true);
-   SETTING(CheckErrors, MatlabInterpreter, bool, false);
-   SETTING(ClearErrors, MatlabInterpreter, bool, false);
-   SETTING(OutputBufferSize, MatlabInterpreter, int, 16384);
-
-   virtual const std::string& getCurrentCommand() const = NULL;
-
-   virtual const std::vector<MatlabInternalCommand*>& getInternalCommands() const = NULL;
-
-   virtual bool isMatlabRunning() const = 0;
-   virtual bool startMatlab() = 0;
-   virtual std::string getStartupMessage() const = 0;
-   virtual bool hideCommandWindow() = 0;
-   virtual bool showCommandWindow() = 0;
-
-   virtual bool getMatlabVariableAsString(const std::string& name, std::string& value) = NULL;
-   virtual mxArray* getMatlabVariable(const std::string& name) = NULL;
-   virtual bool setMatlabVariable(const std::string& name, const mxArray* pArray) = NULL;
-};
-
-#endif
+/*
+ * The information in this file is
+ * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
+ * and is subject to the terms and conditions of the
+ * GNU Lesser General Public License Version 2.1
+ * The license text is available from   
+ * http://www.gnu.org/licenses/lgpl.html
+ */
+
+#ifndef MATLABINTERPRETER_H
+#define MATLABINTERPRETER_H
+
+#include "ConfigurationSettings.h"
+#include "Interpreter.h"
+
+#include <string>
+#include <vector>
+
+class MatlabInternalCommand;
+class RasterElement;
+class TransferPool;
+
+// Forward declaration of mxArray and its associated struct.
+struct mxArray_tag;
+typedef struct mxArray_tag mxArray;
+
+class MatlabInterpreter : public Interpreter
+{
+public:
+   SETTING(AutomaticConfiguration, MatlabInterpreter, bool, true);
+   SETTING_PTR(DLL, MatlabInterpreter, Filename);
+   SETTING(Version, MatlabInterpreter, std::string, std::string());
+   SETTING(InteractiveAvailable, MatlabInterpreter, bool, true);
+   SETTING(CheckErrors, MatlabInterpreter, bool, false);
+   SETTING(ClearErrors, MatlabInterpreter, bool, false);
+   SETTING(OutputBufferSize, MatlabInterpreter, int, 16384);
+   SETTING(TransferThreadCount, MatlabInterpreter, int, 0);
+   SETTING(SharedMemoryThreshold, MatlabInterpreter, int, 64);
+   SETTING(TransferCache, MatlabInterpreter, bool, false);
+   SETTING(TransferPoolSize, MatlabInterpreter, int, 1024);
+
+   virtual const std::string& getCurrentCommand() const = NULL;
+
+   virtual const std::vector<MatlabInternalCommand*>& getInternalCommands() const = NULL;
+
+   virtual bool isMatlabRunning() const = 0;
+   virtual bool startMatlab() = 0;
+   virtual std::string getStartupMessage() const = 0;
+   virtual bool hideCommandWindow() = 0;
+   virtual bool showCommandWindow() = 0;
+
+   virtual bool getMatlabVariableAsString(const std::string& name, std::string& value) = NULL;
+   virtual mxArray* getMatlabVariable(const std::string& name) = NULL;
+   virtual bool setMatlabVariable(const std::string& name, const mxArray* pArray) = NULL;
+
+   // Evaluates several expressions together and returns a 1 x N cell array of their values, which the caller must
+   // destroy. Only strings and real scalars are returned. Cells of other values, and of expressions which could not
+   // be evaluated, are NULL.
+   virtual mxArray* evaluateMatlabExpressions(const std::vector<std::string>& expressions) = NULL;
+
+   // Large arrays can be written into a file which is mapped by both Opticks and MATLAB instead of being
+   // serialized through the engine. mapSharedVariable returns a writable block of size bytes, or NULL if shared
+   // memory is not available, and setSharedVariable unmaps the block and assigns its contents to a MATLAB variable
+   // of the given class and column-major dimensions. unmapSharedVariable discards the block without assigning it.
+   virtual void* mapSharedVariable(size_t size) = NULL;
+   virtual bool setSharedVariable(const std::string& name, const std::string& className,
+      const std::vector<size_t>& dims) = NULL;
+   virtual void unmapSharedVariable() = NULL;
+
+   // Copies of raster elements are remembered by variable name, along with a key describing the subcube, class,
+   // and scale of the copy. recordTransfer keeps a reference to the copy inside MATLAB, and restoreTransfer assigns
+   // it back to the variable instead of copying the data again, provided that the key matches and the element has
+   // not been modified since. restoreTransfer returns false when the copy must be made again.
+   virtual bool restoreTransfer(const std::string& name, RasterElement* pElement, const std::string& key) = NULL;
+   virtual void recordTransfer(const std::string& name, RasterElement* pElement, const std::string& key) = NULL;
+
+   // The arrays and scratch buffers which internal commands reuse between transfers.
+   virtual TransferPool& getTransferPool() = NULL;
+};
+
+#endif
@@ -1,19 +1,19 @@
-/*
- * The information in this file is
- * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
- * and is subject to the terms and conditions of the
- * GNU Lesser General Public License Version 2.1
- * The license text is available from   
- * http://www.gnu.org/licenses/lgpl.html
- */
-
-#ifndef MATLABVERSION_H
-#define MATLABVERSION_H
-
-#define MATLAB_NAME "MATLAB"
-#define MATLAB_NAME_LONG "MATLAB interpreter extension."
-#define MATLAB_COPYRIGHT "Copyright  2013, Ball Aerospace & Technologies Corp."
-#define MATLAB_VERSION_NUMBER "1.9.0rc1"
-#define MATLAB_IS_PRODUCTION_RELEASE false
-
-#endif
+/*
+ * The information in this file is
+ * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
+ * and is subject to the terms and conditions of the
+ * GNU Lesser General Public License Version 2.1
+ * The license text is available from   
+ * http://www.gnu.org/licenses/lgpl.html
+ */
+
+#ifndef MATLABVERSION_H
+#define MATLABVERSION_H
+
+#define MATLAB_NAME "MATLAB"
+#define MATLAB_NAME_LONG "MATLAB interpreter extension."
+#define MATLAB_COPYRIGHT "Copyright  2013, Ball Aerospace & Technologies Corp."
+#define MATLAB_VERSION_NUMBER "1.9.0rc1"
+#define MATLAB_IS_PRODUCTION_RELEASE false
+
+#endif
@@ -1,401 +1,1583 @@
-/*
- * The information in this file is
- * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
- * and is subject to the terms and conditions of the
- * GNU Lesser General Public License Version 2.1
- * The license text is available from   
- * http://www.gnu.org/licenses/lgpl.html
- */
-
-#include "ArrayCommands.h"
-#include "MatlabFunctions.h"
-#include "MatlabInterpreter.h"
-#include "RasterDataDescriptor.h"
-#include "RasterElement.h"
-#include "StringUtilities.h"
-#include "switchOnEncoding.h"
-
-#include <matrix.h>
-
-#include <QtCore/QString>
-
-namespace
-{
-   mxClassID getMxClassFromEncodingType(EncodingType type)
-   {
-      switch (type)
-      {
-         case INT1SBYTE:
-            return mxINT8_CLASS;
-         case INT1UBYTE:
-            return mxUINT8_CLASS;
-         case INT2SBYTES:
-            return mxINT16_CLASS;
-         case INT2UBYTES:
-            return mxUINT16_CLASS;
-         case INT4SBYTES:
-            return mxINT32_CLASS;
-         case INT4UBYTES:
-            return mxUINT32_CLASS;
-         case FLT4BYTES:
-            return mxSINGLE_CLASS;
-         case FLT8BYTES:
-            return mxDOUBLE_CLASS;
-         default:
-            return mxUNKNOWN_CLASS;
-      }
-   }
-
-   EncodingType getEncodingTypeFromMxClass(mxClassID classId)
-   {
-      switch (classId)
-      {
-         case mxINT8_CLASS:
-            return INT1SBYTE;
-         case mxUINT8_CLASS:
-            return INT1UBYTE;
-         case mxINT16_CLASS:
-            return INT2SBYTES;
-         case mxUINT16_CLASS:
-            return INT2UBYTES;
-         case mxINT32_CLASS:
-            return INT4SBYTES;
-         case mxUINT32_CLASS:
-            return INT4UBYTES;
-         case mxSINGLE_CLASS:
-            return FLT4BYTES;
-         case mxDOUBLE_CLASS:
-            return FLT8BYTES;
-         default:
-            return EncodingType();
-      }
-   }
-}
-
-// ArraySizeCommand
-ArraySizeCommand::ArraySizeCommand(const std::string& name) :
-   MatlabInternalCommand(name)
-{}
-
-std::string ArraySizeCommand::execute(MatlabInterpreter& matlabInterpreter,
-   const std::vector<std::string>& strCmds, const std::vector<std::string>& strVars,
-   std::string& output, bool& outputIsError)
-{
-   std::string datasetName = getOrDefault(strCmds, 1);
-   std::string varName = getOrDefault(strVars, 0);
-   if (varName.empty() == false)
-   {
-      varName += " = ";
-   }
-
-   RasterElement* pRasterElement = dynamic_cast<RasterElement*>(MatlabFunctions::getDataset(datasetName));
-   if (pRasterElement == NULL)
-   {
-      outputIsError = true;
-      output = "Unable to find a dataset";
-      return std::string();
-   }
-
-   RasterDataDescriptor* pDescriptor = dynamic_cast<RasterDataDescriptor*>(pRasterElement->getDataDescriptor());
-   if (pDescriptor == NULL)
-   {
-      outputIsError = true;
-      output = "Unable to find a data descriptor";
-      return std::string();
-   }
-
-   outputIsError = false;
-   return varName + "[" + QString::number(pDescriptor->getRowCount()).toStdString() + ", " +
-      QString::number(pDescriptor->getColumnCount()).toStdString() + ", " +
-      QString::number(pDescriptor->getBandCount()).toStdString() + "]";
-}
-
-// ArrayToMatlabCommand
-ArrayToMatlabCommand::ArrayToMatlabCommand(const std::string& name) :
-   MatlabInternalCommand(name)
-{}
-
-std::string ArrayToMatlabCommand::execute(MatlabInterpreter& matlabInterpreter,
-   const std::vector<std::string>& strCmds, const std::vector<std::string>& strVars,
-   std::string& output, bool& outputIsError)
-{
-   std::string arrayName = getOrDefault(strVars, 0, "raster");
-   std::string startColumnValue = getOrDefault(strCmds, 1, "0");
-   std::string stopColumnValue = getOrDefault(strCmds, 2, "0");
-   std::string startRowValue = getOrDefault(strCmds, 3, "0");
-   std::string stopRowValue = getOrDefault(strCmds, 4, "0");
-   std::string startBandValue = getOrDefault(strCmds, 5, "0");
-   std::string stopBandValue = getOrDefault(strCmds, 6, "0");
-   std::string rasterName = getOrDefault(strCmds, 7);
-
-   bool ok = true;
-   unsigned int startColumn = QString::fromStdString(startColumnValue).toUInt(&ok);
-   if (ok == false)
-   {
-      outputIsError = true;
-      output = "Unable to determine the requested start column";
-      return std::string();
-   }
-
-   unsigned int stopColumn = QString::fromStdString(stopColumnValue).toUInt(&ok);
-   if (ok == false)
-   {
-      outputIsError = true;
-      output = "Unable to determine the requested stop column";
-      return std::string();
-   }
-
-   unsigned int startRow = QString::fromStdString(startRowValue).toUInt(&ok);
-   if (ok == false)
-   {
-      outputIsError = true;
-      output = "Unable to determine the requested start row";
-      return std::string();
-   }
-
-   unsigned int stopRow = QString::fromStdString(stopRowValue).toUInt(&ok);
-   if (ok == false)
-   {
-      outputIsError = true;
-      output = "Unable to determine the requested stop row";
-      return std::string();
-   }
-
-   unsigned int startBand = QString::fromStdString(startBandValue).toUInt(&ok);
-   if (ok == false)
-   {
-      outputIsError = true;
-      output = "Unable to determine the requested start band";
-      return std::string();
-   }
-
-   unsigned int stopBand = QString::fromStdString(stopBandValue).toUInt(&ok);
-   if (ok == false)
-   {
-      outputIsError = true;
-      output = "Unable to determine the requested stop band";
-      return std::string();
-   }
-
-   RasterElement* pRasterElement = dynamic_cast<RasterElement*>(MatlabFunctions::getDataset(rasterName));
-   if (pRasterElement == NULL)
-   {
-      outputIsError = true;
-      output = "Unable to find a dataset";
-      return std::string();
-   }
-
-   RasterDataDescriptor* pDescriptor = dynamic_cast<RasterDataDescriptor*>(pRasterElement->getDataDescriptor());
-   if (pDescriptor == NULL)
-   {
-      outputIsError = true;
-      output = "Unable to find a data descriptor";
-      return std::string();
-   }
-
-   if (stopRow == 0)
-   {
-      stopRow = pDescriptor->getRowCount() - 1;
-   }
-
-   if (stopColumn == 0)
-   {
-      stopColumn = pDescriptor->getColumnCount() - 1;
-   }
-
-   if (stopBand == 0)
-   {
-      stopBand = pDescriptor->getBandCount() - 1;
-   }
-
-   // Validate values.
-   if (startRow > stopRow)
-   {
-      std::swap(startRow, stopRow);
-   }
-
-   if (startColumn > stopColumn)
-   {
-      std::swap(startColumn, stopColumn);
-   }
-
-   if (startBand > stopBand)
-   {
-      std::swap(startBand, stopBand);
-   }
-
-   // Clamp to maximum values.
-   stopRow = std::min(stopRow, pDescriptor->getRowCount() - 1);
-   stopColumn = std::min(stopColumn, pDescriptor->getColumnCount() - 1);
-   stopBand = std::min(stopBand, pDescriptor->getBandCount() - 1);
-
-   // Create the mxArray which will hold the copy of data for MATLAB.
-   mwSize nDims = (startBand == stopBand ? 2 : 3);
-   mwSize dims[3];
-   dims[0] = stopRow - startRow + 1;
-   dims[1] = stopColumn - startColumn + 1;
-   dims[2] = stopBand - startBand + 1;
-
-   mxClassID classId = getMxClassFromEncodingType(pDescriptor->getDataType());
-   if (classId == mxUNKNOWN_CLASS)
-   {
-      outputIsError = true;
-      output = "Unsupported data type.";
-      return std::string();
-   }
-
-   mxArray* pArray = mxCreateNumericArray(nDims, dims, classId, mxREAL);
-   if (pArray == NULL)
-   {
-      outputIsError = true;
-      output = "Unable to allocate enough memory to copy the data to MATLAB.";
-      return std::string();
-   }
-
-   void* pArrayData = mxGetData(pArray);
-   if (pArrayData == NULL)
-   {
-      mxDestroyArray(pArray);
-      outputIsError = true;
-      output = "Unable to copy data.";
-      return std::string();
-   }
-
-   // Copy the data. This does not call getRawData because the data must be transposed during the copy
-   // to account for MATLAB's column-major nature.
-   std::string error;
-   switchOnEncoding(pDescriptor->getDataType(), MatlabFunctions::arrayToMatlab, pArrayData, error, pRasterElement,
-      startRow, stopRow, startColumn, stopColumn, startBand, stopBand);
-   if (error.empty() == false)
-   {
-      mxDestroyArray(pArray);
-      outputIsError = true;
-      output = error;
-      return std::string();
-   }
-
-   if (matlabInterpreter.setMatlabVariable(arrayName, pArray) == false)
-   {
-      mxDestroyArray(pArray);
-      outputIsError = true;
-      output = "Unable to set the MATLAB variable.";
-      return std::string();
-   }
-
-   // This command uses mxArray to put the variable into the environment, so there is no need to return anything in the
-   // std::string() since MATLAB does not need to evaluate anything more. This also avoids  potentially printing out the
-   // entire raster element to MATLAB's output, which could take a very long time.
-   mxDestroyArray(pArray);
-   outputIsError = false;
-   return std::string();
-}
-
-// ArrayToOpticksCommand
-ArrayToOpticksCommand::ArrayToOpticksCommand(const std::string& name) :
-   MatlabInternalCommand(name)
-{}
-
-std::string ArrayToOpticksCommand::execute(MatlabInterpreter& matlabInterpreter,
-   const std::vector<std::string>& strCmds, const std::vector<std::string>& strVars,
-   std::string& output, bool& outputIsError)
-{
-   if (strCmds.size() == 1)
-   {
-      outputIsError = true;
-      output = "Usage: " + strCmds[0] + "(matlab_array, opt:parent_raster_name, opt:display_results, "
-         "opt:new_window, opt:interleave, opt:units)";
-      return std::string();
-   }
-
-   std::string arrayName = getOrDefault(strCmds, 1);
-   std::string rasterName = getOrDefault(strCmds, 2);
-   std::string displayResultsValue = getOrDefault(strCmds, 3, "1");
-   std::string newWindowValue = getOrDefault(strCmds, 4, displayResultsValue);
-   std::string interleaveValue = getOrDefault(strCmds, 5, "bsq");
-   std::string units = getOrDefault(strCmds, 6);
-
-   bool error = false;
-   bool displayResults = StringUtilities::fromDisplayString<bool>(displayResultsValue, &error);
-   if (error == true)
-   {
-      outputIsError = true;
-      output = "Unable to determine whether to display results";
-      return std::string();
-   }
-
-   bool newWindow = StringUtilities::fromDisplayString<bool>(newWindowValue, &error);
-   if (error == true)
-   {
-      outputIsError = true;
-      output = "Unable to determine whether to create a window";
-      return std::string();
-   }
-
-   if (displayResults == false && newWindow == true)
-   {
-      outputIsError = true;
-      output = "Unable to create a new window without also displaying the results";
-      return std::string();
-   }
-
-   InterleaveFormatType interleave = MatlabFunctions::getInterleaveByName(interleaveValue);
-   if (interleave.isValid() == false)
-   {
-      outputIsError = true;
-      output = "Unable to determine the requested interleave";
-      return std::string();
-   }
-
-   mxArray* pArray = matlabInterpreter.getMatlabVariable(arrayName);
-   if (pArray == NULL)
-   {
-      outputIsError = true;
-      output = "Unable to get the MATLAB variable";
-      return std::string();
-   }
-
-   const mwSize* varSz = mxGetDimensions(pArray);
-   if (varSz == NULL)
-   {
-      mxDestroyArray(pArray);
-      outputIsError = true;
-      output = "Unable to find the size of the specified array";
-      return std::string();
-   }
-
-   mwSize numDims = mxGetNumberOfDimensions(pArray);
-   if (numDims < 1)
-   {
-      mxDestroyArray(pArray);
-      outputIsError = true;
-      output = "Unable to find the number of dimensions of the specified array";
-      return std::string();
-   }
-
-   const unsigned int rows = varSz[0];
-   const unsigned int columns = numDims >= 2 ? varSz[1] : 1;
-   const unsigned int bands = numDims >= 3 ? varSz[2] : 1;
-
-   mxClassID classId = mxGetClassID(pArray);
-   EncodingType type = getEncodingTypeFromMxClass(classId);
-   if (type.isValid() == false)
-   {
-      mxDestroyArray(pArray);
-      outputIsError = true;
-      output = "Unsupported data type";
-      return std::string();
-   }
-
-   std::string errorMessage;
-   switchOnEncoding(type, MatlabFunctions::arrayToOpticks, mxGetData(pArray), errorMessage,
-      arrayName, columns, rows, bands, units, type, interleave, true, rasterName, displayResults, newWindow);
-   mxDestroyArray(pArray);
-   if (errorMessage.empty() == false)
-   {
-      outputIsError = true;
-      output = errorMessage;
-      return std::string();
-   }
-
-   return std::string();
-}
+/*
+ * The information in this file is
+ * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
+ * and is subject to the terms and conditions of the
+ * GNU Lesser General Public License Version 2.1
+ * The license text is available from   
+ * http://www.gnu.org/licenses/lgpl.html
+ */
+
+#include "AoiElement.h"
+#include "ArrayCommands.h"
+#include "BandMath.h"
+#include "BitMask.h"
+#include "BitMaskIterator.h"
+#include "MatlabFunctions.h"
+#include "MatlabInterpreter.h"
+#include "ModelServices.h"
+#include "ObjectResource.h"
+#include "RasterDataDescriptor.h"
+#include "RasterElement.h"
+#include "RasterUtilities.h"
+#include "StringUtilities.h"
+#include "TransferPool.h"
+#include "Units.h"
+
+#include <matrix.h>
+
+#include <QtCore/QRegExp>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+   mxClassID getMxClassFromEncodingType(EncodingType type)
+   {
+      switch (type)
+      {
+         case INT1SBYTE:
+            return mxINT8_CLASS;
+         case INT1UBYTE:
+            return mxUINT8_CLASS;
+         case INT2SBYTES:
+            return mxINT16_CLASS;
+         case INT2UBYTES:
+            return mxUINT16_CLASS;
+         case INT4SBYTES:
+            return mxINT32_CLASS;
+         case INT4UBYTES:
+            return mxUINT32_CLASS;
+         case FLT4BYTES:
+            return mxSINGLE_CLASS;
+         case FLT8BYTES:
+            return mxDOUBLE_CLASS;
+         default:
+            return mxUNKNOWN_CLASS;
+      }
+   }
+
+   EncodingType getEncodingTypeFromMxClass(mxClassID classId)
+   {
+      switch (classId)
+      {
+         case mxINT8_CLASS:
+            return INT1SBYTE;
+         case mxUINT8_CLASS:
+            return INT1UBYTE;
+         case mxINT16_CLASS:
+            return INT2SBYTES;
+         case mxUINT16_CLASS:
+            return INT2UBYTES;
+         case mxINT32_CLASS:
+            return INT4SBYTES;
+         case mxUINT32_CLASS:
+            return INT4UBYTES;
+         case mxSINGLE_CLASS:
+            return FLT4BYTES;
+         case mxDOUBLE_CLASS:
+            return FLT8BYTES;
+         default:
+            return EncodingType();
+      }
+   }
+
+   const char* const spClassNames[] = { "int8", "uint8", "int16", "uint16", "int32", "uint32", "single", "double" };
+   const mxClassID sClassIds[] = { mxINT8_CLASS, mxUINT8_CLASS, mxINT16_CLASS, mxUINT16_CLASS,
+      mxINT32_CLASS, mxUINT32_CLASS, mxSINGLE_CLASS, mxDOUBLE_CLASS };
+
+   // Returns the numeric class with the given MATLAB class name, or mxUNKNOWN_CLASS if it is not supported.
+   mxClassID getMxClassByName(const std::string& name)
+   {
+      for (unsigned int i = 0; i < 8; ++i)
+      {
+         if (QString::fromStdString(name).compare(spClassNames[i], Qt::CaseInsensitive) == 0)
+         {
+            return sClassIds[i];
+         }
+      }
+
+      return mxUNKNOWN_CLASS;
+   }
+
+   // Returns the MATLAB class name of a supported numeric class, or an empty string if it is not supported.
+   std::string getMxClassName(mxClassID classId)
+   {
+      for (unsigned int i = 0; i < 8; ++i)
+      {
+         if (sClassIds[i] == classId)
+         {
+            return spClassNames[i];
+         }
+      }
+
+      return std::string();
+   }
+
+   using MatlabFunctions::PixelLocation;
+   using MatlabFunctions::Subcube;
+
+   // Parses the C0, C1, R0, R1, B0, B1 arguments which start at strCmds[index].
+   bool parseSubcube(const std::vector<std::string>& strCmds, unsigned int index, Subcube& subcube,
+      std::string& error)
+   {
+      const char* pNames[] = { "start column", "stop column", "start row", "stop row", "start band", "stop band" };
+      unsigned int* pValues[] = { &subcube.mStartColumn, &subcube.mStopColumn, &subcube.mStartRow,
+         &subcube.mStopRow, &subcube.mStartBand, &subcube.mStopBand };
+      for (unsigned int i = 0; i < 6; ++i)
+      {
+         bool ok = true;
+         *pValues[i] = QString::fromStdString(MatlabInternalCommand::getOrDefault(strCmds, index + i, "0")).toUInt(&ok);
+         if (ok == false)
+         {
+            error = std::string("Unable to determine the requested ") + pNames[i];
+            return false;
+         }
+      }
+
+      subcube.mRowStride = 1;
+      subcube.mColumnStride = 1;
+      subcube.mBandStride = 1;
+      subcube.mAverage = false;
+      return true;
+   }
+
+   // Parses the optional row stride, column stride, band stride, and decimation mode arguments
+   // which start at strCmds[index].
+   bool parseStrides(const std::vector<std::string>& strCmds, unsigned int index, Subcube& subcube,
+      std::string& error)
+   {
+      const char* pNames[] = { "row stride", "column stride", "band stride" };
+      unsigned int* pValues[] = { &subcube.mRowStride, &subcube.mColumnStride, &subcube.mBandStride };
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+         bool ok = true;
+         *pValues[i] = QString::fromStdString(MatlabInternalCommand::getOrDefault(strCmds, index + i, "1")).toUInt(&ok);
+         if (ok == false || *pValues[i] == 0)
+         {
+            error = std::string("Unable to determine the requested ") + pNames[i];
+            return false;
+         }
+      }
+
+      QString mode = QString::fromStdString(MatlabInternalCommand::getOrDefault(strCmds, index + 3, "sample"));
+      if (mode.compare("sample", Qt::CaseInsensitive) == 0)
+      {
+         subcube.mAverage = false;
+      }
+      else if (mode.compare("average", Qt::CaseInsensitive) == 0)
+      {
+         subcube.mAverage = true;
+      }
+      else
+      {
+         error = "Unknown decimation mode. Valid values are 'sample' and 'average'.";
+         return false;
+      }
+
+      return true;
+   }
+
+   // Replaces stop values of 0 with the last row, column, or band, orders each pair, and clamps to the element.
+   void clampSubcube(const RasterDataDescriptor* pDescriptor, Subcube& subcube)
+   {
+      if (subcube.mStopRow == 0)
+      {
+         subcube.mStopRow = pDescriptor->getRowCount() - 1;
+      }
+
+      if (subcube.mStopColumn == 0)
+      {
+         subcube.mStopColumn = pDescriptor->getColumnCount() - 1;
+      }
+
+      if (subcube.mStopBand == 0)
+      {
+         subcube.mStopBand = pDescriptor->getBandCount() - 1;
+      }
+
+      // Validate values.
+      if (subcube.mStartRow > subcube.mStopRow)
+      {
+         std::swap(subcube.mStartRow, subcube.mStopRow);
+      }
+
+      if (subcube.mStartColumn > subcube.mStopColumn)
+      {
+         std::swap(subcube.mStartColumn, subcube.mStopColumn);
+      }
+
+      if (subcube.mStartBand > subcube.mStopBand)
+      {
+         std::swap(subcube.mStartBand, subcube.mStopBand);
+      }
+
+      // Clamp to maximum values.
+      subcube.mStopRow = std::min(subcube.mStopRow, pDescriptor->getRowCount() - 1);
+      subcube.mStopColumn = std::min(subcube.mStopColumn, pDescriptor->getColumnCount() - 1);
+      subcube.mStopBand = std::min(subcube.mStopBand, pDescriptor->getBandCount() - 1);
+      subcube.mStartRow = std::min(subcube.mStartRow, subcube.mStopRow);
+      subcube.mStartColumn = std::min(subcube.mStartColumn, subcube.mStopColumn);
+      subcube.mStartBand = std::min(subcube.mStartBand, subcube.mStopBand);
+   }
+
+   // Describes everything about a copy made by putSubcube other than the raster element it came from.
+   std::string getTransferKey(const Subcube& subcube, mxClassID classId, double scale)
+   {
+      QStringList values;
+      values << QString::number(subcube.mStartRow) << QString::number(subcube.mStopRow) <<
+         QString::number(subcube.mStartColumn) << QString::number(subcube.mStopColumn) <<
+         QString::number(subcube.mStartBand) << QString::number(subcube.mStopBand) <<
+         QString::number(subcube.mRowStride) << QString::number(subcube.mColumnStride) <<
+         QString::number(subcube.mBandStride) << QString::number(subcube.mAverage ? 1 : 0) <<
+         QString::number(static_cast<int>(classId)) << QString::number(scale, 'g', 17);
+      return values.join(" ").toStdString();
+   }
+
+   // Copies a transposed subcube into the MATLAB variable called name, or returns false and sets error on failure.
+   // The copy is converted to classId and multiplied by scale, or keeps the raster's own class for mxUNKNOWN_CLASS.
+   // Only copies made with cache set are remembered by the transfer cache, so that temporary copies such as the
+   // tiles of a stream are not kept alive in MATLAB after they are cleared.
+   bool putSubcube(MatlabInterpreter& matlabInterpreter, const std::string& name, RasterElement* pRasterElement,
+      const Subcube& subcube, mxClassID classId, double scale, bool cache, std::string& error)
+   {
+      const RasterDataDescriptor* pDescriptor =
+         dynamic_cast<const RasterDataDescriptor*>(pRasterElement->getDataDescriptor());
+      if (pDescriptor == NULL)
+      {
+         error = "Unable to find a data descriptor";
+         return false;
+      }
+
+      // Determine the size of the array which will hold the copy of data for MATLAB.
+      mwSize dims[3];
+      dims[0] = static_cast<mwSize>((subcube.mStopRow - subcube.mStartRow) / subcube.mRowStride) + 1;
+      dims[1] = static_cast<mwSize>((subcube.mStopColumn - subcube.mStartColumn) / subcube.mColumnStride) + 1;
+      dims[2] = static_cast<mwSize>((subcube.mStopBand - subcube.mStartBand) / subcube.mBandStride) + 1;
+
+      mwSize nDims = (dims[2] == 1 ? 2 : 3);
+
+      if (classId == mxUNKNOWN_CLASS)
+      {
+         classId = getMxClassFromEncodingType(pDescriptor->getDataType());
+      }
+
+      if (classId == mxUNKNOWN_CLASS)
+      {
+         error = "Unsupported data type.";
+         return false;
+      }
+
+      // Skip the copy entirely if MATLAB still holds an identical one from an earlier transfer.
+      const std::string key = getTransferKey(subcube, classId, scale);
+      if (cache == true && matlabInterpreter.restoreTransfer(name, pRasterElement, key) == true)
+      {
+         return true;
+      }
+
+      // Large copies are written straight into a file which MATLAB maps, instead of being built in an mxArray
+      // and then serialized through the engine. Fall back to an mxArray if the file cannot be mapped.
+      const EncodingType arrayType = getEncodingTypeFromMxClass(classId);
+      const size_t size = dims[0] * dims[1] * dims[2] * RasterUtilities::bytesInEncoding(arrayType);
+      const int threshold = MatlabInterpreter::getSettingSharedMemoryThreshold();
+      if (threshold > 0 && size / (1024 * 1024) >= static_cast<size_t>(threshold))
+      {
+         void* pSharedData = matlabInterpreter.mapSharedVariable(size);
+         if (pSharedData != NULL)
+         {
+            MatlabFunctions::arrayToMatlab(pSharedData, arrayType, error, pRasterElement, subcube, scale);
+            if (error.empty() == false)
+            {
+               matlabInterpreter.unmapSharedVariable();
+               return false;
+            }
+
+            std::vector<size_t> sharedDims(dims, dims + nDims);
+            if (matlabInterpreter.setSharedVariable(name, getMxClassName(classId), sharedDims) == false)
+            {
+               error = "Unable to set the MATLAB variable.";
+               return false;
+            }
+
+            if (cache == true)
+            {
+               matlabInterpreter.recordTransfer(name, pRasterElement, key);
+            }
+
+            return true;
+         }
+      }
+
+      // The engine copies the array into MATLAB, so the same array can be filled again by the next transfer.
+      TransferPool& pool = matlabInterpreter.getTransferPool();
+      mxArray* pArray = pool.acquireArray(classId, nDims, dims);
+      if (pArray == NULL)
+      {
+         error = "Unable to allocate enough memory to copy the data to MATLAB.";
+         return false;
+      }
+
+      void* pArrayData = mxGetData(pArray);
+      if (pArrayData == NULL)
+      {
+         pool.releaseArray(pArray);
+         error = "Unable to copy data.";
+         return false;
+      }
+
+      // Copy the data. The data is transposed and converted during the copy to account for MATLAB's column-major
+      // nature and the requested class.
+      MatlabFunctions::arrayToMatlab(pArrayData, arrayType, error, pRasterElement, subcube, scale);
+      if (error.empty() == false)
+      {
+         pool.releaseArray(pArray);
+         return false;
+      }
+
+      const bool success = matlabInterpreter.setMatlabVariable(name, pArray);
+      pool.releaseArray(pArray);
+      if (success == false)
+      {
+         error = "Unable to set the MATLAB variable.";
+         return false;
+      }
+
+      if (cache == true)
+      {
+         matlabInterpreter.recordTransfer(name, pRasterElement, key);
+      }
+
+      return true;
+   }
+
+   // Parses the optional start and stop band arguments at strCmds[index] and strCmds[index + 1] into a zero-based
+   // start band and band count. A stop band of 0 selects the last band.
+   bool parseBands(const std::vector<std::string>& strCmds, unsigned int index,
+      const RasterDataDescriptor* pDescriptor, size_t& startBand, size_t& bandCount, std::string& error)
+   {
+      bool startOk = true;
+      bool stopOk = true;
+      unsigned int start =
+         QString::fromStdString(MatlabInternalCommand::getOrDefault(strCmds, index, "0")).toUInt(&startOk);
+      unsigned int stop =
+         QString::fromStdString(MatlabInternalCommand::getOrDefault(strCmds, index + 1, "0")).toUInt(&stopOk);
+      if (startOk == false || stopOk == false)
+      {
+         error = std::string("Unable to determine the requested ") + (startOk == false ? "start band" : "stop band");
+         return false;
+      }
+
+      if (stop == 0)
+      {
+         stop = pDescriptor->getBandCount() - 1;
+      }
+
+      if (start > stop)
+      {
+         std::swap(start, stop);
+      }
+
+      stop = std::min(stop, pDescriptor->getBandCount() - 1);
+      start = std::min(start, stop);
+      startBand = start;
+      bandCount = static_cast<size_t>(stop - start) + 1;
+      return true;
+   }
+
+   // Collects the pixels selected by an AOI which fall inside a raster element. The iterator visits them in row
+   // order, so each pixel's index is simply its position in the list.
+   void getAoiPixels(const AoiElement* pAoi, const RasterElement* pRasterElement, std::vector<PixelLocation>& pixels)
+   {
+      BitMaskIterator iter(pAoi->getSelectedPoints(), pRasterElement);
+      pixels.clear();
+      pixels.reserve(iter.getNumSelectedPixels());
+      for (; iter != iter.end(); ++iter)
+      {
+         PixelLocation location;
+         location.mRow = static_cast<unsigned int>(iter.getPixelRowLocation());
+         location.mColumn = static_cast<unsigned int>(iter.getPixelColumnLocation());
+         location.mIndex = pixels.size();
+         pixels.push_back(location);
+      }
+   }
+
+   // Returns true if name is a variable in the MATLAB workspace. The variable is checked in MATLAB, so its value is
+   // never fetched.
+   bool isMatlabVariable(MatlabInterpreter& matlabInterpreter, const std::string& name)
+   {
+      if (QRegExp("[A-Za-z]\\w*").exactMatch(QString::fromStdString(name)) == false)
+      {
+         return false;
+      }
+
+      std::vector<std::string> expressions(1, "exist(" + MatlabFunctions::toMatlabString(name) + ", 'var')");
+      mxArray* pValues = matlabInterpreter.evaluateMatlabExpressions(expressions);
+      if (pValues == NULL)
+      {
+         return false;
+      }
+
+      const mxArray* pExists = mxGetCell(pValues, 0);
+      const bool exists = (pExists != NULL && mxGetScalar(pExists) != 0.0);
+      mxDestroyArray(pValues);
+      return exists;
+   }
+
+   // Copies the spectra of a list of pixels into an N x bandCount MATLAB variable called name, in the raster's own
+   // class, or returns false and sets error on failure. The pixels are sorted by the copy.
+   bool putPixelSpectra(MatlabInterpreter& matlabInterpreter, const std::string& name, RasterElement* pRasterElement,
+      std::vector<PixelLocation>& pixels, size_t startBand, size_t bandCount, std::string& error)
+   {
+      const RasterDataDescriptor* pDescriptor =
+         dynamic_cast<const RasterDataDescriptor*>(pRasterElement->getDataDescriptor());
+      if (pDescriptor == NULL)
+      {
+         error = "Unable to find a data descriptor";
+         return false;
+      }
+
+      mxClassID classId = getMxClassFromEncodingType(pDescriptor->getDataType());
+      if (classId == mxUNKNOWN_CLASS)
+      {
+         error = "Unsupported data type.";
+         return false;
+      }
+
+      TransferPool& pool = matlabInterpreter.getTransferPool();
+      const mwSize dims[] = { static_cast<mwSize>(pixels.size()), static_cast<mwSize>(bandCount) };
+      mxArray* pArray = pool.acquireArray(classId, 2, dims);
+      if (pArray == NULL)
+      {
+         error = "Unable to allocate enough memory to copy the data to MATLAB.";
+         return false;
+      }
+
+      if (pixels.empty() == false)
+      {
+         MatlabFunctions::pixelsToMatlab(mxGetData(pArray), getEncodingTypeFromMxClass(classId), error,
+            pRasterElement, pixels, startBand, bandCount);
+         if (error.empty() == false)
+         {
+            pool.releaseArray(pArray);
+            return false;
+         }
+      }
+
+      const bool success = matlabInterpreter.setMatlabVariable(name, pArray);
+      pool.releaseArray(pArray);
+      if (success == false)
+      {
+         error = "Unable to set the MATLAB variable.";
+         return false;
+      }
+
+      return true;
+   }
+}
+
+// ArrayAoiToMatlabCommand
+ArrayAoiToMatlabCommand::ArrayAoiToMatlabCommand(const std::string& name) :
+   MatlabInternalCommand(name)
+{}
+
+std::string ArrayAoiToMatlabCommand::execute(MatlabInterpreter& matlabInterpreter,
+   const std::vector<std::string>& strCmds, const std::vector<std::string>& strVars,
+   std::string& output, bool& outputIsError)
+{
+   std::string spectraName = getOrDefault(strVars, 0, "spectra");
+   std::string locationsName = getOrDefault(strVars, 1, "locations");
+   std::string aoiName = getOrDefault(strCmds, 1);
+   std::string rasterName = getOrDefault(strCmds, 2);
+
+   AoiElement* pAoi = dynamic_cast<AoiElement*>(MatlabFunctions::getDataset(aoiName));
+   if (pAoi == NULL)
+   {
+      outputIsError = true;
+      output = "Unable to find an AOI";
+      return std::string();
+   }
+
+   // An AOI is normally created as a child of the raster it was drawn on, so use that unless a raster is named.
+   RasterElement* pRasterElement = NULL;
+   if (rasterName.empty() == true)
+   {
+      pRasterElement = dynamic_cast<RasterElement*>(pAoi->getParent());
+   }
+
+   if (pRasterElement == NULL)
+   {
+      pRasterElement = dynamic_cast<RasterElement*>(MatlabFunctions::getDataset(rasterName));
+   }
+
+   if (pRasterElement == NULL)
+   {
+      outputIsError = true;
+      output = "Unable to find a dataset";
+      return std::string();
+   }
+
+   const RasterDataDescriptor* pDescriptor =
+      dynamic_cast<const RasterDataDescriptor*>(pRasterElement->getDataDescriptor());
+   if (pDescriptor == NULL)
+   {
+      outputIsError = true;
+      output = "Unable to find a data descriptor";
+      return std::string();
+   }
+
+   size_t startBand = 0;
+   size_t bandCount = 0;
+   if (parseBands(strCmds, 3, pDescriptor, startBand, bandCount, output) == false)
+   {
+      outputIsError = true;
+      return std::string();
+   }
+
+   std::vector<PixelLocation> pixels;
+   getAoiPixels(pAoi, pRasterElement, pixels);
+
+   mxArray* pLocations = mxCreateDoubleMatrix(pixels.size(), 2, mxREAL);
+   if (pLocations == NULL)
+   {
+      outputIsError = true;
+      output = "Unable to allocate enough memory to copy the data to MATLAB.";
+      return std::string();
+   }
+
+   double* pLocationData = mxGetPr(pLocations);
+   for (std::vector<PixelLocation>::const_iterator pixel = pixels.begin();
+      pixel != pixels.end(); ++pixel)
+   {
+      pLocationData[pixel->mIndex] = pixel->mRow;
+      pLocationData[pixels.size() + pixel->mIndex] = pixel->mColumn;
+   }
+
+   const bool success = matlabInterpreter.setMatlabVariable(locationsName, pLocations);
+   mxDestroyArray(pLocations);
+   if (success == false)
+   {
+      outputIsError = true;
+      output = "Unable to set the MATLAB variable.";
+      return std::string();
+   }
+
+   std::string copyError;
+   if (putPixelSpectra(matlabInterpreter, spectraName, pRasterElement, pixels, startBand, bandCount,
+      copyError) == false)
+   {
+      outputIsError = true;
+      output = copyError;
+      return std::string();
+   }
+
+   outputIsError = false;
+   return std::string();
+}
+
+// ArrayCovarianceCommand
+ArrayCovarianceCommand::ArrayCovarianceCommand(const std::string& name) :
+   MatlabInternalCommand(name)
+{}
+
+std::string ArrayCovarianceCommand::execute(MatlabInterpreter& matlabInterpreter,
+   const std::vector<std::string>& strCmds, const std::vector<std::string>& strVars,
+   std::string& output, bool& outputIsError)
+{
+   std::string covarianceName = getOrDefault(strVars, 0, "covariance");
+   std::string meanName = getOrDefault(strVars, 1);
+   std::string eigenvectorsName = getOrDefault(strVars, 2);
+   std::string eigenvaluesName = getOrDefault(strVars, 3);
+   std::string rasterName = getOrDefault(strCmds, 7);
+   std::string aoiName = getOrDefault(strCmds, 12);
+
+   Subcube subcube;
+   if (parseSubcube(strCmds, 1, subcube, output) == false || parseStrides(strCmds, 8, subcube, output) == false)
+   {
+      outputIsError = true;
+      return std::string();
+   }
+
+   RasterElement* pRasterElement = dynamic_cast<RasterElement*>(MatlabFunctions::getDataset(rasterName));
+   if (pRasterElement == NULL)
+   {
+      outputIsError = true;
+      output = "Unable to find a dataset";
+      return std::string();
+   }
+
+   RasterDataDescriptor* pDescriptor = dynamic_cast<RasterDataDescriptor*>(pRasterElement->getDataDescriptor());
+   if (pDescriptor == NULL)
+   {
+      outputIsError = true;
+      output = "Unable to find a data descriptor";
+      return std::string();
+   }
+
+   clampSubcube(pDescriptor, subcube);
+
+   // An AOI selects individual pixels, so it is only combined with the bounds of the subcube and not its strides.
+   std::vector<PixelLocation> pixels;
+   if (aoiName.empty() == false)
+   {
+      AoiElement* pAoi = dynamic_cast<AoiElement*>(MatlabFunctions::getDataset(aoiName));
+      if (pAoi == NULL)
+      {
+         outputIsError = true;
+         output = "Unable to find an AOI";
+         return std::string();
+      }
+
+      if (subcube.mRowStride != 1 || subcube.mColumnStride != 1 || subcube.mBandStride != 1)
+      {
+         outputIsError = true;
+         output = "Strides cannot be used with an AOI";
+         return std::string();
+      }
+
+      std::vector<PixelLocation> aoiPixels;
+      getAoiPixels(pAoi, pRasterElement, aoiPixels);
+      for (std::vector<PixelLocation>::const_iterator iter = aoiPixels.begin(); iter != aoiPixels.end(); ++iter)
+      {
+         if (iter->mRow >= subcube.mStartRow && iter->mRow <= subcube.mStopRow &&
+            iter->mColumn >= subcube.mStartColumn && iter->mColumn <= subcube.mStopColumn)
+         {
+            pixels.push_back(*iter);
+         }
+      }
+   }
+
+   std::vector<double> mean;
+   std::vector<double> covariance;
+   size_t count = 0;
+   std::string error;
+   MatlabFunctions::bandCovariance(pRasterElement, subcube, aoiName.empty() ? NULL : &pixels, mean, covariance,
+      count, error, matlabInterpreter.getTransferPool());
+   if (error.empty() == false)
+   {
+      outputIsError = true;
+      output = error;
+      return std::string();
+   }
+
+   const size_t bandCount = mean.size();
+   std::vector<double> eigenvalues;
+   std::vector<double> eigenvectors;
+   if (eigenvectorsName.empty() == false || eigenvaluesName.empty() == false)
+   {
+      MatlabFunctions::symmetricEigen(covariance, bandCount, eigenvalues, eigenvectors);
+   }
+
+   // Only the requested outputs are created, and each one is a small matrix which is sent to MATLAB as is.
+   const std::string names[] = { covarianceName, meanName, eigenvectorsName, eigenvaluesName };
+   const std::vector<double>* pValues[] = { &covariance, &mean, &eigenvectors, &eigenvalues };
+   const size_t rows[] = { bandCount, 1, bandCount, bandCount };
+   const size_t columns[] = { bandCount, bandCount, bandCount, 1 };
+   for (unsigned int i = 0; i < 4; ++i)
+   {
+      if (names[i].empty() == true)
+      {
+         continue;
+      }
+
+      mxArray* pArray = mxCreateDoubleMatrix(rows[i], columns[i], mxREAL);
+      if (pArray == NULL)
+      {
+         outputIsError = true;
+         output = "Unable to allocate enough memory to return the covariance.";
+         return std::string();
+      }
+
+      std::copy(pValues[i]->begin(), pValues[i]->end(), mxGetPr(pArray));
+      const bool success = matlabInterpreter.setMatlabVariable(names[i], pArray);
+      mxDestroyArray(pArray);
+      if (success == false)
+      {
+         outputIsError = true;
+         output = "Unable to set the MATLAB variable.";
+         return std::string();
+      }
+   }
+
+   outputIsError = false;
+   return std::string();
+}
+
+// ArrayPointsToMatlabCommand
+ArrayPointsToMatlabCommand::ArrayPointsToMatlabCommand(const std::string& name) :
+   MatlabInternalCommand(name)
+{}
+
+std::string ArrayPointsToMatlabCommand::execute(MatlabInterpreter& matlabInterpreter,
+   const std::vector<std::string>& strCmds, const std::vector<std::string>& strVars,
+   std::string& output, bool& outputIsError)
+{
+   if (strCmds.size() == 1)
+   {
+      outputIsError = true;
+      output = "Usage: " + strCmds[0] + "(matlab_points, opt:raster_name, opt:start_band, opt:stop_band)";
+      return std::string();
+   }
+
+   std::string spectraName = getOrDefault(strVars, 0, "spectra");
+   std::string pointsName = getOrDefault(strCmds, 1);
+   std::string rasterName = getOrDefault(strCmds, 2);
+
+   RasterElement* pRasterElement = dynamic_cast<RasterElement*>(MatlabFunctions::getDataset(rasterName));
+   if (pRasterElement == NULL)
+   {
+      outputIsError = true;
+      output = "Unable to find a dataset";
+      return std::string();
+   }
+
+   const RasterDataDescriptor* pDescriptor =
+      dynamic_cast<const RasterDataDescriptor*>(pRasterElement->getDataDescriptor());
+   if (pDescriptor == NULL)
+   {
+      outputIsError = true;
+      output = "Unable to find a data descriptor";
+      return std::string();
+   }
+
+   size_t startBand = 0;
+   size_t bandCount = 0;
+   if (parseBands(strCmds, 3, pDescriptor, startBand, bandCount, output) == false)
+   {
+      outputIsError = true;
+      return std::string();
+   }
+
+   mxArray* pPoints = matlabInterpreter.getMatlabVariable(pointsName);
+   if (pPoints == NULL)
+   {
+      outputIsError = true;
+      output = "Unable to get the MATLAB variable";
+      return std::string();
+   }
+
+   if (mxIsDouble(pPoints) == false || mxIsComplex(pPoints) == true || mxGetNumberOfDimensions(pPoints) != 2 ||
+      (mxGetN(pPoints) != 2 && mxIsEmpty(pPoints) == false))
+   {
+      mxDestroyArray(pPoints);
+      outputIsError = true;
+      output = "The points must be an N x 2 double matrix of zero-based rows and columns";
+      return std::string();
+   }
+
+   // Keep each point's position in the list so that the spectra are returned in the caller's order once the
+   // points have been sorted for the copy.
+   const size_t pointCount = mxGetM(pPoints);
+   const double* pPointData = mxGetPr(pPoints);
+   const double rowCount = pDescriptor->getRowCount();
+   const double columnCount = pDescriptor->getColumnCount();
+   std::vector<PixelLocation> pixels(pointCount);
+   for (size_t i = 0; i < pointCount; ++i)
+   {
+      const double row = pPointData[i];
+      const double column = pPointData[pointCount + i];
+      if ((row >= 0.0 && row < rowCount && column >= 0.0 && column < columnCount) == false ||
+         row != static_cast<unsigned int>(row) || column != static_cast<unsigned int>(column))
+      {
+         mxDestroyArray(pPoints);
+         outputIsError = true;
+         output = "Point " + QString::number(static_cast<qulonglong>(i) + 1).toStdString() + " is not a pixel in the raster element";
+         return std::string();
+      }
+
+      pixels[i].mRow = static_cast<unsigned int>(row);
+      pixels[i].mColumn = static_cast<unsigned int>(column);
+      pixels[i].mIndex = i;
+   }
+
+   mxDestroyArray(pPoints);
+
+   std::string copyError;
+   if (putPixelSpectra(matlabInterpreter, spectraName, pRasterElement, pixels, startBand, bandCount,
+      copyError) == false)
+   {
+      outputIsError = true;
+      output = copyError;
+      return std::string();
+   }
+
+   outputIsError = false;
+   return std::string();
+}
+
+// ArraySizeCommand
+ArraySizeCommand::ArraySizeCommand(const std::string& name) :
+   MatlabInternalCommand(name)
+{}
+
+std::string ArraySizeCommand::execute(MatlabInterpreter& matlabInterpreter,
+   const std::vector<std::string>& strCmds, const std::vector<std::string>& strVars,
+   std::string& output, bool& outputIsError)
+{
+   std::string datasetName = getOrDefault(strCmds, 1);
+   std::string varName = getOrDefault(strVars, 0, "ans");
+
+   RasterElement* pRasterElement = dynamic_cast<RasterElement*>(MatlabFunctions::getDataset(datasetName));
+   if (pRasterElement == NULL)
+   {
+      outputIsError = true;
+      output = "Unable to find a dataset";
+      return std::string();
+   }
+
+   RasterDataDescriptor* pDescriptor = dynamic_cast<RasterDataDescriptor*>(pRasterElement->getDataDescriptor());
+   if (pDescriptor == NULL)
+   {
+      outputIsError = true;
+      output = "Unable to find a data descriptor";
+      return std::string();
+   }
+
+   mxArray* pSize = mxCreateDoubleMatrix(1, 3, mxREAL);
+   if (pSize != NULL)
+   {
+      mxGetPr(pSize)[0] = pDescriptor->getRowCount();
+      mxGetPr(pSize)[1] = pDescriptor->getColumnCount();
+      mxGetPr(pSize)[2] = pDescriptor->getBandCount();
+   }
+
+   return MatlabFunctions::setResult(matlabInterpreter, varName, pSize, output, outputIsError);
+}
+
+// ArrayStatisticsCommand
+ArrayStatisticsCommand::ArrayStatisticsCommand(const std::string& name) :
+   MatlabInternalCommand(name)
+{}
+
+std::string ArrayStatisticsCommand::execute(MatlabInterpreter& matlabInterpreter,
+   const std::vector<std::string>& strCmds, const std::vector<std::string>& strVars,
+   std::string& output, bool& outputIsError)
+{
+   std::string statisticsName = getOrDefault(strVars, 0, "statistics");
+   std::string rasterName = getOrDefault(strCmds, 7);
+   std::string binCountValue = getOrDefault(strCmds, 12, "256");
+
+   Subcube subcube;
+   if (parseSubcube(strCmds, 1, subcube, output) == false || parseStrides(strCmds, 8, subcube, output) == false)
+   {
+      outputIsError = true;
+      return std::string();
+   }
+
+   bool ok = true;
+   unsigned int binCount = QString::fromStdString(binCountValue).toUInt(&ok);
+   if (ok == false)
+   {
+      outputIsError = true;
+      output = "Unable to determine the requested number of histogram bins";
+      return std::string();
+   }
+
+   RasterElement* pRasterElement = dynamic_cast<RasterElement*>(MatlabFunctions::getDataset(rasterName));
+   if (pRasterElement == NULL)
+   {
+      outputIsError = true;
+      output = "Unable to find a dataset";
+      return std::string();
+   }
+
+   RasterDataDescriptor* pDescriptor = dynamic_cast<RasterDataDescriptor*>(pRasterElement->getDataDescriptor());
+   if (pDescriptor == NULL)
+   {
+      outputIsError = true;
+      output = "Unable to find a data descriptor";
+      return std::string();
+   }
+
+   clampSubcube(pDescriptor, subcube);
+
+   std::vector<MatlabFunctions::BandStatistics> statistics;
+   std::string error;
+   MatlabFunctions::bandStatistics(pRasterElement, subcube, binCount, statistics, error,
+      matlabInterpreter.getTransferPool());
+   if (error.empty() == false)
+   {
+      outputIsError = true;
+      output = error;
+      return std::string();
+   }
+
+   // Each field holds one column per band, so the results line up with the bands of array_to_matlab.
+   const char* pFields[] = { "count", "min", "max", "mean", "std", "histogram", "edges" };
+   const size_t bandCount = statistics.size();
+   mxArray* pArray = mxCreateStructMatrix(1, 1, 7, pFields);
+   mxArray* pCount = mxCreateDoubleMatrix(1, bandCount, mxREAL);
+   mxArray* pMin = mxCreateDoubleMatrix(1, bandCount, mxREAL);
+   mxArray* pMax = mxCreateDoubleMatrix(1, bandCount, mxREAL);
+   mxArray* pMean = mxCreateDoubleMatrix(1, bandCount, mxREAL);
+   mxArray* pStd = mxCreateDoubleMatrix(1, bandCount, mxREAL);
+   mxArray* pHistogram = mxCreateDoubleMatrix(binCount, bandCount, mxREAL);
+   mxArray* pEdges = mxCreateDoubleMatrix(binCount == 0 ? 0 : binCount + 1, bandCount, mxREAL);
+   if (pArray == NULL || pCount == NULL || pMin == NULL || pMax == NULL || pMean == NULL || pStd == NULL ||
+      pHistogram == NULL || pEdges == NULL)
+   {
+      mxArray* pArrays[] = { pArray, pCount, pMin, pMax, pMean, pStd, pHistogram, pEdges };
+      for (unsigned int i = 0; i < 8; ++i)
+      {
+         if (pArrays[i] != NULL)
+         {
+            mxDestroyArray(pArrays[i]);
+         }
+      }
+
+      outputIsError = true;
+      output = "Unable to allocate enough memory to return the statistics.";
+      return std::string();
+   }
+
+   // Bands without any values report NaN, as MATLAB does for an empty array. The standard deviation is normalized
+   // by N - 1 to match MATLAB's std.
+   const double nan = std::numeric_limits<double>::quiet_NaN();
+   for (size_t band = 0; band < bandCount; ++band)
+   {
+      const MatlabFunctions::BandStatistics& bandStatistics = statistics[band];
+      const bool empty = (bandStatistics.mCount == 0);
+      mxGetPr(pCount)[band] = static_cast<double>(bandStatistics.mCount);
+      mxGetPr(pMin)[band] = empty ? nan : bandStatistics.mMin;
+      mxGetPr(pMax)[band] = empty ? nan : bandStatistics.mMax;
+      mxGetPr(pMean)[band] = empty ? nan : bandStatistics.mMean;
+      mxGetPr(pStd)[band] = empty ? nan : (bandStatistics.mCount == 1 ? 0.0 :
+         std::sqrt(bandStatistics.mSumSquares / (bandStatistics.mCount - 1)));
+      if (binCount != 0)
+      {
+         std::copy(bandStatistics.mHistogram.begin(), bandStatistics.mHistogram.end(),
+            mxGetPr(pHistogram) + band * binCount);
+         double* pBandEdges = mxGetPr(pEdges) + band * (binCount + 1);
+         for (unsigned int edge = 0; edge <= binCount; ++edge)
+         {
+            pBandEdges[edge] = empty ? nan : bandStatistics.mMin +
+               (bandStatistics.mMax - bandStatistics.mMin) * edge / binCount;
+         }
+      }
+   }
+
+   mxSetField(pArray, 0, "count", pCount);
+   mxSetField(pArray, 0, "min", pMin);
+   mxSetField(pArray, 0, "max", pMax);
+   mxSetField(pArray, 0, "mean", pMean);
+   mxSetField(pArray, 0, "std", pStd);
+   mxSetField(pArray, 0, "histogram", pHistogram);
+   mxSetField(pArray, 0, "edges", pEdges);
+
+   const bool success = matlabInterpreter.setMatlabVariable(statisticsName, pArray);
+   mxDestroyArray(pArray);
+   if (success == false)
+   {
+      outputIsError = true;
+      output = "Unable to set the MATLAB variable.";
+      return std::string();
+   }
+
+   outputIsError = false;
+   return std::string();
+}
+
+// ArrayStreamToMatlabCommand
+ArrayStreamToMatlabCommand::ArrayStreamToMatlabCommand(const std::string& name) :
+   MatlabInternalCommand(name)
+{}
+
+std::string ArrayStreamToMatlabCommand::execute(MatlabInterpreter& matlabInterpreter,
+   const std::vector<std::string>& strCmds, const std::vector<std::string>& strVars,
+   std::string& output, bool& outputIsError)
+{
+   if (strCmds.size() == 1)
+   {
+      outputIsError = true;
+      output = "Usage: " + strCmds[0] + "(function, opt:start_column, opt:stop_column, opt:start_row, "
+         "opt:stop_row, opt:start_band, opt:stop_band, opt:raster_name, opt:block_type, opt:memory_budget_mb)";
+      return std::string();
+   }
+
+   std::string tileName = getOrDefault(strVars, 0, "tile");
+   std::string function = getOrDefault(strCmds, 1);
+   std::string rasterName = getOrDefault(strCmds, 8);
+   std::string blockTypeValue = getOrDefault(strCmds, 9, "rows");
+   std::string memoryBudgetValue = getOrDefault(strCmds, 10, "256");
+
+   if (function.empty() == true)
+   {
+      outputIsError = true;
+      output = "Unable to determine the function to call for each tile";
+      return std::string();
+   }
+
+   Subcube subcube;
+   if (parseSubcube(strCmds, 2, subcube, output) == false)
+   {
+      outputIsError = true;
+      return std::string();
+   }
+
+   QString blockType = QString::fromStdString(blockTypeValue).toLower().trimmed();
+   if (blockType != "rows" && blockType != "bands")
+   {
+      outputIsError = true;
+      output = "Unable to determine the requested block type";
+      return std::string();
+   }
+
+   bool ok = true;
+   double memoryBudget = QString::fromStdString(memoryBudgetValue).toDouble(&ok) * 1024.0 * 1024.0;
+   if (ok == false || memoryBudget <= 0.0)
+   {
+      outputIsError = true;
+      output = "Unable to determine the memory budget";
+      return std::string();
+   }
+
+   RasterElement* pRasterElement = dynamic_cast<RasterElement*>(MatlabFunctions::getDataset(rasterName));
+   if (pRasterElement == NULL)
+   {
+      outputIsError = true;
+      output = "Unable to find a dataset";
+      return std::string();
+   }
+
+   RasterDataDescriptor* pDescriptor = dynamic_cast<RasterDataDescriptor*>(pRasterElement->getDataDescriptor());
+   if (pDescriptor == NULL)
+   {
+      outputIsError = true;
+      output = "Unable to find a data descriptor";
+      return std::string();
+   }
+
+   clampSubcube(pDescriptor, subcube);
+
+   // Size each tile so that it fits within the memory budget. Only one tile exists at a time on either side
+   // since the MATLAB copy is cleared after each call and the Opticks copy is destroyed after it is sent.
+   const double rowCount = subcube.mStopRow - subcube.mStartRow + 1;
+   const double columnCount = subcube.mStopColumn - subcube.mStartColumn + 1;
+   const double bandCount = subcube.mStopBand - subcube.mStartBand + 1;
+   const double elementSize = pDescriptor->getBytesPerElement();
+   const bool rowBlocks = (blockType == "rows");
+   const double sliceSize = elementSize * columnCount * (rowBlocks ? bandCount : rowCount);
+   if (sliceSize > memoryBudget)
+   {
+      outputIsError = true;
+      output = rowBlocks ? "A single row of all bands does not fit within the memory budget" :
+         "A single band does not fit within the memory budget";
+      return std::string();
+   }
+
+   const size_t firstSlice = rowBlocks ? subcube.mStartRow : subcube.mStartBand;
+   const size_t lastSlice = rowBlocks ? subcube.mStopRow : subcube.mStopBand;
+   const size_t slicesPerTile = static_cast<size_t>(
+      std::min(memoryBudget / sliceSize, static_cast<double>(lastSlice - firstSlice + 1)));
+
+   // Function handles and variables which hold them are passed through as-is, and function names are quoted for feval.
+   std::string functionValue = function;
+   if (function[0] != '@' && isMatlabVariable(matlabInterpreter, function) == false)
+   {
+      functionValue = MatlabFunctions::toMatlabString(function);
+   }
+
+   for (size_t slice = firstSlice; slice <= lastSlice; slice += slicesPerTile)
+   {
+      Subcube tile = subcube;
+      if (rowBlocks)
+      {
+         tile.mStartRow = static_cast<unsigned int>(slice);
+         tile.mStopRow = static_cast<unsigned int>(std::min(lastSlice, slice + slicesPerTile - 1));
+      }
+      else
+      {
+         tile.mStartBand = static_cast<unsigned int>(slice);
+         tile.mStopBand = static_cast<unsigned int>(std::min(lastSlice, slice + slicesPerTile - 1));
+      }
+
+      std::string error;
+      if (putSubcube(matlabInterpreter, tileName, pRasterElement, tile, mxUNKNOWN_CLASS, 1.0, false, error) == false)
+      {
+         outputIsError = true;
+         output = error;
+         return std::string();
+      }
+
+      QString callback = QString("feval(%1, %2, %3, %4, %5);").arg(QString::fromStdString(functionValue))
+         .arg(QString::fromStdString(tileName)).arg(tile.mStartRow).arg(tile.mStartColumn).arg(tile.mStartBand);
+      bool success = matlabInterpreter.executeCommand(callback.toStdString());
+      matlabInterpreter.executeCommand("clear " + tileName + ";");
+      if (success == false)
+      {
+         outputIsError = true;
+         output = QString("Streaming stopped at row %1, band %2 because the function failed.")
+            .arg(tile.mStartRow).arg(tile.mStartBand).toStdString();
+         return std::string();
+      }
+   }
+
+   outputIsError = false;
+   return std::string();
+}
+
+// ArrayToMatlabCommand
+ArrayToMatlabCommand::ArrayToMatlabCommand(const std::string& name) :
+   MatlabInternalCommand(name)
+{}
+
+std::string ArrayToMatlabCommand::execute(MatlabInterpreter& matlabInterpreter,
+   const std::vector<std::string>& strCmds, const std::vector<std::string>& strVars,
+   std::string& output, bool& outputIsError)
+{
+   std::string arrayName = getOrDefault(strVars, 0, "raster");
+   std::string rasterName = getOrDefault(strCmds, 7);
+   std::string className = getOrDefault(strCmds, 12);
+   std::string applyUnitsValue = getOrDefault(strCmds, 13, "0");
+
+   Subcube subcube;
+   if (parseSubcube(strCmds, 1, subcube, output) == false || parseStrides(strCmds, 8, subcube, output) == false)
+   {
+      outputIsError = true;
+      return std::string();
+   }
+
+   RasterElement* pRasterElement = dynamic_cast<RasterElement*>(MatlabFunctions::getDataset(rasterName));
+   if (pRasterElement == NULL)
+   {
+      outputIsError = true;
+      output = "Unable to find a dataset";
+      return std::string();
+   }
+
+   RasterDataDescriptor* pDescriptor = dynamic_cast<RasterDataDescriptor*>(pRasterElement->getDataDescriptor());
+   if (pDescriptor == NULL)
+   {
+      outputIsError = true;
+      output = "Unable to find a data descriptor";
+      return std::string();
+   }
+
+   clampSubcube(pDescriptor, subcube);
+
+   bool error = false;
+   bool applyUnits = StringUtilities::fromDisplayString<bool>(applyUnitsValue, &error);
+   if (error == true)
+   {
+      outputIsError = true;
+      output = "Unable to determine whether to apply the units scale factor";
+      return std::string();
+   }
+
+   // Scaled data is returned as double unless another class is requested, since the scaled values
+   // will not generally be integers.
+   mxClassID classId = mxUNKNOWN_CLASS;
+   if (className.empty() == false)
+   {
+      classId = getMxClassByName(className);
+      if (classId == mxUNKNOWN_CLASS)
+      {
+         outputIsError = true;
+         output = "Unsupported class. Valid classes are int8, uint8, int16, uint16, int32, uint32, single, "
+            "and double.";
+         return std::string();
+      }
+   }
+   else if (applyUnits == true)
+   {
+      classId = mxDOUBLE_CLASS;
+   }
+
+   double scale = 1.0;
+   const Units* pUnits = pDescriptor->getUnits();
+   if (applyUnits == true && pUnits != NULL)
+   {
+      scale = pUnits->getScaleFromStandard();
+   }
+
+   std::string copyError;
+   if (putSubcube(matlabInterpreter, arrayName, pRasterElement, subcube, classId, scale, true, copyError) == false)
+   {
+      outputIsError = true;
+      output = copyError;
+      return std::string();
+   }
+
+   // This command puts the variable into the environment directly, so there is no need to return anything in the
+   // std::string() since MATLAB does not need to evaluate anything more. This also avoids  potentially printing out the
+   // entire raster element to MATLAB's output, which could take a very long time.
+   outputIsError = false;
+   return std::string();
+}
+
+// ArrayToOpticksCommand
+ArrayToOpticksCommand::ArrayToOpticksCommand(const std::string& name) :
+   MatlabInternalCommand(name)
+{}
+
+std::string ArrayToOpticksCommand::execute(MatlabInterpreter& matlabInterpreter,
+   const std::vector<std::string>& strCmds, const std::vector<std::string>& strVars,
+   std::string& output, bool& outputIsError)
+{
+   if (strCmds.size() == 1)
+   {
+      outputIsError = true;
+      output = "Usage: " + strCmds[0] + "(matlab_array, opt:parent_raster_name, opt:display_results, "
+         "opt:new_window, opt:interleave, opt:units, opt:class)";
+      return std::string();
+   }
+
+   std::string arrayName = getOrDefault(strCmds, 1);
+   std::string rasterName = getOrDefault(strCmds, 2);
+   std::string displayResultsValue = getOrDefault(strCmds, 3, "1");
+   std::string newWindowValue = getOrDefault(strCmds, 4, displayResultsValue);
+   std::string interleaveValue = getOrDefault(strCmds, 5, "bsq");
+   std::string units = getOrDefault(strCmds, 6);
+   std::string className = getOrDefault(strCmds, 7);
+
+   bool error = false;
+   bool displayResults = StringUtilities::fromDisplayString<bool>(displayResultsValue, &error);
+   if (error == true)
+   {
+      outputIsError = true;
+      output = "Unable to determine whether to display results";
+      return std::string();
+   }
+
+   bool newWindow = StringUtilities::fromDisplayString<bool>(newWindowValue, &error);
+   if (error == true)
+   {
+      outputIsError = true;
+      output = "Unable to determine whether to create a window";
+      return std::string();
+   }
+
+   if (displayResults == false && newWindow == true)
+   {
+      outputIsError = true;
+      output = "Unable to create a new window without also displaying the results";
+      return std::string();
+   }
+
+   InterleaveFormatType interleave = MatlabFunctions::getInterleaveByName(interleaveValue);
+   if (interleave.isValid() == false)
+   {
+      outputIsError = true;
+      output = "Unable to determine the requested interleave";
+      return std::string();
+   }
+
+   mxArray* pArray = matlabInterpreter.getMatlabVariable(arrayName);
+   if (pArray == NULL)
+   {
+      outputIsError = true;
+      output = "Unable to get the MATLAB variable";
+      return std::string();
+   }
+
+   const mwSize* varSz = mxGetDimensions(pArray);
+   if (varSz == NULL)
+   {
+      mxDestroyArray(pArray);
+      outputIsError = true;
+      output = "Unable to find the size of the specified array";
+      return std::string();
+   }
+
+   mwSize numDims = mxGetNumberOfDimensions(pArray);
+   if (numDims < 1)
+   {
+      mxDestroyArray(pArray);
+      outputIsError = true;
+      output = "Unable to find the number of dimensions of the specified array";
+      return std::string();
+   }
+
+   // Opticks addresses each dimension with 32 bits, so reject arrays which cannot be represented instead of letting
+   // their dimensions wrap. Any dimensions past the third must be singletons.
+   const mwSize maxDimension = std::numeric_limits<unsigned int>::max();
+   for (mwSize dim = 0; dim < numDims; ++dim)
+   {
+      if ((dim < 3 && varSz[dim] > maxDimension) || (dim >= 3 && varSz[dim] != 1))
+      {
+         mxDestroyArray(pArray);
+         outputIsError = true;
+         output = "The array is too large to be stored in a raster element";
+         return std::string();
+      }
+   }
+
+   const unsigned int rows = static_cast<unsigned int>(varSz[0]);
+   const unsigned int columns = static_cast<unsigned int>(numDims >= 2 ? varSz[1] : 1);
+   const unsigned int bands = static_cast<unsigned int>(numDims >= 3 ? varSz[2] : 1);
+
+   mxClassID classId = mxGetClassID(pArray);
+   EncodingType arrayType = getEncodingTypeFromMxClass(classId);
+   if (arrayType.isValid() == false)
+   {
+      mxDestroyArray(pArray);
+      outputIsError = true;
+      output = "Unsupported data type";
+      return std::string();
+   }
+
+   // The new element keeps the class of the array unless another class is requested, in which case the values
+   // are converted while they are copied.
+   EncodingType type = arrayType;
+   if (className.empty() == false)
+   {
+      type = getEncodingTypeFromMxClass(getMxClassByName(className));
+      if (type.isValid() == false)
+      {
+         mxDestroyArray(pArray);
+         outputIsError = true;
+         output = "Unsupported class. Valid classes are int8, uint8, int16, uint16, int32, uint32, single, "
+            "and double.";
+         return std::string();
+      }
+   }
+
+   std::string errorMessage;
+   MatlabFunctions::arrayToOpticks(mxGetData(pArray), arrayType, errorMessage, arrayName, columns, rows, bands,
+      units, type, interleave, true, rasterName, displayResults, newWindow);
+   mxDestroyArray(pArray);
+   if (errorMessage.empty() == false)
+   {
+      outputIsError = true;
+      output = errorMessage;
+      return std::string();
+   }
+
+   return std::string();
+}
+
+// ArrayUpdateOpticksCommand
+ArrayUpdateOpticksCommand::ArrayUpdateOpticksCommand(const std::string& name) :
+   MatlabInternalCommand(name)
+{}
+
+std::string ArrayUpdateOpticksCommand::execute(MatlabInterpreter& matlabInterpreter,
+   const std::vector<std::string>& strCmds, const std::vector<std::string>& strVars,
+   std::string& output, bool& outputIsError)
+{
+   if (strCmds.size() == 1)
+   {
+      outputIsError = true;
+      output = "Usage: " + strCmds[0] + "(matlab_array, opt:raster_name, opt:start_column, opt:start_row, "
+         "opt:start_band)";
+      return std::string();
+   }
+
+   std::string arrayName = getOrDefault(strCmds, 1);
+   std::string rasterName = getOrDefault(strCmds, 2);
+
+   const char* pNames[] = { "start column", "start row", "start band" };
+   unsigned int starts[3];
+   for (unsigned int i = 0; i < 3; ++i)
+   {
+      bool ok = true;
+      starts[i] = QString::fromStdString(getOrDefault(strCmds, 3 + i, "0")).toUInt(&ok);
+      if (ok == false)
+      {
+         outputIsError = true;
+         output = std::string("Unable to determine the requested ") + pNames[i];
+         return std::string();
+      }
+   }
+
+   RasterElement* pRasterElement = dynamic_cast<RasterElement*>(MatlabFunctions::getDataset(rasterName));
+   if (pRasterElement == NULL)
+   {
+      outputIsError = true;
+      output = "Unable to find a dataset";
+      return std::string();
+   }
+
+   mxArray* pArray = matlabInterpreter.getMatlabVariable(arrayName);
+   if (pArray == NULL)
+   {
+      outputIsError = true;
+      output = "Unable to get the MATLAB variable";
+      return std::string();
+   }
+
+   const mwSize* varSz = mxGetDimensions(pArray);
+   mwSize numDims = mxGetNumberOfDimensions(pArray);
+   if (varSz == NULL || numDims < 1)
+   {
+      mxDestroyArray(pArray);
+      outputIsError = true;
+      output = "Unable to find the size of the specified array";
+      return std::string();
+   }
+
+   for (mwSize dim = 3; dim < numDims; ++dim)
+   {
+      if (varSz[dim] != 1)
+      {
+         mxDestroyArray(pArray);
+         outputIsError = true;
+         output = "The array must have no more than three dimensions";
+         return std::string();
+      }
+   }
+
+   EncodingType arrayType = getEncodingTypeFromMxClass(mxGetClassID(pArray));
+   if (arrayType.isValid() == false)
+   {
+      mxDestroyArray(pArray);
+      outputIsError = true;
+      output = "Unsupported data type";
+      return std::string();
+   }
+
+   // The values are converted to the type of the element while they are copied, and the element is only
+   // notified once the whole region has been written, so no intermediate copy or repeated redraw is needed.
+   std::string errorMessage;
+   MatlabFunctions::arrayUpdateOpticks(mxGetData(pArray), arrayType, errorMessage, pRasterElement,
+      starts[1], starts[0], starts[2], varSz[0], (numDims >= 2 ? varSz[1] : 1), (numDims >= 3 ? varSz[2] : 1));
+   mxDestroyArray(pArray);
+   if (errorMessage.empty() == false)
+   {
+      outputIsError = true;
+      output = errorMessage;
+      return std::string();
+   }
+
+   return std::string();
+}
+
+// BandMathCommand
+BandMathCommand::BandMathCommand(const std::string& name) :
+   MatlabInternalCommand(name)
+{}
+
+std::string BandMathCommand::execute(MatlabInterpreter& matlabInterpreter,
+   const std::vector<std::string>& strCmds, const std::vector<std::string>& strVars,
+   std::string& output, bool& outputIsError)
+{
+   if (strCmds.size() < 3)
+   {
+      outputIsError = true;
+      output = "Usage: " + strCmds[0] + "(expression, output_name, opt:raster_name, opt:class, opt:output_band, "
+         "opt:display_results, opt:new_window)";
+      return std::string();
+   }
+
+   std::string expressionText = getOrDefault(strCmds, 1);
+   std::string outputName = getOrDefault(strCmds, 2);
+   std::string rasterName = getOrDefault(strCmds, 3);
+   std::string className = getOrDefault(strCmds, 4, "single");
+   std::string outputBandValue = getOrDefault(strCmds, 5, "0");
+   std::string displayResultsValue = getOrDefault(strCmds, 6, "1");
+   std::string newWindowValue = getOrDefault(strCmds, 7, displayResultsValue);
+
+   BandMathExpression expression;
+   std::string error;
+   if (expression.compile(expressionText, error) == false)
+   {
+      outputIsError = true;
+      output = "Unable to parse the expression: " + error;
+      return std::string();
+   }
+
+   if (outputName.empty() == true)
+   {
+      outputIsError = true;
+      output = "Unable to determine the name of the output raster element";
+      return std::string();
+   }
+
+   bool ok = true;
+   unsigned int outputBand = QString::fromStdString(outputBandValue).toUInt(&ok);
+   if (ok == false)
+   {
+      outputIsError = true;
+      output = "Unable to determine the requested output band";
+      return std::string();
+   }
+
+   bool parseError = false;
+   bool displayResults = StringUtilities::fromDisplayString<bool>(displayResultsValue, &parseError);
+   if (parseError == true)
+   {
+      outputIsError = true;
+      output = "Unable to determine whether to display results";
+      return std::string();
+   }
+
+   bool newWindow = StringUtilities::fromDisplayString<bool>(newWindowValue, &parseError);
+   if (parseError == true)
+   {
+      outputIsError = true;
+      output = "Unable to determine whether to create a window";
+      return std::string();
+   }
+
+   RasterElement* pRasterElement = dynamic_cast<RasterElement*>(MatlabFunctions::getDataset(rasterName));
+   if (pRasterElement == NULL)
+   {
+      outputIsError = true;
+      output = "Unable to find a dataset";
+      return std::string();
+   }
+
+   const RasterDataDescriptor* pDescriptor =
+      dynamic_cast<const RasterDataDescriptor*>(pRasterElement->getDataDescriptor());
+   if (pDescriptor == NULL)
+   {
+      outputIsError = true;
+      output = "Unable to find a data descriptor";
+      return std::string();
+   }
+
+   // Write into an existing element if there is one with the output name, and otherwise create a single band
+   // element of the requested class.
+   RasterElement* pOutputElement = dynamic_cast<RasterElement*>(MatlabFunctions::getDataset(outputName));
+   if (pOutputElement != NULL)
+   {
+      MatlabFunctions::bandMath(pRasterElement, expression, pOutputElement, outputBand, error,
+         matlabInterpreter.getTransferPool());
+      if (error.empty() == false)
+      {
+         outputIsError = true;
+         output = error;
+         return std::string();
+      }
+
+      outputIsError = false;
+      return std::string();
+   }
+
+   EncodingType type = getEncodingTypeFromMxClass(getMxClassByName(className));
+   if (type.isValid() == false)
+   {
+      outputIsError = true;
+      output = "Unsupported class. Valid classes are int8, uint8, int16, uint16, int32, uint32, single, and double.";
+      return std::string();
+   }
+
+   ModelResource<RasterElement> pNewElement(RasterUtilities::createRasterElement(outputName,
+      pDescriptor->getRowCount(), pDescriptor->getColumnCount(), 1, type, BSQ, true, NULL));
+   if (pNewElement.get() == NULL)
+   {
+      outputIsError = true;
+      output = "Unable to create new raster element.";
+      return std::string();
+   }
+
+   MatlabFunctions::bandMath(pRasterElement, expression, pNewElement.get(), 0, error,
+      matlabInterpreter.getTransferPool());
+   if (error.empty() == true && displayResults == true)
+   {
+      MatlabFunctions::displayRasterElement(pNewElement.get(), outputName, newWindow, error);
+   }
+
+   if (error.empty() == false)
+   {
+      outputIsError = true;
+      output = error;
+      return std::string();
+   }
+
+   pNewElement.release();
+   outputIsError = false;
+   return std::string();
+}
@@ -1,42 +1,98 @@
-/*
- * The information in this file is
- * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
- * and is subject to the terms and conditions of the
- * GNU Lesser General Public License Version 2.1
- * The license text is available from   
- * http://www.gnu.org/licenses/lgpl.html
- */
-
-#ifndef ARRAYCOMMANDS_H
-#define ARRAYCOMMANDS_H
-
-#include "MatlabInternalCommand.h"
-
-#include <string>
-#include <vector>
-
-class ArraySizeCommand : public MatlabInternalCommand
-{
-public:
-   ArraySizeCommand(const std::string& name);
-   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
-      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
-};
-
-class ArrayToMatlabCommand : public MatlabInternalCommand
-{
-public:
-   ArrayToMatlabCommand(const std::string& name);
-   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
-      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
-};
-
-class ArrayToOpticksCommand : public MatlabInternalCommand
-{
-public:
-   ArrayToOpticksCommand(const std::string& name);
-   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
-      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
-};
-
-#endif
+/*
+ * The information in this file is
+ * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
+ * and is subject to the terms and conditions of the
+ * GNU Lesser General Public License Version 2.1
+ * The license text is available from   
+ * http://www.gnu.org/licenses/lgpl.html
+ */
+
+#ifndef ARRAYCOMMANDS_H
+#define ARRAYCOMMANDS_H
+
+#include "MatlabInternalCommand.h"
+
+#include <string>
+#include <vector>
+
+class ArrayAoiToMatlabCommand : public MatlabInternalCommand
+{
+public:
+   ArrayAoiToMatlabCommand(const std::string& name);
+   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
+      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
+};
+
+class ArrayCovarianceCommand : public MatlabInternalCommand
+{
+public:
+   ArrayCovarianceCommand(const std::string& name);
+   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
+      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
+};
+
+class ArrayPointsToMatlabCommand : public MatlabInternalCommand
+{
+public:
+   ArrayPointsToMatlabCommand(const std::string& name);
+   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
+      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
+};
+
+class ArraySizeCommand : public MatlabInternalCommand
+{
+public:
+   ArraySizeCommand(const std::string& name);
+   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
+      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
+};
+
+class ArrayStatisticsCommand : public MatlabInternalCommand
+{
+public:
+   ArrayStatisticsCommand(const std::string& name);
+   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
+      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
+};
+
+class ArrayStreamToMatlabCommand : public MatlabInternalCommand
+{
+public:
+   ArrayStreamToMatlabCommand(const std::string& name);
+   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
+      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
+};
+
+class ArrayToMatlabCommand : public MatlabInternalCommand
+{
+public:
+   ArrayToMatlabCommand(const std::string& name);
+   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
+      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
+};
+
+class ArrayToOpticksCommand : public MatlabInternalCommand
+{
+public:
+   ArrayToOpticksCommand(const std::string& name);
+   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
+      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
+};
+
+class ArrayUpdateOpticksCommand : public MatlabInternalCommand
+{
+public:
+   ArrayUpdateOpticksCommand(const std::string& name);
+   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
+      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
+};
+
+class BandMathCommand : public MatlabInternalCommand
+{
+public:
+   BandMathCommand(const std::string& name);
+   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
+      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
+};
+
+#endif
@@ -0,0 +1,231 @@
+/*
+ * The information in this file is
+ * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
+ * and is subject to the terms and conditions of the
+ * GNU Lesser General Public License Version 2.1
+ * The license text is available from   
+ * http://www.gnu.org/licenses/lgpl.html
+ */
+
+#ifndef ARRAYTRANSFER_H
+#define ARRAYTRANSFER_H
+
+#include <algorithm>
+#include <limits>
+#include <math.h>
+#include <stddef.h>
+
+// Kernels used to move raster data between Opticks (row-major) and MATLAB (column-major) memory layouts.
+namespace ArrayTransfer
+{
+   // Size in bytes of a single cache line on all supported processors.
+   const size_t CacheLineSize = 64;
+
+   // Each edge of a transpose tile spans at least one cache line, so every line which is touched
+   // on either side of the copy is fully consumed before it can be evicted. When the source and
+   // destination types differ, the edge is sized for the smaller of the two.
+   template<typename S, typename D = S>
+   struct TileTraits
+   {
+      static const size_t ElementSize = sizeof(S) < sizeof(D) ? sizeof(S) : sizeof(D);
+      static const size_t Edge = (CacheLineSize / ElementSize) > 0 ? (CacheLineSize / ElementSize) : 1;
+   };
+
+   /**
+    * Converts a single element from type S to type D.
+    *
+    * Conversions to an integer type round to the nearest integer, with halves rounded away from zero,
+    * and saturate at the limits of D. NaN converts to zero. This matches MATLAB's own numeric casts.
+    */
+   template<typename S, typename D>
+   struct Convert
+   {
+      static D apply(S value)
+      {
+         if (std::numeric_limits<D>::is_integer == false)
+         {
+            return static_cast<D>(value);
+         }
+
+         const double converted = static_cast<double>(value);
+         if (converted != converted)
+         {
+            return 0;
+         }
+
+         if (converted <= static_cast<double>(std::numeric_limits<D>::min()))
+         {
+            return std::numeric_limits<D>::min();
+         }
+
+         if (converted >= static_cast<double>(std::numeric_limits<D>::max()))
+         {
+            return std::numeric_limits<D>::max();
+         }
+
+         return static_cast<D>(converted < 0.0 ? ceil(converted - 0.5) : floor(converted + 0.5));
+      }
+   };
+
+   // Elements which do not change type are copied unmodified.
+   template<typename T>
+   struct Convert<T, T>
+   {
+      static T apply(T value)
+      {
+         return value;
+      }
+   };
+
+   // Converts each element to type D as it is copied.
+   template<typename D>
+   struct Cast
+   {
+      template<typename S>
+      D operator()(S value) const
+      {
+         return Convert<S, D>::apply(value);
+      }
+   };
+
+   // Multiplies each element by a scale factor before converting it to type D.
+   template<typename D>
+   struct Scale
+   {
+      explicit Scale(double factor) :
+         mFactor(factor)
+      {}
+
+      template<typename S>
+      D operator()(S value) const
+      {
+         return Convert<double, D>::apply(static_cast<double>(value) * mFactor);
+      }
+
+      double mFactor;
+   };
+
+   /**
+    * Transposes a two-dimensional block of elements, passing each one through convert.
+    *
+    * Element (row, column) of the source is read from pSource[row * sourceStride + column] and written to
+    * pDest[column * destStride + row]. The copy is blocked into square tiles of TileTraits<S, D>::Edge elements
+    * so that strided accesses stay within the cache regardless of the size of the block.
+    */
+   template<typename S, typename D, typename Converter>
+   void transpose(const S* pSource, size_t sourceStride, D* pDest, size_t destStride, size_t rows, size_t columns,
+      Converter convert)
+   {
+      const size_t tileEdge = TileTraits<S, D>::Edge;
+      for (size_t rowTile = 0; rowTile < rows; rowTile += tileEdge)
+      {
+         const size_t rowTileEnd = std::min(rowTile + tileEdge, rows);
+         for (size_t columnTile = 0; columnTile < columns; columnTile += tileEdge)
+         {
+            const size_t columnTileEnd = std::min(columnTile + tileEdge, columns);
+            for (size_t column = columnTile; column < columnTileEnd; ++column)
+            {
+               const S* pSourceColumn = pSource + column;
+               D* pDestRow = pDest + column * destStride;
+               for (size_t row = rowTile; row < rowTileEnd; ++row)
+               {
+                  pDestRow[row] = convert(pSourceColumn[row * sourceStride]);
+               }
+            }
+         }
+      }
+   }
+
+   /**
+    * Copies a block of rows from one band of a column-major MATLAB array into band sequential rows.
+    *
+    * pSource points to the first element of the band and rowCount is the number of rows in the MATLAB array.
+    * Rows firstRow through firstRow + blockRows - 1 are written starting at pDest, each destStride elements apart.
+    */
+   template<typename S, typename D, typename Converter>
+   void columnMajorToBsq(const S* pSource, size_t rowCount, size_t columnCount,
+      size_t firstRow, size_t blockRows, D* pDest, size_t destStride, Converter convert)
+   {
+      transpose(pSource + firstRow, rowCount, pDest, destStride, columnCount, blockRows, convert);
+   }
+
+   /**
+    * Copies a block of rows of all bands from a column-major MATLAB array into band interleaved by line rows.
+    *
+    * Bands are written bandStride elements apart within each destination row, which allows the block to be
+    * written into a subset of the columns and bands of a larger row. Each band of the block is an independent
+    * transpose, so the source is consumed one band plane at a time.
+    */
+   template<typename S, typename D, typename Converter>
+   void columnMajorToBil(const S* pSource, size_t rowCount, size_t columnCount, size_t bandCount,
+      size_t firstRow, size_t blockRows, D* pDest, size_t destStride, size_t bandStride, Converter convert)
+   {
+      const size_t bandSize = rowCount * columnCount;
+      for (size_t band = 0; band < bandCount; ++band)
+      {
+         transpose(pSource + band * bandSize + firstRow, rowCount, pDest + band * bandStride, destStride,
+            columnCount, blockRows, convert);
+      }
+   }
+
+   /**
+    * Copies a block of rows of all bands from a column-major MATLAB array into band interleaved by pixel rows.
+    *
+    * Pixels are written pixelStride elements apart within each destination row. For each column the bands of
+    * the source are treated as rows of a two-dimensional block, so the spectra of each pixel are written
+    * contiguously while every band plane of the source is still read in cache line runs.
+    */
+   template<typename S, typename D, typename Converter>
+   void columnMajorToBip(const S* pSource, size_t rowCount, size_t columnCount, size_t bandCount,
+      size_t firstRow, size_t blockRows, D* pDest, size_t destStride, size_t pixelStride, Converter convert)
+   {
+      const size_t bandSize = rowCount * columnCount;
+      for (size_t column = 0; column < columnCount; ++column)
+      {
+         transpose(pSource + column * rowCount + firstRow, bandSize, pDest + column * pixelStride, destStride,
+            bandCount, blockRows, convert);
+      }
+   }
+
+   /**
+    * Copies a block of band interleaved by line rows into a column-major MATLAB array.
+    *
+    * pSource points to the first requested column of band zero in the first row of the block, and bands are
+    * bandStride elements apart within each row. Bands firstBand through firstBand + bandCount - 1 are written to
+    * consecutive band planes of pDest, which holds rowCount rows and columnCount columns per band.
+    */
+   template<typename S, typename D, typename Converter>
+   void bilToColumnMajor(const S* pSource, size_t sourceStride, size_t bandStride, size_t firstBand,
+      size_t bandCount, size_t columnCount, size_t blockRows, D* pDest, size_t rowCount, size_t firstRow,
+      Converter convert)
+   {
+      const size_t bandSize = rowCount * columnCount;
+      for (size_t band = 0; band < bandCount; ++band)
+      {
+         transpose(pSource + (firstBand + band) * bandStride, sourceStride, pDest + band * bandSize + firstRow,
+            rowCount, blockRows, columnCount, convert);
+      }
+   }
+
+   /**
+    * Copies a block of band interleaved by pixel rows into a column-major MATLAB array.
+    *
+    * pSource points to band zero of the first requested column in the first row of the block, and pixels are
+    * pixelStride elements apart. For each column the block is transposed from rows-by-bands into the band planes
+    * of pDest, so the interleave conversion and the transpose happen in the same pass.
+    */
+   template<typename S, typename D, typename Converter>
+   void bipToColumnMajor(const S* pSource, size_t sourceStride, size_t pixelStride, size_t firstBand,
+      size_t bandCount, size_t columnCount, size_t blockRows, D* pDest, size_t rowCount, size_t firstRow,
+      Converter convert)
+   {
+      const size_t bandSize = rowCount * columnCount;
+      for (size_t column = 0; column < columnCount; ++column)
+      {
+         transpose(pSource + column * pixelStride + firstBand, sourceStride, pDest + column * rowCount + firstRow,
+            bandSize, blockRows, bandCount, convert);
+      }
+   }
+}
+
+#endif
@@ -0,0 +1,558 @@
+/*
+ * The information in this file is
+ * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
+ * and is subject to the terms and conditions of the
+ * GNU Lesser General Public License Version 2.1
+ * The license text is available from   
+ * http://www.gnu.org/licenses/lgpl.html
+ */
+
+#include "BandMath.h"
+
+#include <algorithm>
+#include <ctype.h>
+#include <math.h>
+#include <stdlib.h>
+
+namespace
+{
+   // The number of pixels which each instruction processes at once. Every value on the stack holds this many
+   // pixels, so the whole stack stays in cache while the program runs.
+   const size_t sRunLength = 1024;
+
+   double roundHalfAway(double value)
+   {
+      return value < 0.0 ? ceil(value - 0.5) : floor(value + 0.5);
+   }
+
+   // Returns the smaller value, ignoring NaN in the same way as MATLAB's min.
+   double minimum(double left, double right)
+   {
+      return (left < right || right != right) ? left : right;
+   }
+
+   // Returns the larger value, ignoring NaN in the same way as MATLAB's max.
+   double maximum(double left, double right)
+   {
+      return (left > right || right != right) ? left : right;
+   }
+}
+
+// Compiles an expression by recursive descent, emitting each operation once its operands have been emitted.
+class BandMathExpression::Parser
+{
+public:
+   Parser(BandMathExpression& expression, const std::string& text) :
+      mExpression(expression),
+      mText(text),
+      mPosition(0)
+   {}
+
+   bool parse(std::string& error)
+   {
+      if (parseSum() == true)
+      {
+         skipSpace();
+         if (mPosition < mText.size())
+         {
+            mError = "Unexpected '" + mText.substr(mPosition, 1) + "'";
+         }
+      }
+
+      error = mError;
+      return mError.empty();
+   }
+
+private:
+   void skipSpace()
+   {
+      while (mPosition < mText.size() && isspace(static_cast<unsigned char>(mText[mPosition])) != 0)
+      {
+         ++mPosition;
+      }
+   }
+
+   // Consumes token if it is next, treating the element-wise forms .* ./ .^ the same as * / ^.
+   bool accept(char token)
+   {
+      skipSpace();
+      if (mPosition + 1 < mText.size() && mText[mPosition] == '.' && mText[mPosition + 1] == token &&
+         (token == '*' || token == '/' || token == '^'))
+      {
+         mPosition += 2;
+         return true;
+      }
+
+      if (mPosition < mText.size() && mText[mPosition] == token)
+      {
+         ++mPosition;
+         return true;
+      }
+
+      return false;
+   }
+
+   bool expect(char token)
+   {
+      if (accept(token) == false)
+      {
+         mError = std::string("Expected '") + token + "'";
+         return false;
+      }
+
+      return true;
+   }
+
+   // sum := product (('+' | '-') product)*
+   bool parseSum()
+   {
+      if (parseProduct() == false)
+      {
+         return false;
+      }
+
+      for (;;)
+      {
+         OpCode opCode = ADD;
+         if (accept('+') == false)
+         {
+            if (accept('-') == false)
+            {
+               return true;
+            }
+
+            opCode = SUBTRACT;
+         }
+
+         if (parseProduct() == false)
+         {
+            return false;
+         }
+
+         mExpression.emit(opCode);
+      }
+   }
+
+   // product := unary (('*' | '/') unary)*
+   bool parseProduct()
+   {
+      if (parseUnary() == false)
+      {
+         return false;
+      }
+
+      for (;;)
+      {
+         OpCode opCode = MULTIPLY;
+         if (accept('*') == false)
+         {
+            if (accept('/') == false)
+            {
+               return true;
+            }
+
+            opCode = DIVIDE;
+         }
+
+         if (parseUnary() == false)
+         {
+            return false;
+         }
+
+         mExpression.emit(opCode);
+      }
+   }
+
+   // unary := ('-' | '+') unary | power
+   // Unary minus binds less tightly than ^, so -2^2 is -4 as it is in MATLAB.
+   bool parseUnary()
+   {
+      if (accept('-') == true)
+      {
+         if (parseUnary() == false)
+         {
+            return false;
+         }
+
+         mExpression.emit(NEGATE);
+         return true;
+      }
+
+      if (accept('+') == true)
+      {
+         return parseUnary();
+      }
+
+      return parsePower();
+   }
+
+   // power := primary ('^' exponent)*, which is left associative as it is in MATLAB.
+   bool parsePower()
+   {
+      if (parsePrimary() == false)
+      {
+         return false;
+      }
+
+      while (accept('^') == true)
+      {
+         if (parseExponent() == false)
+         {
+            return false;
+         }
+
+         mExpression.emit(POWER);
+      }
+
+      return true;
+   }
+
+   // exponent := ('-' | '+') exponent | primary, so that 2^-1 is accepted.
+   bool parseExponent()
+   {
+      if (accept('-') == true)
+      {
+         if (parseExponent() == false)
+         {
+            return false;
+         }
+
+         mExpression.emit(NEGATE);
+         return true;
+      }
+
+      if (accept('+') == true)
+      {
+         return parseExponent();
+      }
+
+      return parsePrimary();
+   }
+
+   // primary := number | band | 'pi' | function '(' sum (',' sum)* ')' | '(' sum ')'
+   bool parsePrimary()
+   {
+      skipSpace();
+      if (accept('(') == true)
+      {
+         return parseSum() == true && expect(')') == true;
+      }
+
+      if (mPosition >= mText.size())
+      {
+         mError = "Unexpected end of expression";
+         return false;
+      }
+
+      const char* pStart = mText.c_str() + mPosition;
+      if (isdigit(static_cast<unsigned char>(*pStart)) != 0 || *pStart == '.')
+      {
+         char* pEnd = NULL;
+         const double value = strtod(pStart, &pEnd);
+         if (pEnd == pStart)
+         {
+            mError = "Invalid number";
+            return false;
+         }
+
+         mPosition += pEnd - pStart;
+         mExpression.emit(CONSTANT, value);
+         return true;
+      }
+
+      if (isalpha(static_cast<unsigned char>(*pStart)) == 0)
+      {
+         mError = "Unexpected '" + mText.substr(mPosition, 1) + "'";
+         return false;
+      }
+
+      size_t end = mPosition;
+      while (end < mText.size() && (isalnum(static_cast<unsigned char>(mText[end])) != 0 || mText[end] == '_'))
+      {
+         ++end;
+      }
+
+      const std::string name = mText.substr(mPosition, end - mPosition);
+      mPosition = end;
+      if (name.size() > 1 && (name[0] == 'b' || name[0] == 'B') &&
+         name.find_first_not_of("0123456789", 1) == std::string::npos)
+      {
+         const double band = strtod(name.c_str() + 1, NULL);
+         if (band > 4294967295.0)
+         {
+            mError = "Band number " + name.substr(1) + " is too large";
+            return false;
+         }
+
+         addBand(static_cast<unsigned int>(band));
+         return true;
+      }
+
+      if (name == "pi")
+      {
+         mExpression.emit(CONSTANT, 3.14159265358979323846);
+         return true;
+      }
+
+      const char* const pNames[] = { "abs", "sqrt", "exp", "log", "log10", "sin", "cos", "tan", "floor", "ceil",
+         "round", "min", "max", "atan2" };
+      const OpCode opCodes[] = { ABS, SQRT, EXP, LOG, LOG10, SIN, COS, TAN, FLOOR, CEIL, ROUND, MIN, MAX, ATAN2 };
+      for (unsigned int i = 0; i < sizeof(opCodes) / sizeof(opCodes[0]); ++i)
+      {
+         if (name == pNames[i])
+         {
+            if (expect('(') == false || parseSum() == false)
+            {
+               return false;
+            }
+
+            if (isBinary(opCodes[i]) == true && (expect(',') == false || parseSum() == false))
+            {
+               return false;
+            }
+
+            if (expect(')') == false)
+            {
+               return false;
+            }
+
+            mExpression.emit(opCodes[i]);
+            return true;
+         }
+      }
+
+      mError = "Unknown name '" + name + "'. Bands are referenced as b0, b1, and so on";
+      return false;
+   }
+
+   void addBand(unsigned int band)
+   {
+      std::vector<unsigned int>& bands = mExpression.mBands;
+      std::vector<unsigned int>::iterator iter = std::find(bands.begin(), bands.end(), band);
+      const size_t index = iter - bands.begin();
+      if (iter == bands.end())
+      {
+         bands.push_back(band);
+      }
+
+      mExpression.emit(BAND, 0.0, index);
+   }
+
+   BandMathExpression& mExpression;
+   const std::string& mText;
+   size_t mPosition;
+   std::string mError;
+};
+
+BandMathExpression::BandMathExpression() :
+   mStackDepth(0)
+{}
+
+bool BandMathExpression::compile(const std::string& expression, std::string& error)
+{
+   mProgram.clear();
+   mBands.clear();
+   mStackDepth = 0;
+
+   Parser parser(*this, expression);
+   if (parser.parse(error) == false)
+   {
+      mProgram.clear();
+      mBands.clear();
+      return false;
+   }
+
+   // Find the deepest point of the stack, which determines how much scratch space evaluate needs.
+   size_t depth = 0;
+   for (std::vector<Instruction>::const_iterator iter = mProgram.begin(); iter != mProgram.end(); ++iter)
+   {
+      if (iter->mOpCode == BAND || iter->mOpCode == CONSTANT)
+      {
+         mStackDepth = std::max(mStackDepth, ++depth);
+      }
+      else if (isBinary(iter->mOpCode) == true)
+      {
+         --depth;
+      }
+   }
+
+   return true;
+}
+
+const std::vector<unsigned int>& BandMathExpression::getBands() const
+{
+   return mBands;
+}
+
+void BandMathExpression::evaluate(const double* const* pBands, size_t count, double* pResult,
+   std::vector<double>& scratch) const
+{
+   scratch.resize(mStackDepth * sRunLength);
+   std::vector<const double*> stack(mStackDepth);
+   for (size_t first = 0; first < count; first += sRunLength)
+   {
+      const size_t length = std::min(sRunLength, count - first);
+      size_t top = 0;
+      for (std::vector<Instruction>::const_iterator iter = mProgram.begin(); iter != mProgram.end(); ++iter)
+      {
+         // Bands are read in place. Every other result is written to the scratch run of its stack slot, which
+         // may also be the run of one of its operands.
+         if (iter->mOpCode == BAND)
+         {
+            stack[top++] = pBands[iter->mBand] + first;
+            continue;
+         }
+
+         if (iter->mOpCode == CONSTANT)
+         {
+            double* pOut = &scratch[top * sRunLength];
+            std::fill(pOut, pOut + length, iter->mValue);
+            stack[top++] = pOut;
+            continue;
+         }
+
+         // Unary operations have no right operand, and the slot above them may be past the end of the stack.
+         const bool binary = isBinary(iter->mOpCode);
+         if (binary == true)
+         {
+            --top;
+         }
+
+         const double* pLeft = stack[top - 1];
+         const double* pRight = (binary == true ? stack[top] : NULL);
+         double* pOut = &scratch[(top - 1) * sRunLength];
+         switch (iter->mOpCode)
+         {
+            case ADD:
+               for (size_t i = 0; i < length; ++i)
+               {
+                  pOut[i] = pLeft[i] + pRight[i];
+               }
+               break;
+            case SUBTRACT:
+               for (size_t i = 0; i < length; ++i)
+               {
+                  pOut[i] = pLeft[i] - pRight[i];
+               }
+               break;
+            case MULTIPLY:
+               for (size_t i = 0; i < length; ++i)
+               {
+                  pOut[i] = pLeft[i] * pRight[i];
+               }
+               break;
+            case DIVIDE:
+               for (size_t i = 0; i < length; ++i)
+               {
+                  pOut[i] = pLeft[i] / pRight[i];
+               }
+               break;
+            case NEGATE:
+               for (size_t i = 0; i < length; ++i)
+               {
+                  pOut[i] = -pLeft[i];
+               }
+               break;
+            default:
+               for (size_t i = 0; i < length; ++i)
+               {
+                  pOut[i] = apply(iter->mOpCode, pLeft[i], binary ? pRight[i] : 0.0);
+               }
+               break;
+         }
+
+         stack[top - 1] = pOut;
+      }
+
+      std::copy(stack[0], stack[0] + length, pResult + first);
+   }
+}
+
+bool BandMathExpression::isBinary(OpCode opCode)
+{
+   return opCode == ADD || opCode == SUBTRACT || opCode == MULTIPLY || opCode == DIVIDE || opCode == POWER ||
+      opCode == MIN || opCode == MAX || opCode == ATAN2;
+}
+
+double BandMathExpression::apply(OpCode opCode, double left, double right)
+{
+   switch (opCode)
+   {
+      case ADD:
+         return left + right;
+      case SUBTRACT:
+         return left - right;
+      case MULTIPLY:
+         return left * right;
+      case DIVIDE:
+         return left / right;
+      case POWER:
+         return pow(left, right);
+      case NEGATE:
+         return -left;
+      case ABS:
+         return fabs(left);
+      case SQRT:
+         return sqrt(left);
+      case EXP:
+         return exp(left);
+      case LOG:
+         return log(left);
+      case LOG10:
+         return log10(left);
+      case SIN:
+         return sin(left);
+      case COS:
+         return cos(left);
+      case TAN:
+         return tan(left);
+      case FLOOR:
+         return floor(left);
+      case CEIL:
+         return ceil(left);
+      case ROUND:
+         return roundHalfAway(left);
+      case MIN:
+         return minimum(left, right);
+      case MAX:
+         return maximum(left, right);
+      case ATAN2:
+         return atan2(left, right);
+      default:
+         return left;
+   }
+}
+
+void BandMathExpression::emit(OpCode opCode, double value, size_t band)
+{
+   // Fold operations whose operands are all constants into a single constant.
+   if (opCode != BAND && opCode != CONSTANT)
+   {
+      const size_t operands = (isBinary(opCode) ? 2 : 1);
+      if (mProgram.size() >= operands && mProgram.back().mOpCode == CONSTANT &&
+         (operands == 1 || mProgram[mProgram.size() - 2].mOpCode == CONSTANT))
+      {
+         const double right = mProgram.back().mValue;
+         mProgram.pop_back();
+         if (operands == 2)
+         {
+            mProgram.back().mValue = apply(opCode, mProgram.back().mValue, right);
+         }
+         else
+         {
+            mProgram.push_back(Instruction());
+            mProgram.back().mOpCode = CONSTANT;
+            mProgram.back().mValue = apply(opCode, right, 0.0);
+            mProgram.back().mBand = 0;
+         }
+
+         return;
+      }
+   }
+
+   Instruction instruction;
+   instruction.mOpCode = opCode;
+   instruction.mValue = value;
+   instruction.mBand = band;
+   mProgram.push_back(instruction);
+}
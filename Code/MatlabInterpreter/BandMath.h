@@ -0,0 +1,76 @@
+/*
+ * The information in this file is
+ * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
+ * and is subject to the terms and conditions of the
+ * GNU Lesser General Public License Version 2.1
+ * The license text is available from   
+ * http://www.gnu.org/licenses/lgpl.html
+ */
+
+#ifndef BANDMATH_H
+#define BANDMATH_H
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+/**
+ * An arithmetic expression over the bands of a raster element, compiled into a short program which is run over
+ * whole runs of pixels at a time.
+ *
+ * Bands are referenced as b0, b1, and so on, with zero-based band numbers. Expressions use MATLAB's syntax for
+ * numbers, the operators + - * / ^ (along with .* ./ .^), unary minus, and parentheses, and may call abs, sqrt,
+ * exp, log, log10, sin, cos, tan, floor, ceil, round, min, max, and atan2. pi is also defined. Every value is a
+ * double, and operations follow MATLAB's element-wise semantics, so dividing by zero gives Inf or NaN.
+ */
+class BandMathExpression
+{
+public:
+   BandMathExpression();
+
+   /**
+    * Compiles an expression, replacing any earlier one.
+    *
+    * Returns false and sets error if the expression cannot be parsed. Operations on constants are evaluated
+    * while compiling, so they cost nothing per pixel.
+    */
+   bool compile(const std::string& expression, std::string& error);
+
+   // The distinct zero-based bands used by the expression, in the order that evaluate expects them.
+   const std::vector<unsigned int>& getBands() const;
+
+   /**
+    * Evaluates the expression for count pixels.
+    *
+    * pBands[i] holds count values of band getBands()[i], and the results are written to pResult, which may be
+    * one of the bands. scratch is resized as needed, so reusing it between calls avoids repeated allocations.
+    */
+   void evaluate(const double* const* pBands, size_t count, double* pResult, std::vector<double>& scratch) const;
+
+private:
+   enum OpCode
+   {
+      BAND, CONSTANT, ADD, SUBTRACT, MULTIPLY, DIVIDE, POWER, NEGATE, ABS, SQRT, EXP, LOG, LOG10, SIN, COS, TAN,
+      FLOOR, CEIL, ROUND, MIN, MAX, ATAN2
+   };
+
+   struct Instruction
+   {
+      OpCode mOpCode;
+      double mValue;
+      size_t mBand;
+   };
+
+   class Parser;
+
+   static bool isBinary(OpCode opCode);
+   static double apply(OpCode opCode, double left, double right);
+
+   void emit(OpCode opCode, double value = 0.0, size_t band = 0);
+
+   std::vector<Instruction> mProgram;
+   std::vector<unsigned int> mBands;
+   size_t mStackDepth;
+};
+
+#endif
@@ -0,0 +1,529 @@
+/*
+ * The information in this file is
+ * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
+ * and is subject to the terms and conditions of the
+ * GNU Lesser General Public License Version 2.1
+ * The license text is available from   
+ * http://www.gnu.org/licenses/lgpl.html
+ */
+
+#include "BenchmarkCommands.h"
+#include "MatlabFunctions.h"
+#include "MatlabInterpreter.h"
+#include "ModelServices.h"
+#include "RasterElement.h"
+#include "RasterUtilities.h"
+
+#include <matrix.h>
+
+#include <QtCore/QAtomicInt>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QString>
+#include <QtCore/QTextStream>
+
+#include <algorithm>
+#include <limits>
+#include <new>
+#include <stdlib.h>
+
+#if defined(MATLAB_COUNT_ALLOCATIONS)
+namespace
+{
+   // Allocations are only counted while at least one AllocationCounter exists, so the replacement operator new
+   // below costs a single comparison the rest of the time.
+   QAtomicInt sAllocationCount;
+   QAtomicInt sActiveCounters;
+
+   void* allocate(size_t size, bool throwOnFailure)
+   {
+      if (sActiveCounters != 0)
+      {
+         sAllocationCount.ref();
+      }
+
+      for (;;)
+      {
+         void* pMemory = malloc(size == 0 ? 1 : size);
+         if (pMemory != NULL)
+         {
+            return pMemory;
+         }
+
+         std::new_handler handler = std::set_new_handler(NULL);
+         std::set_new_handler(handler);
+         if (handler == NULL)
+         {
+            if (throwOnFailure == true)
+            {
+               throw std::bad_alloc();
+            }
+
+            return NULL;
+         }
+
+         handler();
+      }
+   }
+}
+
+// Replacing operator new affects every allocation made by this module, and on platforms other than Windows possibly
+// the rest of the process, so it is only done in builds which define MATLAB_COUNT_ALLOCATIONS for benchmarking.
+void* operator new(size_t size) throw(std::bad_alloc)
+{
+   return allocate(size, true);
+}
+
+void* operator new[](size_t size) throw(std::bad_alloc)
+{
+   return allocate(size, true);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) throw()
+{
+   try
+   {
+      return allocate(size, false);
+   }
+   catch (const std::bad_alloc&)
+   {
+      return NULL;
+   }
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) throw()
+{
+   try
+   {
+      return allocate(size, false);
+   }
+   catch (const std::bad_alloc&)
+   {
+      return NULL;
+   }
+}
+
+void operator delete(void* pMemory) throw()
+{
+   free(pMemory);
+}
+
+void operator delete[](void* pMemory) throw()
+{
+   free(pMemory);
+}
+
+void operator delete(void* pMemory, const std::nothrow_t&) throw()
+{
+   free(pMemory);
+}
+
+void operator delete[](void* pMemory, const std::nothrow_t&) throw()
+{
+   free(pMemory);
+}
+#endif
+
+namespace
+{
+   // Counts the heap allocations made through operator new during its lifetime by any thread. Allocations are only
+   // counted in builds which define MATLAB_COUNT_ALLOCATIONS, and getCount returns -1 in any other build.
+   class AllocationCounter
+   {
+   public:
+#if defined(MATLAB_COUNT_ALLOCATIONS)
+      AllocationCounter() :
+         mStart(0)
+      {
+         sActiveCounters.ref();
+         mStart = sAllocationCount;
+      }
+
+      ~AllocationCounter()
+      {
+         sActiveCounters.deref();
+      }
+
+      int getCount() const
+      {
+         return sAllocationCount - mStart;
+      }
+
+   private:
+      int mStart;
+#else
+      int getCount() const
+      {
+         return -1;
+      }
+#endif
+   };
+
+   struct BenchmarkShape
+   {
+      const char* mpName;
+      unsigned int mRows;
+      unsigned int mColumns;
+      unsigned int mBands;
+   };
+
+   // Each shape holds the same number of elements, so throughput can be compared between them. Rows are scaled
+   // by the command's scale argument.
+   const BenchmarkShape sShapes[] =
+   {
+      { "square", 512, 512, 8 },
+      { "narrow", 4096, 64, 8 },
+      { "deep", 64, 64, 512 }
+   };
+
+   const char* const spEncodingNames[] = { "int8", "uint8", "int16", "uint16", "int32", "uint32", "single", "double" };
+   const EncodingType sEncodings[] = { INT1SBYTE, INT1UBYTE, INT2SBYTES, INT2UBYTES, INT4SBYTES, INT4UBYTES,
+      FLT4BYTES, FLT8BYTES };
+
+   const char* const spInterleaveNames[] = { "bip", "bil", "bsq" };
+   const InterleaveFormatType sInterleaves[] = { BIP, BIL, BSQ };
+
+   struct BenchmarkResult
+   {
+      std::string mOperation;
+      std::string mEncoding;
+      std::string mInterleave;
+      std::string mStorage;
+      std::string mShape;
+      unsigned int mRows;
+      unsigned int mColumns;
+      unsigned int mBands;
+      double mBytes;
+      unsigned int mRepetitions;
+      double mBestSeconds;
+      double mMeanSeconds;
+      double mAllocations;
+   };
+
+   template<typename T>
+   void fillArray(T* pArray, size_t count)
+   {
+      for (size_t i = 0; i < count; ++i)
+      {
+         pArray[i] = static_cast<T>(i % 127);
+      }
+   }
+
+   // Fills a column-major array with values which every supported encoding can represent exactly.
+   void fillArray(void* pArray, EncodingType type, size_t count)
+   {
+      switch (type)
+      {
+         case INT1SBYTE:
+            fillArray(static_cast<signed char*>(pArray), count);
+            break;
+         case INT1UBYTE:
+            fillArray(static_cast<unsigned char*>(pArray), count);
+            break;
+         case INT2SBYTES:
+            fillArray(static_cast<signed short*>(pArray), count);
+            break;
+         case INT2UBYTES:
+            fillArray(static_cast<unsigned short*>(pArray), count);
+            break;
+         case INT4SBYTES:
+            fillArray(static_cast<signed int*>(pArray), count);
+            break;
+         case INT4UBYTES:
+            fillArray(static_cast<unsigned int*>(pArray), count);
+            break;
+         case FLT4BYTES:
+            fillArray(static_cast<float*>(pArray), count);
+            break;
+         case FLT8BYTES:
+            fillArray(static_cast<double*>(pArray), count);
+            break;
+         default:
+            break;
+      }
+   }
+
+   void addTiming(BenchmarkResult& result, double seconds, int allocations)
+   {
+      result.mBestSeconds = (result.mRepetitions == 0 ? seconds : std::min(result.mBestSeconds, seconds));
+      result.mMeanSeconds += seconds;
+      result.mAllocations += (allocations < 0 ? std::numeric_limits<double>::quiet_NaN() : allocations);
+      ++result.mRepetitions;
+   }
+
+   void finishResult(BenchmarkResult& result)
+   {
+      if (result.mRepetitions > 0)
+      {
+         result.mMeanSeconds /= result.mRepetitions;
+         result.mAllocations /= result.mRepetitions;
+      }
+   }
+
+   double getGigabytesPerSecond(const BenchmarkResult& result)
+   {
+      return result.mBestSeconds > 0.0 ? result.mBytes / result.mBestSeconds / 1.0e9 : 0.0;
+   }
+
+   // Times arrayToOpticks and arrayToMatlab for one combination of encoding, interleave, storage, and shape.
+   // Each repetition creates the raster element from the array, copies the whole element back into a second
+   // array, and then destroys the element.
+   bool runBenchmark(EncodingType type, InterleaveFormatType interleave, bool inMemory, unsigned int rows,
+      unsigned int columns, unsigned int bands, unsigned int repetitions, BenchmarkResult& toOpticks,
+      BenchmarkResult& toMatlab, std::string& error)
+   {
+      const size_t count = static_cast<size_t>(rows) * columns * bands;
+      const size_t bytes = count * RasterUtilities::bytesInEncoding(type);
+      std::vector<char> source(bytes);
+      std::vector<char> dest(bytes);
+      fillArray(&source[0], type, count);
+
+      toOpticks.mBytes = static_cast<double>(bytes);
+      toMatlab.mBytes = static_cast<double>(bytes);
+
+      MatlabFunctions::Subcube subcube;
+      subcube.mStartRow = 0;
+      subcube.mStopRow = rows - 1;
+      subcube.mStartColumn = 0;
+      subcube.mStopColumn = columns - 1;
+      subcube.mStartBand = 0;
+      subcube.mStopBand = bands - 1;
+      subcube.mRowStride = 1;
+      subcube.mColumnStride = 1;
+      subcube.mBandStride = 1;
+      subcube.mAverage = false;
+
+      const std::string name = "Array Benchmark";
+      Service<ModelServices> pModel;
+      for (unsigned int repetition = 0; repetition < repetitions; ++repetition)
+      {
+         QElapsedTimer timer;
+         int allocations = 0;
+         {
+            AllocationCounter counter;
+            timer.start();
+            MatlabFunctions::arrayToOpticks(&source[0], type, error, name, columns, rows, bands, std::string(),
+               type, interleave, inMemory, std::string(), false, false);
+            allocations = counter.getCount();
+         }
+
+         addTiming(toOpticks, timer.nsecsElapsed() / 1.0e9, allocations);
+         if (error.empty() == false)
+         {
+            return false;
+         }
+
+         RasterElement* pElement = dynamic_cast<RasterElement*>(MatlabFunctions::getDataset(name));
+         if (pElement == NULL)
+         {
+            error = "Unable to find the benchmark raster element.";
+            return false;
+         }
+
+         {
+            AllocationCounter counter;
+            timer.start();
+            MatlabFunctions::arrayToMatlab(&dest[0], type, error, pElement, subcube, 1.0);
+            allocations = counter.getCount();
+         }
+
+         addTiming(toMatlab, timer.nsecsElapsed() / 1.0e9, allocations);
+         pModel->destroyElement(pElement);
+         if (error.empty() == false)
+         {
+            return false;
+         }
+
+         if (dest != source)
+         {
+            error = "The data copied back from the benchmark raster element does not match the original array.";
+            return false;
+         }
+      }
+
+      finishResult(toOpticks);
+      finishResult(toMatlab);
+      return true;
+   }
+
+   std::string getCsvHeader()
+   {
+      return "operation,encoding,interleave,storage,shape,rows,columns,bands,bytes,repetitions,best_seconds,"
+         "mean_seconds,gigabytes_per_second,allocations\n";
+   }
+
+   std::string getCsvLine(const BenchmarkResult& result)
+   {
+      return QString("%1,%2,%3,%4,%5,%6,%7,%8,%9,").arg(QString::fromStdString(result.mOperation),
+         QString::fromStdString(result.mEncoding), QString::fromStdString(result.mInterleave),
+         QString::fromStdString(result.mStorage), QString::fromStdString(result.mShape),
+         QString::number(result.mRows), QString::number(result.mColumns), QString::number(result.mBands),
+         QString::number(result.mBytes, 'f', 0)).toStdString() +
+         QString("%1,%2,%3,%4,%5\n").arg(QString::number(result.mRepetitions),
+         QString::number(result.mBestSeconds, 'g', 6), QString::number(result.mMeanSeconds, 'g', 6),
+         QString::number(getGigabytesPerSecond(result), 'g', 6),
+         QString::number(result.mAllocations, 'g', 6)).toStdString();
+   }
+
+   // Creates an N x 1 struct array with one field for each CSV column.
+   mxArray* createResultArray(const std::vector<BenchmarkResult>& results)
+   {
+      const char* pFields[] = { "operation", "encoding", "interleave", "storage", "shape", "rows", "columns",
+         "bands", "bytes", "repetitions", "best_seconds", "mean_seconds", "gigabytes_per_second", "allocations" };
+      mxArray* pArray = mxCreateStructMatrix(results.size(), 1, 14, pFields);
+      if (pArray == NULL)
+      {
+         return NULL;
+      }
+
+      for (size_t i = 0; i < results.size(); ++i)
+      {
+         const BenchmarkResult& result = results[i];
+         const mwIndex index = static_cast<mwIndex>(i);
+         mxSetField(pArray, index, "operation", mxCreateString(result.mOperation.c_str()));
+         mxSetField(pArray, index, "encoding", mxCreateString(result.mEncoding.c_str()));
+         mxSetField(pArray, index, "interleave", mxCreateString(result.mInterleave.c_str()));
+         mxSetField(pArray, index, "storage", mxCreateString(result.mStorage.c_str()));
+         mxSetField(pArray, index, "shape", mxCreateString(result.mShape.c_str()));
+         mxSetField(pArray, index, "rows", mxCreateDoubleScalar(result.mRows));
+         mxSetField(pArray, index, "columns", mxCreateDoubleScalar(result.mColumns));
+         mxSetField(pArray, index, "bands", mxCreateDoubleScalar(result.mBands));
+         mxSetField(pArray, index, "bytes", mxCreateDoubleScalar(result.mBytes));
+         mxSetField(pArray, index, "repetitions", mxCreateDoubleScalar(result.mRepetitions));
+         mxSetField(pArray, index, "best_seconds", mxCreateDoubleScalar(result.mBestSeconds));
+         mxSetField(pArray, index, "mean_seconds", mxCreateDoubleScalar(result.mMeanSeconds));
+         mxSetField(pArray, index, "gigabytes_per_second", mxCreateDoubleScalar(getGigabytesPerSecond(result)));
+         mxSetField(pArray, index, "allocations", mxCreateDoubleScalar(result.mAllocations));
+      }
+
+      return pArray;
+   }
+}
+
+// ArrayBenchmarkCommand
+ArrayBenchmarkCommand::ArrayBenchmarkCommand(const std::string& name) :
+   MatlabInternalCommand(name)
+{}
+
+std::string ArrayBenchmarkCommand::execute(MatlabInterpreter& matlabInterpreter,
+   const std::vector<std::string>& strCmds, const std::vector<std::string>& strVars,
+   std::string& output, bool& outputIsError)
+{
+   std::string varName = getOrDefault(strVars, 0);
+   std::string filename = getOrDefault(strCmds, 1);
+
+   bool ok = true;
+   const unsigned int repetitions = QString::fromStdString(getOrDefault(strCmds, 2, "3")).toUInt(&ok);
+   if (ok == false || repetitions == 0)
+   {
+      outputIsError = true;
+      output = "Unable to determine the number of repetitions";
+      return std::string();
+   }
+
+   const double scale = QString::fromStdString(getOrDefault(strCmds, 3, "1")).toDouble(&ok);
+   if (ok == false || scale <= 0.0)
+   {
+      outputIsError = true;
+      output = "Unable to determine the scale";
+      return std::string();
+   }
+
+   if (MatlabFunctions::getDataset("Array Benchmark") != NULL)
+   {
+      outputIsError = true;
+      output = "A data element named \"Array Benchmark\" already exists";
+      return std::string();
+   }
+
+   std::vector<BenchmarkResult> results;
+   for (unsigned int shape = 0; shape < sizeof(sShapes) / sizeof(sShapes[0]); ++shape)
+   {
+      const unsigned int rows = std::max(1u, static_cast<unsigned int>(sShapes[shape].mRows * scale));
+      for (unsigned int encoding = 0; encoding < sizeof(sEncodings) / sizeof(sEncodings[0]); ++encoding)
+      {
+         for (unsigned int interleave = 0; interleave < sizeof(sInterleaves) / sizeof(sInterleaves[0]);
+            ++interleave)
+         {
+            for (unsigned int storage = 0; storage < 2; ++storage)
+            {
+               BenchmarkResult toOpticks;
+               toOpticks.mOperation = "array_to_opticks";
+               toOpticks.mEncoding = spEncodingNames[encoding];
+               toOpticks.mInterleave = spInterleaveNames[interleave];
+               toOpticks.mStorage = (storage == 0 ? "memory" : "disk");
+               toOpticks.mShape = sShapes[shape].mpName;
+               toOpticks.mRows = rows;
+               toOpticks.mColumns = sShapes[shape].mColumns;
+               toOpticks.mBands = sShapes[shape].mBands;
+               toOpticks.mBytes = 0.0;
+               toOpticks.mRepetitions = 0;
+               toOpticks.mBestSeconds = 0.0;
+               toOpticks.mMeanSeconds = 0.0;
+               toOpticks.mAllocations = 0.0;
+
+               BenchmarkResult toMatlab = toOpticks;
+               toMatlab.mOperation = "array_to_matlab";
+
+               std::string error;
+               if (runBenchmark(sEncodings[encoding], sInterleaves[interleave], storage == 0, rows,
+                  toOpticks.mColumns, toOpticks.mBands, repetitions, toOpticks, toMatlab, error) == false)
+               {
+                  outputIsError = true;
+                  output = "Benchmark of " + toOpticks.mEncoding + " " + toOpticks.mInterleave + " " +
+                     toOpticks.mStorage + " " + toOpticks.mShape + " failed: " + error;
+                  return std::string();
+               }
+
+               results.push_back(toOpticks);
+               results.push_back(toMatlab);
+            }
+         }
+      }
+   }
+
+   std::string csv = getCsvHeader();
+   for (std::vector<BenchmarkResult>::const_iterator iter = results.begin(); iter != results.end(); ++iter)
+   {
+      csv += getCsvLine(*iter);
+   }
+
+   if (filename.empty() == false)
+   {
+      QFile file(QString::fromStdString(filename));
+      if (file.open(QIODevice::WriteOnly | QIODevice::Text) == false)
+      {
+         outputIsError = true;
+         output = "Unable to open " + filename + " for writing";
+         return std::string();
+      }
+
+      QTextStream stream(&file);
+      stream << QString::fromStdString(csv);
+   }
+
+   outputIsError = false;
+   if (varName.empty() == true)
+   {
+      output = csv;
+      return std::string();
+   }
+
+   mxArray* pArray = createResultArray(results);
+   if (pArray == NULL)
+   {
+      outputIsError = true;
+      output = "Unable to allocate the benchmark results";
+      return std::string();
+   }
+
+   const bool success = matlabInterpreter.setMatlabVariable(varName, pArray);
+   mxDestroyArray(pArray);
+   if (success == false)
+   {
+      outputIsError = true;
+      output = "Unable to set the MATLAB variable.";
+   }
+
+   return std::string();
+}
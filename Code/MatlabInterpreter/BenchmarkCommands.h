@@ -0,0 +1,26 @@
+/*
+ * The information in this file is
+ * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
+ * and is subject to the terms and conditions of the
+ * GNU Lesser General Public License Version 2.1
+ * The license text is available from   
+ * http://www.gnu.org/licenses/lgpl.html
+ */
+
+#ifndef BENCHMARKCOMMANDS_H
+#define BENCHMARKCOMMANDS_H
+
+#include "MatlabInternalCommand.h"
+
+#include <string>
+#include <vector>
+
+class ArrayBenchmarkCommand : public MatlabInternalCommand
+{
+public:
+   ArrayBenchmarkCommand(const std::string& name);
+   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
+      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
+};
+
+#endif
@@ -1,42 +1,42 @@
-/*
- * The information in this file is
- * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
- * and is subject to the terms and conditions of the
- * GNU Lesser General Public License Version 2.1
- * The license text is available from   
- * http://www.gnu.org/licenses/lgpl.html
- */
-
-#ifndef MATLABCOMMANDS_H
-#define MATLABCOMMANDS_H
-
-#include "MatlabInternalCommand.h"
-
-#include <string>
-#include <vector>
-
-class HideCommandWindowCommand : public MatlabInternalCommand
-{
-public:
-   HideCommandWindowCommand(const std::string& name);
-   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
-      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
-};
-
-class RunCommand : public MatlabInternalCommand
-{
-public:
-   RunCommand(const std::string& name);
-   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
-      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
-};
-
-class ShowCommandWindowCommand : public MatlabInternalCommand
-{
-public:
-   ShowCommandWindowCommand(const std::string& name);
-   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
-      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
-};
-
-#endif
+/*
+ * The information in this file is
+ * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
+ * and is subject to the terms and conditions of the
+ * GNU Lesser General Public License Version 2.1
+ * The license text is available from   
+ * http://www.gnu.org/licenses/lgpl.html
+ */
+
+#ifndef MATLABCOMMANDS_H
+#define MATLABCOMMANDS_H
+
+#include "MatlabInternalCommand.h"
+
+#include <string>
+#include <vector>
+
+class HideCommandWindowCommand : public MatlabInternalCommand
+{
+public:
+   HideCommandWindowCommand(const std::string& name);
+   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
+      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
+};
+
+class RunCommand : public MatlabInternalCommand
+{
+public:
+   RunCommand(const std::string& name);
+   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
+      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
+};
+
+class ShowCommandWindowCommand : public MatlabInternalCommand
+{
+public:
+   ShowCommandWindowCommand(const std::string& name);
+   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
+      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
+};
+
+#endif
@@ -1,617 +1,2263 @@
-/*
- * The information in this file is
- * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
- * and is subject to the terms and conditions of the
- * GNU Lesser General Public License Version 2.1
- * The license text is available from   
- * http://www.gnu.org/licenses/lgpl.html
- */
-
-#include "DataElement.h"
-#include "DesktopServices.h"
-#include "Layer.h"
-#include "LayerList.h"
-#include "MatlabFunctions.h"
-#include "ModelServices.h"
-#include "RasterElement.h"
-#include "RasterLayer.h"
-#include "SpatialDataView.h"
-#include "SpatialDataWindow.h"
-#include "View.h"
-#include "Window.h"
-#include "WizardItem.h"
-#include "WizardNode.h"
-#include "WizardObject.h"
-#include "xmlreader.h"
-
-#include <QtCore/QString>
-#include <QtCore/QStringList>
-
-std::string MatlabFunctions::toMatlabString(const std::string& value)
-{
-   // Single quote characters are escaped by using two single quotes, and the entire name is wrapped in single quotes.
-   // This is done so that controllers with single quotes in their names are displayed properly in MATLAB.
-   QString valueTemp(QString::fromStdString(value));
-   valueTemp = valueTemp.replace('\'', "\'\'");
-   return '\'' + valueTemp.toStdString() + '\'';
-}
-
-std::string MatlabFunctions::toMatlabString(const std::vector<std::string>& values)
-{
-   QStringList valueList;
-   for (std::vector<std::string>::const_iterator iter = values.begin(); iter != values.end(); ++iter)
-   {
-      valueList.append(QString::fromStdString(toMatlabString(*iter)));
-   }
-
-   return "char(" + valueList.join(", ").toStdString() + ')';
-}
-
-DataElement* MatlabFunctions::getDataset(const std::string& name)
-{
-   DataElement* pElement = NULL;
-   if (name.empty())
-   {
-      SpatialDataWindow* pWindow = dynamic_cast<SpatialDataWindow*>(
-         Service<DesktopServices>()->getCurrentWorkspaceWindow());
-      SpatialDataView* pView = (pWindow == NULL) ? NULL : pWindow->getSpatialDataView();
-      if (pView == NULL)
-      {
-         return NULL;
-      }
-
-      LayerList* pList = pView->getLayerList();
-      pElement = (pList == NULL) ? NULL : pList->getPrimaryRasterElement();
-   }
-   else
-   {
-      QString str = QString::fromStdString(name);
-      QStringList list = str.split(QString("=>"));
-
-      bool first = true;
-      Service<ModelServices> pModel;
-      while (!list.isEmpty())
-      {
-         QString partName = list.front();
-         list.pop_front();
-
-         pElement = pModel->getElement(partName.toStdString(), "", pElement);
-         if (pElement == NULL && first)
-         {
-            //the element was not found to be top level
-            //check for an element with the => in the name
-            std::vector<DataElement*> elements = pModel->getElements("");
-            for (std::vector<DataElement*>::iterator element = elements.begin();
-               element != elements.end(); ++element)
-            {
-               if ((*element) != NULL && ((*element)->getName() == name || (*element)->getDisplayName() == name))
-               {
-                  pElement = *element;
-                  break;
-               }
-            }
-         }
-         first = false;
-      }
-   }
-   return pElement;
-}
-
-SpatialDataWindow* MatlabFunctions::getWindowByRaster(RasterElement* pRasterElement)
-{
-   std::vector<Window*> windows;
-   Service<DesktopServices>()->getWindows(SPATIAL_DATA_WINDOW, windows);
-
-   for (std::vector<Window*>::const_iterator windowIter = windows.begin();
-      windowIter != windows.end();
-      ++windowIter)
-   {
-      SpatialDataWindow* pSpatialDataWindow = dynamic_cast<SpatialDataWindow*>(*windowIter);
-      if (pSpatialDataWindow != NULL)
-      {
-         SpatialDataView* pSpatialDataView = dynamic_cast<SpatialDataView*>(pSpatialDataWindow->getView());
-         if (pSpatialDataView != NULL)
-         {
-            LayerList* pLayerList = pSpatialDataView->getLayerList();
-            if (pLayerList != NULL)
-            {
-               std::vector<Layer*> layers;
-               pLayerList->getLayers(RASTER, layers);
-               for (std::vector<Layer*>::const_iterator layerIter = layers.begin();
-                  layerIter != layers.end();
-                  ++layerIter)
-               {
-                  RasterLayer* pRasterLayer = dynamic_cast<RasterLayer*>(*layerIter);
-                  if (pRasterLayer != NULL && pRasterLayer->getDataElement() == pRasterElement)
-                  {
-                     return pSpatialDataWindow;
-                  }
-               }
-            }
-         }
-      }
-   }
-   return NULL;
-
-}
-
-Layer* MatlabFunctions::getLayerByRaster(RasterElement* pElement)
-{
-   VERIFYRV(pElement != NULL, NULL);
-   Layer* pDatasetLayer = NULL;
-   std::vector<Window*> windows;
-   Service<DesktopServices>()->getWindows(SPATIAL_DATA_WINDOW, windows);
-
-   for (std::vector<Window*>::const_iterator windowIter = windows.begin();
-      windowIter != windows.end(); ++windowIter)
-   {
-      SpatialDataWindow* pSpatialDataWindow = dynamic_cast<SpatialDataWindow*>(*windowIter);
-      if (pSpatialDataWindow != NULL)
-      {
-         SpatialDataView* pSpatialDataView = dynamic_cast<SpatialDataView*>(pSpatialDataWindow->getView());
-         VERIFYRV(pSpatialDataView != NULL, NULL);
-
-         LayerList* pLayerList = pSpatialDataView->getLayerList();
-         VERIFYRV(pLayerList != NULL, NULL);
-
-         // Retrieve all the raster layers in the current window
-         std::vector<Layer*> layers;
-         pLayerList->getLayers(RASTER, layers);
-         for (std::vector<Layer*>::const_iterator layerIter = layers.begin();
-            layerIter != layers.end(); ++layerIter)
-         {
-            RasterLayer* pRasterLayer = dynamic_cast<RasterLayer*>(*layerIter);
-            VERIFYRV(pRasterLayer != NULL, NULL);
-
-            DataElement* pDataElement = pRasterLayer->getDataElement();
-            if (pDataElement == pElement)
-            {
-               pDatasetLayer = pRasterLayer;
-               break;
-            }
-         }
-      }
-   }
-   return pDatasetLayer;
-}
-
-SpatialDataView* MatlabFunctions::getViewByWindowName(const std::string& windowName)
-{
-   Service<DesktopServices> pDesktop;
-   SpatialDataWindow* pWindow = NULL;
-   if (windowName.empty())
-   {
-      pWindow = dynamic_cast<SpatialDataWindow*>(pDesktop->getCurrentWorkspaceWindow());
-   }
-   else 
-   {
-      pWindow = dynamic_cast<SpatialDataWindow*>(pDesktop->getWindow(windowName, SPATIAL_DATA_WINDOW));
-   }
-
-   if (pWindow == NULL)
-   {
-      return NULL;
-   }
-
-   return pWindow->getSpatialDataView();
-}
-
-Layer* MatlabFunctions::getLayerByName(const std::string& windowName,
-   const std::string& layerName, bool onlyRasterLayers)
-{
-   SpatialDataView* pView = dynamic_cast<SpatialDataView*>(getViewByWindowName(windowName));
-   if (pView == NULL)
-   {
-      return NULL;
-   }
-
-   LayerList* pList = pView->getLayerList();
-   if (pList == NULL)
-   {
-      return NULL;
-   }
-
-   if (layerName.empty() == true)
-   {
-      if (onlyRasterLayers)
-      {
-         return pView->getTopMostLayer(RASTER);
-      }
-
-      return pView->getTopMostLayer();
-   }
-
-   std::vector<Layer*> layers;
-   if (onlyRasterLayers)
-   {
-      layers = pList->getLayers(RASTER);
-   }
-   else
-   {
-      pList->getLayers(layers);
-   }
-
-   for (std::vector<Layer*>::const_iterator iter = layers.begin(); iter != layers.end(); ++iter)
-   {
-      Layer* pLayer = *iter;
-      if (pLayer != NULL && (layerName == pLayer->getName() || layerName == pLayer->getDisplayName()))
-      {
-         return pLayer;
-      }
-   }
-
-   return NULL;
-}
-
-Layer* MatlabFunctions::getLayerByIndex(const std::string& windowName, int index)
-{
-   SpatialDataView* pView = dynamic_cast<SpatialDataView*>(getViewByWindowName(windowName));
-   if (pView == NULL)
-   {
-      return NULL;
-   }
-
-   // Get the current layer if the index is invalid.
-   if (index < 0)
-   {
-      return pView->getTopMostLayer();
-   }
-
-   LayerList* pList = pView->getLayerList();
-   if (pList == NULL)
-   {
-      return NULL;
-   }
-
-   std::vector<Layer*> layers;
-   pList->getLayers(layers);
-   if (static_cast<std::vector<Layer*>::size_type>(index) >= layers.size())
-   {
-      return NULL;
-   }
-
-   return layers[index];
-}
-
-RasterChannelType MatlabFunctions::getChannelByName(const std::string& name)
-{
-   QString nameLower = QString::fromStdString(name).toLower();
-   if (nameLower == "gray" || nameLower == "grayscale" ||
-      nameLower == "grey" || nameLower == "greyscale")
-   {
-      return GRAY;
-   }
-
-   if (nameLower == "red")
-   {
-      return RED;
-   }
-
-   if (nameLower == "green")
-   {
-      return GREEN;
-   }
-
-   if (nameLower == "blue")
-   {
-      return BLUE;
-   }
-
-   return RasterChannelType();
-}
-
-DisplayMode MatlabFunctions::getDisplayModeByName(const std::string& name)
-{
-   QString nameLower = QString::fromStdString(name).toLower();
-   if (nameLower == "gray" || nameLower == "grayscale" ||
-      nameLower == "grey" || nameLower == "greyscale")
-   {
-      return GRAYSCALE_MODE;
-   }
-
-   if (nameLower == "rgb")
-   {
-      return RGB_MODE;
-   }
-
-   return DisplayMode();
-}
-
-StretchType MatlabFunctions::getStretchTypeByName(const std::string& name)
-{
-   QString nameLower = QString::fromStdString(name).toLower();
-   if (nameLower == "linear")
-   {
-      return LINEAR;
-   }
-
-   if (nameLower == "logarithmic")
-   {
-      return LOGARITHMIC;
-   }
-
-   if (nameLower == "exponential")
-   {
-      return EXPONENTIAL;
-   }
-
-   if (nameLower == "equalization")
-   {
-      return EQUALIZATION;
-   }
-
-   return StretchType();
-}
-
-RegionUnits MatlabFunctions::getRegionUnitsByName(const std::string& name)
-{
-   QString nameLower = QString::fromStdString(name).toLower();
-   if (nameLower == "raw" || nameLower == "raw value")
-   {
-      return RAW_VALUE;
-   }
-
-   if (nameLower == "percentage")
-   {
-      return PERCENTAGE;
-   }
-
-   if (nameLower == "percentile")
-   {
-      return PERCENTILE;
-   }
-
-   if (nameLower == "stddev")
-   {
-      return STD_DEV;
-   }
-
-   return RegionUnits();
-}
-
-AnimationCycle MatlabFunctions::getAnimationCycleByName(const std::string& name)
-{
-   QString nameLower = QString::fromStdString(name).toLower();
-   if (nameLower == "play_once" || nameLower == "play once")
-   {
-      return PLAY_ONCE;
-   }
-
-   if (nameLower == "bounce")
-   {
-      return BOUNCE;
-   }
-
-   if (nameLower == "repeat")
-   {
-      return REPEAT;
-   }
-
-   return AnimationCycle();
-}
-
-AnimationState MatlabFunctions::getAnimationStateByName(const std::string& name)
-{
-   QString nameLower = QString::fromStdString(name).toLower();
-   if (nameLower == "stop")
-   {
-      return STOP;
-   }
-
-   if (nameLower == "play_forward")
-   {
-      return PLAY_FORWARD;
-   }
-
-   if (nameLower == "play_backward")
-   {
-      return PLAY_BACKWARD;
-   }
-
-   if (nameLower == "pause_forward")
-   {
-      return PAUSE_FORWARD;
-   }
-
-   if (nameLower == "pause_backward")
-   {
-      return PAUSE_BACKWARD;
-   }
-
-   return AnimationState();
-}
-
-WindowType MatlabFunctions::getWindowTypeByName(const std::string& name)
-{
-   QString nameLower = QString::fromStdString(name).toLower().remove(' ');
-   if (nameLower == "workspacewindow")
-   {
-       return WORKSPACE_WINDOW;
-   }
-
-   if (nameLower == "spatialdatawindow")
-   {
-       return SPATIAL_DATA_WINDOW;
-   }
-
-   if (nameLower == "productwindow")
-   {
-       return PRODUCT_WINDOW;
-   }
-
-   if (nameLower == "dockwindow" || nameLower == "plotwindow")
-   {
-       return DOCK_WINDOW;
-   }
-
-   return WORKSPACE_WINDOW;
-}
-
-InterleaveFormatType MatlabFunctions::getInterleaveByName(const std::string& name)
-{
-   QString nameLower = QString::fromStdString(name).toLower().remove(' ');
-   if (nameLower == "bsq")
-   {
-       return BSQ;
-   }
-
-   if (nameLower == "bil")
-   {
-       return BIL;
-   }
-
-   if (nameLower == "bip")
-   {
-       return BIP;
-   }
-
-   return InterleaveFormatType();
-}
-
-bool MatlabFunctions::setWizardObjectValue(WizardObject* pObject, const std::string& name, const DataVariant& value)
-{
-   if (pObject == NULL)
-   {
-      return false;
-   }
-   std::vector<std::string> parts = StringUtilities::split(name, '/');
-   if (parts.size() != 2)
-   {
-      return false;
-   }
-   std::string itemName = parts[0];
-   std::string nodeName = parts[1];
-
-   const std::vector<WizardItem*>& items = pObject->getItems();
-   for (std::vector<WizardItem*>::const_iterator item = items.begin(); item != items.end(); ++item)
-   {
-      if ((*item)->getName() == itemName)
-      {
-         WizardNode* pNode = (*item)->getOutputNode(nodeName, value.getTypeName());
-         if (pNode != NULL)
-         {
-            pNode->setValue(value.getPointerToValueAsVoid());
-            return true;
-         }
-         else if (value.getTypeName() == TypeConverter::toString<std::string>())
-         {
-            pNode = (*item)->getOutputNode(nodeName, TypeConverter::toString<Filename>());
-            if (pNode != NULL)
-            {
-               FactoryResource<Filename> pFilename;
-               pFilename->setFullPathAndName(dv_cast<std::string>(value));
-               pNode->setValue(pFilename.release());
-               return true;
-            }
-         }
-         break;
-      }
-   }
-   return false;
-}
-
-DataVariant MatlabFunctions::getWizardObjectValue(const WizardObject* pObject, const std::string& name)
-{
-   if (pObject == NULL)
-   {
-      return DataVariant();
-   }
-   std::vector<std::string> parts = StringUtilities::split(name, '/');
-   if (parts.size() != 2)
-   {
-      return DataVariant();
-   }
-   std::string itemName = parts[0];
-   std::string nodeName = parts[1];
-
-   const std::vector<WizardItem*>& items = pObject->getItems();
-   for (std::vector<WizardItem*>::const_iterator item = items.begin(); item != items.end(); ++item)
-   {
-      if ((*item)->getName() == itemName)
-      {
-         std::vector<WizardNode*> nodes = (*item)->getOutputNodes();
-         for (std::vector<WizardNode*>::const_iterator node = nodes.begin(); node != nodes.end(); ++node)
-         {
-            if ((*node)->getName() == nodeName)
-            {
-               return DataVariant((*node)->getType(), (*node)->getValue(), false);
-            }
-         }
-      }
-   }
-
-   return DataVariant();
-}
-
-bool MatlabFunctions::clearWizardObject(const std::string& wizardName)
-{
-   if (wizardName.empty())
-   {
-      for (std::vector<WizardObject*>::iterator iter = spWizards.begin(); iter != spWizards.end(); ++iter)
-      {
-         FactoryResource<WizardObject> pWiz(*iter);
-      }
-      spWizards.clear();
-      return true;
-   }
-
-   //traverse the list of items, looking for the one that matches the item name
-   for (std::vector<WizardObject*>::iterator iter = spWizards.begin(); iter != spWizards.end(); ++iter)
-   {
-      WizardObject* pItem = *iter;
-      if (pItem != NULL && pItem->getName() == wizardName)
-      {
-         FactoryResource<WizardObject> pWiz(pItem);
-         spWizards.erase(iter);
-         return true;
-      }
-   }
-   return false;
-}
-
-WizardObject* MatlabFunctions::getWizardObject(const std::string& wizardName)
-{
-   WizardObject* pWizard = NULL;
-
-   //traverse the list of items, looking for the one that matches the item name
-   for (std::vector<WizardObject*>::const_iterator iter = spWizards.begin(); iter != spWizards.end(); ++iter)
-   {
-      WizardObject* pItem = *iter;
-      if (pItem != NULL && pItem->getName() == wizardName)
-      {
-         pWizard = pItem;
-         break;
-      }
-   }
-   if (pWizard == NULL)
-   {
-      //the wizard object doesn't exist, read it from the file
-      FactoryResource<WizardObject> pNewWizard;
-      VERIFYRV(pNewWizard.get() != NULL, NULL);
-
-      FactoryResource<Filename> pWizardFilename;
-      pWizardFilename->setFullPathAndName(wizardName);
-
-      bool bSuccess = false;
-      XmlReader xml;
-      XERCES_CPP_NAMESPACE_QUALIFIER DOMDocument* pDocument = xml.parse(pWizardFilename.get());
-      if (pDocument != NULL)
-      {
-         XERCES_CPP_NAMESPACE_QUALIFIER DOMElement* pRoot = pDocument->getDocumentElement();
-         if (pRoot != NULL)
-         {
-            unsigned int version = atoi(A(pRoot->getAttribute(X("version"))));
-            bSuccess = pNewWizard->fromXml(pRoot, version);
-         }
-      }
-
-      if (bSuccess == false)
-      {
-         return NULL;
-      }
-      pWizard = pNewWizard.release();
-      pWizard->setName(wizardName);
-      spWizards.push_back(pWizard);
-   }
-   return pWizard;
-}
+/*
+ * The information in this file is
+ * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
+ * and is subject to the terms and conditions of the
+ * GNU Lesser General Public License Version 2.1
+ * The license text is available from   
+ * http://www.gnu.org/licenses/lgpl.html
+ */
+
+#include "BandMath.h"
+#include "DataElement.h"
+#include "DesktopServices.h"
+#include "Layer.h"
+#include "LayerList.h"
+#include "MatlabFunctions.h"
+#include "MatlabInterpreter.h"
+#include "ModelServices.h"
+#include "RasterElement.h"
+#include "RasterLayer.h"
+#include "SpatialDataView.h"
+#include "SpatialDataWindow.h"
+#include "TransferPool.h"
+#include "View.h"
+#include "Window.h"
+#include "WizardItem.h"
+#include "WizardNode.h"
+#include "WizardObject.h"
+#include "xmlreader.h"
+
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+std::string MatlabFunctions::toMatlabString(const std::string& value)
+{
+   // Single quote characters are escaped by using two single quotes, and the entire name is wrapped in single quotes.
+   // This is done so that controllers with single quotes in their names are displayed properly in MATLAB.
+   QString valueTemp(QString::fromStdString(value));
+   valueTemp = valueTemp.replace('\'', "\'\'");
+   return '\'' + valueTemp.toStdString() + '\'';
+}
+
+mxArray* MatlabFunctions::toMatlabArray(const std::vector<std::string>& values)
+{
+   std::vector<const char*> strings;
+   for (std::vector<std::string>::const_iterator iter = values.begin(); iter != values.end(); ++iter)
+   {
+      strings.push_back(iter->c_str());
+   }
+
+   return mxCreateCharMatrixFromStrings(strings.size(), strings.empty() ? NULL : &strings[0]);
+}
+
+std::string MatlabFunctions::setResults(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& names,
+   const std::vector<mxArray*>& values, std::string& output, bool& outputIsError)
+{
+   bool success = (names.size() == values.size());
+   for (std::vector<mxArray*>::size_type i = 0; i < values.size(); ++i)
+   {
+      success = success && values[i] != NULL && matlabInterpreter.setMatlabVariable(names[i], values[i]);
+      if (values[i] != NULL)
+      {
+         mxDestroyArray(values[i]);
+      }
+   }
+
+   if (success == false)
+   {
+      outputIsError = true;
+      output = "Unable to set the MATLAB variable.";
+      return std::string();
+   }
+
+   outputIsError = false;
+   if (QString::fromStdString(matlabInterpreter.getCurrentCommand()).endsWith(';') == true)
+   {
+      return std::string();
+   }
+
+   QStringList displayNames;
+   for (std::vector<std::string>::const_iterator iter = names.begin(); iter != names.end(); ++iter)
+   {
+      displayNames.append(QString::fromStdString(*iter));
+   }
+
+   return displayNames.join(", ").toStdString();
+}
+
+std::string MatlabFunctions::setResult(MatlabInterpreter& matlabInterpreter, const std::string& name,
+   mxArray* pValue, std::string& output, bool& outputIsError)
+{
+   return setResults(matlabInterpreter, std::vector<std::string>(1, name), std::vector<mxArray*>(1, pValue),
+      output, outputIsError);
+}
+
+DataElement* MatlabFunctions::getDataset(const std::string& name)
+{
+   DataElement* pElement = NULL;
+   if (name.empty())
+   {
+      SpatialDataWindow* pWindow = dynamic_cast<SpatialDataWindow*>(
+         Service<DesktopServices>()->getCurrentWorkspaceWindow());
+      SpatialDataView* pView = (pWindow == NULL) ? NULL : pWindow->getSpatialDataView();
+      if (pView == NULL)
+      {
+         return NULL;
+      }
+
+      LayerList* pList = pView->getLayerList();
+      pElement = (pList == NULL) ? NULL : pList->getPrimaryRasterElement();
+   }
+   else
+   {
+      QString str = QString::fromStdString(name);
+      QStringList list = str.split(QString("=>"));
+
+      bool first = true;
+      Service<ModelServices> pModel;
+      while (!list.isEmpty())
+      {
+         QString partName = list.front();
+         list.pop_front();
+
+         pElement = pModel->getElement(partName.toStdString(), "", pElement);
+         if (pElement == NULL && first)
+         {
+            //the element was not found to be top level
+            //check for an element with the => in the name
+            std::vector<DataElement*> elements = pModel->getElements("");
+            for (std::vector<DataElement*>::iterator element = elements.begin();
+               element != elements.end(); ++element)
+            {
+               if ((*element) != NULL && ((*element)->getName() == name || (*element)->getDisplayName() == name))
+               {
+                  pElement = *element;
+                  break;
+               }
+            }
+         }
+         first = false;
+      }
+   }
+   return pElement;
+}
+
+SpatialDataWindow* MatlabFunctions::getWindowByRaster(RasterElement* pRasterElement)
+{
+   std::vector<Window*> windows;
+   Service<DesktopServices>()->getWindows(SPATIAL_DATA_WINDOW, windows);
+
+   for (std::vector<Window*>::const_iterator windowIter = windows.begin();
+      windowIter != windows.end();
+      ++windowIter)
+   {
+      SpatialDataWindow* pSpatialDataWindow = dynamic_cast<SpatialDataWindow*>(*windowIter);
+      if (pSpatialDataWindow != NULL)
+      {
+         SpatialDataView* pSpatialDataView = dynamic_cast<SpatialDataView*>(pSpatialDataWindow->getView());
+         if (pSpatialDataView != NULL)
+         {
+            LayerList* pLayerList = pSpatialDataView->getLayerList();
+            if (pLayerList != NULL)
+            {
+               std::vector<Layer*> layers;
+               pLayerList->getLayers(RASTER, layers);
+               for (std::vector<Layer*>::const_iterator layerIter = layers.begin();
+                  layerIter != layers.end();
+                  ++layerIter)
+               {
+                  RasterLayer* pRasterLayer = dynamic_cast<RasterLayer*>(*layerIter);
+                  if (pRasterLayer != NULL && pRasterLayer->getDataElement() == pRasterElement)
+                  {
+                     return pSpatialDataWindow;
+                  }
+               }
+            }
+         }
+      }
+   }
+   return NULL;
+
+}
+
+Layer* MatlabFunctions::getLayerByRaster(RasterElement* pElement)
+{
+   VERIFYRV(pElement != NULL, NULL);
+   Layer* pDatasetLayer = NULL;
+   std::vector<Window*> windows;
+   Service<DesktopServices>()->getWindows(SPATIAL_DATA_WINDOW, windows);
+
+   for (std::vector<Window*>::const_iterator windowIter = windows.begin();
+      windowIter != windows.end(); ++windowIter)
+   {
+      SpatialDataWindow* pSpatialDataWindow = dynamic_cast<SpatialDataWindow*>(*windowIter);
+      if (pSpatialDataWindow != NULL)
+      {
+         SpatialDataView* pSpatialDataView = dynamic_cast<SpatialDataView*>(pSpatialDataWindow->getView());
+         VERIFYRV(pSpatialDataView != NULL, NULL);
+
+         LayerList* pLayerList = pSpatialDataView->getLayerList();
+         VERIFYRV(pLayerList != NULL, NULL);
+
+         // Retrieve all the raster layers in the current window
+         std::vector<Layer*> layers;
+         pLayerList->getLayers(RASTER, layers);
+         for (std::vector<Layer*>::const_iterator layerIter = layers.begin();
+            layerIter != layers.end(); ++layerIter)
+         {
+            RasterLayer* pRasterLayer = dynamic_cast<RasterLayer*>(*layerIter);
+            VERIFYRV(pRasterLayer != NULL, NULL);
+
+            DataElement* pDataElement = pRasterLayer->getDataElement();
+            if (pDataElement == pElement)
+            {
+               pDatasetLayer = pRasterLayer;
+               break;
+            }
+         }
+      }
+   }
+   return pDatasetLayer;
+}
+
+SpatialDataView* MatlabFunctions::getViewByWindowName(const std::string& windowName)
+{
+   Service<DesktopServices> pDesktop;
+   SpatialDataWindow* pWindow = NULL;
+   if (windowName.empty())
+   {
+      pWindow = dynamic_cast<SpatialDataWindow*>(pDesktop->getCurrentWorkspaceWindow());
+   }
+   else 
+   {
+      pWindow = dynamic_cast<SpatialDataWindow*>(pDesktop->getWindow(windowName, SPATIAL_DATA_WINDOW));
+   }
+
+   if (pWindow == NULL)
+   {
+      return NULL;
+   }
+
+   return pWindow->getSpatialDataView();
+}
+
+Layer* MatlabFunctions::getLayerByName(const std::string& windowName,
+   const std::string& layerName, bool onlyRasterLayers)
+{
+   SpatialDataView* pView = dynamic_cast<SpatialDataView*>(getViewByWindowName(windowName));
+   if (pView == NULL)
+   {
+      return NULL;
+   }
+
+   LayerList* pList = pView->getLayerList();
+   if (pList == NULL)
+   {
+      return NULL;
+   }
+
+   if (layerName.empty() == true)
+   {
+      if (onlyRasterLayers)
+      {
+         return pView->getTopMostLayer(RASTER);
+      }
+
+      return pView->getTopMostLayer();
+   }
+
+   std::vector<Layer*> layers;
+   if (onlyRasterLayers)
+   {
+      layers = pList->getLayers(RASTER);
+   }
+   else
+   {
+      pList->getLayers(layers);
+   }
+
+   for (std::vector<Layer*>::const_iterator iter = layers.begin(); iter != layers.end(); ++iter)
+   {
+      Layer* pLayer = *iter;
+      if (pLayer != NULL && (layerName == pLayer->getName() || layerName == pLayer->getDisplayName()))
+      {
+         return pLayer;
+      }
+   }
+
+   return NULL;
+}
+
+Layer* MatlabFunctions::getLayerByIndex(const std::string& windowName, int index)
+{
+   SpatialDataView* pView = dynamic_cast<SpatialDataView*>(getViewByWindowName(windowName));
+   if (pView == NULL)
+   {
+      return NULL;
+   }
+
+   // Get the current layer if the index is invalid.
+   if (index < 0)
+   {
+      return pView->getTopMostLayer();
+   }
+
+   LayerList* pList = pView->getLayerList();
+   if (pList == NULL)
+   {
+      return NULL;
+   }
+
+   std::vector<Layer*> layers;
+   pList->getLayers(layers);
+   if (static_cast<std::vector<Layer*>::size_type>(index) >= layers.size())
+   {
+      return NULL;
+   }
+
+   return layers[index];
+}
+
+RasterChannelType MatlabFunctions::getChannelByName(const std::string& name)
+{
+   QString nameLower = QString::fromStdString(name).toLower();
+   if (nameLower == "gray" || nameLower == "grayscale" ||
+      nameLower == "grey" || nameLower == "greyscale")
+   {
+      return GRAY;
+   }
+
+   if (nameLower == "red")
+   {
+      return RED;
+   }
+
+   if (nameLower == "green")
+   {
+      return GREEN;
+   }
+
+   if (nameLower == "blue")
+   {
+      return BLUE;
+   }
+
+   return RasterChannelType();
+}
+
+DisplayMode MatlabFunctions::getDisplayModeByName(const std::string& name)
+{
+   QString nameLower = QString::fromStdString(name).toLower();
+   if (nameLower == "gray" || nameLower == "grayscale" ||
+      nameLower == "grey" || nameLower == "greyscale")
+   {
+      return GRAYSCALE_MODE;
+   }
+
+   if (nameLower == "rgb")
+   {
+      return RGB_MODE;
+   }
+
+   return DisplayMode();
+}
+
+StretchType MatlabFunctions::getStretchTypeByName(const std::string& name)
+{
+   QString nameLower = QString::fromStdString(name).toLower();
+   if (nameLower == "linear")
+   {
+      return LINEAR;
+   }
+
+   if (nameLower == "logarithmic")
+   {
+      return LOGARITHMIC;
+   }
+
+   if (nameLower == "exponential")
+   {
+      return EXPONENTIAL;
+   }
+
+   if (nameLower == "equalization")
+   {
+      return EQUALIZATION;
+   }
+
+   return StretchType();
+}
+
+RegionUnits MatlabFunctions::getRegionUnitsByName(const std::string& name)
+{
+   QString nameLower = QString::fromStdString(name).toLower();
+   if (nameLower == "raw" || nameLower == "raw value")
+   {
+      return RAW_VALUE;
+   }
+
+   if (nameLower == "percentage")
+   {
+      return PERCENTAGE;
+   }
+
+   if (nameLower == "percentile")
+   {
+      return PERCENTILE;
+   }
+
+   if (nameLower == "stddev")
+   {
+      return STD_DEV;
+   }
+
+   return RegionUnits();
+}
+
+AnimationCycle MatlabFunctions::getAnimationCycleByName(const std::string& name)
+{
+   QString nameLower = QString::fromStdString(name).toLower();
+   if (nameLower == "play_once" || nameLower == "play once")
+   {
+      return PLAY_ONCE;
+   }
+
+   if (nameLower == "bounce")
+   {
+      return BOUNCE;
+   }
+
+   if (nameLower == "repeat")
+   {
+      return REPEAT;
+   }
+
+   return AnimationCycle();
+}
+
+AnimationState MatlabFunctions::getAnimationStateByName(const std::string& name)
+{
+   QString nameLower = QString::fromStdString(name).toLower();
+   if (nameLower == "stop")
+   {
+      return STOP;
+   }
+
+   if (nameLower == "play_forward")
+   {
+      return PLAY_FORWARD;
+   }
+
+   if (nameLower == "play_backward")
+   {
+      return PLAY_BACKWARD;
+   }
+
+   if (nameLower == "pause_forward")
+   {
+      return PAUSE_FORWARD;
+   }
+
+   if (nameLower == "pause_backward")
+   {
+      return PAUSE_BACKWARD;
+   }
+
+   return AnimationState();
+}
+
+WindowType MatlabFunctions::getWindowTypeByName(const std::string& name)
+{
+   QString nameLower = QString::fromStdString(name).toLower().remove(' ');
+   if (nameLower == "workspacewindow")
+   {
+       return WORKSPACE_WINDOW;
+   }
+
+   if (nameLower == "spatialdatawindow")
+   {
+       return SPATIAL_DATA_WINDOW;
+   }
+
+   if (nameLower == "productwindow")
+   {
+       return PRODUCT_WINDOW;
+   }
+
+   if (nameLower == "dockwindow" || nameLower == "plotwindow")
+   {
+       return DOCK_WINDOW;
+   }
+
+   return WORKSPACE_WINDOW;
+}
+
+InterleaveFormatType MatlabFunctions::getInterleaveByName(const std::string& name)
+{
+   QString nameLower = QString::fromStdString(name).toLower().remove(' ');
+   if (nameLower == "bsq")
+   {
+       return BSQ;
+   }
+
+   if (nameLower == "bil")
+   {
+       return BIL;
+   }
+
+   if (nameLower == "bip")
+   {
+       return BIP;
+   }
+
+   return InterleaveFormatType();
+}
+
+bool MatlabFunctions::setWizardObjectValue(WizardObject* pObject, const std::string& name, const DataVariant& value)
+{
+   if (pObject == NULL)
+   {
+      return false;
+   }
+   std::vector<std::string> parts = StringUtilities::split(name, '/');
+   if (parts.size() != 2)
+   {
+      return false;
+   }
+   std::string itemName = parts[0];
+   std::string nodeName = parts[1];
+
+   const std::vector<WizardItem*>& items = pObject->getItems();
+   for (std::vector<WizardItem*>::const_iterator item = items.begin(); item != items.end(); ++item)
+   {
+      if ((*item)->getName() == itemName)
+      {
+         WizardNode* pNode = (*item)->getOutputNode(nodeName, value.getTypeName());
+         if (pNode != NULL)
+         {
+            pNode->setValue(value.getPointerToValueAsVoid());
+            return true;
+         }
+         else if (value.getTypeName() == TypeConverter::toString<std::string>())
+         {
+            pNode = (*item)->getOutputNode(nodeName, TypeConverter::toString<Filename>());
+            if (pNode != NULL)
+            {
+               FactoryResource<Filename> pFilename;
+               pFilename->setFullPathAndName(dv_cast<std::string>(value));
+               pNode->setValue(pFilename.release());
+               return true;
+            }
+         }
+         break;
+      }
+   }
+   return false;
+}
+
+DataVariant MatlabFunctions::getWizardObjectValue(const WizardObject* pObject, const std::string& name)
+{
+   if (pObject == NULL)
+   {
+      return DataVariant();
+   }
+   std::vector<std::string> parts = StringUtilities::split(name, '/');
+   if (parts.size() != 2)
+   {
+      return DataVariant();
+   }
+   std::string itemName = parts[0];
+   std::string nodeName = parts[1];
+
+   const std::vector<WizardItem*>& items = pObject->getItems();
+   for (std::vector<WizardItem*>::const_iterator item = items.begin(); item != items.end(); ++item)
+   {
+      if ((*item)->getName() == itemName)
+      {
+         std::vector<WizardNode*> nodes = (*item)->getOutputNodes();
+         for (std::vector<WizardNode*>::const_iterator node = nodes.begin(); node != nodes.end(); ++node)
+         {
+            if ((*node)->getName() == nodeName)
+            {
+               return DataVariant((*node)->getType(), (*node)->getValue(), false);
+            }
+         }
+      }
+   }
+
+   return DataVariant();
+}
+
+bool MatlabFunctions::clearWizardObject(const std::string& wizardName)
+{
+   if (wizardName.empty())
+   {
+      for (std::vector<WizardObject*>::iterator iter = spWizards.begin(); iter != spWizards.end(); ++iter)
+      {
+         FactoryResource<WizardObject> pWiz(*iter);
+      }
+      spWizards.clear();
+      return true;
+   }
+
+   //traverse the list of items, looking for the one that matches the item name
+   for (std::vector<WizardObject*>::iterator iter = spWizards.begin(); iter != spWizards.end(); ++iter)
+   {
+      WizardObject* pItem = *iter;
+      if (pItem != NULL && pItem->getName() == wizardName)
+      {
+         FactoryResource<WizardObject> pWiz(pItem);
+         spWizards.erase(iter);
+         return true;
+      }
+   }
+   return false;
+}
+
+WizardObject* MatlabFunctions::getWizardObject(const std::string& wizardName)
+{
+   WizardObject* pWizard = NULL;
+
+   //traverse the list of items, looking for the one that matches the item name
+   for (std::vector<WizardObject*>::const_iterator iter = spWizards.begin(); iter != spWizards.end(); ++iter)
+   {
+      WizardObject* pItem = *iter;
+      if (pItem != NULL && pItem->getName() == wizardName)
+      {
+         pWizard = pItem;
+         break;
+      }
+   }
+   if (pWizard == NULL)
+   {
+      //the wizard object doesn't exist, read it from the file
+      FactoryResource<WizardObject> pNewWizard;
+      VERIFYRV(pNewWizard.get() != NULL, NULL);
+
+      FactoryResource<Filename> pWizardFilename;
+      pWizardFilename->setFullPathAndName(wizardName);
+
+      bool bSuccess = false;
+      XmlReader xml;
+      XERCES_CPP_NAMESPACE_QUALIFIER DOMDocument* pDocument = xml.parse(pWizardFilename.get());
+      if (pDocument != NULL)
+      {
+         XERCES_CPP_NAMESPACE_QUALIFIER DOMElement* pRoot = pDocument->getDocumentElement();
+         if (pRoot != NULL)
+         {
+            unsigned int version = atoi(A(pRoot->getAttribute(X("version"))));
+            bSuccess = pNewWizard->fromXml(pRoot, version);
+         }
+      }
+
+      if (bSuccess == false)
+      {
+         return NULL;
+      }
+      pWizard = pNewWizard.release();
+      pWizard->setName(wizardName);
+      spWizards.push_back(pWizard);
+   }
+   return pWizard;
+}
+
+unsigned int MatlabFunctions::getTransferThreadCount()
+{
+   // A value of zero uses one thread per processor.
+   int threadCount = MatlabInterpreter::getSettingTransferThreadCount();
+   if (threadCount <= 0)
+   {
+      threadCount = QThread::idealThreadCount();
+   }
+
+   return static_cast<unsigned int>(std::max(threadCount, 1));
+}
+
+std::vector<MatlabFunctions::TransferRange> MatlabFunctions::getTransferRanges(size_t rowCount,
+   size_t bandCount, size_t blockSize, bool splitBands)
+{
+   std::vector<TransferRange> ranges;
+   if (rowCount == 0 || bandCount == 0)
+   {
+      return ranges;
+   }
+
+   const unsigned int threadCount = getTransferThreadCount();
+   if (splitBands == true && bandCount >= threadCount)
+   {
+      // There are enough bands to keep every thread busy, so give each one a group of whole bands.
+      for (size_t thread = 0; thread < threadCount; ++thread)
+      {
+         TransferRange range;
+         range.mFirstRow = 0;
+         range.mRowCount = rowCount;
+         range.mFirstBand = bandCount * thread / threadCount;
+         range.mBandCount = bandCount * (thread + 1) / threadCount - range.mFirstBand;
+         ranges.push_back(range);
+      }
+
+      return ranges;
+   }
+
+   // Split the rows of each band (or of all bands together) so that every block starts on a block boundary.
+   blockSize = std::max(blockSize, static_cast<size_t>(1));
+   const size_t bandGroups = (splitBands == true ? bandCount : 1);
+   const size_t rowSplits = (threadCount + bandGroups - 1) / bandGroups;
+   const size_t rowBlocks = (rowCount + blockSize - 1) / blockSize;
+   const size_t rowsPerSplit = ((rowBlocks + rowSplits - 1) / rowSplits) * blockSize;
+   for (size_t group = 0; group < bandGroups; ++group)
+   {
+      for (size_t row = 0; row < rowCount; row += rowsPerSplit)
+      {
+         TransferRange range;
+         range.mFirstRow = row;
+         range.mRowCount = std::min(rowsPerSplit, rowCount - row);
+         range.mFirstBand = (splitBands == true ? group : 0);
+         range.mBandCount = (splitBands == true ? 1 : bandCount);
+         ranges.push_back(range);
+      }
+   }
+
+   return ranges;
+}
+
+std::string MatlabFunctions::runTransferWorkers(std::vector<TransferWorker*>& workers)
+{
+   if (workers.size() == 1)
+   {
+      // Avoid the overhead of starting a thread when there is nothing to run concurrently.
+      workers.front()->run();
+   }
+   else if (workers.empty() == false)
+   {
+      QThreadPool pool;
+      pool.setMaxThreadCount(static_cast<int>(getTransferThreadCount()));
+      for (std::vector<TransferWorker*>::const_iterator iter = workers.begin(); iter != workers.end(); ++iter)
+      {
+         pool.start(*iter);
+      }
+
+      pool.waitForDone();
+   }
+
+   std::string error;
+   for (std::vector<TransferWorker*>::iterator iter = workers.begin(); iter != workers.end(); ++iter)
+   {
+      if (error.empty() == true)
+      {
+         error = (*iter)->getError();
+      }
+
+      delete *iter;
+   }
+
+   workers.clear();
+   return error;
+}
+
+void MatlabFunctions::setRequestBounds(DataRequest* pRequest, const RasterDataDescriptor* pDescriptor,
+   size_t startRow, size_t stopRow, size_t concurrentRows, size_t startColumn, size_t stopColumn,
+   size_t startBand, size_t stopBand)
+{
+   pRequest->setRows(pDescriptor->getActiveRow(static_cast<unsigned int>(startRow)),
+      pDescriptor->getActiveRow(static_cast<unsigned int>(stopRow)), static_cast<unsigned int>(concurrentRows));
+   pRequest->setColumns(pDescriptor->getActiveColumn(static_cast<unsigned int>(startColumn)),
+      pDescriptor->getActiveColumn(static_cast<unsigned int>(stopColumn)));
+   pRequest->setBands(pDescriptor->getActiveBand(static_cast<unsigned int>(startBand)),
+      pDescriptor->getActiveBand(static_cast<unsigned int>(stopBand)));
+}
+
+namespace
+{
+   // Calls functor with a NULL pointer to the C++ type which holds each element of the given encoding, so that
+   // a transfer can be resolved for both its source and destination types. Complex encodings have no MATLAB
+   // equivalent, so false is returned for them without calling the functor.
+   template<typename Functor>
+   bool switchOnRealEncoding(EncodingType type, Functor& functor)
+   {
+      switch (type)
+      {
+         case INT1SBYTE:
+            functor(static_cast<signed char*>(NULL));
+            break;
+         case INT1UBYTE:
+            functor(static_cast<unsigned char*>(NULL));
+            break;
+         case INT2SBYTES:
+            functor(static_cast<signed short*>(NULL));
+            break;
+         case INT2UBYTES:
+            functor(static_cast<unsigned short*>(NULL));
+            break;
+         case INT4SBYTES:
+            functor(static_cast<signed int*>(NULL));
+            break;
+         case INT4UBYTES:
+            functor(static_cast<unsigned int*>(NULL));
+            break;
+         case FLT4BYTES:
+            functor(static_cast<float*>(NULL));
+            break;
+         case FLT8BYTES:
+            functor(static_cast<double*>(NULL));
+            break;
+         default:
+            return false;
+      }
+
+      return true;
+   }
+
+   // Copies a MATLAB array of type S into a raster element, starting at the given row, column, and band of the
+   // element, once the element's type has been resolved.
+   template<typename S>
+   class ArrayToOpticksCopy
+   {
+   public:
+      ArrayToOpticksCopy(const S* pArray, RasterElement* pElement, InterleaveFormatType interleave,
+         size_t heightStart, size_t widthStart, size_t bandStart, size_t rowCount, size_t columnCount,
+         size_t bandCount) :
+         mpArray(pArray),
+         mpElement(pElement),
+         mInterleave(interleave),
+         mHeightStart(heightStart),
+         mWidthStart(widthStart),
+         mBandStart(bandStart),
+         mRowCount(rowCount),
+         mColumnCount(columnCount),
+         mBandCount(bandCount)
+      {}
+
+      template<typename D>
+      void operator()(D*)
+      {
+         // BSQ bands are independent, but BIL and BIP rows hold every band so those are only split by row.
+         D* pRawData = reinterpret_cast<D*>(mpElement->getRawData());
+         const size_t blockSize = ArrayTransfer::TileTraits<S, D>::Edge;
+         std::vector<MatlabFunctions::TransferRange> ranges =
+            MatlabFunctions::getTransferRanges(mRowCount, mBandCount, blockSize, mInterleave == BSQ);
+         std::vector<MatlabFunctions::TransferWorker*> workers;
+         for (std::vector<MatlabFunctions::TransferRange>::const_iterator iter = ranges.begin();
+            iter != ranges.end(); ++iter)
+         {
+            workers.push_back(new MatlabFunctions::ArrayToOpticksWorker<S, D>(*iter, mpArray, mpElement, pRawData,
+               mInterleave, mHeightStart, mWidthStart, mBandStart, mRowCount, mColumnCount, mBandCount));
+         }
+
+         mError = MatlabFunctions::runTransferWorkers(workers);
+      }
+
+      const std::string& getError() const
+      {
+         return mError;
+      }
+
+   private:
+      const S* mpArray;
+      RasterElement* mpElement;
+      InterleaveFormatType mInterleave;
+      size_t mHeightStart;
+      size_t mWidthStart;
+      size_t mBandStart;
+      size_t mRowCount;
+      size_t mColumnCount;
+      size_t mBandCount;
+      std::string mError;
+   };
+
+   // Resolves the type of a MATLAB array and then copies it into a raster element of the element's own type.
+   class ArrayToOpticksSource
+   {
+   public:
+      ArrayToOpticksSource(const void* pArray, RasterElement* pElement, EncodingType type,
+         InterleaveFormatType interleave, size_t heightStart, size_t widthStart, size_t bandStart,
+         size_t rowCount, size_t columnCount, size_t bandCount) :
+         mpArray(pArray),
+         mpElement(pElement),
+         mType(type),
+         mInterleave(interleave),
+         mHeightStart(heightStart),
+         mWidthStart(widthStart),
+         mBandStart(bandStart),
+         mRowCount(rowCount),
+         mColumnCount(columnCount),
+         mBandCount(bandCount)
+      {}
+
+      template<typename S>
+      void operator()(S*)
+      {
+         ArrayToOpticksCopy<S> copy(reinterpret_cast<const S*>(mpArray), mpElement, mInterleave,
+            mHeightStart, mWidthStart, mBandStart, mRowCount, mColumnCount, mBandCount);
+         if (switchOnRealEncoding(mType, copy) == false)
+         {
+            mError = "Unsupported data type.";
+            return;
+         }
+
+         mError = copy.getError();
+      }
+
+      const std::string& getError() const
+      {
+         return mError;
+      }
+
+   private:
+      const void* mpArray;
+      RasterElement* mpElement;
+      EncodingType mType;
+      InterleaveFormatType mInterleave;
+      size_t mHeightStart;
+      size_t mWidthStart;
+      size_t mBandStart;
+      size_t mRowCount;
+      size_t mColumnCount;
+      size_t mBandCount;
+      std::string mError;
+   };
+
+   // Copies a subcube of a raster element into a MATLAB array of type D once the element's type has been resolved.
+   template<typename D>
+   class ArrayToMatlabCopy
+   {
+   public:
+      ArrayToMatlabCopy(D* pArray, RasterElement* pElement, const MatlabFunctions::Subcube& subcube, double scale) :
+         mpArray(pArray),
+         mpElement(pElement),
+         mSubcube(subcube),
+         mScale(scale)
+      {}
+
+      template<typename S>
+      void operator()(S*)
+      {
+         const RasterDataDescriptor* pDescriptor =
+            dynamic_cast<const RasterDataDescriptor*>(mpElement->getDataDescriptor());
+         const size_t rowCount = static_cast<size_t>(mSubcube.mStopRow - mSubcube.mStartRow) + 1;
+         const size_t columnCount = static_cast<size_t>(mSubcube.mStopColumn - mSubcube.mStartColumn) + 1;
+         const size_t bandCount = static_cast<size_t>(mSubcube.mStopBand - mSubcube.mStartBand) + 1;
+
+         // Read the data in its native interleave. Each BIL or BIP row holds every band, so those are only split
+         // by row. Elements which are entirely in memory are read directly, and all others through a DataAccessor.
+         InterleaveFormatType interleave = pDescriptor->getInterleaveFormat();
+         std::vector<MatlabFunctions::TransferRange> ranges;
+         std::vector<MatlabFunctions::TransferWorker*> workers;
+         if (mSubcube.mRowStride == 1 && mSubcube.mColumnStride == 1 && mSubcube.mBandStride == 1)
+         {
+            const S* pRawData = reinterpret_cast<const S*>(mpElement->getRawData());
+            const size_t blockSize = ArrayTransfer::TileTraits<S, D>::Edge;
+            ranges = MatlabFunctions::getTransferRanges(rowCount, bandCount, blockSize, interleave == BSQ);
+            for (std::vector<MatlabFunctions::TransferRange>::const_iterator iter = ranges.begin();
+               iter != ranges.end(); ++iter)
+            {
+               workers.push_back(new MatlabFunctions::ArrayToMatlabWorker<S, D>(*iter, mpArray, mpElement, pRawData,
+                  interleave, mSubcube.mStartRow, mSubcube.mStartColumn, mSubcube.mStartBand, rowCount, columnCount,
+                  mScale));
+            }
+         }
+         else
+         {
+            const size_t outRows = (rowCount + mSubcube.mRowStride - 1) / mSubcube.mRowStride;
+            const size_t outBands = (bandCount + mSubcube.mBandStride - 1) / mSubcube.mBandStride;
+            ranges = MatlabFunctions::getTransferRanges(outRows, outBands, 1, interleave == BSQ);
+            for (std::vector<MatlabFunctions::TransferRange>::const_iterator iter = ranges.begin();
+               iter != ranges.end(); ++iter)
+            {
+               workers.push_back(new MatlabFunctions::DecimatedArrayToMatlabWorker<S, D>(*iter, mpArray, mpElement,
+                  interleave, mSubcube.mStartRow, mSubcube.mStartColumn, mSubcube.mStartBand,
+                  rowCount, columnCount, bandCount, mSubcube.mRowStride, mSubcube.mColumnStride,
+                  mSubcube.mBandStride, mSubcube.mAverage, mScale));
+            }
+         }
+
+         mError = MatlabFunctions::runTransferWorkers(workers);
+      }
+
+      const std::string& getError() const
+      {
+         return mError;
+      }
+
+   private:
+      D* mpArray;
+      RasterElement* mpElement;
+      MatlabFunctions::Subcube mSubcube;
+      double mScale;
+      std::string mError;
+   };
+
+   // Resolves the type of a MATLAB array and then copies a subcube of a raster element of any type into it.
+   class ArrayToMatlabTarget
+   {
+   public:
+      ArrayToMatlabTarget(void* pArray, RasterElement* pElement, EncodingType type,
+         const MatlabFunctions::Subcube& subcube, double scale) :
+         mpArray(pArray),
+         mpElement(pElement),
+         mType(type),
+         mSubcube(subcube),
+         mScale(scale)
+      {}
+
+      template<typename D>
+      void operator()(D*)
+      {
+         ArrayToMatlabCopy<D> copy(reinterpret_cast<D*>(mpArray), mpElement, mSubcube, mScale);
+         if (switchOnRealEncoding(mType, copy) == false)
+         {
+            mError = "Unsupported data type.";
+            return;
+         }
+
+         mError = copy.getError();
+      }
+
+      const std::string& getError() const
+      {
+         return mError;
+      }
+
+   private:
+      void* mpArray;
+      RasterElement* mpElement;
+      EncodingType mType;
+      MatlabFunctions::Subcube mSubcube;
+      double mScale;
+      std::string mError;
+   };
+
+   // Copies the spectra of a sorted list of pixels into a MATLAB array of type D once the element's type has been
+   // resolved.
+   template<typename D>
+   class PixelsToMatlabCopy
+   {
+   public:
+      PixelsToMatlabCopy(D* pArray, RasterElement* pElement, const std::vector<MatlabFunctions::PixelLocation>& pixels,
+         size_t startBand, size_t bandCount) :
+         mpArray(pArray),
+         mpElement(pElement),
+         mPixels(pixels),
+         mStartBand(startBand),
+         mBandCount(bandCount)
+      {}
+
+      template<typename S>
+      void operator()(S*)
+      {
+         const RasterDataDescriptor* pDescriptor =
+            dynamic_cast<const RasterDataDescriptor*>(mpElement->getDataDescriptor());
+         InterleaveFormatType interleave = pDescriptor->getInterleaveFormat();
+         const S* pRawData = reinterpret_cast<const S*>(mpElement->getRawData());
+         std::vector<MatlabFunctions::TransferRange> ranges =
+            MatlabFunctions::getTransferRanges(mPixels.size(), mBandCount, 1, interleave == BSQ);
+         std::vector<MatlabFunctions::TransferWorker*> workers;
+         for (std::vector<MatlabFunctions::TransferRange>::const_iterator iter = ranges.begin();
+            iter != ranges.end(); ++iter)
+         {
+            workers.push_back(new MatlabFunctions::PixelSpectraWorker<S, D>(*iter, mpArray, mpElement, pRawData,
+               interleave, mPixels, mStartBand));
+         }
+
+         mError = MatlabFunctions::runTransferWorkers(workers);
+      }
+
+      const std::string& getError() const
+      {
+         return mError;
+      }
+
+   private:
+      D* mpArray;
+      RasterElement* mpElement;
+      const std::vector<MatlabFunctions::PixelLocation>& mPixels;
+      size_t mStartBand;
+      size_t mBandCount;
+      std::string mError;
+   };
+
+   // Resolves the type of a MATLAB array and then copies the spectra of a list of pixels into it.
+   class PixelsToMatlabTarget
+   {
+   public:
+      PixelsToMatlabTarget(void* pArray, RasterElement* pElement, EncodingType type,
+         const std::vector<MatlabFunctions::PixelLocation>& pixels, size_t startBand, size_t bandCount) :
+         mpArray(pArray),
+         mpElement(pElement),
+         mType(type),
+         mPixels(pixels),
+         mStartBand(startBand),
+         mBandCount(bandCount)
+      {}
+
+      template<typename D>
+      void operator()(D*)
+      {
+         PixelsToMatlabCopy<D> copy(reinterpret_cast<D*>(mpArray), mpElement, mPixels, mStartBand, mBandCount);
+         if (switchOnRealEncoding(mType, copy) == false)
+         {
+            mError = "Unsupported data type.";
+            return;
+         }
+
+         mError = copy.getError();
+      }
+
+      const std::string& getError() const
+      {
+         return mError;
+      }
+
+   private:
+      void* mpArray;
+      RasterElement* mpElement;
+      EncodingType mType;
+      const std::vector<MatlabFunctions::PixelLocation>& mPixels;
+      size_t mStartBand;
+      size_t mBandCount;
+      std::string mError;
+   };
+}
+
+void MatlabFunctions::arrayToOpticks(const void* pArray, EncodingType arrayType, std::string& error,
+   const std::string& name, unsigned int columnCount, unsigned int rowCount, unsigned int bandCount,
+   const std::string& unit, EncodingType type, InterleaveFormatType interleave, bool inMemory,
+   const std::string& filename, bool displayResults, bool newWindow)
+{
+   if (pArray == NULL)
+   {
+      error = "no source data.";
+      return;
+   }
+
+   // Get the specified view and sensor data.
+   RasterElement* pParentElement = NULL;
+   if (filename.empty() == false)
+   {
+      pParentElement = dynamic_cast<RasterElement*>(getDataset(filename));
+   }
+
+   //it doesn't exist, so we can make a new one
+   ModelResource<RasterElement> pNewElement(RasterUtilities::createRasterElement(name,
+      rowCount, columnCount, bandCount, type, interleave, inMemory, pParentElement));
+   if (pNewElement.get() == NULL)
+   {
+      error = "Unable to create new raster element.";
+      return;
+   }
+
+   RasterDataDescriptor* pDescriptor = dynamic_cast<RasterDataDescriptor*>(pNewElement->getDataDescriptor());
+   if (pDescriptor == NULL)
+   {
+      error = "Unable to obtain the raster data descriptor.";
+      return;
+   }
+
+   if (interleave != BSQ && interleave != BIL && interleave != BIP)
+   {
+      error = "Unrecognized interleave.";
+      return;
+   }
+
+   // The array is converted to the type of the new element while it is transposed.
+   ArrayToOpticksSource source(pArray, pNewElement.get(), type, interleave, 0, 0, 0, rowCount, columnCount, bandCount);
+   if (switchOnRealEncoding(arrayType, source) == false)
+   {
+      error = "Unsupported data type.";
+      return;
+   }
+
+   error = source.getError();
+   if (error.empty() == false)
+   {
+      return;
+   }
+
+   if (unit.empty() == false)
+   {
+      Units* pScale = pDescriptor->getUnits();
+      if (pScale != NULL)
+      {
+         bool bError = false;
+         UnitType uType = StringUtilities::fromDisplayString<UnitType>(unit, &bError);
+         if (bError)
+         {
+            pScale->setUnitType(CUSTOM_UNIT);
+         }
+         else
+         {
+            pScale->setUnitType(uType);
+         }
+         pScale->setUnitName(unit);
+         pDescriptor->setUnits(pScale);
+      }
+   }
+
+   if (displayResults == true)
+   {
+      displayRasterElement(pNewElement.get(), name, newWindow, error);
+      if (error.empty() == false)
+      {
+         return;
+      }
+   }
+
+   pNewElement.release();
+}
+
+void MatlabFunctions::displayRasterElement(RasterElement* pElement, const std::string& name, bool newWindow,
+   std::string& error)
+{
+   // Add the element to the current view or create a new one. Note that this will create a window when newWindow
+   // is false if there is no current window.
+   SpatialDataView* pView = NULL;
+   if (newWindow == false)
+   {
+      WorkspaceWindow* pData = Service<DesktopServices>()->getCurrentWorkspaceWindow();
+      if (pData != NULL)
+      {
+         pView = dynamic_cast<SpatialDataView*>(pData->getView());
+      }
+   }
+
+   if (pView != NULL)
+   {
+      UndoLock undo(pView);
+      pView->createLayer(RASTER, pElement, name);
+   }
+   else
+   {
+      SpatialDataWindow* pWindow = static_cast<SpatialDataWindow*>(
+         Service<DesktopServices>()->createWindow(name, SPATIAL_DATA_WINDOW));
+
+      if (pWindow == NULL)
+      {
+         error = "Unable to create the window.";
+         return;
+      }
+
+      SpatialDataView* pView = pWindow->getSpatialDataView();
+      if (pView == NULL)
+      {
+         error = "Unable to create the view.";
+         return;
+      }
+
+      UndoLock undo(pView);
+      if (pView->setPrimaryRasterElement(pElement) == false)
+      {
+         error = "Unable to set the primary raster element into the view";
+         return;
+      }
+
+      RasterLayer* pLayer = static_cast<RasterLayer*>(pView->createLayer(RASTER, pElement));
+      if (pLayer == NULL)
+      {
+         error = "Unable to create the layer";
+         return;
+      }
+   }
+}
+
+void MatlabFunctions::arrayToMatlab(void* pArray, EncodingType arrayType, std::string& error,
+   RasterElement* pParentElement, const Subcube& subcube, double scale)
+{
+   if (pParentElement == NULL)
+   {
+      error = "No raster element provided";
+      return;
+   }
+
+   if (subcube.mRowStride == 0 || subcube.mColumnStride == 0 || subcube.mBandStride == 0)
+   {
+      error = "Invalid stride.";
+      return;
+   }
+
+   const RasterDataDescriptor* pDescriptor =
+      dynamic_cast<const RasterDataDescriptor*>(pParentElement->getDataDescriptor());
+   if (pDescriptor == NULL)
+   {
+      error = "Unable to obtain the raster data descriptor.";
+      return;
+   }
+
+   ArrayToMatlabTarget target(pArray, pParentElement, pDescriptor->getDataType(), subcube, scale);
+   if (switchOnRealEncoding(arrayType, target) == false)
+   {
+      error = "Unsupported data type.";
+      return;
+   }
+
+   error = target.getError();
+}
+
+void MatlabFunctions::pixelsToMatlab(void* pArray, EncodingType arrayType, std::string& error,
+   RasterElement* pElement, std::vector<PixelLocation>& pixels, size_t startBand, size_t bandCount)
+{
+   if (pElement == NULL)
+   {
+      error = "No raster element provided";
+      return;
+   }
+
+   const RasterDataDescriptor* pDescriptor = dynamic_cast<const RasterDataDescriptor*>(pElement->getDataDescriptor());
+   if (pDescriptor == NULL)
+   {
+      error = "Unable to obtain the raster data descriptor.";
+      return;
+   }
+
+   if (bandCount == 0 || startBand + bandCount > pDescriptor->getBandCount())
+   {
+      error = "Invalid band range.";
+      return;
+   }
+
+   for (std::vector<PixelLocation>::const_iterator iter = pixels.begin(); iter != pixels.end(); ++iter)
+   {
+      if (iter->mRow >= pDescriptor->getRowCount() || iter->mColumn >= pDescriptor->getColumnCount() ||
+         iter->mIndex >= pixels.size())
+      {
+         error = "Pixel location is outside of the raster element.";
+         return;
+      }
+   }
+
+   if (pixels.empty())
+   {
+      return;
+   }
+
+   std::sort(pixels.begin(), pixels.end());
+   PixelsToMatlabTarget target(pArray, pElement, pDescriptor->getDataType(), pixels, startBand, bandCount);
+   if (switchOnRealEncoding(arrayType, target) == false)
+   {
+      error = "Unsupported data type.";
+      return;
+   }
+
+   error = target.getError();
+}
+
+namespace
+{
+   // Writes an array into part of a raster element without notifying its observers, so that a caller writing
+   // several parts can notify them once. Returns true if any data may have been written, even if error is set.
+   bool writeToOpticks(const void* pArray, EncodingType arrayType, std::string& error,
+      RasterElement* pElement, size_t startRow, size_t startColumn, size_t startBand,
+      size_t rowCount, size_t columnCount, size_t bandCount)
+   {
+      if (pArray == NULL)
+      {
+         error = "no source data.";
+         return false;
+      }
+
+      if (pElement == NULL)
+      {
+         error = "No raster element provided";
+         return false;
+      }
+
+      const RasterDataDescriptor* pDescriptor =
+         dynamic_cast<const RasterDataDescriptor*>(pElement->getDataDescriptor());
+      if (pDescriptor == NULL)
+      {
+         error = "Unable to obtain the raster data descriptor.";
+         return false;
+      }
+
+      // Compare against the space remaining after each start so that very large arrays cannot wrap the sums.
+      const size_t totalRows = pDescriptor->getRowCount();
+      const size_t totalColumns = pDescriptor->getColumnCount();
+      const size_t totalBands = pDescriptor->getBandCount();
+      if (rowCount == 0 || columnCount == 0 || bandCount == 0 ||
+         startRow >= totalRows || rowCount > totalRows - startRow ||
+         startColumn >= totalColumns || columnCount > totalColumns - startColumn ||
+         startBand >= totalBands || bandCount > totalBands - startBand)
+      {
+         error = "The array does not fit within the raster element.";
+         return false;
+      }
+
+      // The array is converted to the type of the element and written in the element's own interleave.
+      ArrayToOpticksSource source(pArray, pElement, pDescriptor->getDataType(), pDescriptor->getInterleaveFormat(),
+         startRow, startColumn, startBand, rowCount, columnCount, bandCount);
+      if (switchOnRealEncoding(arrayType, source) == false)
+      {
+         error = "Unsupported data type.";
+         return false;
+      }
+
+      error = source.getError();
+      return true;
+   }
+}
+
+void MatlabFunctions::arrayUpdateOpticks(const void* pArray, EncodingType arrayType, std::string& error,
+   RasterElement* pElement, size_t startRow, size_t startColumn, size_t startBand,
+   size_t rowCount, size_t columnCount, size_t bandCount)
+{
+   // Notify attached layers and views once, even if only part of the region was written.
+   if (writeToOpticks(pArray, arrayType, error, pElement, startRow, startColumn, startBand,
+      rowCount, columnCount, bandCount) == true)
+   {
+      pElement->updateData();
+   }
+}
+
+namespace
+{
+   // The largest block of a subcube which is converted to double precision at once while it is being processed.
+   const size_t sBlockBytes = 64 * 1024 * 1024;
+
+   // Copies a subcube to double precision one block of rows at a time, after its strides have been applied, and
+   // passes each block to visitor. Each block is a column-major pixels x bands matrix held in block, which is reused
+   // for every block. The visitor returns an error message, or an empty string to continue with the next block.
+   template<typename Visitor>
+   std::string visitSubcubeBlocks(RasterElement* pElement, const MatlabFunctions::Subcube& subcube,
+      Visitor& visitor, std::vector<double>& block)
+   {
+      const size_t columnCount = (subcube.mStopColumn - subcube.mStartColumn) / subcube.mColumnStride + 1;
+      const size_t bandCount = (subcube.mStopBand - subcube.mStartBand) / subcube.mBandStride + 1;
+      const size_t blockRows = std::max(sBlockBytes / (columnCount * bandCount * sizeof(double)),
+         static_cast<size_t>(1));
+
+      // Every block except the last starts on a row stride boundary so that averaging is unaffected by the split.
+      const size_t stopRow = subcube.mStopRow;
+      for (size_t row = subcube.mStartRow; row <= stopRow; row += blockRows * subcube.mRowStride)
+      {
+         MatlabFunctions::Subcube blockCube = subcube;
+         blockCube.mStartRow = static_cast<unsigned int>(row);
+         blockCube.mStopRow = static_cast<unsigned int>(std::min(stopRow, row + blockRows * subcube.mRowStride - 1));
+         const size_t pixelCount = ((blockCube.mStopRow - blockCube.mStartRow) / subcube.mRowStride + 1) *
+            columnCount;
+         block.resize(pixelCount * bandCount);
+
+         std::string error;
+         MatlabFunctions::arrayToMatlab(&block[0], FLT8BYTES, error, pElement, blockCube, 1.0);
+         if (error.empty() == false)
+         {
+            return error;
+         }
+
+         error = visitor(&block[0], pixelCount, bandCount);
+         if (error.empty() == false)
+         {
+            return error;
+         }
+      }
+
+      return std::string();
+   }
+
+   // Combines the statistics of two disjoint sets of values of the same band, ignoring any histograms.
+   void mergeStatistics(MatlabFunctions::BandStatistics& total, const MatlabFunctions::BandStatistics& part)
+   {
+      if (part.mCount == 0)
+      {
+         return;
+      }
+
+      if (total.mCount == 0)
+      {
+         total.mCount = part.mCount;
+         total.mMin = part.mMin;
+         total.mMax = part.mMax;
+         total.mMean = part.mMean;
+         total.mSumSquares = part.mSumSquares;
+         return;
+      }
+
+      const double count = static_cast<double>(total.mCount + part.mCount);
+      const double delta = part.mMean - total.mMean;
+      total.mMean += delta * part.mCount / count;
+      total.mSumSquares += part.mSumSquares + delta * delta * total.mCount * part.mCount / count;
+      total.mCount += part.mCount;
+      total.mMin = std::min(total.mMin, part.mMin);
+      total.mMax = std::max(total.mMax, part.mMax);
+   }
+
+   // Computes the statistics of a range of pixels and bands of a block. Each band's pixels are contiguous, so the
+   // loops run straight through memory and the compiler is able to vectorize them.
+   class BandMomentsWorker : public MatlabFunctions::TransferWorker
+   {
+   public:
+      BandMomentsWorker(const MatlabFunctions::TransferRange& range, const double* pBlock, size_t pixelCount,
+         MatlabFunctions::BandStatistics* pStatistics) :
+         TransferWorker(range),
+         mpBlock(pBlock),
+         mPixelCount(pixelCount),
+         mpStatistics(pStatistics)
+      {}
+
+      virtual void run()
+      {
+         for (size_t band = 0; band < mRange.mBandCount; ++band)
+         {
+            const double* pValues = mpBlock + (mRange.mFirstBand + band) * mPixelCount + mRange.mFirstRow;
+            size_t count = 0;
+            double sum = 0.0;
+            double minValue = std::numeric_limits<double>::infinity();
+            double maxValue = -std::numeric_limits<double>::infinity();
+            for (size_t i = 0; i < mRange.mRowCount; ++i)
+            {
+               const double value = pValues[i];
+               if (value == value)
+               {
+                  ++count;
+                  sum += value;
+                  minValue = std::min(minValue, value);
+                  maxValue = std::max(maxValue, value);
+               }
+            }
+
+            // Sum the squared deviations in a second pass over the cached values instead of summing squares,
+            // which loses precision when the mean is large compared to the spread.
+            const double mean = (count == 0 ? 0.0 : sum / count);
+            double sumSquares = 0.0;
+            for (size_t i = 0; i < mRange.mRowCount; ++i)
+            {
+               const double value = pValues[i];
+               if (value == value)
+               {
+                  sumSquares += (value - mean) * (value - mean);
+               }
+            }
+
+            MatlabFunctions::BandStatistics& statistics = mpStatistics[band];
+            statistics.mCount = count;
+            statistics.mMin = minValue;
+            statistics.mMax = maxValue;
+            statistics.mMean = mean;
+            statistics.mSumSquares = sumSquares;
+         }
+      }
+
+   private:
+      const double* mpBlock;
+      size_t mPixelCount;
+      MatlabFunctions::BandStatistics* mpStatistics;
+   };
+
+   // Adds a range of pixels and bands of a block to per-band histograms which span each band's minimum to maximum.
+   class BandHistogramWorker : public MatlabFunctions::TransferWorker
+   {
+   public:
+      BandHistogramWorker(const MatlabFunctions::TransferRange& range, const double* pBlock, size_t pixelCount,
+         const std::vector<MatlabFunctions::BandStatistics>& bounds, std::vector<double>* pHistograms) :
+         TransferWorker(range),
+         mpBlock(pBlock),
+         mPixelCount(pixelCount),
+         mBounds(bounds),
+         mpHistograms(pHistograms)
+      {}
+
+      virtual void run()
+      {
+         for (size_t band = 0; band < mRange.mBandCount; ++band)
+         {
+            const MatlabFunctions::BandStatistics& bounds = mBounds[mRange.mFirstBand + band];
+            std::vector<double>& histogram = mpHistograms[band];
+            const size_t binCount = histogram.size();
+            const double range = bounds.mMax - bounds.mMin;
+            const double binScale = (range > 0.0 && range < std::numeric_limits<double>::infinity() ?
+               binCount / range : 0.0);
+            const double* pValues = mpBlock + (mRange.mFirstBand + band) * mPixelCount + mRange.mFirstRow;
+            for (size_t i = 0; i < mRange.mRowCount; ++i)
+            {
+               const double value = pValues[i];
+               if (value == value)
+               {
+                  const double bin = (value - bounds.mMin) * binScale;
+                  histogram[bin < binCount ? static_cast<size_t>(bin) : binCount - 1] += 1.0;
+               }
+            }
+         }
+      }
+
+   private:
+      const double* mpBlock;
+      size_t mPixelCount;
+      const std::vector<MatlabFunctions::BandStatistics>& mBounds;
+      std::vector<double>* mpHistograms;
+   };
+
+   // Accumulates the moments of every band of each block of a subcube.
+   class BandMomentsVisitor
+   {
+   public:
+      BandMomentsVisitor(std::vector<MatlabFunctions::BandStatistics>& statistics) :
+         mStatistics(statistics)
+      {}
+
+      std::string operator()(const double* pBlock, size_t pixelCount, size_t bandCount)
+      {
+         std::vector<MatlabFunctions::TransferRange> ranges =
+            MatlabFunctions::getTransferRanges(pixelCount, bandCount, 1, true);
+         std::vector<std::vector<MatlabFunctions::BandStatistics> > parts(ranges.size());
+         std::vector<MatlabFunctions::TransferWorker*> workers;
+         for (size_t i = 0; i < ranges.size(); ++i)
+         {
+            parts[i].resize(ranges[i].mBandCount);
+            workers.push_back(new BandMomentsWorker(ranges[i], pBlock, pixelCount, &parts[i][0]));
+         }
+
+         std::string error = MatlabFunctions::runTransferWorkers(workers);
+         for (size_t i = 0; i < ranges.size(); ++i)
+         {
+            for (size_t band = 0; band < ranges[i].mBandCount; ++band)
+            {
+               mergeStatistics(mStatistics[ranges[i].mFirstBand + band], parts[i][band]);
+            }
+         }
+
+         return error;
+      }
+
+   private:
+      std::vector<MatlabFunctions::BandStatistics>& mStatistics;
+   };
+
+   // Accumulates the histogram of every band of each block of a subcube once the band bounds are known.
+   class BandHistogramVisitor
+   {
+   public:
+      BandHistogramVisitor(std::vector<MatlabFunctions::BandStatistics>& statistics) :
+         mStatistics(statistics)
+      {}
+
+      std::string operator()(const double* pBlock, size_t pixelCount, size_t bandCount)
+      {
+         const size_t binCount = mStatistics.front().mHistogram.size();
+         std::vector<MatlabFunctions::TransferRange> ranges =
+            MatlabFunctions::getTransferRanges(pixelCount, bandCount, 1, true);
+         std::vector<std::vector<std::vector<double> > > parts(ranges.size());
+         std::vector<MatlabFunctions::TransferWorker*> workers;
+         for (size_t i = 0; i < ranges.size(); ++i)
+         {
+            parts[i].resize(ranges[i].mBandCount, std::vector<double>(binCount, 0.0));
+            workers.push_back(new BandHistogramWorker(ranges[i], pBlock, pixelCount, mStatistics, &parts[i][0]));
+         }
+
+         std::string error = MatlabFunctions::runTransferWorkers(workers);
+         for (size_t i = 0; i < ranges.size(); ++i)
+         {
+            for (size_t band = 0; band < ranges[i].mBandCount; ++band)
+            {
+               std::vector<double>& histogram = mStatistics[ranges[i].mFirstBand + band].mHistogram;
+               for (size_t bin = 0; bin < binCount; ++bin)
+               {
+                  histogram[bin] += parts[i][band][bin];
+               }
+            }
+         }
+
+         return error;
+      }
+
+   private:
+      std::vector<MatlabFunctions::BandStatistics>& mStatistics;
+   };
+}
+
+void MatlabFunctions::bandStatistics(RasterElement* pElement, const Subcube& subcube, size_t binCount,
+   std::vector<BandStatistics>& statistics, std::string& error, TransferPool& pool)
+{
+   if (pElement == NULL)
+   {
+      error = "No raster element provided";
+      return;
+   }
+
+   if (subcube.mRowStride == 0 || subcube.mColumnStride == 0 || subcube.mBandStride == 0)
+   {
+      error = "Invalid stride.";
+      return;
+   }
+
+   BandStatistics empty;
+   empty.mCount = 0;
+   empty.mMin = 0.0;
+   empty.mMax = 0.0;
+   empty.mMean = 0.0;
+   empty.mSumSquares = 0.0;
+   statistics.assign((subcube.mStopBand - subcube.mStartBand) / subcube.mBandStride + 1, empty);
+
+   BandMomentsVisitor moments(statistics);
+   error = visitSubcubeBlocks(pElement, subcube, moments, pool.getBuffer(0));
+   if (error.empty() == false || binCount == 0)
+   {
+      return;
+   }
+
+   // The histogram bins depend on the range of each band, so they are counted in a second pass.
+   for (std::vector<BandStatistics>::iterator iter = statistics.begin(); iter != statistics.end(); ++iter)
+   {
+      iter->mHistogram.assign(binCount, 0.0);
+   }
+
+   BandHistogramVisitor histograms(statistics);
+   error = visitSubcubeBlocks(pElement, subcube, histograms, pool.getBuffer(0));
+}
+
+namespace
+{
+   // Copies the spectra of a list of pixels to double precision one block of pixels at a time and passes each
+   // block to visitor, in the same form as visitSubcubeBlocks.
+   template<typename Visitor>
+   std::string visitPixelBlocks(RasterElement* pElement, const std::vector<MatlabFunctions::PixelLocation>& pixels,
+      size_t startBand, size_t bandCount, Visitor& visitor, std::vector<double>& block)
+   {
+      std::vector<MatlabFunctions::PixelLocation> sortedPixels(pixels);
+      std::sort(sortedPixels.begin(), sortedPixels.end());
+
+      const size_t blockPixels = std::max(sBlockBytes / (bandCount * sizeof(double)), static_cast<size_t>(1));
+      std::vector<MatlabFunctions::PixelLocation> blockPixelList;
+      for (size_t first = 0; first < sortedPixels.size(); first += blockPixels)
+      {
+         const size_t pixelCount = std::min(blockPixels, sortedPixels.size() - first);
+         blockPixelList.assign(sortedPixels.begin() + first, sortedPixels.begin() + first + pixelCount);
+         for (size_t i = 0; i < pixelCount; ++i)
+         {
+            blockPixelList[i].mIndex = i;
+         }
+
+         block.resize(pixelCount * bandCount);
+         std::string error;
+         MatlabFunctions::pixelsToMatlab(&block[0], FLT8BYTES, error, pElement, blockPixelList, startBand,
+            bandCount);
+         if (error.empty() == false)
+         {
+            return error;
+         }
+
+         error = visitor(&block[0], pixelCount, bandCount);
+         if (error.empty() == false)
+         {
+            return error;
+         }
+      }
+
+      return std::string();
+   }
+
+   // Splits the columns of the upper triangle of a size x size matrix into contiguous ranges which hold about the
+   // same number of elements. Column j holds j + 1 elements, so the ranges become narrower towards the right.
+   std::vector<MatlabFunctions::TransferRange> getTriangleRanges(size_t size)
+   {
+      std::vector<MatlabFunctions::TransferRange> ranges;
+      const size_t threadCount = std::min(static_cast<size_t>(MatlabFunctions::getTransferThreadCount()), size);
+      size_t first = 0;
+      for (size_t thread = 1; thread <= threadCount; ++thread)
+      {
+         const size_t stop = (thread == threadCount ? size :
+            static_cast<size_t>(size * std::sqrt(static_cast<double>(thread) / threadCount)));
+         if (stop > first)
+         {
+            MatlabFunctions::TransferRange range;
+            range.mFirstRow = 0;
+            range.mRowCount = 1;
+            range.mFirstBand = first;
+            range.mBandCount = stop - first;
+            ranges.push_back(range);
+            first = stop;
+         }
+      }
+
+      return ranges;
+   }
+
+   // Computes the mean of each band in a range of a block and subtracts it from the band.
+   class CenterBandsWorker : public MatlabFunctions::TransferWorker
+   {
+   public:
+      CenterBandsWorker(const MatlabFunctions::TransferRange& range, double* pBlock, size_t pixelCount,
+         double* pMeans) :
+         TransferWorker(range),
+         mpBlock(pBlock),
+         mPixelCount(pixelCount),
+         mpMeans(pMeans)
+      {}
+
+      virtual void run()
+      {
+         for (size_t band = mRange.mFirstBand; band < mRange.mFirstBand + mRange.mBandCount; ++band)
+         {
+            double* pValues = mpBlock + band * mPixelCount;
+            double sum = 0.0;
+            for (size_t i = 0; i < mPixelCount; ++i)
+            {
+               sum += pValues[i];
+            }
+
+            const double mean = sum / mPixelCount;
+            for (size_t i = 0; i < mPixelCount; ++i)
+            {
+               pValues[i] -= mean;
+            }
+
+            mpMeans[band] = mean;
+         }
+      }
+
+   private:
+      double* mpBlock;
+      size_t mPixelCount;
+      double* mpMeans;
+   };
+
+   // Adds the products of every pair of centered bands of a block to a range of columns of the upper triangle of
+   // a co-moment matrix. The pixels are processed in short runs so that the bands of a run stay in cache while
+   // each of their products is summed.
+   class CoMomentWorker : public MatlabFunctions::TransferWorker
+   {
+   public:
+      CoMomentWorker(const MatlabFunctions::TransferRange& range, const double* pBlock, size_t pixelCount,
+         size_t bandCount, double* pCoMoment) :
+         TransferWorker(range),
+         mpBlock(pBlock),
+         mPixelCount(pixelCount),
+         mBandCount(bandCount),
+         mpCoMoment(pCoMoment)
+      {}
+
+      virtual void run()
+      {
+         const size_t runLength = 256;
+         const size_t columnEnd = mRange.mFirstBand + mRange.mBandCount;
+         for (size_t first = 0; first < mPixelCount; first += runLength)
+         {
+            const size_t count = std::min(runLength, mPixelCount - first);
+            for (size_t column = mRange.mFirstBand; column < columnEnd; ++column)
+            {
+               const double* pColumn = mpBlock + column * mPixelCount + first;
+               double* pCoMoment = mpCoMoment + column * mBandCount;
+               for (size_t row = 0; row <= column; ++row)
+               {
+                  const double* pRow = mpBlock + row * mPixelCount + first;
+                  double sum = 0.0;
+                  for (size_t i = 0; i < count; ++i)
+                  {
+                     sum += pRow[i] * pColumn[i];
+                  }
+
+                  pCoMoment[row] += sum;
+               }
+            }
+         }
+      }
+
+   private:
+      const double* mpBlock;
+      size_t mPixelCount;
+      size_t mBandCount;
+      double* mpCoMoment;
+   };
+
+   // Accumulates the band means and the upper triangle of the co-moment matrix of each block of data. Each block
+   // is centered on its own mean before its products are summed, and is then merged with the earlier blocks using
+   // the pairwise update of Chan et al., so large offsets in the data do not cost any precision.
+   class CovarianceVisitor
+   {
+   public:
+      CovarianceVisitor(size_t bandCount) :
+         mCount(0),
+         mMean(bandCount, 0.0),
+         mCoMoment(bandCount * bandCount, 0.0),
+         mBlockMean(bandCount, 0.0),
+         mBlockCoMoment(bandCount * bandCount, 0.0)
+      {}
+
+      std::string operator()(double* pBlock, size_t pixelCount, size_t bandCount)
+      {
+         std::vector<MatlabFunctions::TransferRange> ranges = MatlabFunctions::getTransferRanges(1, bandCount, 1, true);
+         std::vector<MatlabFunctions::TransferWorker*> workers;
+         for (std::vector<MatlabFunctions::TransferRange>::const_iterator iter = ranges.begin();
+            iter != ranges.end(); ++iter)
+         {
+            workers.push_back(new CenterBandsWorker(*iter, pBlock, pixelCount, &mBlockMean[0]));
+         }
+
+         std::string error = MatlabFunctions::runTransferWorkers(workers);
+         if (error.empty() == false)
+         {
+            return error;
+         }
+
+         std::fill(mBlockCoMoment.begin(), mBlockCoMoment.end(), 0.0);
+         ranges = getTriangleRanges(bandCount);
+         for (std::vector<MatlabFunctions::TransferRange>::const_iterator iter = ranges.begin();
+            iter != ranges.end(); ++iter)
+         {
+            workers.push_back(new CoMomentWorker(*iter, pBlock, pixelCount, bandCount, &mBlockCoMoment[0]));
+         }
+
+         error = MatlabFunctions::runTransferWorkers(workers);
+         if (error.empty() == false)
+         {
+            return error;
+         }
+
+         const double total = static_cast<double>(mCount + pixelCount);
+         const double weight = static_cast<double>(mCount) * pixelCount / total;
+         for (size_t column = 0; column < bandCount; ++column)
+         {
+            const double columnDelta = mBlockMean[column] - mMean[column];
+            for (size_t row = 0; row <= column; ++row)
+            {
+               mCoMoment[column * bandCount + row] += mBlockCoMoment[column * bandCount + row] +
+                  (mBlockMean[row] - mMean[row]) * columnDelta * weight;
+            }
+         }
+
+         for (size_t band = 0; band < bandCount; ++band)
+         {
+            mMean[band] += (mBlockMean[band] - mMean[band]) * pixelCount / total;
+         }
+
+         mCount += pixelCount;
+         return std::string();
+      }
+
+      size_t getCount() const
+      {
+         return mCount;
+      }
+
+      const std::vector<double>& getMean() const
+      {
+         return mMean;
+      }
+
+      const std::vector<double>& getCoMoment() const
+      {
+         return mCoMoment;
+      }
+
+   private:
+      size_t mCount;
+      std::vector<double> mMean;
+      std::vector<double> mCoMoment;
+      std::vector<double> mBlockMean;
+      std::vector<double> mBlockCoMoment;
+   };
+
+   // Orders eigenvalue indices by decreasing eigenvalue.
+   class EigenvalueGreater
+   {
+   public:
+      EigenvalueGreater(const std::vector<double>& eigenvalues) :
+         mEigenvalues(eigenvalues)
+      {}
+
+      bool operator()(size_t left, size_t right) const
+      {
+         return mEigenvalues[left] > mEigenvalues[right];
+      }
+
+   private:
+      const std::vector<double>& mEigenvalues;
+   };
+}
+
+void MatlabFunctions::bandCovariance(RasterElement* pElement, const Subcube& subcube,
+   const std::vector<PixelLocation>* pPixels, std::vector<double>& mean, std::vector<double>& covariance,
+   size_t& count, std::string& error, TransferPool& pool)
+{
+   count = 0;
+   if (pElement == NULL)
+   {
+      error = "No raster element provided";
+      return;
+   }
+
+   if (subcube.mRowStride == 0 || subcube.mColumnStride == 0 || subcube.mBandStride == 0 ||
+      (pPixels != NULL && subcube.mBandStride != 1))
+   {
+      error = "Invalid stride.";
+      return;
+   }
+
+   const size_t bandCount = (subcube.mStopBand - subcube.mStartBand) / subcube.mBandStride + 1;
+   CovarianceVisitor visitor(bandCount);
+   if (pPixels == NULL)
+   {
+      error = visitSubcubeBlocks(pElement, subcube, visitor, pool.getBuffer(0));
+   }
+   else
+   {
+      error = visitPixelBlocks(pElement, *pPixels, subcube.mStartBand, bandCount, visitor, pool.getBuffer(0));
+   }
+
+   if (error.empty() == false)
+   {
+      return;
+   }
+
+   count = visitor.getCount();
+   if (count < 2)
+   {
+      error = "At least two pixels are needed to compute a covariance.";
+      return;
+   }
+
+   mean = visitor.getMean();
+   const std::vector<double>& coMoment = visitor.getCoMoment();
+   covariance.resize(bandCount * bandCount);
+   for (size_t column = 0; column < bandCount; ++column)
+   {
+      for (size_t row = 0; row <= column; ++row)
+      {
+         const double value = coMoment[column * bandCount + row] / (count - 1);
+         covariance[column * bandCount + row] = value;
+         covariance[row * bandCount + column] = value;
+      }
+   }
+}
+
+void MatlabFunctions::symmetricEigen(const std::vector<double>& matrix, size_t size,
+   std::vector<double>& eigenvalues, std::vector<double>& eigenvectors)
+{
+   std::vector<double> a(matrix);
+   std::vector<double> v(size * size, 0.0);
+   for (size_t i = 0; i < size; ++i)
+   {
+      v[i * size + i] = 1.0;
+   }
+
+   double total = 0.0;
+   for (size_t i = 0; i < size * size; ++i)
+   {
+      total += a[i] * a[i];
+   }
+
+   // Each sweep applies a rotation to every off-diagonal element in turn, which converges quadratically once the
+   // off-diagonal elements are small. Stop once they are negligible compared to the whole matrix.
+   const double tolerance = std::numeric_limits<double>::epsilon() * std::numeric_limits<double>::epsilon() * total;
+   for (unsigned int sweep = 0; sweep < 100; ++sweep)
+   {
+      double offDiagonal = 0.0;
+      for (size_t q = 1; q < size; ++q)
+      {
+         for (size_t p = 0; p < q; ++p)
+         {
+            offDiagonal += a[q * size + p] * a[q * size + p];
+         }
+      }
+
+      if (offDiagonal <= tolerance)
+      {
+         break;
+      }
+
+      for (size_t p = 0; p + 1 < size; ++p)
+      {
+         for (size_t q = p + 1; q < size; ++q)
+         {
+            const double apq = a[q * size + p];
+            if (apq == 0.0)
+            {
+               continue;
+            }
+
+            // Choose the smaller rotation angle which zeroes a(p, q), computed so that it does not overflow.
+            const double theta = (a[q * size + q] - a[p * size + p]) / (2.0 * apq);
+            const double t = (std::fabs(theta) > 1.0e150 ? 0.5 / theta :
+               (theta < 0.0 ? -1.0 : 1.0) / (std::fabs(theta) + std::sqrt(theta * theta + 1.0)));
+            const double c = 1.0 / std::sqrt(t * t + 1.0);
+            const double s = t * c;
+
+            // Rotate columns p and q of a and v, and then rows p and q of a.
+            double* pColumnP = &a[p * size];
+            double* pColumnQ = &a[q * size];
+            double* pVectorP = &v[p * size];
+            double* pVectorQ = &v[q * size];
+            for (size_t k = 0; k < size; ++k)
+            {
+               const double akp = pColumnP[k];
+               const double akq = pColumnQ[k];
+               pColumnP[k] = c * akp - s * akq;
+               pColumnQ[k] = s * akp + c * akq;
+
+               const double vkp = pVectorP[k];
+               const double vkq = pVectorQ[k];
+               pVectorP[k] = c * vkp - s * vkq;
+               pVectorQ[k] = s * vkp + c * vkq;
+            }
+
+            for (size_t k = 0; k < size; ++k)
+            {
+               const double apk = a[k * size + p];
+               const double aqk = a[k * size + q];
+               a[k * size + p] = c * apk - s * aqk;
+               a[k * size + q] = s * apk + c * aqk;
+            }
+         }
+      }
+   }
+
+   std::vector<double> values(size);
+   std::vector<size_t> order(size);
+   for (size_t i = 0; i < size; ++i)
+   {
+      values[i] = a[i * size + i];
+      order[i] = i;
+   }
+
+   std::stable_sort(order.begin(), order.end(), EigenvalueGreater(values));
+   eigenvalues.resize(size);
+   eigenvectors.resize(size * size);
+   for (size_t i = 0; i < size; ++i)
+   {
+      eigenvalues[i] = values[order[i]];
+      std::copy(v.begin() + order[i] * size, v.begin() + (order[i] + 1) * size, eigenvectors.begin() + i * size);
+   }
+}
+
+namespace
+{
+   // Evaluates a band math expression over a range of pixels of a block, using its own scratch space.
+   class BandMathWorker : public MatlabFunctions::TransferWorker
+   {
+   public:
+      BandMathWorker(const MatlabFunctions::TransferRange& range, const BandMathExpression& expression,
+         const std::vector<const double*>& bands, double* pResult) :
+         TransferWorker(range),
+         mExpression(expression),
+         mBands(bands),
+         mpResult(pResult)
+      {}
+
+      virtual void run()
+      {
+         std::vector<const double*> bands(mBands.size());
+         for (size_t i = 0; i < mBands.size(); ++i)
+         {
+            bands[i] = mBands[i] + mRange.mFirstRow;
+         }
+
+         std::vector<double> scratch;
+         mExpression.evaluate(bands.empty() ? NULL : &bands[0], mRange.mRowCount, mpResult + mRange.mFirstRow,
+            scratch);
+      }
+
+   private:
+      const BandMathExpression& mExpression;
+      const std::vector<const double*>& mBands;
+      double* mpResult;
+   };
+}
+
+void MatlabFunctions::bandMath(RasterElement* pSource, const BandMathExpression& expression,
+   RasterElement* pDestination, size_t destinationBand, std::string& error, TransferPool& pool)
+{
+   if (pSource == NULL || pDestination == NULL)
+   {
+      error = "No raster element provided";
+      return;
+   }
+
+   const RasterDataDescriptor* pSourceDescriptor =
+      dynamic_cast<const RasterDataDescriptor*>(pSource->getDataDescriptor());
+   const RasterDataDescriptor* pDestinationDescriptor =
+      dynamic_cast<const RasterDataDescriptor*>(pDestination->getDataDescriptor());
+   if (pSourceDescriptor == NULL || pDestinationDescriptor == NULL)
+   {
+      error = "Unable to obtain the raster data descriptor.";
+      return;
+   }
+
+   const size_t rowCount = pSourceDescriptor->getRowCount();
+   const size_t columnCount = pSourceDescriptor->getColumnCount();
+   if (pDestinationDescriptor->getRowCount() != rowCount || pDestinationDescriptor->getColumnCount() != columnCount)
+   {
+      error = "The output raster element must have the same number of rows and columns as the input.";
+      return;
+   }
+
+   if (destinationBand >= pDestinationDescriptor->getBandCount())
+   {
+      error = "The output band is outside of the output raster element.";
+      return;
+   }
+
+   const std::vector<unsigned int>& bandNumbers = expression.getBands();
+   for (std::vector<unsigned int>::const_iterator iter = bandNumbers.begin(); iter != bandNumbers.end(); ++iter)
+   {
+      if (*iter >= pSourceDescriptor->getBandCount())
+      {
+         error = "The expression uses a band which is not in the raster element.";
+         return;
+      }
+   }
+
+   // Each block of rows is read one referenced band at a time, evaluated by the transfer threads, and written to
+   // the output band, so only the bands which the expression uses are ever read. Only the results are converted
+   // to the output type, so intermediate values keep full precision. Each band uses its own pooled buffer, and the
+   // results use the one after the last band.
+   const size_t blockRows = std::max(sBlockBytes / (columnCount * (bandNumbers.size() + 1) * sizeof(double)),
+      static_cast<size_t>(1));
+   std::vector<const double*> bands(bandNumbers.size());
+   std::vector<double>& result = pool.getBuffer(bandNumbers.size());
+   bool updated = false;
+   for (size_t row = 0; row < rowCount; row += blockRows)
+   {
+      const size_t count = std::min(blockRows, rowCount - row);
+      const size_t pixelCount = count * columnCount;
+      for (size_t i = 0; i < bandNumbers.size(); ++i)
+      {
+         Subcube subcube = { 0, static_cast<unsigned int>(columnCount - 1), static_cast<unsigned int>(row),
+            static_cast<unsigned int>(row + count - 1), bandNumbers[i], bandNumbers[i], 1, 1, 1, false };
+         std::vector<double>& block = pool.getBuffer(i);
+         block.resize(pixelCount);
+         arrayToMatlab(&block[0], FLT8BYTES, error, pSource, subcube, 1.0);
+         if (error.empty() == false)
+         {
+            break;
+         }
+
+         bands[i] = &block[0];
+      }
+
+      if (error.empty() == false)
+      {
+         break;
+      }
+
+      result.resize(pixelCount);
+      std::vector<TransferRange> ranges = getTransferRanges(pixelCount, 1, 1, false);
+      std::vector<TransferWorker*> workers;
+      for (std::vector<TransferRange>::const_iterator iter = ranges.begin(); iter != ranges.end(); ++iter)
+      {
+         workers.push_back(new BandMathWorker(*iter, expression, bands, &result[0]));
+      }
+
+      error = runTransferWorkers(workers);
+      if (error.empty() == false)
+      {
+         break;
+      }
+
+      // Every block is written before attached layers and views are notified, so they only update once.
+      const bool written = writeToOpticks(&result[0], FLT8BYTES, error, pDestination, row, 0, destinationBand,
+         count, columnCount, 1);
+      updated = updated || written;
+      if (error.empty() == false)
+      {
+         break;
+      }
+   }
+
+   if (updated == true)
+   {
+      pDestination->updateData();
+   }
+}
@@ -1,324 +1,905 @@
-/*
- * The information in this file is
- * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
- * and is subject to the terms and conditions of the
- * GNU Lesser General Public License Version 2.1
- * The license text is available from   
- * http://www.gnu.org/licenses/lgpl.html
- */
-
-#ifndef MATLABFUNCTIONS_H
-#define MATLABFUNCTIONS_H
-
-#include "DataAccessor.h"
-#include "DataAccessorImpl.h"
-#include "DataRequest.h"
-#include "DesktopServices.h"
-#include "ObjectResource.h"
-#include "RasterDataDescriptor.h"
-#include "RasterElement.h"
-#include "RasterLayer.h"
-#include "RasterUtilities.h"
-#include "SpatialDataView.h"
-#include "SpatialDataWindow.h"
-#include "StringUtilities.h"
-#include "TypesFile.h"
-#include "Undo.h"
-#include "Units.h"
-
-#include <matrix.h>
-
-#include <string>
-#include <vector>
-
-class DataElement;
-class Layer;
-class WizardObject;
-
-// Largely copied from the existing IdlFunctions namespace.
-namespace MatlabFunctions
-{
-   static std::vector<WizardObject*> spWizards;
-   std::string toMatlabString(const std::string& value);
-   std::string toMatlabString(const std::vector<std::string>& values);
-   DataElement* getDataset(const std::string& name);
-   Layer* getLayerByRaster(RasterElement* pParentElement);
-   SpatialDataWindow* getWindowByRaster(RasterElement* pRasterElement);
-   SpatialDataView* getViewByWindowName(const std::string& windowName);
-   Layer* getLayerByName(const std::string& windowName,
-      const std::string& layerName, bool onlyRasterLayers = true);
-   Layer* getLayerByIndex(const std::string& windowName, int index);
-   RasterChannelType getChannelByName(const std::string& channelName);
-   DisplayMode getDisplayModeByName(const std::string& name);
-   StretchType getStretchTypeByName(const std::string& name);
-   RegionUnits getRegionUnitsByName(const std::string& name);
-   AnimationCycle getAnimationCycleByName(const std::string& name);
-   AnimationState getAnimationStateByName(const std::string& name);
-   WindowType getWindowTypeByName(const std::string& name);
-   InterleaveFormatType getInterleaveByName(const std::string& name);
-   WizardObject* getWizardObject(const std::string& wizardName);
-   DataVariant getWizardObjectValue(const WizardObject* pObject, const std::string& name);
-   bool clearWizardObject(const std::string& wizardName);
-   bool setWizardObjectValue(WizardObject* pObject, const std::string& name, const DataVariant& value);
-
-   template<typename T>
-   void arrayToOpticks(T* pArray, std::string& error, const std::string& name,
-      unsigned int columnCount, unsigned int rowCount, unsigned int bandCount, const std::string& unit,
-      EncodingType type, InterleaveFormatType interleave, bool inMemory, const std::string& filename,
-      bool displayResults, bool newWindow)
-   {
-      if (pArray == NULL)
-      {
-         error = "no source data.";
-         return;
-      }
-
-      // Get the specified view and sensor data.
-      RasterElement* pParentElement = NULL;
-      if (filename.empty() == false)
-      {
-         pParentElement = dynamic_cast<RasterElement*>(getDataset(filename));
-      }
-
-      //it doesn't exist, so we can make a new one
-      ModelResource<RasterElement> pNewElement(RasterUtilities::createRasterElement(name,
-         rowCount, columnCount, bandCount, type, interleave, inMemory, pParentElement));
-      if (pNewElement.get() == NULL)
-      {
-         error = "Unable to create new raster element.";
-         return;
-      }
-
-      RasterDataDescriptor* pDescriptor = dynamic_cast<RasterDataDescriptor*>(pNewElement->getDataDescriptor());
-      if (pDescriptor == NULL)
-      {
-         error = "Unable to obtain the raster data descriptor.";
-         return;
-      }
-
-      if (interleave == BSQ)
-      {
-         for (unsigned int band = 0; band < bandCount; ++band)
-         {
-            FactoryResource<DataRequest> pRequest;
-            pRequest->setWritable(true);
-            pRequest->setInterleaveFormat(BSQ);
-            pRequest->setRows(pDescriptor->getActiveRow(0), pDescriptor->getActiveRow(rowCount - 1), 1);
-            pRequest->setColumns(pDescriptor->getActiveColumn(0), pDescriptor->getActiveColumn(columnCount - 1));
-            pRequest->setBands(pDescriptor->getActiveBand(band), pDescriptor->getActiveBand(band), 1);
-            DataAccessor daImage = pNewElement->getDataAccessor(pRequest.release());
-
-            for (unsigned int row = 0; row < rowCount; ++row)
-            {
-               if (!daImage.isValid())
-               {
-                  error = "Unable to access the raster data.";
-                  return;
-               }
-
-               T* pPixel = reinterpret_cast<T*>(daImage->getRow());
-               for (unsigned int column = 0; column < columnCount; ++column)
-               {
-                  // Transpose the data during the copy.
-                  unsigned int dataOffset = columnCount * rowCount * band + column * rowCount + row;
-                  pPixel[column] = pArray[dataOffset];
-               }
-
-               daImage->nextRow();
-            }
-         }
-      }
-      else if (interleave == BIL)
-      {
-         FactoryResource<DataRequest> pRequest;
-         pRequest->setWritable(true);
-         pRequest->setInterleaveFormat(BIL);
-         pRequest->setRows(pDescriptor->getActiveRow(0), pDescriptor->getActiveRow(rowCount - 1), 1);
-         pRequest->setColumns(pDescriptor->getActiveColumn(0), pDescriptor->getActiveColumn(columnCount - 1));
-         pRequest->setBands(pDescriptor->getActiveBand(0), pDescriptor->getActiveBand(bandCount - 1));
-         DataAccessor daImage = pNewElement->getDataAccessor(pRequest.release());
-
-         for (unsigned int row = 0; row < rowCount; ++row)
-         {
-            if (!daImage.isValid())
-            {
-               error = "Unable to access the raster data.";
-               return;
-            }
-
-            T* pPixel = reinterpret_cast<T*>(daImage->getRow());
-            for (unsigned int band = 0; band < bandCount; ++band)
-            {
-               for (unsigned int column = 0; column < columnCount; ++column)
-               {
-                  // Transpose the data during the copy.
-                  unsigned int dataOffset = columnCount * rowCount * band + column * rowCount + row;
-                  pPixel[column + band * columnCount] = pArray[dataOffset];
-               }
-            }
-
-            daImage->nextRow();
-         }
-      }
-      else if (interleave == BIP)
-      {
-         FactoryResource<DataRequest> pRequest;
-         pRequest->setWritable(true);
-         pRequest->setInterleaveFormat(BIP);
-         pRequest->setRows(pDescriptor->getActiveRow(0), pDescriptor->getActiveRow(rowCount - 1), 1);
-         pRequest->setColumns(pDescriptor->getActiveColumn(0), pDescriptor->getActiveColumn(columnCount - 1));
-         pRequest->setBands(pDescriptor->getActiveBand(0), pDescriptor->getActiveBand(bandCount - 1));
-         DataAccessor daImage = pNewElement->getDataAccessor(pRequest.release());
-
-         for (unsigned int row = 0; row < rowCount; ++row)
-         {
-            if (!daImage.isValid())
-            {
-               error = "Unable to access the raster data.";
-               return;
-            }
-
-            T* pPixel = reinterpret_cast<T*>(daImage->getRow());
-            for (unsigned int column = 0; column < columnCount; ++column)
-            {
-               for (unsigned int band = 0; band < bandCount; ++band)
-               {
-                  // Transpose the data during the copy.
-                  unsigned int dataOffset = columnCount * rowCount * band + column * rowCount + row;
-                  pPixel[band + column * bandCount] = pArray[dataOffset];
-               }
-            }
-
-            daImage->nextRow();
-         }
-      }
-      else
-      {
-         error = "Unrecognized interleave.";
-         return;
-      }
-
-      if (unit.empty() == false)
-      {
-         Units* pScale = pDescriptor->getUnits();
-         if (pScale != NULL)
-         {
-            bool bError = false;
-            UnitType uType = StringUtilities::fromDisplayString<UnitType>(unit, &bError);
-            if (bError)
-            {
-               pScale->setUnitType(CUSTOM_UNIT);
-            }
-            else
-            {
-               pScale->setUnitType(uType);
-            }
-            pScale->setUnitName(unit);
-            pDescriptor->setUnits(pScale);
-         }
-      }
-
-      if (displayResults == true)
-      {
-         //the matrix is now created, so we should add it to the current view or create a new one
-         //note that this will create a window when newWindow is false if there is no current window
-         SpatialDataView* pView = NULL;
-         if (newWindow == false)
-         {
-            WorkspaceWindow* pData = Service<DesktopServices>()->getCurrentWorkspaceWindow();
-            if (pData != NULL)
-            {
-               pView = dynamic_cast<SpatialDataView*>(pData->getView());
-            }
-         }
-
-         if (pView != NULL)
-         {
-            UndoLock undo(pView);
-            pView->createLayer(RASTER, pNewElement.get(), name);
-         }
-         else
-         {
-            SpatialDataWindow* pWindow = static_cast<SpatialDataWindow*>(
-               Service<DesktopServices>()->createWindow(name, SPATIAL_DATA_WINDOW));
-
-            if (pWindow == NULL)
-            {
-               error = "Unable to create the window.";
-               return;
-            }
-
-            SpatialDataView* pView = pWindow->getSpatialDataView();
-            if (pView == NULL)
-            {
-               error = "Unable to create the view.";
-               return;
-            }
-
-            UndoLock undo(pView);
-            if (pView->setPrimaryRasterElement(pNewElement.get()) == false)
-            {
-               error = "Unable to set the primary raster element into the view";
-               return;
-            }
-
-            RasterLayer* pLayer = static_cast<RasterLayer*>(pView->createLayer(RASTER, pNewElement.get()));
-            if (pLayer == NULL)
-            {
-               error = "Unable to create the layer";
-               return;
-            }
-         }
-      }
-
-      pNewElement.release();
-   }
-
-   template<typename T>
-   void arrayToMatlab(T* pArray, std::string& error, RasterElement* pParentElement,
-      unsigned int heightStart, unsigned int heightEnd,
-      unsigned int widthStart, unsigned int widthEnd, unsigned int bandStart, unsigned int bandEnd)
-   {
-      unsigned int rowCount = heightEnd - heightStart + 1;
-      unsigned int columnCount = widthEnd - widthStart + 1;
-      unsigned int bandCount = bandEnd - bandStart + 1;
-
-      if (pParentElement == NULL)
-      {
-         error = "No raster element provided";
-         return;
-      }
-
-      RasterDataDescriptor* pDescriptor = dynamic_cast<RasterDataDescriptor*>(pParentElement->getDataDescriptor());
-      for (unsigned int band = bandStart; band <= bandEnd; ++band)
-      {
-         FactoryResource<DataRequest> pRequest;
-         pRequest->setInterleaveFormat(BSQ);
-         pRequest->setRows(pDescriptor->getActiveRow(heightStart), pDescriptor->getActiveRow(heightEnd), 1);
-         pRequest->setColumns(pDescriptor->getActiveColumn(widthStart), pDescriptor->getActiveColumn(widthEnd));
-         pRequest->setBands(pDescriptor->getActiveBand(band), pDescriptor->getActiveBand(band), 1);
-         DataAccessor daImage = pParentElement->getDataAccessor(pRequest.release());
-
-         for (unsigned int row = 0; row < rowCount; ++row)
-         {
-            if (!daImage.isValid())
-            {
-               error = "error copying array values to MATLAB.";
-               return;
-            }
-
-            T* pPixel = reinterpret_cast<T*>(daImage->getRow());
-            for (unsigned int column = 0; column < columnCount; ++column)
-            {
-               // Transpose the data during the copy.
-               unsigned int dataOffset = columnCount * rowCount * (band - bandStart) + column * rowCount + row;
-               pArray[dataOffset] = pPixel[column];
-            }
-
-            daImage->nextRow();
-         }
-      }
-   }
-};
-
-#endif
+/*
+ * The information in this file is
+ * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
+ * and is subject to the terms and conditions of the
+ * GNU Lesser General Public License Version 2.1
+ * The license text is available from   
+ * http://www.gnu.org/licenses/lgpl.html
+ */
+
+#ifndef MATLABFUNCTIONS_H
+#define MATLABFUNCTIONS_H
+
+#include "ArrayTransfer.h"
+#include "DataAccessor.h"
+#include "DataAccessorImpl.h"
+#include "DataRequest.h"
+#include "DesktopServices.h"
+#include "ObjectResource.h"
+#include "RasterDataDescriptor.h"
+#include "RasterElement.h"
+#include "RasterLayer.h"
+#include "RasterUtilities.h"
+#include "SpatialDataView.h"
+#include "SpatialDataWindow.h"
+#include "StringUtilities.h"
+#include "TypesFile.h"
+#include "Undo.h"
+#include "Units.h"
+
+#include <matrix.h>
+
+#include <QtCore/QRunnable>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+class BandMathExpression;
+class DataElement;
+class Layer;
+class MatlabInterpreter;
+class TransferPool;
+class WizardObject;
+
+// Largely copied from the existing IdlFunctions namespace.
+namespace MatlabFunctions
+{
+   static std::vector<WizardObject*> spWizards;
+   std::string toMatlabString(const std::string& value);
+
+   // Creates a char matrix with one row for each value, padded with blanks as MATLAB's char function does.
+   mxArray* toMatlabArray(const std::vector<std::string>& values);
+
+   // Assigns the results of an internal command to MATLAB variables and destroys the arrays. The returned command
+   // displays the variables, and is empty if the current command ends with a semicolon or an error occurred.
+   std::string setResults(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& names,
+      const std::vector<mxArray*>& values, std::string& output, bool& outputIsError);
+   std::string setResult(MatlabInterpreter& matlabInterpreter, const std::string& name, mxArray* pValue,
+      std::string& output, bool& outputIsError);
+   DataElement* getDataset(const std::string& name);
+   Layer* getLayerByRaster(RasterElement* pParentElement);
+   SpatialDataWindow* getWindowByRaster(RasterElement* pRasterElement);
+   SpatialDataView* getViewByWindowName(const std::string& windowName);
+   Layer* getLayerByName(const std::string& windowName,
+      const std::string& layerName, bool onlyRasterLayers = true);
+   Layer* getLayerByIndex(const std::string& windowName, int index);
+   RasterChannelType getChannelByName(const std::string& channelName);
+   DisplayMode getDisplayModeByName(const std::string& name);
+   StretchType getStretchTypeByName(const std::string& name);
+   RegionUnits getRegionUnitsByName(const std::string& name);
+   AnimationCycle getAnimationCycleByName(const std::string& name);
+   AnimationState getAnimationStateByName(const std::string& name);
+   WindowType getWindowTypeByName(const std::string& name);
+   InterleaveFormatType getInterleaveByName(const std::string& name);
+   WizardObject* getWizardObject(const std::string& wizardName);
+   DataVariant getWizardObjectValue(const WizardObject* pObject, const std::string& name);
+   bool clearWizardObject(const std::string& wizardName);
+   bool setWizardObjectValue(WizardObject* pObject, const std::string& name, const DataVariant& value);
+
+   // A portion of a transfer which is copied by a single worker.
+   // Rows and bands are relative to the start of the subcube being transferred.
+   struct TransferRange
+   {
+      size_t mFirstRow;
+      size_t mRowCount;
+      size_t mFirstBand;
+      size_t mBandCount;
+   };
+
+   // Zero-based, inclusive bounds of the portion of a raster element to copy, along with the spacing
+   // of the rows, columns, and bands which are copied from within those bounds.
+   struct Subcube
+   {
+      unsigned int mStartColumn;
+      unsigned int mStopColumn;
+      unsigned int mStartRow;
+      unsigned int mStopRow;
+      unsigned int mStartBand;
+      unsigned int mStopBand;
+      unsigned int mRowStride;
+      unsigned int mColumnStride;
+      unsigned int mBandStride;
+      bool mAverage;
+   };
+
+   // A pixel whose spectrum is copied into row mIndex of an N x bands MATLAB array. Rows and columns are the
+   // zero-based active row and column of the pixel within its raster element.
+   struct PixelLocation
+   {
+      unsigned int mRow;
+      unsigned int mColumn;
+      size_t mIndex;
+
+      // Orders pixels by row and then by column, which is the order they are stored in every interleave.
+      bool operator<(const PixelLocation& other) const
+      {
+         return mRow < other.mRow || (mRow == other.mRow && mColumn < other.mColumn);
+      }
+   };
+
+   // Statistics of the finite and infinite values of a single band. NaN values are skipped. mSumSquares is the sum
+   // of the squared deviations from mMean, which is merged between blocks without losing precision. mHistogram
+   // holds the number of values in each of a set of equally sized bins which span mMin to mMax.
+   struct BandStatistics
+   {
+      size_t mCount;
+      double mMin;
+      double mMax;
+      double mMean;
+      double mSumSquares;
+      std::vector<double> mHistogram;
+   };
+
+   unsigned int getTransferThreadCount();
+   std::vector<TransferRange> getTransferRanges(size_t rowCount, size_t bandCount,
+      size_t blockSize, bool splitBands);
+
+   // Base class for workers which copy a single TransferRange with their own DataAccessor.
+   class TransferWorker : public QRunnable
+   {
+   public:
+      TransferWorker(const TransferRange& range) :
+         mRange(range)
+      {
+         setAutoDelete(false);
+      }
+
+      virtual ~TransferWorker()
+      {}
+
+      const std::string& getError() const
+      {
+         return mError;
+      }
+
+   protected:
+      TransferRange mRange;
+      std::string mError;
+   };
+
+   // Runs and then deletes all workers, returning the first error which was reported.
+   std::string runTransferWorkers(std::vector<TransferWorker*>& workers);
+
+   // Sets the inclusive, zero-based on-disk rows, columns, and bands of a request. Opticks addresses each
+   // dimension with 32 bits, so only offsets which span several dimensions need to be computed as size_t.
+   void setRequestBounds(DataRequest* pRequest, const RasterDataDescriptor* pDescriptor, size_t startRow,
+      size_t stopRow, size_t concurrentRows, size_t startColumn, size_t stopColumn, size_t startBand,
+      size_t stopBand);
+
+   // Creates a raster element of the given type from a column-major MATLAB array whose elements are of arrayType.
+   void arrayToOpticks(const void* pArray, EncodingType arrayType, std::string& error, const std::string& name,
+      unsigned int columnCount, unsigned int rowCount, unsigned int bandCount, const std::string& unit,
+      EncodingType type, InterleaveFormatType interleave, bool inMemory, const std::string& filename,
+      bool displayResults, bool newWindow);
+
+   // Adds a raster element to the current view, or to a new window if newWindow is true or there is no current view.
+   void displayRasterElement(RasterElement* pElement, const std::string& name, bool newWindow, std::string& error);
+
+   // Writes a column-major MATLAB array whose elements are of arrayType into an existing raster element, starting
+   // at the given zero-based row, column, and band. The array is converted to the element's type and the element
+   // emits a single data modified notification once the whole region has been written.
+   void arrayUpdateOpticks(const void* pArray, EncodingType arrayType, std::string& error, RasterElement* pElement,
+      size_t startRow, size_t startColumn, size_t startBand, size_t rowCount, size_t columnCount, size_t bandCount);
+
+   // Copies a subcube into a MATLAB array whose elements are of arrayType, multiplying each element by scale.
+   // The array must already be sized for the subcube after its strides have been applied.
+   void arrayToMatlab(void* pArray, EncodingType arrayType, std::string& error, RasterElement* pParentElement,
+      const Subcube& subcube, double scale);
+
+   // Copies the spectra of a list of pixels into an N x bandCount column-major MATLAB array whose elements are of
+   // arrayType, where N is the number of pixels. The pixels are sorted by row and column so that the element is
+   // read in a single pass, and each spectrum is written to the row of the array given by its mIndex.
+   void pixelsToMatlab(void* pArray, EncodingType arrayType, std::string& error, RasterElement* pElement,
+      std::vector<PixelLocation>& pixels, size_t startBand, size_t bandCount);
+
+   // Computes the statistics of each band of a subcube after its strides have been applied, along with a histogram
+   // of binCount bins when binCount is not zero. The subcube is read one block of rows at a time, so the whole
+   // subcube is never held in memory, and each block is processed by the transfer threads. The blocks are held in
+   // buffers from pool.
+   void bandStatistics(RasterElement* pElement, const Subcube& subcube, size_t binCount,
+      std::vector<BandStatistics>& statistics, std::string& error, TransferPool& pool);
+
+   // Computes the mean of each band and the bands x bands column-major covariance matrix, normalized by count - 1,
+   // of a subcube after its strides have been applied. If pPixels is not NULL, only those pixels are used and the
+   // rows, columns, and strides of the subcube are ignored. count is set to the number of pixels which were used.
+   // The data is read one block at a time into a buffer from pool, and each block is processed by the transfer
+   // threads.
+   void bandCovariance(RasterElement* pElement, const Subcube& subcube, const std::vector<PixelLocation>* pPixels,
+      std::vector<double>& mean, std::vector<double>& covariance, size_t& count, std::string& error,
+      TransferPool& pool);
+
+   // Evaluates a band math expression for every pixel of pSource and writes the results to one band of
+   // pDestination, which must have the same number of rows and columns. The data is processed one block of rows at
+   // a time, using buffers from pool, and the destination is notified of the change once, after every block has
+   // been written. It is also notified if an error stops the evaluation after some blocks were written.
+   void bandMath(RasterElement* pSource, const BandMathExpression& expression, RasterElement* pDestination,
+      size_t destinationBand, std::string& error, TransferPool& pool);
+
+   // Computes the eigenvalues and eigenvectors of a size x size column-major symmetric matrix with the cyclic
+   // Jacobi method. The eigenvalues are sorted in decreasing order and column i of eigenvectors is the unit vector
+   // for eigenvalue i.
+   void symmetricEigen(const std::vector<double>& matrix, size_t size, std::vector<double>& eigenvalues,
+      std::vector<double>& eigenvectors);
+
+   // Copies a column-major MATLAB array of type S into a raster element of type D, starting at the given row,
+   // column, and band of the element. Elements which are entirely in memory are written directly through pRawData.
+   template<typename S, typename D>
+   class ArrayToOpticksWorker : public TransferWorker
+   {
+   public:
+      ArrayToOpticksWorker(const TransferRange& range, const S* pArray, RasterElement* pElement, D* pRawData,
+         InterleaveFormatType interleave, size_t heightStart, size_t widthStart, size_t bandStart,
+         size_t rowCount, size_t columnCount, size_t bandCount) :
+         TransferWorker(range),
+         mpArray(pArray),
+         mpElement(pElement),
+         mpRawData(pRawData),
+         mInterleave(interleave),
+         mHeightStart(heightStart),
+         mWidthStart(widthStart),
+         mBandStart(bandStart),
+         mRowCount(rowCount),
+         mColumnCount(columnCount),
+         mBandCount(bandCount)
+      {}
+
+      virtual void run()
+      {
+         const RasterDataDescriptor* pDescriptor =
+            dynamic_cast<const RasterDataDescriptor*>(mpElement->getDataDescriptor());
+         if (pDescriptor == NULL)
+         {
+            mError = "Unable to obtain the raster data descriptor.";
+            return;
+         }
+
+         if (mInterleave != BSQ && mInterleave != BIL && mInterleave != BIP)
+         {
+            mError = "Unrecognized interleave.";
+            return;
+         }
+
+         if (mpRawData != NULL)
+         {
+            copyRawData(pDescriptor);
+            return;
+         }
+
+         // Write one tile worth of rows at a time so that each block can be filled from a single pointer.
+         // BSQ bands are written one at a time, while BIL and BIP rows hold every band of the element.
+         const size_t blockSize = ArrayTransfer::TileTraits<S, D>::Edge;
+         const size_t rowEnd = mRange.mFirstRow + mRange.mRowCount;
+         const size_t totalBands = pDescriptor->getBandCount();
+         const size_t bandEnd = (mInterleave == BSQ ? mRange.mFirstBand + mRange.mBandCount : 1);
+         for (size_t band = (mInterleave == BSQ ? mRange.mFirstBand : 0); band < bandEnd; ++band)
+         {
+            FactoryResource<DataRequest> pRequest;
+            pRequest->setWritable(true);
+            pRequest->setInterleaveFormat(mInterleave);
+            setRequestBounds(pRequest.get(), pDescriptor, mHeightStart + mRange.mFirstRow, mHeightStart + rowEnd - 1,
+               blockSize, mWidthStart, mWidthStart + mColumnCount - 1, (mInterleave == BSQ ? mBandStart + band : 0),
+               (mInterleave == BSQ ? mBandStart + band : totalBands - 1));
+
+            // Within each BIL row the bands are one request row of columns apart, and within each BIP row the
+            // pixels are one spectrum apart.
+            const size_t bandOffset = (mInterleave == BIL ? mBandStart * mColumnCount : mBandStart);
+            const size_t stride = (mInterleave == BIL ? mColumnCount : totalBands);
+            DataAccessor daImage = mpElement->getDataAccessor(pRequest.release());
+            for (size_t row = mRange.mFirstRow; row < rowEnd; row += blockSize)
+            {
+               if (!daImage.isValid())
+               {
+                  mError = "Unable to access the raster data.";
+                  return;
+               }
+
+               // Transpose and interleave the data during the copy.
+               const size_t blockRows = std::min(blockSize, rowEnd - row);
+               D* pRows = reinterpret_cast<D*>(daImage->getRow());
+               copyBlock(mInterleave == BSQ ? pRows : pRows + bandOffset, daImage->getRowSize() / sizeof(D), stride,
+                  row, blockRows, band);
+
+               daImage->nextRow(blockRows);
+            }
+         }
+      }
+
+   private:
+      // Copies the rows of this worker's range straight into the raw data of an element which is entirely in memory.
+      void copyRawData(const RasterDataDescriptor* pDescriptor)
+      {
+         const size_t totalRows = pDescriptor->getRowCount();
+         const size_t totalColumns = pDescriptor->getColumnCount();
+         const size_t totalBands = pDescriptor->getBandCount();
+         const size_t blockSize = ArrayTransfer::TileTraits<S, D>::Edge;
+         const size_t rowEnd = mRange.mFirstRow + mRange.mRowCount;
+         if (mInterleave == BSQ)
+         {
+            for (size_t band = mRange.mFirstBand; band < mRange.mFirstBand + mRange.mBandCount; ++band)
+            {
+               D* pBand = mpRawData + (mBandStart + band) * totalRows * totalColumns + mWidthStart;
+               for (size_t row = mRange.mFirstRow; row < rowEnd; row += blockSize)
+               {
+                  copyBlock(pBand + (mHeightStart + row) * totalColumns, totalColumns, 0, row,
+                     std::min(blockSize, rowEnd - row), band);
+               }
+            }
+
+            return;
+         }
+
+         // BIL rows start with the first column of band zero, while BIP rows start with band zero of the first column.
+         const size_t rowStride = totalColumns * totalBands;
+         const size_t offset = (mInterleave == BIL ? mBandStart * totalColumns + mWidthStart :
+            mWidthStart * totalBands + mBandStart);
+         const size_t stride = (mInterleave == BIL ? totalColumns : totalBands);
+         for (size_t row = mRange.mFirstRow; row < rowEnd; row += blockSize)
+         {
+            copyBlock(mpRawData + (mHeightStart + row) * rowStride + offset, rowStride, stride, row,
+               std::min(blockSize, rowEnd - row), 0);
+         }
+      }
+
+      // Transposes, interleaves, and converts a block of rows into the raster rows which start at pDest.
+      // For BIL data stride is the distance between bands within a row, and for BIP data it is the distance
+      // between pixels.
+      void copyBlock(D* pDest, size_t destStride, size_t stride, size_t row, size_t blockRows, size_t band)
+      {
+         if (mInterleave == BSQ)
+         {
+            ArrayTransfer::columnMajorToBsq(mpArray + mColumnCount * mRowCount * band, mRowCount, mColumnCount,
+               row, blockRows, pDest, destStride, ArrayTransfer::Cast<D>());
+         }
+         else if (mInterleave == BIL)
+         {
+            ArrayTransfer::columnMajorToBil(mpArray, mRowCount, mColumnCount, mBandCount, row, blockRows,
+               pDest, destStride, stride, ArrayTransfer::Cast<D>());
+         }
+         else
+         {
+            ArrayTransfer::columnMajorToBip(mpArray, mRowCount, mColumnCount, mBandCount, row, blockRows,
+               pDest, destStride, stride, ArrayTransfer::Cast<D>());
+         }
+      }
+
+      const S* mpArray;
+      RasterElement* mpElement;
+      D* mpRawData;
+      InterleaveFormatType mInterleave;
+      size_t mHeightStart;
+      size_t mWidthStart;
+      size_t mBandStart;
+      size_t mRowCount;
+      size_t mColumnCount;
+      size_t mBandCount;
+   };
+
+   // Copies a subcube of a raster element of type S into a column-major MATLAB array of type D,
+   // multiplying each element by scale as it is converted.
+   template<typename S, typename D>
+   class ArrayToMatlabWorker : public TransferWorker
+   {
+   public:
+      ArrayToMatlabWorker(const TransferRange& range, D* pArray, RasterElement* pElement, const S* pRawData,
+         InterleaveFormatType interleave, size_t heightStart, size_t widthStart, size_t bandStart,
+         size_t rowCount, size_t columnCount, double scale) :
+         TransferWorker(range),
+         mpArray(pArray),
+         mpElement(pElement),
+         mpRawData(pRawData),
+         mInterleave(interleave),
+         mHeightStart(heightStart),
+         mWidthStart(widthStart),
+         mBandStart(bandStart),
+         mRowCount(rowCount),
+         mColumnCount(columnCount),
+         mScale(scale)
+      {}
+
+      virtual void run()
+      {
+         const RasterDataDescriptor* pDescriptor =
+            dynamic_cast<const RasterDataDescriptor*>(mpElement->getDataDescriptor());
+         if (pDescriptor == NULL)
+         {
+            mError = "Unable to obtain the raster data descriptor.";
+            return;
+         }
+
+         if (mInterleave != BSQ && mInterleave != BIL && mInterleave != BIP)
+         {
+            mError = "Unrecognized interleave.";
+            return;
+         }
+
+         if (mpRawData != NULL)
+         {
+            copyRawData(pDescriptor);
+            return;
+         }
+
+         if (mInterleave == BSQ)
+         {
+            for (size_t band = mRange.mFirstBand; band < mRange.mFirstBand + mRange.mBandCount; ++band)
+            {
+               DataAccessor daImage = getAccessor(pDescriptor, mBandStart + band, mBandStart + band);
+               if (copyRows(daImage, band, 0, 0) == false)
+               {
+                  return;
+               }
+            }
+         }
+         else if (mInterleave == BIL || mInterleave == BIP)
+         {
+            // Request every band in the element's own interleave so that the raster does not need to reformat
+            // the data. The interleave conversion is then done as part of the transpose.
+            const size_t totalBands = pDescriptor->getBandCount();
+            DataAccessor daImage = getAccessor(pDescriptor, 0, totalBands - 1);
+            copyRows(daImage, mRange.mFirstBand, mBandStart + mRange.mFirstBand, totalBands);
+         }
+      }
+
+   private:
+      DataAccessor getAccessor(const RasterDataDescriptor* pDescriptor, size_t startBand, size_t stopBand)
+      {
+         // Request one tile worth of rows at a time so that each block can be transposed from a single pointer.
+         const size_t blockSize = ArrayTransfer::TileTraits<S, D>::Edge;
+         FactoryResource<DataRequest> pRequest;
+         pRequest->setInterleaveFormat(mInterleave);
+         setRequestBounds(pRequest.get(), pDescriptor, mHeightStart + mRange.mFirstRow,
+            mHeightStart + mRange.mFirstRow + mRange.mRowCount - 1, blockSize,
+            mWidthStart, mWidthStart + mColumnCount - 1, startBand, stopBand);
+         return mpElement->getDataAccessor(pRequest.release());
+      }
+
+      // Copies the rows of this worker's range from daImage into the MATLAB array, starting at destBand.
+      // For BIL and BIP data, sourceBand and sourceBands identify the bands to copy within each row.
+      bool copyRows(DataAccessor& daImage, size_t destBand, size_t sourceBand, size_t sourceBands)
+      {
+         const size_t blockSize = ArrayTransfer::TileTraits<S, D>::Edge;
+         const size_t rowEnd = mRange.mFirstRow + mRange.mRowCount;
+         D* pDest = mpArray + mColumnCount * mRowCount * destBand;
+         for (size_t row = mRange.mFirstRow; row < rowEnd; row += blockSize)
+         {
+            if (!daImage.isValid())
+            {
+               mError = "error copying array values to MATLAB.";
+               return false;
+            }
+
+            const size_t blockRows = std::min(blockSize, rowEnd - row);
+            copyBlock(reinterpret_cast<S*>(daImage->getRow()), daImage->getRowSize() / sizeof(S), row, blockRows,
+               pDest, sourceBand, sourceBands);
+
+            daImage->nextRow(blockRows);
+         }
+
+         return true;
+      }
+
+      // Copies the rows of this worker's range straight from the raw data of an element which is entirely
+      // in memory, avoiding the overhead of creating and advancing a DataAccessor.
+      void copyRawData(const RasterDataDescriptor* pDescriptor)
+      {
+         const size_t totalRows = pDescriptor->getRowCount();
+         const size_t totalColumns = pDescriptor->getColumnCount();
+         const size_t totalBands = pDescriptor->getBandCount();
+         const size_t blockSize = ArrayTransfer::TileTraits<S, D>::Edge;
+         const size_t rowEnd = mRange.mFirstRow + mRange.mRowCount;
+         if (mInterleave == BSQ)
+         {
+            for (size_t band = mRange.mFirstBand; band < mRange.mFirstBand + mRange.mBandCount; ++band)
+            {
+               const S* pBand = mpRawData + (mBandStart + band) * totalRows * totalColumns + mWidthStart;
+               D* pDest = mpArray + mColumnCount * mRowCount * band;
+               for (size_t row = mRange.mFirstRow; row < rowEnd; row += blockSize)
+               {
+                  const size_t blockRows = std::min(blockSize, rowEnd - row);
+                  copyBlock(pBand + (mHeightStart + row) * totalColumns, totalColumns, row, blockRows, pDest, 0, 1);
+               }
+            }
+
+            return;
+         }
+
+         // BIL rows start with the first column of band zero, while BIP rows start with band zero of the first column.
+         const size_t rowStride = totalColumns * totalBands;
+         const size_t columnOffset = (mInterleave == BIP ? mWidthStart * totalBands : mWidthStart);
+         D* pDest = mpArray + mColumnCount * mRowCount * mRange.mFirstBand;
+         for (size_t row = mRange.mFirstRow; row < rowEnd; row += blockSize)
+         {
+            const size_t blockRows = std::min(blockSize, rowEnd - row);
+            copyBlock(mpRawData + (mHeightStart + row) * rowStride + columnOffset, rowStride, row, blockRows, pDest,
+               mBandStart + mRange.mFirstBand, totalBands);
+         }
+      }
+
+      // Transposes a block of rows which starts at pSource into the MATLAB array. Unscaled copies avoid the
+      // floating point multiply, and copies which do not change type compile down to a plain transpose.
+      void copyBlock(const S* pSource, size_t rowStride, size_t row, size_t blockRows, D* pDest,
+         size_t sourceBand, size_t sourceBands)
+      {
+         if (mScale == 1.0)
+         {
+            copyBlock(pSource, rowStride, row, blockRows, pDest, sourceBand, sourceBands, ArrayTransfer::Cast<D>());
+         }
+         else
+         {
+            copyBlock(pSource, rowStride, row, blockRows, pDest, sourceBand, sourceBands,
+               ArrayTransfer::Scale<D>(mScale));
+         }
+      }
+
+      template<typename Converter>
+      void copyBlock(const S* pSource, size_t rowStride, size_t row, size_t blockRows, D* pDest,
+         size_t sourceBand, size_t sourceBands, Converter convert)
+      {
+         if (mInterleave == BSQ)
+         {
+            ArrayTransfer::transpose(pSource, rowStride, pDest + row, mRowCount, blockRows, mColumnCount, convert);
+         }
+         else if (mInterleave == BIL)
+         {
+            ArrayTransfer::bilToColumnMajor(pSource, rowStride, rowStride / sourceBands, sourceBand,
+               mRange.mBandCount, mColumnCount, blockRows, pDest, mRowCount, row, convert);
+         }
+         else
+         {
+            ArrayTransfer::bipToColumnMajor(pSource, rowStride, sourceBands, sourceBand,
+               mRange.mBandCount, mColumnCount, blockRows, pDest, mRowCount, row, convert);
+         }
+      }
+
+      D* mpArray;
+      RasterElement* mpElement;
+      const S* mpRawData;
+      InterleaveFormatType mInterleave;
+      size_t mHeightStart;
+      size_t mWidthStart;
+      size_t mBandStart;
+      size_t mRowCount;
+      size_t mColumnCount;
+      double mScale;
+   };
+
+   // Copies every Nth row, column, and band of a subcube of type S into a column-major MATLAB array of type D.
+   // When averaging, each output element is instead the mean of the full block of elements it represents.
+   template<typename S, typename D>
+   class DecimatedArrayToMatlabWorker : public TransferWorker
+   {
+   public:
+      DecimatedArrayToMatlabWorker(const TransferRange& range, D* pArray, RasterElement* pElement,
+         InterleaveFormatType interleave, size_t heightStart, size_t widthStart, size_t bandStart,
+         size_t rowCount, size_t columnCount, size_t bandCount,
+         size_t rowStride, size_t columnStride, size_t bandStride, bool average, double scale) :
+         TransferWorker(range),
+         mpArray(pArray),
+         mpElement(pElement),
+         mInterleave(interleave),
+         mHeightStart(heightStart),
+         mWidthStart(widthStart),
+         mBandStart(bandStart),
+         mRowCount(rowCount),
+         mColumnCount(columnCount),
+         mBandCount(bandCount),
+         mRowStride(rowStride),
+         mColumnStride(columnStride),
+         mBandStride(bandStride),
+         mAverage(average),
+         mScale(scale),
+         mOutRows((rowCount + rowStride - 1) / rowStride),
+         mOutColumns((columnCount + columnStride - 1) / columnStride),
+         mOutBands((bandCount + bandStride - 1) / bandStride)
+      {}
+
+      virtual void run()
+      {
+         const RasterDataDescriptor* pDescriptor =
+            dynamic_cast<const RasterDataDescriptor*>(mpElement->getDataDescriptor());
+         if (pDescriptor == NULL)
+         {
+            mError = "Unable to obtain the raster data descriptor.";
+            return;
+         }
+
+         if (mInterleave == BSQ)
+         {
+            // Accumulate one output band at a time, reading each of its source bands in turn.
+            std::vector<double> sums(mRange.mRowCount * mOutColumns);
+            for (size_t outBand = mRange.mFirstBand; outBand < mRange.mFirstBand + mRange.mBandCount; ++outBand)
+            {
+               std::fill(sums.begin(), sums.end(), 0.0);
+               const size_t bandEnd = outBand * mBandStride + getExtent(outBand, mBandStride, mBandCount);
+               for (size_t band = outBand * mBandStride; band < bandEnd; ++band)
+               {
+                  DataAccessor daImage = getAccessor(pDescriptor, mBandStart + band, mBandStart + band);
+                  size_t currentRow = mRange.mFirstRow * mRowStride;
+                  for (size_t outRow = mRange.mFirstRow; outRow < mRange.mFirstRow + mRange.mRowCount; ++outRow)
+                  {
+                     double* pSums = &sums[(outRow - mRange.mFirstRow) * mOutColumns];
+                     const size_t rowEnd = outRow * mRowStride + getExtent(outRow, mRowStride, mRowCount);
+                     for (size_t row = outRow * mRowStride; row < rowEnd; ++row)
+                     {
+                        daImage->nextRow(row - currentRow);
+                        currentRow = row;
+                        if (!daImage.isValid())
+                        {
+                           mError = "error copying array values to MATLAB.";
+                           return;
+                        }
+
+                        accumulateRow(reinterpret_cast<S*>(daImage->getRow()), 1, pSums);
+                     }
+                  }
+               }
+
+               for (size_t outRow = mRange.mFirstRow; outRow < mRange.mFirstRow + mRange.mRowCount; ++outRow)
+               {
+                  writeRow(&sums[(outRow - mRange.mFirstRow) * mOutColumns], outRow, outBand);
+               }
+            }
+
+            return;
+         }
+
+         if (mInterleave != BIL && mInterleave != BIP)
+         {
+            mError = "Unrecognized interleave.";
+            return;
+         }
+
+         // Every band is in each row, so accumulate all output bands of one output row at a time.
+         const size_t totalBands = pDescriptor->getBandCount();
+         DataAccessor daImage = getAccessor(pDescriptor, 0, totalBands - 1);
+         std::vector<double> sums(mOutBands * mOutColumns);
+         size_t currentRow = mRange.mFirstRow * mRowStride;
+         for (size_t outRow = mRange.mFirstRow; outRow < mRange.mFirstRow + mRange.mRowCount; ++outRow)
+         {
+            std::fill(sums.begin(), sums.end(), 0.0);
+            const size_t rowEnd = outRow * mRowStride + getExtent(outRow, mRowStride, mRowCount);
+            for (size_t row = outRow * mRowStride; row < rowEnd; ++row)
+            {
+               daImage->nextRow(row - currentRow);
+               currentRow = row;
+               if (!daImage.isValid())
+               {
+                  mError = "error copying array values to MATLAB.";
+                  return;
+               }
+
+               const S* pRow = reinterpret_cast<S*>(daImage->getRow());
+               const size_t bandStride = (mInterleave == BIL ? daImage->getRowSize() / sizeof(S) / totalBands : 1);
+               const size_t pixelStride = (mInterleave == BIP ? totalBands : 1);
+               for (size_t outBand = 0; outBand < mOutBands; ++outBand)
+               {
+                  const size_t bandEnd = outBand * mBandStride + getExtent(outBand, mBandStride, mBandCount);
+                  for (size_t band = outBand * mBandStride; band < bandEnd; ++band)
+                  {
+                     accumulateRow(pRow + (mBandStart + band) * bandStride, pixelStride,
+                        &sums[outBand * mOutColumns]);
+                  }
+               }
+            }
+
+            for (size_t outBand = 0; outBand < mOutBands; ++outBand)
+            {
+               writeRow(&sums[outBand * mOutColumns], outRow, outBand);
+            }
+         }
+      }
+
+   private:
+      // Returns the number of source elements which contribute to the given output index along one dimension.
+      size_t getExtent(size_t outIndex, size_t stride, size_t count) const
+      {
+         return mAverage ? std::min(stride, count - outIndex * stride) : 1;
+      }
+
+      DataAccessor getAccessor(const RasterDataDescriptor* pDescriptor, size_t startBand, size_t stopBand)
+      {
+         const size_t firstRow = mRange.mFirstRow * mRowStride;
+         const size_t lastRow = std::min(mRowCount, (mRange.mFirstRow + mRange.mRowCount) * mRowStride) - 1;
+         FactoryResource<DataRequest> pRequest;
+         pRequest->setInterleaveFormat(mInterleave);
+         setRequestBounds(pRequest.get(), pDescriptor, mHeightStart + firstRow, mHeightStart + lastRow, 1,
+            mWidthStart, mWidthStart + mColumnCount - 1, startBand, stopBand);
+         return mpElement->getDataAccessor(pRequest.release());
+      }
+
+      // Adds the sampled or averaged columns of one source row to pSums.
+      void accumulateRow(const S* pRow, size_t pixelStride, double* pSums) const
+      {
+         for (size_t outColumn = 0; outColumn < mOutColumns; ++outColumn)
+         {
+            const size_t columnEnd = outColumn * mColumnStride +
+               getExtent(outColumn, mColumnStride, mColumnCount);
+            for (size_t column = outColumn * mColumnStride; column < columnEnd; ++column)
+            {
+               pSums[outColumn] += static_cast<double>(pRow[column * pixelStride]);
+            }
+         }
+      }
+
+      // Writes one output row of one output band, dividing each sum by the number of elements it contains.
+      // The scale is applied to the mean so that integer targets are rounded only once.
+      void writeRow(const double* pSums, size_t outRow, size_t outBand)
+      {
+         const size_t rowBandCount =
+            getExtent(outRow, mRowStride, mRowCount) * getExtent(outBand, mBandStride, mBandCount);
+         D* pDest = mpArray + (outBand * mOutColumns * mOutRows) + outRow;
+         for (size_t outColumn = 0; outColumn < mOutColumns; ++outColumn)
+         {
+            const double count = static_cast<double>(rowBandCount * getExtent(outColumn, mColumnStride, mColumnCount));
+            pDest[outColumn * mOutRows] =
+               ArrayTransfer::Convert<double, D>::apply(pSums[outColumn] / count * mScale);
+         }
+      }
+
+      D* mpArray;
+      RasterElement* mpElement;
+      InterleaveFormatType mInterleave;
+      size_t mHeightStart;
+      size_t mWidthStart;
+      size_t mBandStart;
+      size_t mRowCount;
+      size_t mColumnCount;
+      size_t mBandCount;
+      size_t mRowStride;
+      size_t mColumnStride;
+      size_t mBandStride;
+      bool mAverage;
+      double mScale;
+      size_t mOutRows;
+      size_t mOutColumns;
+      size_t mOutBands;
+   };
+
+   // Copies the spectra of a sorted list of pixels of type S into an N x bands column-major MATLAB array of type D.
+   // The rows of this worker's range are entries in the pixel list rather than rows of the element.
+   template<typename S, typename D>
+   class PixelSpectraWorker : public TransferWorker
+   {
+   public:
+      PixelSpectraWorker(const TransferRange& range, D* pArray, RasterElement* pElement, const S* pRawData,
+         InterleaveFormatType interleave, const std::vector<PixelLocation>& pixels, size_t bandStart) :
+         TransferWorker(range),
+         mpArray(pArray),
+         mpElement(pElement),
+         mpRawData(pRawData),
+         mInterleave(interleave),
+         mPixels(pixels),
+         mBandStart(bandStart)
+      {}
+
+      virtual void run()
+      {
+         const RasterDataDescriptor* pDescriptor =
+            dynamic_cast<const RasterDataDescriptor*>(mpElement->getDataDescriptor());
+         if (pDescriptor == NULL)
+         {
+            mError = "Unable to obtain the raster data descriptor.";
+            return;
+         }
+
+         if (mInterleave != BSQ && mInterleave != BIL && mInterleave != BIP)
+         {
+            mError = "Unrecognized interleave.";
+            return;
+         }
+
+         const size_t totalRows = pDescriptor->getRowCount();
+         const size_t totalColumns = pDescriptor->getColumnCount();
+         const size_t totalBands = pDescriptor->getBandCount();
+         const size_t pixelEnd = mRange.mFirstRow + mRange.mRowCount;
+         const size_t bandEnd = mRange.mFirstBand + mRange.mBandCount;
+         if (mpRawData != NULL)
+         {
+            // Find each element directly, using the same offsets as copyRawData in ArrayToMatlabWorker.
+            const size_t bandSize = (mInterleave == BSQ ? totalRows * totalColumns :
+               (mInterleave == BIL ? totalColumns : 1));
+            for (size_t pixel = mRange.mFirstRow; pixel < pixelEnd; ++pixel)
+            {
+               const PixelLocation& location = mPixels[pixel];
+               const size_t offset = (mInterleave == BSQ ? location.mRow * totalColumns + location.mColumn :
+                  (mInterleave == BIL ? location.mRow * totalColumns * totalBands + location.mColumn :
+                  (location.mRow * totalColumns + location.mColumn) * totalBands));
+               for (size_t band = mRange.mFirstBand; band < bandEnd; ++band)
+               {
+                  mpArray[band * mPixels.size() + location.mIndex] =
+                     ArrayTransfer::Convert<S, D>::apply(mpRawData[offset + (mBandStart + band) * bandSize]);
+               }
+            }
+
+            return;
+         }
+
+         // Only request the columns which hold this worker's pixels.
+         unsigned int startColumn = mPixels[mRange.mFirstRow].mColumn;
+         unsigned int stopColumn = startColumn;
+         for (size_t pixel = mRange.mFirstRow; pixel < pixelEnd; ++pixel)
+         {
+            startColumn = std::min(startColumn, mPixels[pixel].mColumn);
+            stopColumn = std::max(stopColumn, mPixels[pixel].mColumn);
+         }
+
+         if (mInterleave == BSQ)
+         {
+            for (size_t band = mRange.mFirstBand; band < bandEnd; ++band)
+            {
+               DataAccessor daImage = getAccessor(pDescriptor, startColumn, stopColumn,
+                  mBandStart + band, mBandStart + band);
+               if (copyPixels(daImage, startColumn, band, band + 1, 0, 1) == false)
+               {
+                  return;
+               }
+            }
+         }
+         else
+         {
+            // Request every band in the element's own interleave so that the raster does not need to reformat
+            // the data.
+            DataAccessor daImage = getAccessor(pDescriptor, startColumn, stopColumn, 0, totalBands - 1);
+            const size_t requestColumns = static_cast<size_t>(stopColumn - startColumn) + 1;
+            copyPixels(daImage, startColumn, mRange.mFirstBand, bandEnd, mInterleave == BIL ? requestColumns : 1,
+               mInterleave == BIP ? totalBands : 1);
+         }
+      }
+
+   private:
+      DataAccessor getAccessor(const RasterDataDescriptor* pDescriptor, size_t startColumn, size_t stopColumn,
+         size_t startBand, size_t stopBand)
+      {
+         FactoryResource<DataRequest> pRequest;
+         pRequest->setInterleaveFormat(mInterleave);
+         setRequestBounds(pRequest.get(), pDescriptor, mPixels[mRange.mFirstRow].mRow,
+            mPixels[mRange.mFirstRow + mRange.mRowCount - 1].mRow, 1, startColumn, stopColumn, startBand, stopBand);
+         return mpElement->getDataAccessor(pRequest.release());
+      }
+
+      // Copies bands [firstBand, bandEnd) of this worker's pixels from daImage, skipping the rows which hold none
+      // of them. Within a row, band b of column c is at (c - startColumn) * pixelStride + (mBandStart + b) *
+      // bandStride, so BSQ accessors which only hold a single band pass a bandStride of 0.
+      bool copyPixels(DataAccessor& daImage, unsigned int startColumn, size_t firstBand, size_t bandEnd,
+         size_t bandStride, size_t pixelStride)
+      {
+         const size_t pixelEnd = mRange.mFirstRow + mRange.mRowCount;
+         size_t currentRow = mPixels[mRange.mFirstRow].mRow;
+         for (size_t pixel = mRange.mFirstRow; pixel < pixelEnd; ++pixel)
+         {
+            const PixelLocation& location = mPixels[pixel];
+            if (location.mRow != currentRow)
+            {
+               daImage->nextRow(location.mRow - currentRow);
+               currentRow = location.mRow;
+            }
+
+            if (!daImage.isValid())
+            {
+               mError = "error copying array values to MATLAB.";
+               return false;
+            }
+
+            const S* pColumn = reinterpret_cast<const S*>(daImage->getRow()) +
+               (location.mColumn - startColumn) * pixelStride;
+            for (size_t band = firstBand; band < bandEnd; ++band)
+            {
+               const size_t sourceBand = (bandStride == 0 ? 0 : mBandStart + band);
+               mpArray[band * mPixels.size() + location.mIndex] =
+                  ArrayTransfer::Convert<S, D>::apply(pColumn[sourceBand * bandStride]);
+            }
+         }
+
+         return true;
+      }
+
+      D* mpArray;
+      RasterElement* mpElement;
+      const S* mpRawData;
+      InterleaveFormatType mInterleave;
+      const std::vector<PixelLocation>& mPixels;
+      size_t mBandStart;
+   };
+};
+
+#endif
@@ -1,470 +1,1207 @@
-/*
- * The information in this file is
- * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
- * and is subject to the terms and conditions of the
- * GNU Lesser General Public License Version 2.1
- * The license text is available from   
- * http://www.gnu.org/licenses/lgpl.html
- */
-
-#include "AppConfig.h"
-#include "AppVerify.h"
-#include "ConfigurationSettings.h"
-#include "MatlabFunctions.h"
-#include "MatlabInterpreterEngine.h"
-#include "MatlabInterpreterOptions.h"
-#include "MatlabVersion.h"
-#include "InterpreterUtilities.h"
-
-#include <engine.h>
-
-#include <QtCore/QString>
-
-MatlabInterpreterEngine::MatlabInterpreterEngine() :
-   mpMatlabEngine(NULL),
-   mGlobalOutputShown(false),
-   mScopedCommandDepth(0)
-{}
-
-MatlabInterpreterEngine::~MatlabInterpreterEngine()
-{
-   notify(SIGNAL_NAME(Subject, Deleted));
-
-   if (mpMatlabEngine != NULL)
-   {
-      engClose(mpMatlabEngine);
-      mpMatlabEngine = NULL;
-   }
-}
-
-const std::string& MatlabInterpreterEngine::getCurrentCommand() const
-{
-   return mCurrentCommand;
-}
-
-const std::vector<MatlabInternalCommand*>& MatlabInterpreterEngine::getInternalCommands() const
-{
-   return mParser.getInternalCommands();
-}
-
-bool MatlabInterpreterEngine::isMatlabRunning() const
-{
-   return mpMatlabEngine != NULL;
-}
-
-std::string MatlabInterpreterEngine::getStartupMessage() const
-{
-   return mStartupMessage;
-}
-
-bool MatlabInterpreterEngine::startMatlab()
-{
-   if (isMatlabRunning() == true)
-   {
-      return true;
-   }
-
-   mpMatlabEngine = engOpenSingleUse(NULL, NULL, NULL);
-   if (mpMatlabEngine == NULL)
-   {
-      mStartupMessage = "Unable to start the MATLAB engine. "
-         "Please check your platform, configuration, and license settings and try again.";
-      return false;
-   }
-
-   // Suppress extra whitespace in results.
-   executeCommandInMatlab("format compact");
-
-   // Add the SupportFiles directory to the MATLAB path so that the internal command .m files can be located.
-   // This ensures that help(internal_command) will function appropriately.
-   const Filename* pSupportFiles = ConfigurationSettings::getSettingSupportFilesPath();
-   if (pSupportFiles != NULL)
-   {
-      executeCommandInMatlab("path('" + pSupportFiles->getFullPathAndName() + "/MATLAB/', path)");
-   }
-
-   // Hide the command window on startup.
-   hideCommandWindow();
-
-   // Get the version number and description (e.g.: "Service Pack 1") for the startup message.
-   std::string version;
-   mStartupMessage = "MATLAB";
-   if (getMatlabVariableAsString("version", version) == true && version.empty() == false)
-   {
-      mStartupMessage.append(" " + version);
-   }
-
-   if (MatlabInterpreter::getSettingInteractiveAvailable() == false)
-   {
-      mStartupMessage.append("\nThe ability to type MATLAB commands into the Scripting Window has been disabled.");
-   }
-
-   return isMatlabRunning();
-}
-
-std::string MatlabInterpreterEngine::getPrompt() const
-{
-   const unsigned int depth = mParser.getCommandDepth() + mParser.getCommentDepth();
-   return depth > 0 ? std::string(depth * 3, '.') : ">> ";
-}
-
-bool MatlabInterpreterEngine::executeScopedCommand(const std::string& command, const Slot& output, const Slot& error, Progress* pProgress)
-{
-   if (++mScopedCommandDepth == 1)
-   {
-      attach(SIGNAL_NAME(MatlabInterpreterEngine, ScopedOutputText), output);
-      attach(SIGNAL_NAME(MatlabInterpreterEngine, ScopedErrorText), error);
-   }
-
-   bool retValue = executeCommand(command);
-
-   if (--mScopedCommandDepth == 0)
-   {
-      detach(SIGNAL_NAME(MatlabInterpreterEngine, ScopedErrorText), error);
-      detach(SIGNAL_NAME(MatlabInterpreterEngine, ScopedOutputText), output);
-   }
-
-   return retValue;
-}
-
-bool MatlabInterpreterEngine::executeCommand(const std::string& command)
-{
-   // The parseLine method does not handle commands spanning multiple lines.
-   // Split the lines here, returning immediately if an error occurs.
-   QStringList commandList = QString::fromStdString(command).split("\n");
-   foreach(QString currentCommand, commandList)
-   {
-      // Parse the input to determine if there is a command to run in MATLAB.
-      std::string output;
-      bool outputIsError = false;
-      mCurrentCommand = currentCommand.toStdString();
-      std::string actualCommand = mParser.parseLine(*this, mCurrentCommand, output, outputIsError);
-      mCurrentCommand.clear();
-      if (outputIsError == true)
-      {
-         if (output.empty() == true)
-         {
-            output = "Unknown parse error.";
-         }
-
-         sendError(output);
-         return false;
-      }
-
-      if (output.empty() == false)
-      {
-         sendOutput(output);
-         output.clear();
-      }
-
-      // Run the command in MATLAB.
-      if (actualCommand.empty() == false)
-      {
-         // Suppress output from actualCommand by appending a semicolon if the original command ended with one.
-         if (currentCommand.endsWith(';') && actualCommand[actualCommand.size() - 1] != ';')
-         {
-            actualCommand += ';';
-         }
-
-         // This checks for output before returning, even in the case where there were errors.
-         bool outputTruncated = false;
-         bool success = executeCommandInMatlab(actualCommand, output, outputIsError, outputTruncated);
-         if (outputIsError == true && output.empty() == true)
-         {
-            output = "Unknown MATLAB error.";
-         }
-
-         if (output.empty() == false)
-         {
-            outputIsError ? sendError(output) : sendOutput(output);
-         }
-
-         if (outputTruncated == true)
-         {
-            // Prepend a newline to the error to prevent it from showing up on the same line as the output.
-            // Normally this is not a problem, however, since the output was truncated, it is unlikely that
-            // the last character was a newline.
-            sendError("\nThe previous output was truncated. Please increase the MATLAB output buffer size and try again.");
-         }
-
-         if (success == false)
-         {
-            sendError("MATLAB is no longer running.");
-            return false;
-         }
-
-         if (outputIsError == true)
-         {
-            return false;
-         }
-      }
-   }
-
-   return true;
-}
-
-bool MatlabInterpreterEngine::isGlobalOutputShown() const
-{
-   return mGlobalOutputShown;
-}
-
-void MatlabInterpreterEngine::showGlobalOutput(bool newValue)
-{
-   mGlobalOutputShown = newValue;
-}
-
-const std::string& MatlabInterpreterEngine::getObjectType() const
-{
-   static std::string sType("MatlabInterpreterEngine");
-   return sType;
-}
-
-bool MatlabInterpreterEngine::isKindOf(const std::string& className) const
-{
-   if (className == getObjectType())
-   {
-      return true;
-   }
-
-   return SubjectImp::isKindOf(className);
-}
-
-void MatlabInterpreterEngine::sendOutput(const std::string& text)
-{
-   if (text.empty())
-   {
-      return;
-   }
-
-   if (mScopedCommandDepth > 0)
-   {
-      notify(SIGNAL_NAME(MatlabInterpreterEngine, ScopedOutputText), text);
-   }
-
-   if (mScopedCommandDepth == 0|| mGlobalOutputShown)
-   {
-      notify(SIGNAL_NAME(Interpreter, OutputText), text);
-   } 
-}
-
-void MatlabInterpreterEngine::sendError(const std::string& text)
-{
-   if (text.empty())
-   {
-      return;
-   }
-
-   if (mScopedCommandDepth > 0)
-   {
-      notify(SIGNAL_NAME(MatlabInterpreterEngine, ScopedErrorText), text);
-   }
-
-   if (mScopedCommandDepth == 0 || mGlobalOutputShown)
-   {
-      notify(SIGNAL_NAME(Interpreter, ErrorText), text);
-   } 
-}
-
-bool MatlabInterpreterEngine::executeCommandInMatlab(const std::string& command)
-{
-   return engOutputBuffer(mpMatlabEngine, NULL, 0) == 0 &&
-      engEvalString(mpMatlabEngine, command.c_str()) == 0;
-}
-
-bool MatlabInterpreterEngine::executeCommandInMatlab(const std::string& command, std::string& output,
-   bool& outputIsError, bool& outputTruncated)
-{
-   // Setup the output buffer.
-   // Check the buffer size before running each command so settings do not require a restart.
-   // The mOutputBuffer is only a member to avoid dynamic memory allocation on the heap.
-   int outputBufferSize = MatlabInterpreter::getSettingOutputBufferSize();
-   if (outputBufferSize > 0 && mOutputBuffer.size() != outputBufferSize)
-   {
-      try
-      {
-         // This can throw if there is not enough memory available.
-         mOutputBuffer.resize(outputBufferSize);
-      }
-      catch (const std::bad_alloc&)
-      {
-         outputBufferSize = 0;
-      }
-
-      if (outputBufferSize == 0)
-      {
-         QString errorMessage = QString("Unable to allocate buffer of %1 bytes").arg(
-            MatlabInterpreter::getSettingOutputBufferSize());
-         sendError(errorMessage.toStdString());
-      }
-   }
-
-   if (outputBufferSize <= 0)
-   {
-      mOutputBuffer.clear();
-      engOutputBuffer(mpMatlabEngine, NULL, 0);
-   }
-   else
-   {
-      // Always initialize the buffer to all NULL characters since MATLAB does not NULL-terminate its output.
-      memset(&mOutputBuffer[0], 0, outputBufferSize);
-      engOutputBuffer(mpMatlabEngine, &mOutputBuffer[0], outputBufferSize);
-   }
-
-   // Run the command.
-   int retVal = engEvalString(mpMatlabEngine, command.c_str());
-
-   // Gather the output from the buffer.
-   if (mOutputBuffer.empty() == true || mOutputBuffer[0] == 0)
-   {
-      // Either no buffer is being used or there was no output, so return an empty string.
-      output = std::string();
-      outputTruncated = false;
-   }
-   else
-   {
-      // Check whether the command filled the buffer.
-      if (mOutputBuffer.back() != 0)
-      {
-         mOutputBuffer.back() = 0;
-         outputTruncated = true;
-      }
-      else
-      {
-         outputTruncated = false;
-      }
-
-      // Copy the contents of the output buffer into the string.
-      output.assign(&mOutputBuffer[0]);
-   }
-
-   // Check whether the command resulted in an error.
-   outputIsError = false;
-   if (retVal == 0 && mOutputBuffer.empty() == false && MatlabInterpreter::getSettingCheckErrors() == true)
-   {
-      memset(&mOutputBuffer[0], 0, outputBufferSize);
-      if (engEvalString(mpMatlabEngine, "lasterror") == 0)
-      {
-         // Check whether the command filled the buffer.
-         bool errorTruncated = false;
-         if (mOutputBuffer.back() != 0)
-         {
-            mOutputBuffer.back() = 0;
-            errorTruncated = true;
-         }
-
-         // Copy the contents of the output buffer into the string.
-         QString error(&mOutputBuffer[0]);
-
-         // Check for the message. Note: messageIndex may be -1 if the user has reassigned the lasterror variable.
-         int messageIndex = error.indexOf(QRegExp("message:"));
-         if (messageIndex >= 0)
-         {
-            int startIndex = error.indexOf('\'', messageIndex);
-            if (startIndex >= 0)
-            {
-               int endIndex = error.indexOf('\'', startIndex + 1);
-               if (endIndex >= 0)
-               {
-                  int length = endIndex - (startIndex + 1);
-                  if (length > 0)
-                  {
-                     error = error.mid(startIndex + 1, length).trimmed();
-                     if (error.isEmpty() == false)
-                     {
-                        output = error.toStdString();
-                        outputIsError = true;
-                        outputTruncated = errorTruncated;
-                     }
-                  }
-               }
-            }
-         }
-      }
-   }
-
-   if (retVal == 0 && MatlabInterpreter::getSettingClearErrors() == true)
-   {
-      engEvalString(mpMatlabEngine, "lasterror('reset');");
-   }
-
-   return retVal == 0;
-}
-
-bool MatlabInterpreterEngine::hideCommandWindow()
-{
-   return engSetVisible(mpMatlabEngine, false) == 0;
-}
-
-bool MatlabInterpreterEngine::showCommandWindow()
-{
-   return engSetVisible(mpMatlabEngine, true) == 0;
-}
-
-bool MatlabInterpreterEngine::getMatlabVariableAsString(const std::string& name, std::string& value)
-{
-   std::string output;
-   bool outputIsError = false;
-   bool outputTruncated = false;
-   if (executeCommandInMatlab(name, output, outputIsError, outputTruncated) == false ||
-      outputIsError == true || outputTruncated == true || output.empty() == true)
-   {
-      return false;
-   }
-
-   std::string isCharOutput;
-   if (executeCommandInMatlab("ischar(" + name + ")", isCharOutput, outputIsError, outputTruncated) == false ||
-      outputIsError == true || outputTruncated == true || isCharOutput.empty() == true)
-   {
-      return false;
-   }
-
-   // Massage the output into something more readable.
-   //    - Remove leading and trailing spaces.
-   //    - For all non-character types, remove intermediate spaces as well.
-   QString formattedOutput = QString::fromStdString(output);
-   formattedOutput = formattedOutput.remove('\n');
-   isCharOutput = QString::fromStdString(isCharOutput).remove('\n').remove(' ').trimmed().toStdString();
-   if (isCharOutput.find("ans=1") == std::string::npos)
-   {
-      formattedOutput = formattedOutput.remove(' ');
-   }
-   else
-   {
-      // If it is a string, check whether it is empty.
-      // MATLAB outputs '' for empty strings, but that is not safe to check since a string containing
-      // two apostrophes ('''''') is equivalent once whitespace has been removed.
-      std::string isEmptyOutput;
-      if (executeCommandInMatlab("isempty(" + name + ")", isEmptyOutput, outputIsError, outputTruncated) == false ||
-         outputIsError == true || outputTruncated == true || isEmptyOutput.empty() == true)
-      {
-         return false;
-      }
-
-      isEmptyOutput = QString::fromStdString(isEmptyOutput).remove('\n').remove(' ').trimmed().toStdString();
-      if (isEmptyOutput.find("ans=1") != std::string::npos)
-      {
-         value.clear();
-         return true;
-      }
-   }
-
-   formattedOutput = formattedOutput.trimmed();
-   value = formattedOutput.toStdString();
-   std::string::size_type pos = value.find('=');
-   if (pos != std::string::npos)
-   {
-      value = value.substr(pos + 1, std::string::npos);
-   }
-
-   return true;
-}
-
-mxArray* MatlabInterpreterEngine::getMatlabVariable(const std::string& name)
-{
-   return engGetVariable(mpMatlabEngine, name.c_str());
-}
-
-bool MatlabInterpreterEngine::setMatlabVariable(const std::string& name, const mxArray* pArray)
-{
-   return engPutVariable(mpMatlabEngine, name.c_str(), pArray) == 0;
-}
+/*
+ * The information in this file is
+ * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
+ * and is subject to the terms and conditions of the
+ * GNU Lesser General Public License Version 2.1
+ * The license text is available from   
+ * http://www.gnu.org/licenses/lgpl.html
+ */
+
+#include "AppConfig.h"
+#include "AppVerify.h"
+#include "ConfigurationSettings.h"
+#include "MatlabFunctions.h"
+#include "MatlabInterpreterEngine.h"
+#include "MatlabInterpreterOptions.h"
+#include "MatlabVersion.h"
+#include "InterpreterUtilities.h"
+#include "RasterElement.h"
+
+#include <engine.h>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QRegExp>
+#include <QtCore/QString>
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+   // The size of the output buffer before any command has needed a larger one.
+   const int sInitialOutputBufferSize = 4096;
+
+   // Returns a MATLAB expression for the text of a command, which may span several lines.
+   std::string toMatlabText(const std::string& command)
+   {
+      QStringList lines;
+      foreach (QString line, QString::fromStdString(command).split('\n'))
+      {
+         lines.append(QString::fromStdString(MatlabFunctions::toMatlabString(line.toStdString())));
+      }
+
+      return lines.size() == 1 ? lines.front().toStdString() : '[' + lines.join(" char(10) ").toStdString() + ']';
+   }
+}
+
+MatlabInterpreterEngine::MatlabInterpreterEngine() :
+   mpMatlabEngine(NULL),
+   mGlobalOutputShown(false),
+   mScopedCommandDepth(0),
+   mCommandDepth(0),
+   mBlockDepth(0),
+   mpSharedData(NULL)
+{}
+
+MatlabInterpreterEngine::~MatlabInterpreterEngine()
+{
+   notify(SIGNAL_NAME(Subject, Deleted));
+   clearTransferCache();
+
+   if (mpMatlabEngine != NULL)
+   {
+      engClose(mpMatlabEngine);
+      mpMatlabEngine = NULL;
+   }
+
+   // Remove the shared memory file only after MATLAB has exited so that it no longer holds the file open.
+   removeSharedFile();
+
+   QFile::remove(getOutputFileName());
+}
+
+const std::string& MatlabInterpreterEngine::getCurrentCommand() const
+{
+   return mCurrentCommand;
+}
+
+const std::vector<MatlabInternalCommand*>& MatlabInterpreterEngine::getInternalCommands() const
+{
+   return mParser.getInternalCommands();
+}
+
+bool MatlabInterpreterEngine::isMatlabRunning() const
+{
+   return mpMatlabEngine != NULL;
+}
+
+std::string MatlabInterpreterEngine::getStartupMessage() const
+{
+   return mStartupMessage;
+}
+
+bool MatlabInterpreterEngine::startMatlab()
+{
+   if (isMatlabRunning() == true)
+   {
+      return true;
+   }
+
+   // Pooled arrays sized for the previous session are not likely to be reused by the new one.
+   mTransferPool.clear();
+
+   mpMatlabEngine = engOpenSingleUse(NULL, NULL, NULL);
+   if (mpMatlabEngine == NULL)
+   {
+      mStartupMessage = "Unable to start the MATLAB engine. "
+         "Please check your platform, configuration, and license settings and try again.";
+      return false;
+   }
+
+   // Suppress extra whitespace in results.
+   executeCommandInMatlab("format compact");
+
+   // Add the SupportFiles directory to the MATLAB path so that the internal command .m files can be located.
+   // This ensures that help(internal_command) will function appropriately.
+   const Filename* pSupportFiles = ConfigurationSettings::getSettingSupportFilesPath();
+   if (pSupportFiles != NULL)
+   {
+      executeCommandInMatlab("path('" + pSupportFiles->getFullPathAndName() + "/MATLAB/', path)");
+   }
+
+   // Hide the command window on startup.
+   hideCommandWindow();
+
+   // Get the version number and description (e.g.: "Service Pack 1") for the startup message.
+   std::string version;
+   mStartupMessage = "MATLAB";
+   if (getMatlabVariableAsString("version", version) == true && version.empty() == false)
+   {
+      mStartupMessage.append(" " + version);
+   }
+
+   if (MatlabInterpreter::getSettingInteractiveAvailable() == false)
+   {
+      mStartupMessage.append("\nThe ability to type MATLAB commands into the Scripting Window has been disabled.");
+   }
+
+   return isMatlabRunning();
+}
+
+std::string MatlabInterpreterEngine::getPrompt() const
+{
+   const unsigned int depth = mParser.getCommandDepth() + mParser.getCommentDepth();
+   return depth > 0 ? std::string(depth * 3, '.') : ">> ";
+}
+
+bool MatlabInterpreterEngine::executeScopedCommand(const std::string& command, const Slot& output, const Slot& error, Progress* pProgress)
+{
+   if (++mScopedCommandDepth == 1)
+   {
+      attach(SIGNAL_NAME(MatlabInterpreterEngine, ScopedOutputText), output);
+      attach(SIGNAL_NAME(MatlabInterpreterEngine, ScopedErrorText), error);
+   }
+
+   bool retValue = executeCommand(command);
+
+   if (--mScopedCommandDepth == 0)
+   {
+      detach(SIGNAL_NAME(MatlabInterpreterEngine, ScopedErrorText), error);
+      detach(SIGNAL_NAME(MatlabInterpreterEngine, ScopedOutputText), output);
+   }
+
+   return retValue;
+}
+
+bool MatlabInterpreterEngine::executeCommand(const std::string& command)
+{
+   // Commands run from other commands, such as scripts and stream callbacks, share the shared memory file, which is
+   // removed once the outermost command finishes so that a large transfer does not hold disk space while idle.
+   ++mCommandDepth;
+   const bool success = executeCommandLines(command);
+   if (--mCommandDepth == 0)
+   {
+      removeSharedFile();
+   }
+
+   return success;
+}
+
+bool MatlabInterpreterEngine::executeCommandLines(const std::string& command)
+{
+   // The parseLine method does not handle commands spanning multiple lines.
+   // Split the lines here, returning immediately if an error occurs.
+   QStringList commandList = QString::fromStdString(command).split("\n");
+   foreach(QString currentCommand, commandList)
+   {
+      // Parse the input to determine if there is a command to run in MATLAB.
+      std::string output;
+      bool outputIsError = false;
+      bool containsInternalCommands = false;
+      mCurrentCommand = currentCommand.toStdString();
+      std::string actualCommand = mParser.parseLine(*this, mCurrentCommand, output, outputIsError,
+         containsInternalCommands);
+      mCurrentCommand.clear();
+      if (outputIsError == true)
+      {
+         if (output.empty() == true)
+         {
+            output = "Unknown parse error.";
+         }
+
+         sendError(output);
+         return false;
+      }
+
+      if (output.empty() == false)
+      {
+         sendOutput(output);
+         output.clear();
+      }
+
+      // Run a block containing internal commands one statement at a time.
+      if (containsInternalCommands == true)
+      {
+         QStringList blockLines = QString::fromStdString(actualCommand).split("\n");
+         std::vector<std::string> lines;
+         foreach (QString line, blockLines)
+         {
+            lines.push_back(line.toStdString());
+         }
+
+         bool breakLoop = false;
+         bool continueLoop = false;
+         if (executeBlock(lines, breakLoop, continueLoop) == false)
+         {
+            return false;
+         }
+
+         continue;
+      }
+
+      // Run the command in MATLAB.
+      if (actualCommand.empty() == false)
+      {
+         // Suppress output from actualCommand by appending a semicolon if the original command ended with one.
+         if (currentCommand.endsWith(';') && actualCommand[actualCommand.size() - 1] != ';')
+         {
+            actualCommand += ';';
+         }
+
+         if (executeStatements(actualCommand) == false)
+         {
+            return false;
+         }
+      }
+   }
+
+   return true;
+}
+
+bool MatlabInterpreterEngine::executeStatements(const std::string& statements)
+{
+   // This checks for output before returning, even in the case where there were errors.
+   std::string output;
+   bool outputIsError = false;
+   bool outputTruncated = false;
+   bool success = executeCommandInMatlab(statements, output, outputIsError, outputTruncated);
+   if (outputIsError == true && output.empty() == true)
+   {
+      output = "Unknown MATLAB error.";
+   }
+
+   if (output.empty() == false)
+   {
+      outputIsError ? sendError(output) : sendOutput(output);
+   }
+
+   if (outputTruncated == true)
+   {
+      // Prepend a newline to the error to prevent it from showing up on the same line as the output.
+      // Normally this is not a problem, however, since the output was truncated, it is unlikely that
+      // the last character was a newline.
+      sendError("\nThe previous output was truncated. Please increase the MATLAB output buffer size and try again.");
+   }
+
+   if (success == false)
+   {
+      sendError("MATLAB is no longer running.");
+      return false;
+   }
+
+   return outputIsError == false;
+}
+
+bool MatlabInterpreterEngine::executeBlock(const std::vector<std::string>& lines, bool& breakLoop,
+   bool& continueLoop)
+{
+   // Each level of nesting uses its own variables for the values of a for loop.
+   ++mBlockDepth;
+   const bool success = executeBlockAtDepth(lines, breakLoop, continueLoop);
+   --mBlockDepth;
+   return success;
+}
+
+bool MatlabInterpreterEngine::executeBlockAtDepth(const std::vector<std::string>& lines, bool& breakLoop,
+   bool& continueLoop)
+{
+   if (lines.size() < 2)
+   {
+      sendError("Unable to parse the block.");
+      return false;
+   }
+
+   QString header = QString::fromStdString(lines.front()).trimmed();
+   while (header.endsWith(';') == true || header.endsWith(',') == true)
+   {
+      header.chop(1);
+   }
+
+   const QString keyword = header.section(' ', 0, 0).toLower();
+   const QString expression = header.section(' ', 1).trimmed();
+   const std::vector<std::string> body(lines.begin() + 1, lines.end() - 1);
+   if (keyword == "for")
+   {
+      // Strip the optional parentheses from "for (i = values)".
+      QString loop = expression;
+      if (loop.startsWith('(') == true && loop.endsWith(')') == true)
+      {
+         loop = loop.mid(1, loop.size() - 2).trimmed();
+      }
+
+      const QString variable = loop.section('=', 0, 0).trimmed();
+      const QString values = loop.section('=', 1).trimmed();
+      if (QRegExp("[A-Za-z]\\w*").exactMatch(variable) == false || values.isEmpty() == true)
+      {
+         sendError("Unable to parse the for loop.");
+         return false;
+      }
+
+      // MATLAB assigns each column of the values to the loop variable in turn.
+      const QString valuesName = QString("opticks_loop__%1").arg(mBlockDepth);
+      const QString countName = QString("opticks_loop_count__%1").arg(mBlockDepth);
+      if (executeStatements(QString("%1 = %2; %3 = size(%1(:, :), 2);")
+         .arg(valuesName, values, countName).toStdString()) == false)
+      {
+         return false;
+      }
+
+      mxArray* pCount = getMatlabVariable(countName.toStdString());
+      const double count = (pCount == NULL ? 0.0 : mxGetScalar(pCount));
+      if (pCount != NULL)
+      {
+         mxDestroyArray(pCount);
+      }
+
+      bool success = true;
+      for (double column = 1.0; column <= count && success == true; ++column)
+      {
+         const std::string assignment = QString("%1 = %2(:, %3);")
+            .arg(variable, valuesName, QString::number(column, 'f', 0)).toStdString();
+         success = executeBody(body, assignment, std::string(), breakLoop, continueLoop);
+         continueLoop = false;
+         if (breakLoop == true)
+         {
+            breakLoop = false;
+            break;
+         }
+      }
+
+      return executeStatements(QString("clear %1 %2;").arg(valuesName, countName).toStdString()) && success;
+   }
+
+   if (keyword == "while")
+   {
+      // The condition is evaluated along with the last statements of the body where possible.
+      const std::string condition = getConditionCommand(expression.toStdString());
+      bool success = executeStatements(condition);
+      bool value = false;
+      while (success == true)
+      {
+         success = getCondition(value);
+         if (success == false || value == false)
+         {
+            break;
+         }
+
+         success = executeBody(body, std::string(), condition, breakLoop, continueLoop);
+         if (breakLoop == true)
+         {
+            breakLoop = false;
+            break;
+         }
+
+         // The body stops at a continue statement without evaluating the condition.
+         if (continueLoop == true)
+         {
+            continueLoop = false;
+            success = success && executeStatements(condition);
+         }
+      }
+
+      return executeStatements("clear opticks_condition__;") && success;
+   }
+
+   if (keyword == "if")
+   {
+      // Split the body into branches at the elseif and else statements which belong to this block.
+      std::vector<QString> conditions(1, expression);
+      std::vector<std::vector<std::string> > branches(1);
+      unsigned int depth = 0;
+      for (std::vector<std::string>::const_iterator iter = body.begin(); iter != body.end(); ++iter)
+      {
+         QString line = QString::fromStdString(*iter).trimmed();
+         while (line.endsWith(';') == true || line.endsWith(',') == true)
+         {
+            line.chop(1);
+         }
+
+         const QString lineKeyword = line.section(' ', 0, 0).toLower();
+         if (depth == 0 && (lineKeyword == "elseif" || line.toLower() == "else"))
+         {
+            conditions.push_back(lineKeyword == "elseif" ? line.section(' ', 1).trimmed() : QString());
+            branches.push_back(std::vector<std::string>());
+            continue;
+         }
+
+         if (MatlabParser::startsWithValidLoopKeyword(*iter) == true)
+         {
+            ++depth;
+         }
+         else if (MatlabParser::isEndKeyword(*iter) == true && depth > 0)
+         {
+            --depth;
+         }
+
+         branches.back().push_back(*iter);
+      }
+
+      bool success = true;
+      for (std::vector<QString>::size_type i = 0; i < conditions.size() && success == true; ++i)
+      {
+         bool value = true;
+         if (conditions[i].isEmpty() == false)
+         {
+            success = executeStatements(getConditionCommand(conditions[i].toStdString())) && getCondition(value);
+         }
+
+         if (success == true && value == true)
+         {
+            success = executeBody(branches[i], std::string(), std::string(), breakLoop, continueLoop);
+            break;
+         }
+      }
+
+      return executeStatements("clear opticks_condition__;") && success;
+   }
+
+   sendError("Unable to run internal commands inside a \"" + keyword.toStdString() + "\" block.");
+   return false;
+}
+
+bool MatlabInterpreterEngine::executeBody(const std::vector<std::string>& lines, const std::string& prefix,
+   const std::string& suffix, bool& breakLoop, bool& continueLoop)
+{
+   // Consecutive MATLAB statements, including blocks which MATLAB can run by itself, are sent together. Internal
+   // commands, blocks which contain them, and break and continue statements end the statements sent so far.
+   std::string statements = prefix;
+   for (std::vector<std::string>::size_type i = 0; i < lines.size(); ++i)
+   {
+      QString line = QString::fromStdString(lines[i]).trimmed();
+      while (line.endsWith(';') == true || line.endsWith(',') == true)
+      {
+         line.chop(1);
+      }
+
+      std::vector<std::string> block;
+      bool interpretBlock = false;
+      if (MatlabParser::startsWithValidLoopKeyword(lines[i]) == true)
+      {
+         unsigned int depth = 0;
+         bool containsJump = false;
+         for (; i < lines.size(); ++i)
+         {
+            block.push_back(lines[i]);
+            const QString blockLine = QString::fromStdString(lines[i]).trimmed().toLower();
+            interpretBlock = interpretBlock || mParser.isInternalCommandLine(lines[i]);
+            containsJump = containsJump || QRegExp("(break|continue)\\s*[;,]?").exactMatch(blockLine);
+            if (MatlabParser::startsWithValidLoopKeyword(lines[i]) == true)
+            {
+               ++depth;
+            }
+            else if (MatlabParser::isEndKeyword(lines[i]) == true && --depth == 0)
+            {
+               break;
+            }
+         }
+
+         // MATLAB cannot break out of a loop which is being run by the interpreter.
+         interpretBlock = interpretBlock || (containsJump && line.toLower().startsWith("if ") == true);
+         if (interpretBlock == false)
+         {
+            for (std::vector<std::string>::const_iterator iter = block.begin(); iter != block.end(); ++iter)
+            {
+               statements += (statements.empty() ? "" : "\n") + *iter;
+            }
+
+            continue;
+         }
+      }
+
+      const bool jump = (line.toLower() == "break" || line.toLower() == "continue");
+      if (interpretBlock == true || jump == true || mParser.isInternalCommandLine(lines[i]) == true)
+      {
+         if (statements.empty() == false && executeStatements(statements) == false)
+         {
+            return false;
+         }
+
+         statements.clear();
+         if (jump == true)
+         {
+            (line.toLower() == "break" ? breakLoop : continueLoop) = true;
+            return true;
+         }
+
+         if (interpretBlock == true ? executeBlock(block, breakLoop, continueLoop) == false :
+            executeCommand(lines[i]) == false)
+         {
+            return false;
+         }
+
+         if (breakLoop == true || continueLoop == true)
+         {
+            return true;
+         }
+
+         continue;
+      }
+
+      statements += (statements.empty() ? "" : "\n") + lines[i];
+   }
+
+   statements += (statements.empty() || suffix.empty() ? "" : "\n") + suffix;
+   return statements.empty() == true || executeStatements(statements);
+}
+
+std::string MatlabInterpreterEngine::getConditionCommand(const std::string& expression)
+{
+   // MATLAB treats a condition as true when it is not empty and all of its elements are nonzero.
+   return "opticks_condition__ = (" + expression + "); opticks_condition__ = ~isempty(opticks_condition__) && "
+      "all(opticks_condition__(:));";
+}
+
+bool MatlabInterpreterEngine::getCondition(bool& value)
+{
+   mxArray* pCondition = getMatlabVariable("opticks_condition__");
+   if (pCondition == NULL)
+   {
+      sendError("Unable to evaluate the condition.");
+      return false;
+   }
+
+   value = mxIsLogicalScalarTrue(pCondition);
+   mxDestroyArray(pCondition);
+   return true;
+}
+
+bool MatlabInterpreterEngine::isGlobalOutputShown() const
+{
+   return mGlobalOutputShown;
+}
+
+void MatlabInterpreterEngine::showGlobalOutput(bool newValue)
+{
+   mGlobalOutputShown = newValue;
+}
+
+const std::string& MatlabInterpreterEngine::getObjectType() const
+{
+   static std::string sType("MatlabInterpreterEngine");
+   return sType;
+}
+
+bool MatlabInterpreterEngine::isKindOf(const std::string& className) const
+{
+   if (className == getObjectType())
+   {
+      return true;
+   }
+
+   return SubjectImp::isKindOf(className);
+}
+
+void MatlabInterpreterEngine::sendOutput(const std::string& text)
+{
+   if (text.empty())
+   {
+      return;
+   }
+
+   if (mScopedCommandDepth > 0)
+   {
+      notify(SIGNAL_NAME(MatlabInterpreterEngine, ScopedOutputText), text);
+   }
+
+   if (mScopedCommandDepth == 0|| mGlobalOutputShown)
+   {
+      notify(SIGNAL_NAME(Interpreter, OutputText), text);
+   } 
+}
+
+void MatlabInterpreterEngine::sendError(const std::string& text)
+{
+   if (text.empty())
+   {
+      return;
+   }
+
+   if (mScopedCommandDepth > 0)
+   {
+      notify(SIGNAL_NAME(MatlabInterpreterEngine, ScopedErrorText), text);
+   }
+
+   if (mScopedCommandDepth == 0 || mGlobalOutputShown)
+   {
+      notify(SIGNAL_NAME(Interpreter, ErrorText), text);
+   } 
+}
+
+bool MatlabInterpreterEngine::executeCommandInMatlab(const std::string& command)
+{
+   return engOutputBuffer(mpMatlabEngine, NULL, 0) == 0 &&
+      engEvalString(mpMatlabEngine, command.c_str()) == 0;
+}
+
+QString MatlabInterpreterEngine::getOutputFileName() const
+{
+   return QDir::temp().filePath(QString("OpticksMatlabOutput%1.txt").arg(QCoreApplication::applicationPid()));
+}
+
+bool MatlabInterpreterEngine::executeCommandInMatlab(const std::string& command, std::string& output,
+   bool& outputIsError, bool& outputTruncated)
+{
+   // Setup the output buffer.
+   // Check the buffer size before running each command so settings do not require a restart. The buffer starts
+   // small and grows to fit the output of earlier commands, up to the size given by the setting. Between commands
+   // the buffer holds only NULL characters, since MATLAB does not NULL-terminate its output.
+   const int maxBufferSize = MatlabInterpreter::getSettingOutputBufferSize();
+   bool captureOutput = maxBufferSize > 0;
+   if (captureOutput == true &&
+      (mOutputBuffer.empty() == true || mOutputBuffer.size() > static_cast<size_t>(maxBufferSize)))
+   {
+      try
+      {
+         // This can throw if there is not enough memory available.
+         mOutputBuffer.assign(std::min(maxBufferSize, sInitialOutputBufferSize), 0);
+      }
+      catch (const std::bad_alloc&)
+      {
+         captureOutput = false;
+         QString errorMessage = QString("Unable to allocate buffer of %1 bytes").arg(
+            std::min(maxBufferSize, sInitialOutputBufferSize));
+         sendError(errorMessage.toStdString());
+      }
+   }
+
+   if (captureOutput == false)
+   {
+      mOutputBuffer.clear();
+      engOutputBuffer(mpMatlabEngine, NULL, 0);
+   }
+   else
+   {
+      engOutputBuffer(mpMatlabEngine, &mOutputBuffer[0], static_cast<int>(mOutputBuffer.size()));
+   }
+
+   // Run the command. Its output is captured with evalc and printed into the buffer if it fits, or written to a
+   // temporary file if it does not, so output is never lost to a full buffer. The command is run inside a try
+   // block within the text passed to evalc, so output printed before an error is kept. The catch block stores the
+   // error in a variable. When checking for errors, this is the message, so that fetching the variable is the only
+   // other call to the engine. Otherwise, it is the error structure, which is rethrown once the output has been
+   // printed so that MATLAB reports the error as it would for the command alone. The outer try block catches
+   // syntax errors in the command, and errors are cleared by the same call when requested.
+   const bool checkErrors = MatlabInterpreter::getSettingCheckErrors();
+   const bool clearErrors = MatlabInterpreter::getSettingClearErrors();
+   const QString outputFileName = getOutputFileName();
+   QFile::remove(outputFileName);
+
+   std::string evalCommand = command;
+   if (captureOutput == true)
+   {
+      const std::string capturedCommand = "try\n" + command + "\ncatch\nopticks_error__ = " +
+         (checkErrors == true ? "lasterr" : "lasterror") + ";\nend";
+      evalCommand = "opticks_output__ = evalc(" + toMatlabText(capturedCommand) + ");";
+   }
+   else if (checkErrors == true)
+   {
+      evalCommand = "eval(" + toMatlabText(command) + ");";
+   }
+
+   if (checkErrors == true)
+   {
+      evalCommand = "clear opticks_error__; try, " + evalCommand + " catch, " +
+         (captureOutput ? "opticks_output__ = ''; " : "") + "opticks_error__ = lasterr; end;";
+   }
+
+   if (captureOutput == true)
+   {
+      // The buffer holds bytes rather than characters. ASCII output needs one byte per character, and any other
+      // character needs at most four, so only output which is certain to fit is printed into the buffer.
+      const size_t bufferLimit = mOutputBuffer.size() - 1;
+      evalCommand += QString(" if numel(opticks_output__) < %1 && (numel(opticks_output__) < %2 || "
+         "all(opticks_output__ < 128)), fprintf('%s', opticks_output__); else, "
+         "opticks_file__ = fopen(%3, 'w'); fwrite(opticks_file__, opticks_output__, 'char'); "
+         "fclose(opticks_file__); clear opticks_file__; end; clear opticks_output__;")
+         .arg(static_cast<qulonglong>(bufferLimit)).arg(static_cast<qulonglong>(bufferLimit / 4))
+         .arg(QString::fromStdString(MatlabFunctions::toMatlabString(outputFileName.toStdString()))).toStdString();
+      if (checkErrors == false)
+      {
+         evalCommand += " if exist('opticks_error__', 'var'), lasterror(opticks_error__); clear opticks_error__; "
+            "rethrow(lasterror); end;";
+      }
+   }
+
+   if (checkErrors == true && clearErrors == true)
+   {
+      evalCommand += " lasterror('reset');";
+   }
+
+   int retVal = engEvalString(mpMatlabEngine, evalCommand.c_str());
+
+   // Gather the output from the buffer, clearing only the characters which were written.
+   output.clear();
+   outputTruncated = false;
+   if (mOutputBuffer.empty() == false)
+   {
+      const size_t length = std::find(mOutputBuffer.begin(), mOutputBuffer.end(), 0) - mOutputBuffer.begin();
+      output.assign(&mOutputBuffer[0], length);
+      memset(&mOutputBuffer[0], 0, length);
+      outputTruncated = (length == mOutputBuffer.size());
+   }
+
+   // Output which did not fit in the buffer was written to the file instead.
+   QFile outputFile(outputFileName);
+   if (outputFile.open(QIODevice::ReadOnly) == true)
+   {
+      const QByteArray text = outputFile.readAll();
+      output.append(text.constData(), text.size());
+      outputFile.close();
+      outputFile.remove();
+   }
+
+   // Grow the buffer so that output of the same length fits the next time.
+   if (captureOutput == true && output.size() >= mOutputBuffer.size() &&
+      mOutputBuffer.size() < static_cast<size_t>(maxBufferSize))
+   {
+      size_t newSize = mOutputBuffer.size();
+      while (newSize <= output.size() && newSize < static_cast<size_t>(maxBufferSize))
+      {
+         newSize *= 2;
+      }
+
+      try
+      {
+         mOutputBuffer.resize(std::min(newSize, static_cast<size_t>(maxBufferSize)), 0);
+      }
+      catch (const std::bad_alloc&)
+      {
+         // Keep using the current buffer, since larger output is still written to the file.
+      }
+   }
+
+   // Check whether the command resulted in an error. The variable only exists if an error was caught.
+   outputIsError = false;
+   if (retVal == 0 && checkErrors == true)
+   {
+      mxArray* pError = getMatlabVariable("opticks_error__");
+      if (pError != NULL)
+      {
+         char* pMessage = mxArrayToString(pError);
+         mxDestroyArray(pError);
+         engEvalString(mpMatlabEngine, "clear opticks_error__;");
+
+         const QString error = QString(pMessage == NULL ? "" : pMessage).trimmed();
+         mxFree(pMessage);
+         if (error.isEmpty() == false)
+         {
+            // Keep anything which was printed before the error, as MATLAB's own command window does.
+            if (output.empty() == false && output[output.size() - 1] != '\n')
+            {
+               output += '\n';
+            }
+
+            output += error.toStdString();
+            outputIsError = true;
+         }
+      }
+   }
+
+   if (retVal == 0 && checkErrors == false && clearErrors == true)
+   {
+      engEvalString(mpMatlabEngine, "lasterror('reset');");
+   }
+
+   return retVal == 0;
+}
+
+bool MatlabInterpreterEngine::hideCommandWindow()
+{
+   return engSetVisible(mpMatlabEngine, false) == 0;
+}
+
+bool MatlabInterpreterEngine::showCommandWindow()
+{
+   return engSetVisible(mpMatlabEngine, true) == 0;
+}
+
+bool MatlabInterpreterEngine::getMatlabVariableAsString(const std::string& name, std::string& value)
+{
+   std::string output;
+   bool outputIsError = false;
+   bool outputTruncated = false;
+   if (executeCommandInMatlab(name, output, outputIsError, outputTruncated) == false ||
+      outputIsError == true || outputTruncated == true || output.empty() == true)
+   {
+      return false;
+   }
+
+   std::string isCharOutput;
+   if (executeCommandInMatlab("ischar(" + name + ")", isCharOutput, outputIsError, outputTruncated) == false ||
+      outputIsError == true || outputTruncated == true || isCharOutput.empty() == true)
+   {
+      return false;
+   }
+
+   // Massage the output into something more readable.
+   //    - Remove leading and trailing spaces.
+   //    - For all non-character types, remove intermediate spaces as well.
+   QString formattedOutput = QString::fromStdString(output);
+   formattedOutput = formattedOutput.remove('\n');
+   isCharOutput = QString::fromStdString(isCharOutput).remove('\n').remove(' ').trimmed().toStdString();
+   if (isCharOutput.find("ans=1") == std::string::npos)
+   {
+      formattedOutput = formattedOutput.remove(' ');
+   }
+   else
+   {
+      // If it is a string, check whether it is empty.
+      // MATLAB outputs '' for empty strings, but that is not safe to check since a string containing
+      // two apostrophes ('''''') is equivalent once whitespace has been removed.
+      std::string isEmptyOutput;
+      if (executeCommandInMatlab("isempty(" + name + ")", isEmptyOutput, outputIsError, outputTruncated) == false ||
+         outputIsError == true || outputTruncated == true || isEmptyOutput.empty() == true)
+      {
+         return false;
+      }
+
+      isEmptyOutput = QString::fromStdString(isEmptyOutput).remove('\n').remove(' ').trimmed().toStdString();
+      if (isEmptyOutput.find("ans=1") != std::string::npos)
+      {
+         value.clear();
+         return true;
+      }
+   }
+
+   formattedOutput = formattedOutput.trimmed();
+   value = formattedOutput.toStdString();
+   std::string::size_type pos = value.find('=');
+   if (pos != std::string::npos)
+   {
+      value = value.substr(pos + 1, std::string::npos);
+   }
+
+   return true;
+}
+
+mxArray* MatlabInterpreterEngine::getMatlabVariable(const std::string& name)
+{
+   return engGetVariable(mpMatlabEngine, name.c_str());
+}
+
+bool MatlabInterpreterEngine::setMatlabVariable(const std::string& name, const mxArray* pArray)
+{
+   return engPutVariable(mpMatlabEngine, name.c_str(), pArray) == 0;
+}
+
+mxArray* MatlabInterpreterEngine::evaluateMatlabExpressions(const std::vector<std::string>& expressions)
+{
+   mxArray* pValues = mxCreateCellMatrix(1, expressions.size());
+   if (pValues == NULL || expressions.empty() == true || isMatlabRunning() == false)
+   {
+      return pValues;
+   }
+
+   // Collect the values into a cell array which is fetched with one call. Each value is wrapped in a cell of its own
+   // so that it can be told apart from an expression which failed and left its cell empty. Only strings and scalars
+   // are collected, so that an argument which names a large array is checked in MATLAB instead of being fetched.
+   QString command = QString("opticks_arguments__ = cell(1, %1);").arg(static_cast<qulonglong>(expressions.size()));
+   for (std::vector<std::string>::size_type i = 0; i < expressions.size(); ++i)
+   {
+      command += QString(" try, opticks_argument__ = (%2); if (ischar(opticks_argument__) && "
+         "ndims(opticks_argument__) == 2 && size(opticks_argument__, 1) <= 1) || "
+         "((isnumeric(opticks_argument__) || islogical(opticks_argument__)) && "
+         "isreal(opticks_argument__) && numel(opticks_argument__) == 1), "
+         "opticks_arguments__{%1} = {opticks_argument__}; end; end;")
+         .arg(static_cast<qulonglong>(i + 1)).arg(QString::fromStdString(expressions[i]));
+   }
+
+   command += " clear opticks_argument__;";
+
+   std::string output;
+   bool outputIsError = false;
+   bool outputTruncated = false;
+   if (executeCommandInMatlab(command.toStdString(), output, outputIsError, outputTruncated) == false ||
+      outputIsError == true)
+   {
+      return pValues;
+   }
+
+   mxArray* pArguments = getMatlabVariable("opticks_arguments__");
+   engEvalString(mpMatlabEngine, "clear opticks_arguments__;");
+   if (pArguments != NULL && mxIsCell(pArguments) == true && mxGetNumberOfElements(pArguments) == expressions.size())
+   {
+      for (std::vector<std::string>::size_type i = 0; i < expressions.size(); ++i)
+      {
+         const mxArray* pWrapper = mxGetCell(pArguments, i);
+         if (pWrapper != NULL && mxIsCell(pWrapper) == true && mxGetNumberOfElements(pWrapper) == 1 &&
+            mxGetCell(pWrapper, 0) != NULL)
+         {
+            mxSetCell(pValues, i, mxDuplicateArray(mxGetCell(pWrapper, 0)));
+         }
+      }
+   }
+
+   if (pArguments != NULL)
+   {
+      mxDestroyArray(pArguments);
+   }
+
+   return pValues;
+}
+
+void* MatlabInterpreterEngine::mapSharedVariable(size_t size)
+{
+   unmapSharedVariable();
+   if (isMatlabRunning() == false || size == 0)
+   {
+      return NULL;
+   }
+
+   // A single file is reused for every transfer made by a command and removed once the command finishes.
+   if (mSharedFile.isOpen() == false)
+   {
+      mSharedFile.setFileName(QDir::temp().filePath(
+         QString("OpticksMatlab%1.dat").arg(QCoreApplication::applicationPid())));
+      if (mSharedFile.open(QIODevice::ReadWrite | QIODevice::Truncate) == false)
+      {
+         return NULL;
+      }
+   }
+
+   // The file only grows while it exists, so a smaller transfer uses its beginning and MATLAB maps a single record.
+   const qint64 fileSize = static_cast<qint64>(size);
+   if (mSharedFile.size() < fileSize && mSharedFile.resize(fileSize) == false)
+   {
+      return NULL;
+   }
+
+   mpSharedData = mSharedFile.map(0, fileSize);
+   return mpSharedData;
+}
+
+bool MatlabInterpreterEngine::setSharedVariable(const std::string& name, const std::string& className,
+   const std::vector<size_t>& dims)
+{
+   if (mpSharedData == NULL)
+   {
+      return false;
+   }
+
+   // Both processes map the same file, so the data written by Opticks is visible to MATLAB as soon as it is
+   // unmapped here. MATLAB copies it out of its own mapping, so nothing is serialized through the engine.
+   unmapSharedVariable();
+
+   QStringList dimensions;
+   for (std::vector<size_t>::const_iterator iter = dims.begin(); iter != dims.end(); ++iter)
+   {
+      dimensions.append(QString::number(static_cast<qulonglong>(*iter)));
+   }
+
+   // The memmapfile object is cleared right away so that the file can be resized for the next transfer.
+   QString command = QString("try, opticks_shared_map__ = memmapfile(%1, 'Format', {'%2', [%3], 'x'}, "
+      "'Repeat', 1); %4 = opticks_shared_map__.Data.x; opticks_shared_ok__ = true; "
+      "catch, opticks_shared_ok__ = false; end; clear opticks_shared_map__;")
+      .arg(QString::fromStdString(MatlabFunctions::toMatlabString(mSharedFile.fileName().toStdString())),
+      QString::fromStdString(className), dimensions.join(" "), QString::fromStdString(name));
+   if (executeCommandInMatlab(command.toStdString()) == false)
+   {
+      return false;
+   }
+
+   mxArray* pSuccess = getMatlabVariable("opticks_shared_ok__");
+   executeCommandInMatlab("clear opticks_shared_ok__;");
+   if (pSuccess == NULL)
+   {
+      return false;
+   }
+
+   const bool success = mxIsLogicalScalarTrue(pSuccess);
+   mxDestroyArray(pSuccess);
+   return success;
+}
+
+void MatlabInterpreterEngine::unmapSharedVariable()
+{
+   if (mpSharedData != NULL)
+   {
+      mSharedFile.unmap(mpSharedData);
+      mpSharedData = NULL;
+   }
+}
+
+void MatlabInterpreterEngine::removeSharedFile()
+{
+   unmapSharedVariable();
+   if (mSharedFile.fileName().isEmpty() == false)
+   {
+      mSharedFile.remove();
+      mSharedFile.setFileName(QString());
+   }
+}
+
+bool MatlabInterpreterEngine::restoreTransfer(const std::string& name, RasterElement* pElement,
+   const std::string& key)
+{
+   if (isMatlabRunning() == false || pElement == NULL)
+   {
+      return false;
+   }
+
+   // Release every remembered copy as soon as the cache is turned off.
+   if (MatlabInterpreter::getSettingTransferCache() == false)
+   {
+      if (mElementGenerations.empty() == false)
+      {
+         clearTransferCache();
+         executeCommandInMatlab("clear opticks_transfer_cache__;");
+      }
+
+      return false;
+   }
+
+   std::map<std::string, CachedTransfer>::iterator transfer = mTransfers.find(name);
+   if (transfer == mTransfers.end())
+   {
+      return false;
+   }
+
+   Subject* pSubject = pElement;
+   std::map<Subject*, unsigned int>::const_iterator generation = mElementGenerations.find(pSubject);
+   if (transfer->second.mpElement != pSubject || transfer->second.mKey != key ||
+      generation == mElementGenerations.end() || generation->second != transfer->second.mGeneration)
+   {
+      return false;
+   }
+
+   // Assigning the remembered copy only shares its data, so nothing is copied unless either one is changed
+   // afterwards. This also undoes any changes which were made to the variable in MATLAB.
+   const QString command = QString("%1%2 = opticks_transfer_cache__.%2;")
+      .arg(QString::fromStdString(pruneTransferCache()), QString::fromStdString(name));
+   if (executeCheckedCommandInMatlab(command.toStdString()) == false)
+   {
+      // The cache was cleared in MATLAB, so the copy has to be made again.
+      mTransfers.erase(name);
+      return false;
+   }
+
+   return true;
+}
+
+void MatlabInterpreterEngine::recordTransfer(const std::string& name, RasterElement* pElement,
+   const std::string& key)
+{
+   mTransfers.erase(name);
+   if (isMatlabRunning() == false || pElement == NULL || MatlabInterpreter::getSettingTransferCache() == false)
+   {
+      return;
+   }
+
+   // Copies are kept as fields of a single struct, so only plain variable names can be remembered.
+   if (QRegExp("[A-Za-z]\\w*").exactMatch(QString::fromStdString(name)) == false)
+   {
+      return;
+   }
+
+   const QString command = QString("%1opticks_transfer_cache__.%2 = %2;")
+      .arg(QString::fromStdString(pruneTransferCache()), QString::fromStdString(name));
+   if (executeCheckedCommandInMatlab(command.toStdString()) == false)
+   {
+      return;
+   }
+
+   Subject* pSubject = pElement;
+   std::map<Subject*, unsigned int>::iterator generation = mElementGenerations.find(pSubject);
+   if (generation == mElementGenerations.end())
+   {
+      pSubject->attach(SIGNAL_NAME(Subject, Modified), Slot(this, &MatlabInterpreterEngine::elementModified));
+      pSubject->attach(SIGNAL_NAME(Subject, Deleted), Slot(this, &MatlabInterpreterEngine::elementDeleted));
+      generation = mElementGenerations.insert(std::make_pair(pSubject, 0U)).first;
+   }
+
+   CachedTransfer transfer;
+   transfer.mpElement = pSubject;
+   transfer.mKey = key;
+   transfer.mGeneration = generation->second;
+   mTransfers[name] = transfer;
+}
+
+TransferPool& MatlabInterpreterEngine::getTransferPool()
+{
+   // The setting is in megabytes, and is limited so that the number of bytes fits in a size_t.
+   const size_t poolSize = static_cast<size_t>(std::max(MatlabInterpreter::getSettingTransferPoolSize(), 0));
+   mTransferPool.setMaxArrayBytes(std::min(poolSize, std::numeric_limits<size_t>::max() >> 20) << 20);
+   return mTransferPool;
+}
+
+bool MatlabInterpreterEngine::executeCheckedCommandInMatlab(const std::string& command)
+{
+   const std::string checkedCommand = "try, " + command +
+      " opticks_command_ok__ = true; catch, opticks_command_ok__ = false; end;";
+   if (executeCommandInMatlab(checkedCommand) == false)
+   {
+      return false;
+   }
+
+   mxArray* pSuccess = getMatlabVariable("opticks_command_ok__");
+   executeCommandInMatlab("clear opticks_command_ok__;");
+   if (pSuccess == NULL)
+   {
+      return false;
+   }
+
+   const bool success = mxIsLogicalScalarTrue(pSuccess);
+   mxDestroyArray(pSuccess);
+   return success;
+}
+
+void MatlabInterpreterEngine::elementModified(Subject& subject, const std::string& signal, const boost::any& data)
+{
+   // Copies made before this generation no longer match the element. They are released from MATLAB the next
+   // time the cache is used, since the element may be modified many times before then.
+   std::map<Subject*, unsigned int>::iterator generation = mElementGenerations.find(&subject);
+   if (generation != mElementGenerations.end())
+   {
+      ++generation->second;
+   }
+}
+
+void MatlabInterpreterEngine::elementDeleted(Subject& subject, const std::string& signal, const boost::any& data)
+{
+   // Forget the element right away, since a new element could be created at the same address.
+   mElementGenerations.erase(&subject);
+   for (std::map<std::string, CachedTransfer>::iterator iter = mTransfers.begin(); iter != mTransfers.end();)
+   {
+      if (iter->second.mpElement == &subject)
+      {
+         mStaleTransfers.push_back(iter->first);
+         mTransfers.erase(iter++);
+      }
+      else
+      {
+         ++iter;
+      }
+   }
+}
+
+std::string MatlabInterpreterEngine::pruneTransferCache()
+{
+   for (std::map<std::string, CachedTransfer>::iterator iter = mTransfers.begin(); iter != mTransfers.end();)
+   {
+      std::map<Subject*, unsigned int>::const_iterator generation = mElementGenerations.find(iter->second.mpElement);
+      if (generation == mElementGenerations.end() || generation->second != iter->second.mGeneration)
+      {
+         mStaleTransfers.push_back(iter->first);
+         mTransfers.erase(iter++);
+      }
+      else
+      {
+         ++iter;
+      }
+   }
+
+   // Each field is removed in its own try block, since the cache may have been cleared in MATLAB.
+   std::string command;
+   for (std::vector<std::string>::const_iterator iter = mStaleTransfers.begin(); iter != mStaleTransfers.end(); ++iter)
+   {
+      command += "try, opticks_transfer_cache__ = rmfield(opticks_transfer_cache__, '" + *iter + "'); end; ";
+   }
+
+   mStaleTransfers.clear();
+   return command;
+}
+
+void MatlabInterpreterEngine::clearTransferCache()
+{
+   for (std::map<Subject*, unsigned int>::iterator iter = mElementGenerations.begin();
+      iter != mElementGenerations.end(); ++iter)
+   {
+      iter->first->detach(SIGNAL_NAME(Subject, Modified), Slot(this, &MatlabInterpreterEngine::elementModified));
+      iter->first->detach(SIGNAL_NAME(Subject, Deleted), Slot(this, &MatlabInterpreterEngine::elementDeleted));
+   }
+
+   mElementGenerations.clear();
+   mTransfers.clear();
+   mStaleTransfers.clear();
+}
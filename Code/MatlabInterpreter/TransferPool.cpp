@@ -0,0 +1,126 @@
+/*
+ * The information in this file is
+ * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
+ * and is subject to the terms and conditions of the
+ * GNU Lesser General Public License Version 2.1
+ * The license text is available from   
+ * http://www.gnu.org/licenses/lgpl.html
+ */
+
+#include "TransferPool.h"
+
+#include <algorithm>
+
+namespace
+{
+   // The number of released arrays which are kept. This covers a few variables being transferred in turn, such
+   // as the tiles of a stream and the final partial tile.
+   const size_t sMaxArrays = 4;
+
+   // The default limit on the bytes held by released arrays, which matches the TransferPoolSize setting.
+   const size_t sDefaultMaxArrayBytes = 1024 * 1024 * 1024;
+
+   size_t getArrayBytes(const mxArray* pArray)
+   {
+      return mxGetNumberOfElements(pArray) * mxGetElementSize(pArray);
+   }
+}
+
+TransferPool::TransferPool() :
+   mArrayBytes(0),
+   mMaxArrayBytes(sDefaultMaxArrayBytes)
+{}
+
+TransferPool::~TransferPool()
+{
+   clear();
+}
+
+mxArray* TransferPool::acquireArray(mxClassID classId, mwSize nDims, const mwSize* pDims)
+{
+   // Search the most recently released arrays first, since a loop usually transfers the same array each time.
+   for (std::vector<mxArray*>::reverse_iterator iter = mArrays.rbegin(); iter != mArrays.rend(); ++iter)
+   {
+      mxArray* pArray = *iter;
+      if (mxGetClassID(pArray) == classId && mxGetNumberOfDimensions(pArray) == nDims &&
+         std::equal(pDims, pDims + nDims, mxGetDimensions(pArray)) == true)
+      {
+         mArrays.erase(iter.base() - 1);
+         mArrayBytes -= getArrayBytes(pArray);
+         return pArray;
+      }
+   }
+
+   mxArray* pArray = mxCreateNumericArray(nDims, pDims, classId, mxREAL);
+   if (pArray == NULL && mArrays.empty() == false)
+   {
+      // Give the memory held by the pool back and try again.
+      destroyArrays();
+      pArray = mxCreateNumericArray(nDims, pDims, classId, mxREAL);
+   }
+
+   return pArray;
+}
+
+void TransferPool::releaseArray(mxArray* pArray)
+{
+   if (pArray == NULL)
+   {
+      return;
+   }
+
+   const size_t bytes = getArrayBytes(pArray);
+   if (bytes > mMaxArrayBytes)
+   {
+      mxDestroyArray(pArray);
+      return;
+   }
+
+   trimArrays(sMaxArrays - 1, mMaxArrayBytes - bytes);
+   mArrays.push_back(pArray);
+   mArrayBytes += bytes;
+}
+
+void TransferPool::setMaxArrayBytes(size_t maxBytes)
+{
+   mMaxArrayBytes = maxBytes;
+   trimArrays(sMaxArrays, mMaxArrayBytes);
+}
+
+std::vector<double>& TransferPool::getBuffer(size_t index)
+{
+   if (index >= mBuffers.size())
+   {
+      mBuffers.resize(index + 1);
+   }
+
+   return mBuffers[index];
+}
+
+void TransferPool::clear()
+{
+   destroyArrays();
+   mBuffers.clear();
+}
+
+void TransferPool::destroyArrays()
+{
+   for (std::vector<mxArray*>::iterator iter = mArrays.begin(); iter != mArrays.end(); ++iter)
+   {
+      mxDestroyArray(*iter);
+   }
+
+   mArrays.clear();
+   mArrayBytes = 0;
+}
+
+void TransferPool::trimArrays(size_t maxCount, size_t maxBytes)
+{
+   // Destroy the least recently released arrays first.
+   while (mArrays.empty() == false && (mArrays.size() > maxCount || mArrayBytes > maxBytes))
+   {
+      mArrayBytes -= getArrayBytes(mArrays.front());
+      mxDestroyArray(mArrays.front());
+      mArrays.erase(mArrays.begin());
+   }
+}
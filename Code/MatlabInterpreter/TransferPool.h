@@ -0,0 +1,79 @@
+/*
+ * The information in this file is
+ * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
+ * and is subject to the terms and conditions of the
+ * GNU Lesser General Public License Version 2.1
+ * The license text is available from   
+ * http://www.gnu.org/licenses/lgpl.html
+ */
+
+#ifndef TRANSFERPOOL_H
+#define TRANSFERPOOL_H
+
+#include <matrix.h>
+
+#include <stddef.h>
+#include <deque>
+#include <vector>
+
+/**
+ * Arrays and scratch buffers which are kept between transfers, so that commands which repeatedly copy data of the
+ * same class and size do not allocate once the pool holds what they need.
+ *
+ * The pool is owned by the interpreter and is only used from the thread which runs internal commands. It is kept
+ * between commands, so a loop which runs one command per frame reuses its arrays, and is cleared when MATLAB is
+ * started again.
+ */
+class TransferPool
+{
+public:
+   TransferPool();
+   ~TransferPool();
+
+   /**
+    * Returns a real numeric array of the given class and dimensions, reusing one which was released earlier when
+    * one matches exactly. The contents of a reused array are undefined, so the caller must write every element.
+    *
+    * The array must be handed back with releaseArray rather than destroyed. If the array cannot be allocated, the
+    * pooled arrays are freed and the allocation is tried again. Returns NULL if it still fails.
+    */
+   mxArray* acquireArray(mxClassID classId, mwSize nDims, const mwSize* pDims);
+
+   /**
+    * Returns an array from acquireArray to the pool. Only the most recently released arrays are kept, up to a
+    * fixed number of arrays and the limit set with setMaxArrayBytes, so a series of differently-sized transfers
+    * cannot hold on to an unbounded amount of memory. An array which is larger than the limit by itself is
+    * destroyed instead.
+    */
+   void releaseArray(mxArray* pArray);
+
+   /**
+    * Sets the largest number of bytes held by released arrays, destroying the oldest arrays if the pool now holds
+    * more than that. Zero disables pooling of arrays.
+    */
+   void setMaxArrayBytes(size_t maxBytes);
+
+   /**
+    * Returns the scratch buffer with the given index. Its contents are left over from the previous user, and
+    * resizing it within its capacity does not allocate. Buffers are never moved, so references to other buffers
+    * stay valid.
+    */
+   std::vector<double>& getBuffer(size_t index);
+
+   // Frees every pooled array and buffer.
+   void clear();
+
+private:
+   TransferPool(const TransferPool& rhs);
+   TransferPool& operator=(const TransferPool& rhs);
+
+   void destroyArrays();
+   void trimArrays(size_t maxCount, size_t maxBytes);
+
+   std::vector<mxArray*> mArrays;
+   size_t mArrayBytes;
+   size_t mMaxArrayBytes;
+   std::deque<std::vector<double> > mBuffers;
+};
+
+#endif
@@ -1,71 +1,71 @@
-/*
- * The information in this file is
- * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
- * and is subject to the terms and conditions of the
- * GNU Lesser General Public License Version 2.1
- * The license text is available from   
- * http://www.gnu.org/licenses/lgpl.html
- */
-
-#ifndef VISUALIZATIONCOMMANDS_H
-#define VISUALIZATIONCOMMANDS_H
-
-#include "MatlabInternalCommand.h"
-
-class GetStretchUnitsCommand : public MatlabInternalCommand
-{
-public:
-   GetStretchUnitsCommand(const std::string& name);
-   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
-      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
-};
-
-class GetStretchTypeCommand : public MatlabInternalCommand
-{
-public:
-   GetStretchTypeCommand(const std::string& name);
-   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
-      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
-};
-
-class GetStretchValuesCommand : public MatlabInternalCommand
-{
-public:
-   GetStretchValuesCommand(const std::string& name);
-   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
-      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
-};
-
-class SetColorMapCommand : public MatlabInternalCommand
-{
-public:
-   SetColorMapCommand(const std::string& name);
-   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
-      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
-};
-
-class SetStretchUnitsCommand : public MatlabInternalCommand
-{
-public:
-   SetStretchUnitsCommand(const std::string& name);
-   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
-      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
-};
-
-class SetStretchTypeCommand : public MatlabInternalCommand
-{
-public:
-   SetStretchTypeCommand(const std::string& name);
-   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
-      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
-};
-
-class SetStretchValuesCommand : public MatlabInternalCommand
-{
-public:
-   SetStretchValuesCommand(const std::string& name);
-   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
-      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
-};
-
-#endif
+/*
+ * The information in this file is
+ * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
+ * and is subject to the terms and conditions of the
+ * GNU Lesser General Public License Version 2.1
+ * The license text is available from   
+ * http://www.gnu.org/licenses/lgpl.html
+ */
+
+#ifndef VISUALIZATIONCOMMANDS_H
+#define VISUALIZATIONCOMMANDS_H
+
+#include "MatlabInternalCommand.h"
+
+class GetStretchUnitsCommand : public MatlabInternalCommand
+{
+public:
+   GetStretchUnitsCommand(const std::string& name);
+   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
+      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
+};
+
+class GetStretchTypeCommand : public MatlabInternalCommand
+{
+public:
+   GetStretchTypeCommand(const std::string& name);
+   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
+      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
+};
+
+class GetStretchValuesCommand : public MatlabInternalCommand
+{
+public:
+   GetStretchValuesCommand(const std::string& name);
+   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
+      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
+};
+
+class SetColorMapCommand : public MatlabInternalCommand
+{
+public:
+   SetColorMapCommand(const std::string& name);
+   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
+      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
+};
+
+class SetStretchUnitsCommand : public MatlabInternalCommand
+{
+public:
+   SetStretchUnitsCommand(const std::string& name);
+   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
+      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
+};
+
+class SetStretchTypeCommand : public MatlabInternalCommand
+{
+public:
+   SetStretchTypeCommand(const std::string& name);
+   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
+      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
+};
+
+class SetStretchValuesCommand : public MatlabInternalCommand
+{
+public:
+   SetStretchValuesCommand(const std::string& name);
+   std::string execute(MatlabInterpreter& matlabInterpreter, const std::vector<std::string>& strCmds,
+      const std::vector<std::string>& strVars, std::string& output, bool& outputIsError);
+};
+
+#endif
@@ -1,16 +1,16 @@
-/*
- * The information in this file is
- * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
- * and is subject to the terms and conditions of the
- * GNU Lesser General Public License Version 2.1
- * The license text is available from   
- * http://www.gnu.org/licenses/lgpl.html
- */
-
-#include "PlugInRegistration.h"
-
-#if !defined(_MSC_VER)
-#error Unrecognized build platform
-#endif
-
-REGISTER_MODULE(Matlab);
+/*
+ * The information in this file is
+ * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
+ * and is subject to the terms and conditions of the
+ * GNU Lesser General Public License Version 2.1
+ * The license text is available from   
+ * http://www.gnu.org/licenses/lgpl.html
+ */
+
+#include "PlugInRegistration.h"
+
+#if !defined(_MSC_VER)
+#error Unrecognized build platform
+#endif
+
+REGISTER_MODULE(Matlab);
@@ -0,0 +1,214 @@
+/*
+ * The information in this file is
+ * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
+ * and is subject to the terms and conditions of the
+ * GNU Lesser General Public License Version 2.1
+ * The license text is available from   
+ * http://www.gnu.org/licenses/lgpl.html
+ */
+
+#include "TransferPool.h"
+
+#include <engine.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string.h>
+#include <string>
+#include <vector>
+
+// Runs the mock MATLAB engine without Opticks, so that it can be tested and used to try out MATLAB code on any
+// platform. With no arguments, a test suite of the engine calls and commands used by the interpreter is run and the
+// exit code is the number of failed tests. With a file name, each line of the file is evaluated on its own and its
+// output is printed.
+namespace
+{
+   const int sBufferSize = 65536;
+
+   class MockSession
+   {
+   public:
+      MockSession() :
+         mpEngine(engOpen(NULL)),
+         mBuffer(sBufferSize, 0)
+      {
+         engOutputBuffer(mpEngine, &mBuffer[0], sBufferSize - 1);
+      }
+
+      ~MockSession()
+      {
+         engClose(mpEngine);
+      }
+
+      Engine* getEngine() const
+      {
+         return mpEngine;
+      }
+
+      // Evaluates the command and returns its output. The engine does not NULL-terminate the output, so the buffer
+      // is cleared first.
+      std::string evaluate(const std::string& command)
+      {
+         memset(&mBuffer[0], 0, mBuffer.size());
+         engEvalString(mpEngine, command.c_str());
+         return std::string(&mBuffer[0]);
+      }
+
+   private:
+      MockSession(const MockSession& rhs);
+      MockSession& operator=(const MockSession& rhs);
+
+      Engine* mpEngine;
+      std::vector<char> mBuffer;
+   };
+
+   int sFailures = 0;
+
+   void check(bool condition, const std::string& description)
+   {
+      if (condition == false)
+      {
+         std::cout << "   Error with " << description << "." << std::endl;
+         ++sFailures;
+      }
+   }
+
+   void testRoundTrip(MockSession& session)
+   {
+      const mwSize dims[] = { 2, 3, 4 };
+      mxArray* pArray = mxCreateNumericArray(3, dims, mxDOUBLE_CLASS, mxREAL);
+      double* pData = mxGetPr(pArray);
+      for (size_t i = 0; i < 24; ++i)
+      {
+         pData[i] = static_cast<double>(i + 1);
+      }
+
+      check(engPutVariable(session.getEngine(), "A", pArray) == 0, "engPutVariable");
+      mxDestroyArray(pArray);
+
+      session.evaluate("B = A(:, 1:2:end, 1:3:end) * 2;");
+      mxArray* pResult = engGetVariable(session.getEngine(), "B");
+      check(pResult != NULL, "engGetVariable");
+      if (pResult != NULL)
+      {
+         // The strided copy keeps columns 1 and 3 of bands 1 and 4.
+         const double expected[] = { 2, 4, 10, 12, 38, 40, 46, 48 };
+         const mwSize* pDims = mxGetDimensions(pResult);
+         check(mxGetClassID(pResult) == mxDOUBLE_CLASS && mxGetNumberOfDimensions(pResult) == 3 &&
+            pDims[0] == 2 && pDims[1] == 2 && pDims[2] == 2 &&
+            std::equal(expected, expected + 8, mxGetPr(pResult)) == true, "a strided round trip");
+         mxDestroyArray(pResult);
+      }
+
+      session.evaluate("clear A B;");
+   }
+
+   void testConversion(MockSession& session)
+   {
+      session.evaluate("C = uint8([0.4, 1.5; -3, 300]);");
+      mxArray* pResult = engGetVariable(session.getEngine(), "C");
+      check(pResult != NULL && mxGetClassID(pResult) == mxUINT8_CLASS, "uint8 conversion");
+      if (pResult != NULL)
+      {
+         const unsigned char expected[] = { 0, 0, 2, 255 };
+         check(mxGetNumberOfElements(pResult) == 4 &&
+            memcmp(mxGetData(pResult), expected, sizeof(expected)) == 0, "uint8 rounding and saturation");
+         mxDestroyArray(pResult);
+      }
+
+      session.evaluate("clear C;");
+   }
+
+   void testOutput(MockSession& session)
+   {
+      check(session.evaluate("x = 1 + 2") == "x =\n     3\n", "compact output");
+      session.evaluate("clear x;");
+
+      // This is how the interpreter runs commands when it is not checking for errors, so output printed before an
+      // error has to come before the error message.
+      const std::string output = session.evaluate("opticks_output__ = evalc(['try' char(10) "
+         "'disp(''before'');' char(10) 'error(''boom %d'', 3);' char(10) 'catch' char(10) "
+         "'opticks_error__ = lasterror;' char(10) 'end']); fprintf('%s', opticks_output__); "
+         "clear opticks_output__; if exist('opticks_error__', 'var'), lasterror(opticks_error__); "
+         "clear opticks_error__; rethrow(lasterror); end;");
+      check(output == "before\n??? boom 3\n", "output printed before an error");
+
+      // When checking for errors, the message is kept in a variable instead.
+      session.evaluate("clear opticks_error__; try, eval('error(''checked'');'); catch, "
+         "opticks_error__ = lasterr; end;");
+      mxArray* pError = engGetVariable(session.getEngine(), "opticks_error__");
+      check(pError != NULL && mxIsChar(pError) == true, "a checked error");
+      if (pError != NULL)
+      {
+         char* pMessage = mxArrayToString(pError);
+         check(pMessage != NULL && std::string(pMessage) == "checked", "the message of a checked error");
+         mxFree(pMessage);
+         mxDestroyArray(pError);
+      }
+
+      session.evaluate("clear opticks_error__; lasterror('reset');");
+   }
+
+   void testTransferPool()
+   {
+      TransferPool pool;
+      const mwSize dims[] = { 16, 16, 4 };
+      mxArray* pFirst = pool.acquireArray(mxSINGLE_CLASS, 3, dims);
+      pool.releaseArray(pFirst);
+      mxArray* pSecond = pool.acquireArray(mxSINGLE_CLASS, 3, dims);
+      check(pFirst == pSecond, "reusing a pooled array");
+      pool.releaseArray(pSecond);
+
+      // An array of another class must not be handed out for the pooled one.
+      mxArray* pOther = pool.acquireArray(mxDOUBLE_CLASS, 3, dims);
+      check(pOther != NULL && mxGetClassID(pOther) == mxDOUBLE_CLASS, "acquiring an array of another class");
+      pool.releaseArray(pOther);
+
+      // Without any space, released arrays are destroyed rather than pooled.
+      pool.setMaxArrayBytes(0);
+      mxArray* pUnpooled = pool.acquireArray(mxSINGLE_CLASS, 3, dims);
+      check(pUnpooled != NULL, "acquiring an array from an empty pool");
+      pool.releaseArray(pUnpooled);
+      pool.clear();
+   }
+
+   int runScript(const char* pFilename)
+   {
+      std::ifstream script(pFilename);
+      if (script.is_open() == false)
+      {
+         std::cerr << "Unable to open " << pFilename << std::endl;
+         return 1;
+      }
+
+      MockSession session;
+      std::string line;
+      while (std::getline(script, line))
+      {
+         std::cout << session.evaluate(line);
+      }
+
+      return 0;
+   }
+}
+
+int main(int argc, char** argv)
+{
+   if (argc > 1)
+   {
+      return runScript(argv[1]);
+   }
+
+   std::cout << "Testing the mock MATLAB engine. . ." << std::endl;
+   {
+      MockSession session;
+      testRoundTrip(session);
+      testConversion(session);
+      testOutput(session);
+   }
+
+   testTransferPool();
+   std::cout << "Finished running MatlabMockTest." << std::endl;
+   return sFailures;
+}
@@ -0,0 +1,699 @@
+/*
+ * The information in this file is
+ * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
+ * and is subject to the terms and conditions of the
+ * GNU Lesser General Public License Version 2.1
+ * The license text is available from   
+ * http://www.gnu.org/licenses/lgpl.html
+ */
+
+#include "MockArray.h"
+
+#include <algorithm>
+#include <limits>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace
+{
+   const char* const spClassNames[] = { "unknown", "cell", "struct", "logical", "char", "void", "double", "single",
+      "int8", "uint8", "int16", "uint16", "int32", "uint32", "int64", "uint64", "function_handle" };
+
+   template<typename T>
+   T saturate(double value)
+   {
+      if (std::numeric_limits<T>::is_integer == false)
+      {
+         return static_cast<T>(value);
+      }
+
+      if (value != value)
+      {
+         return 0;
+      }
+
+      if (value <= static_cast<double>(std::numeric_limits<T>::min()))
+      {
+         return std::numeric_limits<T>::min();
+      }
+
+      if (value >= static_cast<double>(std::numeric_limits<T>::max()))
+      {
+         return std::numeric_limits<T>::max();
+      }
+
+      return static_cast<T>(value < 0.0 ? ceil(value - 0.5) : floor(value + 0.5));
+   }
+
+   template<typename T>
+   void store(mxArray* pArray, size_t i, double value)
+   {
+      reinterpret_cast<T*>(&pArray->mData[0])[i] = saturate<T>(value);
+   }
+
+   template<typename T>
+   double load(const mxArray* pArray, size_t i)
+   {
+      return static_cast<double>(reinterpret_cast<const T*>(&pArray->mData[0])[i]);
+   }
+
+   void destroyChildren(std::vector<mxArray*>& arrays)
+   {
+      for (std::vector<mxArray*>::iterator iter = arrays.begin(); iter != arrays.end(); ++iter)
+      {
+         mxDestroyArray(*iter);
+      }
+
+      arrays.clear();
+   }
+}
+
+size_t MockArray::getElementSize(mxClassID classId)
+{
+   switch (classId)
+   {
+      case mxLOGICAL_CLASS:
+         return sizeof(mxLogical);
+      case mxCHAR_CLASS:
+         return sizeof(mxChar);
+      case mxDOUBLE_CLASS:
+         return sizeof(double);
+      case mxSINGLE_CLASS:
+         return sizeof(float);
+      case mxINT8_CLASS:
+      case mxUINT8_CLASS:
+         return 1;
+      case mxINT16_CLASS:
+      case mxUINT16_CLASS:
+         return 2;
+      case mxINT32_CLASS:
+      case mxUINT32_CLASS:
+         return 4;
+      case mxINT64_CLASS:
+      case mxUINT64_CLASS:
+         return 8;
+      default:
+         return 0;
+   }
+}
+
+bool MockArray::isArithmetic(mxClassID classId)
+{
+   return classId >= mxLOGICAL_CLASS && classId <= mxUINT64_CLASS && classId != mxVOID_CLASS;
+}
+
+bool MockArray::isInteger(mxClassID classId)
+{
+   return classId >= mxINT8_CLASS && classId <= mxUINT64_CLASS;
+}
+
+const char* MockArray::getClassName(mxClassID classId)
+{
+   if (classId < mxUNKNOWN_CLASS || classId > mxFUNCTION_CLASS)
+   {
+      return spClassNames[0];
+   }
+
+   return spClassNames[classId];
+}
+
+mxClassID MockArray::getClassByName(const std::string& name)
+{
+   for (int i = mxCELL_CLASS; i <= mxFUNCTION_CLASS; ++i)
+   {
+      if (name == spClassNames[i])
+      {
+         return static_cast<mxClassID>(i);
+      }
+   }
+
+   return mxUNKNOWN_CLASS;
+}
+
+size_t MockArray::getCount(const std::vector<mwSize>& dims)
+{
+   size_t count = 1;
+   for (std::vector<mwSize>::const_iterator iter = dims.begin(); iter != dims.end(); ++iter)
+   {
+      count *= *iter;
+   }
+
+   return count;
+}
+
+mxArray* MockArray::create(mxClassID classId, const std::vector<mwSize>& dims)
+{
+   mxArray* pArray = new mxArray;
+   pArray->mClassId = classId;
+   pArray->mDims = dims;
+   while (pArray->mDims.size() > 2 && pArray->mDims.back() == 1)
+   {
+      pArray->mDims.pop_back();
+   }
+
+   while (pArray->mDims.size() < 2)
+   {
+      pArray->mDims.push_back(pArray->mDims.empty() ? 0 : 1);
+   }
+
+   const size_t count = getCount(pArray->mDims);
+   if (classId == mxCELL_CLASS)
+   {
+      pArray->mCells.resize(count, NULL);
+   }
+   else
+   {
+      pArray->mData.resize(count * getElementSize(classId));
+   }
+
+   return pArray;
+}
+
+double MockArray::getValue(const mxArray* pArray, size_t i)
+{
+   switch (pArray->mClassId)
+   {
+      case mxLOGICAL_CLASS:
+         return reinterpret_cast<const mxLogical*>(&pArray->mData[0])[i] ? 1.0 : 0.0;
+      case mxCHAR_CLASS:
+         return load<mxChar>(pArray, i);
+      case mxDOUBLE_CLASS:
+         return load<double>(pArray, i);
+      case mxSINGLE_CLASS:
+         return load<float>(pArray, i);
+      case mxINT8_CLASS:
+         return load<signed char>(pArray, i);
+      case mxUINT8_CLASS:
+         return load<unsigned char>(pArray, i);
+      case mxINT16_CLASS:
+         return load<short>(pArray, i);
+      case mxUINT16_CLASS:
+         return load<unsigned short>(pArray, i);
+      case mxINT32_CLASS:
+         return load<int>(pArray, i);
+      case mxUINT32_CLASS:
+         return load<unsigned int>(pArray, i);
+      case mxINT64_CLASS:
+         return load<long long>(pArray, i);
+      case mxUINT64_CLASS:
+         return load<unsigned long long>(pArray, i);
+      default:
+         return 0.0;
+   }
+}
+
+void MockArray::setValue(mxArray* pArray, size_t i, double value)
+{
+   switch (pArray->mClassId)
+   {
+      case mxLOGICAL_CLASS:
+         reinterpret_cast<mxLogical*>(&pArray->mData[0])[i] = (value != 0.0);
+         break;
+      case mxCHAR_CLASS:
+         store<mxChar>(pArray, i, value);
+         break;
+      case mxDOUBLE_CLASS:
+         store<double>(pArray, i, value);
+         break;
+      case mxSINGLE_CLASS:
+         store<float>(pArray, i, value);
+         break;
+      case mxINT8_CLASS:
+         store<signed char>(pArray, i, value);
+         break;
+      case mxUINT8_CLASS:
+         store<unsigned char>(pArray, i, value);
+         break;
+      case mxINT16_CLASS:
+         store<short>(pArray, i, value);
+         break;
+      case mxUINT16_CLASS:
+         store<unsigned short>(pArray, i, value);
+         break;
+      case mxINT32_CLASS:
+         store<int>(pArray, i, value);
+         break;
+      case mxUINT32_CLASS:
+         store<unsigned int>(pArray, i, value);
+         break;
+      case mxINT64_CLASS:
+         store<long long>(pArray, i, value);
+         break;
+      case mxUINT64_CLASS:
+         store<unsigned long long>(pArray, i, value);
+         break;
+      default:
+         break;
+   }
+}
+
+std::string MockArray::getString(const mxArray* pArray)
+{
+   std::string value;
+   if (pArray != NULL && pArray->mClassId == mxCHAR_CLASS)
+   {
+      const size_t count = getCount(pArray->mDims);
+      value.reserve(count);
+      for (size_t i = 0; i < count; ++i)
+      {
+         value.push_back(static_cast<char>(load<mxChar>(pArray, i)));
+      }
+   }
+
+   return value;
+}
+
+mxArray* MockArray::createString(const std::string& value)
+{
+   std::vector<mwSize> dims(2, 1);
+   dims[1] = value.size();
+   if (value.empty() == true)
+   {
+      dims[0] = 0;
+   }
+
+   mxArray* pArray = create(mxCHAR_CLASS, dims);
+   for (size_t i = 0; i < value.size(); ++i)
+   {
+      store<mxChar>(pArray, i, static_cast<unsigned char>(value[i]));
+   }
+
+   return pArray;
+}
+
+mxArray* mxCreateNumericArray(mwSize ndim, const mwSize* dims, mxClassID classid, mxComplexity flag)
+{
+   if (flag != mxREAL || MockArray::isArithmetic(classid) == false || classid == mxCHAR_CLASS)
+   {
+      return NULL;
+   }
+
+   return MockArray::create(classid, std::vector<mwSize>(dims, dims + ndim));
+}
+
+mxArray* mxCreateNumericMatrix(mwSize m, mwSize n, mxClassID classid, mxComplexity flag)
+{
+   const mwSize dims[] = { m, n };
+   return mxCreateNumericArray(2, dims, classid, flag);
+}
+
+mxArray* mxCreateDoubleMatrix(mwSize m, mwSize n, mxComplexity flag)
+{
+   return mxCreateNumericMatrix(m, n, mxDOUBLE_CLASS, flag);
+}
+
+mxArray* mxCreateDoubleScalar(double value)
+{
+   mxArray* pArray = mxCreateDoubleMatrix(1, 1, mxREAL);
+   MockArray::setValue(pArray, 0, value);
+   return pArray;
+}
+
+mxArray* mxCreateLogicalScalar(mxLogical value)
+{
+   mxArray* pArray = MockArray::create(mxLOGICAL_CLASS, std::vector<mwSize>(2, 1));
+   MockArray::setValue(pArray, 0, value ? 1.0 : 0.0);
+   return pArray;
+}
+
+mxArray* mxCreateString(const char* str)
+{
+   return MockArray::createString(str == NULL ? std::string() : std::string(str));
+}
+
+mxArray* mxCreateCharMatrixFromStrings(mwSize m, const char** str)
+{
+   // Shorter strings are padded with blanks to the length of the longest one.
+   size_t length = 0;
+   for (mwSize row = 0; row < m; ++row)
+   {
+      length = std::max(length, strlen(str[row]));
+   }
+
+   std::vector<mwSize> dims(2, m);
+   dims[1] = length;
+   mxArray* pArray = MockArray::create(mxCHAR_CLASS, dims);
+   for (mwSize row = 0; row < m; ++row)
+   {
+      const size_t rowLength = strlen(str[row]);
+      for (size_t column = 0; column < length; ++column)
+      {
+         const char value = (column < rowLength ? str[row][column] : ' ');
+         store<mxChar>(pArray, column * m + row, static_cast<unsigned char>(value));
+      }
+   }
+
+   return pArray;
+}
+
+mxArray* mxCreateCellMatrix(mwSize m, mwSize n)
+{
+   std::vector<mwSize> dims(2, m);
+   dims[1] = n;
+   return MockArray::create(mxCELL_CLASS, dims);
+}
+
+mxArray* mxCreateStructMatrix(mwSize m, mwSize n, int nfields, const char** fieldnames)
+{
+   std::vector<mwSize> dims(2, m);
+   dims[1] = n;
+   mxArray* pArray = MockArray::create(mxSTRUCT_CLASS, dims);
+   for (int i = 0; i < nfields; ++i)
+   {
+      pArray->mFieldNames.push_back(fieldnames[i]);
+   }
+
+   pArray->mFields.resize(m * n * pArray->mFieldNames.size(), NULL);
+   return pArray;
+}
+
+mxArray* mxDuplicateArray(const mxArray* pa)
+{
+   if (pa == NULL)
+   {
+      return NULL;
+   }
+
+   mxArray* pArray = new mxArray(*pa);
+   for (std::vector<mxArray*>::iterator iter = pArray->mCells.begin(); iter != pArray->mCells.end(); ++iter)
+   {
+      *iter = mxDuplicateArray(*iter);
+   }
+
+   for (std::vector<mxArray*>::iterator iter = pArray->mFields.begin(); iter != pArray->mFields.end(); ++iter)
+   {
+      *iter = mxDuplicateArray(*iter);
+   }
+
+   return pArray;
+}
+
+void mxDestroyArray(mxArray* pa)
+{
+   if (pa != NULL)
+   {
+      destroyChildren(pa->mCells);
+      destroyChildren(pa->mFields);
+      delete pa;
+   }
+}
+
+mxClassID mxGetClassID(const mxArray* pa)
+{
+   return pa == NULL ? mxUNKNOWN_CLASS : pa->mClassId;
+}
+
+const char* mxGetClassName(const mxArray* pa)
+{
+   return MockArray::getClassName(mxGetClassID(pa));
+}
+
+mwSize mxGetNumberOfDimensions(const mxArray* pa)
+{
+   return pa->mDims.size();
+}
+
+const mwSize* mxGetDimensions(const mxArray* pa)
+{
+   return &pa->mDims[0];
+}
+
+size_t mxGetM(const mxArray* pa)
+{
+   return pa->mDims[0];
+}
+
+size_t mxGetN(const mxArray* pa)
+{
+   return MockArray::getCount(pa->mDims) / std::max<size_t>(pa->mDims[0], 1);
+}
+
+size_t mxGetNumberOfElements(const mxArray* pa)
+{
+   return MockArray::getCount(pa->mDims);
+}
+
+size_t mxGetElementSize(const mxArray* pa)
+{
+   if (pa->mClassId == mxCELL_CLASS || pa->mClassId == mxSTRUCT_CLASS)
+   {
+      return sizeof(mxArray*);
+   }
+
+   return MockArray::getElementSize(pa->mClassId);
+}
+
+void* mxGetData(const mxArray* pa)
+{
+   if (pa == NULL || pa->mData.empty() == true)
+   {
+      return NULL;
+   }
+
+   return const_cast<char*>(&pa->mData[0]);
+}
+
+double* mxGetPr(const mxArray* pa)
+{
+   return (pa != NULL && pa->mClassId == mxDOUBLE_CLASS) ? reinterpret_cast<double*>(mxGetData(pa)) : NULL;
+}
+
+mxLogical* mxGetLogicals(const mxArray* pa)
+{
+   return (pa != NULL && pa->mClassId == mxLOGICAL_CLASS) ? reinterpret_cast<mxLogical*>(mxGetData(pa)) : NULL;
+}
+
+mxChar* mxGetChars(const mxArray* pa)
+{
+   return (pa != NULL && pa->mClassId == mxCHAR_CLASS) ? reinterpret_cast<mxChar*>(mxGetData(pa)) : NULL;
+}
+
+double mxGetScalar(const mxArray* pa)
+{
+   if (pa == NULL || MockArray::isArithmetic(pa->mClassId) == false || mxIsEmpty(pa) == true)
+   {
+      return 0.0;
+   }
+
+   return MockArray::getValue(pa, 0);
+}
+
+bool mxIsNumeric(const mxArray* pa)
+{
+   return pa != NULL && (pa->mClassId == mxDOUBLE_CLASS || pa->mClassId == mxSINGLE_CLASS ||
+      MockArray::isInteger(pa->mClassId));
+}
+
+bool mxIsChar(const mxArray* pa)
+{
+   return mxGetClassID(pa) == mxCHAR_CLASS;
+}
+
+bool mxIsLogical(const mxArray* pa)
+{
+   return mxGetClassID(pa) == mxLOGICAL_CLASS;
+}
+
+bool mxIsCell(const mxArray* pa)
+{
+   return mxGetClassID(pa) == mxCELL_CLASS;
+}
+
+bool mxIsStruct(const mxArray* pa)
+{
+   return mxGetClassID(pa) == mxSTRUCT_CLASS;
+}
+
+bool mxIsDouble(const mxArray* pa)
+{
+   return mxGetClassID(pa) == mxDOUBLE_CLASS;
+}
+
+// The mock only creates real arrays.
+bool mxIsComplex(const mxArray*)
+{
+   return false;
+}
+
+bool mxIsEmpty(const mxArray* pa)
+{
+   return mxGetNumberOfElements(pa) == 0;
+}
+
+bool mxIsLogicalScalarTrue(const mxArray* pa)
+{
+   return mxIsLogical(pa) && mxGetNumberOfElements(pa) == 1 && MockArray::getValue(pa, 0) != 0.0;
+}
+
+mxArray* mxGetCell(const mxArray* pa, mwIndex i)
+{
+   if (mxIsCell(pa) == false || i >= pa->mCells.size())
+   {
+      return NULL;
+   }
+
+   return pa->mCells[i];
+}
+
+void mxSetCell(mxArray* pa, mwIndex i, mxArray* value)
+{
+   if (mxIsCell(pa) == true && i < pa->mCells.size())
+   {
+      mxDestroyArray(pa->mCells[i]);
+      pa->mCells[i] = value;
+   }
+}
+
+int mxGetNumberOfFields(const mxArray* pa)
+{
+   return mxIsStruct(pa) ? static_cast<int>(pa->mFieldNames.size()) : 0;
+}
+
+const char* mxGetFieldNameByNumber(const mxArray* pa, int n)
+{
+   if (n < 0 || n >= mxGetNumberOfFields(pa))
+   {
+      return NULL;
+   }
+
+   return pa->mFieldNames[n].c_str();
+}
+
+int mxGetFieldNumber(const mxArray* pa, const char* name)
+{
+   for (int i = 0; i < mxGetNumberOfFields(pa); ++i)
+   {
+      if (pa->mFieldNames[i] == name)
+      {
+         return i;
+      }
+   }
+
+   return -1;
+}
+
+int mxAddField(mxArray* pa, const char* fieldname)
+{
+   if (mxIsStruct(pa) == false)
+   {
+      return -1;
+   }
+
+   int field = mxGetFieldNumber(pa, fieldname);
+   if (field >= 0)
+   {
+      return field;
+   }
+
+   // Insert a new, empty field into every element of the struct array.
+   const size_t fieldCount = pa->mFieldNames.size();
+   const size_t count = mxGetNumberOfElements(pa);
+   std::vector<mxArray*> fields;
+   fields.reserve(count * (fieldCount + 1));
+   for (size_t i = 0; i < count; ++i)
+   {
+      fields.insert(fields.end(), pa->mFields.begin() + i * fieldCount, pa->mFields.begin() + (i + 1) * fieldCount);
+      fields.push_back(NULL);
+   }
+
+   pa->mFields.swap(fields);
+   pa->mFieldNames.push_back(fieldname);
+   return static_cast<int>(fieldCount);
+}
+
+void mxRemoveField(mxArray* pa, int fieldnumber)
+{
+   if (mxIsStruct(pa) == false || fieldnumber < 0 || fieldnumber >= mxGetNumberOfFields(pa))
+   {
+      return;
+   }
+
+   // Remove the field from every element of the struct array.
+   const size_t fieldCount = pa->mFieldNames.size();
+   const size_t count = mxGetNumberOfElements(pa);
+   std::vector<mxArray*> fields;
+   fields.reserve(count * (fieldCount - 1));
+   for (size_t i = 0; i < count; ++i)
+   {
+      for (size_t field = 0; field < fieldCount; ++field)
+      {
+         mxArray* pField = pa->mFields[i * fieldCount + field];
+         if (field == static_cast<size_t>(fieldnumber))
+         {
+            mxDestroyArray(pField);
+         }
+         else
+         {
+            fields.push_back(pField);
+         }
+      }
+   }
+
+   pa->mFields.swap(fields);
+   pa->mFieldNames.erase(pa->mFieldNames.begin() + fieldnumber);
+}
+
+mxArray* mxGetField(const mxArray* pa, mwIndex i, const char* fieldname)
+{
+   const int field = mxGetFieldNumber(pa, fieldname);
+   if (field < 0 || i >= mxGetNumberOfElements(pa))
+   {
+      return NULL;
+   }
+
+   return pa->mFields[i * pa->mFieldNames.size() + field];
+}
+
+void mxSetField(mxArray* pa, mwIndex i, const char* fieldname, mxArray* value)
+{
+   const int field = mxGetFieldNumber(pa, fieldname);
+   if (field >= 0 && i < mxGetNumberOfElements(pa))
+   {
+      mxArray*& pField = pa->mFields[i * pa->mFieldNames.size() + field];
+      mxDestroyArray(pField);
+      pField = value;
+   }
+}
+
+int mxGetString(const mxArray* pa, char* buf, mwSize buflen)
+{
+   if (mxIsChar(pa) == false || buflen == 0)
+   {
+      return 1;
+   }
+
+   const std::string value = MockArray::getString(pa);
+   const size_t length = std::min<size_t>(value.size(), buflen - 1);
+   memcpy(buf, value.c_str(), length);
+   buf[length] = '\0';
+   return length == value.size() ? 0 : 1;
+}
+
+char* mxArrayToString(const mxArray* pa)
+{
+   if (mxIsChar(pa) == false)
+   {
+      return NULL;
+   }
+
+   const std::string value = MockArray::getString(pa);
+   char* pString = reinterpret_cast<char*>(mxMalloc(value.size() + 1));
+   memcpy(pString, value.c_str(), value.size() + 1);
+   return pString;
+}
+
+void* mxMalloc(size_t n)
+{
+   return malloc(n);
+}
+
+void* mxCalloc(size_t n, size_t size)
+{
+   return calloc(n, size);
+}
+
+void mxFree(void* ptr)
+{
+   free(ptr);
+}
@@ -0,0 +1,70 @@
+/*
+ * The information in this file is
+ * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
+ * and is subject to the terms and conditions of the
+ * GNU Lesser General Public License Version 2.1
+ * The license text is available from   
+ * http://www.gnu.org/licenses/lgpl.html
+ */
+
+#ifndef MOCKARRAY_H
+#define MOCKARRAY_H
+
+#include "matrix.h"
+
+#include <string>
+#include <vector>
+
+// The in-memory representation of an mxArray. Numeric, logical, and character elements are stored in mData, while
+// cells and struct fields own the arrays they hold. Struct fields are stored element by element, so field f of
+// element i is mFields[i * mFieldNames.size() + f].
+struct mxArray_tag
+{
+   mxClassID mClassId;
+   std::vector<mwSize> mDims;
+   std::vector<char> mData;
+   std::vector<mxArray*> mCells;
+   std::vector<std::string> mFieldNames;
+   std::vector<mxArray*> mFields;
+};
+
+// Helpers shared by the mxArray functions and MockEvaluator.
+namespace MockArray
+{
+   // Returns the size in bytes of a single element of classId, or zero for classes which do not store data.
+   size_t getElementSize(mxClassID classId);
+
+   // Returns true for the classes which can take part in arithmetic: numeric, logical, and character.
+   bool isArithmetic(mxClassID classId);
+
+   // Returns true for the signed and unsigned integer classes.
+   bool isInteger(mxClassID classId);
+
+   // Returns the MATLAB name of classId, such as "double" or "cell".
+   const char* getClassName(mxClassID classId);
+
+   // Returns the class with the given MATLAB name, or mxUNKNOWN_CLASS if there is none.
+   mxClassID getClassByName(const std::string& name);
+
+   // Creates a zero-filled array of the given class and dimensions. Trailing singleton dimensions are removed,
+   // but at least two dimensions are always kept.
+   mxArray* create(mxClassID classId, const std::vector<mwSize>& dims);
+
+   // Returns the number of elements in an array of the given dimensions.
+   size_t getCount(const std::vector<mwSize>& dims);
+
+   // Reads element i of an arithmetic array as a double.
+   double getValue(const mxArray* pArray, size_t i);
+
+   // Writes element i of an arithmetic array, rounding and saturating the value for integer classes in the same
+   // way as MATLAB's own casts.
+   void setValue(mxArray* pArray, size_t i, double value);
+
+   // Returns the contents of a character array as a string, reading the characters in column-major order.
+   std::string getString(const mxArray* pArray);
+
+   // Creates a 1 x N character array.
+   mxArray* createString(const std::string& value);
+}
+
+#endif
@@ -0,0 +1,129 @@
+/*
+ * The information in this file is
+ * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
+ * and is subject to the terms and conditions of the
+ * GNU Lesser General Public License Version 2.1
+ * The license text is available from   
+ * http://www.gnu.org/licenses/lgpl.html
+ */
+
+#include "engine.h"
+#include "MockEvaluator.h"
+
+#include <algorithm>
+#include <string.h>
+#include <string>
+
+struct engine
+{
+   engine() :
+      mpBuffer(NULL),
+      mBufferLength(0),
+      mVisible(false)
+   {}
+
+   MockEvaluator mEvaluator;
+   char* mpBuffer;
+   int mBufferLength;
+   bool mVisible;
+};
+
+Engine* engOpen(const char*)
+{
+   return new engine;
+}
+
+Engine* engOpenSingleUse(const char*, void*, int* retstatus)
+{
+   if (retstatus != NULL)
+   {
+      *retstatus = 0;
+   }
+
+   return new engine;
+}
+
+int engClose(Engine* ep)
+{
+   if (ep == NULL)
+   {
+      return 1;
+   }
+
+   delete ep;
+   return 0;
+}
+
+int engEvalString(Engine* ep, const char* string)
+{
+   if (ep == NULL || string == NULL)
+   {
+      return 1;
+   }
+
+   std::string output;
+   ep->mEvaluator.evaluate(string, output);
+
+   // Like MATLAB, copy as much output as fits without NULL-terminating it.
+   if (ep->mpBuffer != NULL && ep->mBufferLength > 0)
+   {
+      const size_t length = std::min(output.size(), static_cast<size_t>(ep->mBufferLength));
+      memcpy(ep->mpBuffer, output.data(), length);
+   }
+
+   return 0;
+}
+
+int engOutputBuffer(Engine* ep, char* buffer, int buflen)
+{
+   if (ep == NULL)
+   {
+      return 1;
+   }
+
+   ep->mpBuffer = (buflen > 0 ? buffer : NULL);
+   ep->mBufferLength = (buffer != NULL ? buflen : 0);
+   return 0;
+}
+
+mxArray* engGetVariable(Engine* ep, const char* name)
+{
+   if (ep == NULL || name == NULL)
+   {
+      return NULL;
+   }
+
+   return ep->mEvaluator.getVariable(name);
+}
+
+int engPutVariable(Engine* ep, const char* var_name, const mxArray* ap)
+{
+   if (ep == NULL || var_name == NULL)
+   {
+      return 1;
+   }
+
+   return ep->mEvaluator.setVariable(var_name, ap) ? 0 : 1;
+}
+
+int engSetVisible(Engine* ep, bool newVal)
+{
+   if (ep == NULL)
+   {
+      return 1;
+   }
+
+   ep->mVisible = newVal;
+   return 0;
+}
+
+int engGetVisible(Engine* ep, bool* bVal)
+{
+   if (ep == NULL || bVal == NULL)
+   {
+      return 1;
+   }
+
+   *bVal = ep->mVisible;
+   return 0;
+}
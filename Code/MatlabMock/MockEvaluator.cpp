@@ -0,0 +1,4643 @@
+/*
+ * The information in this file is
+ * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
+ * and is subject to the terms and conditions of the
+ * GNU Lesser General Public License Version 2.1
+ * The license text is available from   
+ * http://www.gnu.org/licenses/lgpl.html
+ */
+
+#include "MockArray.h"
+#include "MockEvaluator.h"
+
+#include <algorithm>
+#include <ctype.h>
+#include <map>
+#include <math.h>
+#include <stdexcept>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+namespace
+{
+   // Reference counted handle to an mxArray, so that variables and intermediate results share their data until
+   // one of them is modified.
+   class Value
+   {
+   public:
+      Value() :
+         mpShared(NULL)
+      {}
+
+      explicit Value(mxArray* pArray) :
+         mpShared(pArray == NULL ? NULL : new Shared(pArray))
+      {}
+
+      Value(const Value& rhs) :
+         mpShared(rhs.mpShared)
+      {
+         if (mpShared != NULL)
+         {
+            ++mpShared->mCount;
+         }
+      }
+
+      ~Value()
+      {
+         reset();
+      }
+
+      Value& operator=(const Value& rhs)
+      {
+         if (rhs.mpShared != NULL)
+         {
+            ++rhs.mpShared->mCount;
+         }
+
+         reset();
+         mpShared = rhs.mpShared;
+         return *this;
+      }
+
+      bool isNull() const
+      {
+         return mpShared == NULL;
+      }
+
+      const mxArray* get() const
+      {
+         return mpShared == NULL ? NULL : mpShared->mpArray;
+      }
+
+      // Returns an array which is not shared with any other value, copying it first if necessary.
+      mxArray* edit()
+      {
+         if (mpShared != NULL && mpShared->mCount > 1)
+         {
+            mxArray* pArray = mxDuplicateArray(mpShared->mpArray);
+            --mpShared->mCount;
+            mpShared = new Shared(pArray);
+         }
+
+         return mpShared == NULL ? NULL : mpShared->mpArray;
+      }
+
+      // Transfers ownership of the array to the caller, copying it if it is shared, and leaves this value null.
+      mxArray* release()
+      {
+         mxArray* pArray = edit();
+         if (mpShared != NULL)
+         {
+            delete mpShared;
+            mpShared = NULL;
+         }
+
+         return pArray;
+      }
+
+   private:
+      struct Shared
+      {
+         explicit Shared(mxArray* pArray) :
+            mpArray(pArray),
+            mCount(1)
+         {}
+
+         mxArray* mpArray;
+         int mCount;
+      };
+
+      void reset()
+      {
+         if (mpShared != NULL && --mpShared->mCount == 0)
+         {
+            mxDestroyArray(mpShared->mpArray);
+            delete mpShared;
+         }
+
+         mpShared = NULL;
+      }
+
+      Shared* mpShared;
+   };
+
+   class EvaluationError : public std::runtime_error
+   {
+   public:
+      explicit EvaluationError(const std::string& message, const std::string& identifier = std::string()) :
+         std::runtime_error(message),
+         mIdentifier(identifier)
+      {}
+
+      ~EvaluationError() throw()
+      {}
+
+      std::string mIdentifier;
+   };
+
+   std::vector<mwSize> makeDims(mwSize rows, mwSize columns)
+   {
+      std::vector<mwSize> dims(2, rows);
+      dims[1] = columns;
+      return dims;
+   }
+
+   Value makeScalar(double value, mxClassID classId = mxDOUBLE_CLASS)
+   {
+      mxArray* pArray = MockArray::create(classId, makeDims(1, 1));
+      MockArray::setValue(pArray, 0, value);
+      return Value(pArray);
+   }
+
+   Value makeString(const std::string& value)
+   {
+      return Value(MockArray::createString(value));
+   }
+
+   Value makeEmpty(mxClassID classId = mxDOUBLE_CLASS)
+   {
+      return Value(MockArray::create(classId, makeDims(0, 0)));
+   }
+
+   size_t getCount(const mxArray* pArray)
+   {
+      return MockArray::getCount(pArray->mDims);
+   }
+
+   bool isScalar(const mxArray* pArray)
+   {
+      return getCount(pArray) == 1;
+   }
+
+   bool isVector(const std::vector<mwSize>& dims)
+   {
+      return dims.size() == 2 && (dims[0] == 1 || dims[1] == 1);
+   }
+
+   std::string getString(const Value& value, const std::string& context)
+   {
+      if (mxIsChar(value.get()) == false)
+      {
+         throw EvaluationError(context + " must be a string.");
+      }
+
+      return MockArray::getString(value.get());
+   }
+
+   double getScalar(const Value& value, const std::string& context)
+   {
+      if (MockArray::isArithmetic(mxGetClassID(value.get())) == false || isScalar(value.get()) == false)
+      {
+         throw EvaluationError(context + " must be a numeric scalar.");
+      }
+
+      return MockArray::getValue(value.get(), 0);
+   }
+
+   bool isTrue(const Value& value)
+   {
+      const mxArray* pArray = value.get();
+      if (MockArray::isArithmetic(mxGetClassID(pArray)) == false)
+      {
+         throw EvaluationError("Conversion to logical from " + std::string(mxGetClassName(pArray)) +
+            " is not possible.");
+      }
+
+      // Like MATLAB, an empty condition is false and a non-scalar condition is true only if all elements are.
+      const size_t count = getCount(pArray);
+      for (size_t i = 0; i < count; ++i)
+      {
+         if (MockArray::getValue(pArray, i) == 0.0)
+         {
+            return false;
+         }
+      }
+
+      return count > 0;
+   }
+
+   // Copies element sourceIndex of pSource into element destIndex of pDest, converting arithmetic values when the
+   // classes differ. Cells and struct elements are copied deeply.
+   void copyElement(const mxArray* pSource, size_t sourceIndex, mxArray* pDest, size_t destIndex)
+   {
+      if (pDest->mClassId == mxCELL_CLASS)
+      {
+         mxDestroyArray(pDest->mCells[destIndex]);
+         pDest->mCells[destIndex] = mxDuplicateArray(pSource->mCells[sourceIndex]);
+      }
+      else if (pDest->mClassId == mxSTRUCT_CLASS)
+      {
+         const size_t fieldCount = pDest->mFieldNames.size();
+         for (size_t field = 0; field < fieldCount; ++field)
+         {
+            mxArray*& pField = pDest->mFields[destIndex * fieldCount + field];
+            mxDestroyArray(pField);
+            pField = mxDuplicateArray(pSource->mFields[sourceIndex * fieldCount + field]);
+         }
+      }
+      else if (pDest->mClassId == pSource->mClassId)
+      {
+         const size_t size = MockArray::getElementSize(pDest->mClassId);
+         memcpy(&pDest->mData[destIndex * size], &pSource->mData[sourceIndex * size], size);
+      }
+      else
+      {
+         MockArray::setValue(pDest, destIndex, MockArray::getValue(pSource, sourceIndex));
+      }
+   }
+
+   // Creates an array which has the same class, and for structs the same fields, as pTemplate.
+   mxArray* createLike(const mxArray* pTemplate, mxClassID classId, const std::vector<mwSize>& dims)
+   {
+      mxArray* pArray = MockArray::create(classId, dims);
+      if (classId == mxSTRUCT_CLASS)
+      {
+         pArray->mFieldNames = pTemplate->mFieldNames;
+         pArray->mFields.resize(getCount(pArray) * pArray->mFieldNames.size(), NULL);
+      }
+
+      return pArray;
+   }
+
+   Value convert(const Value& value, mxClassID classId)
+   {
+      const mxArray* pSource = value.get();
+      if (pSource->mClassId == classId)
+      {
+         return value;
+      }
+
+      if (MockArray::isArithmetic(pSource->mClassId) == false || MockArray::isArithmetic(classId) == false)
+      {
+         throw EvaluationError(std::string("Conversion to ") + MockArray::getClassName(classId) + " from " +
+            mxGetClassName(pSource) + " is not possible.");
+      }
+
+      mxArray* pDest = MockArray::create(classId, pSource->mDims);
+      const size_t count = getCount(pSource);
+      for (size_t i = 0; i < count; ++i)
+      {
+         MockArray::setValue(pDest, i, MockArray::getValue(pSource, i));
+      }
+
+      return Value(pDest);
+   }
+
+   // Tokens
+
+   enum TokenType
+   {
+      NUMBER,
+      STRING,
+      IDENTIFIER,
+      KEYWORD,
+      OPERATOR,
+      SEPARATOR,
+      COMMAND,
+      END_OF_INPUT
+   };
+
+   struct Token
+   {
+      Token() :
+         mType(END_OF_INPUT),
+         mNumber(0.0),
+         mSpaceBefore(false),
+         mInMatrix(false)
+      {}
+
+      TokenType mType;
+      std::string mText;
+      double mNumber;
+      bool mSpaceBefore;
+      bool mInMatrix;
+      std::vector<std::string> mArguments;
+   };
+
+   bool isKeyword(const std::string& text)
+   {
+      const char* pKeywords[] = { "if", "elseif", "else", "end", "for", "while", "try", "catch", "break",
+         "continue", "return", "function", "switch", "case", "otherwise" };
+      for (size_t i = 0; i < sizeof(pKeywords) / sizeof(pKeywords[0]); ++i)
+      {
+         if (text == pKeywords[i])
+         {
+            return true;
+         }
+      }
+
+      return false;
+   }
+
+   // Functions which MATLAB commonly calls with command syntax, such as "format compact" or "clear x y".
+   bool isCommandWord(const std::string& text)
+   {
+      const char* pCommands[] = { "clear", "clc", "close", "format", "hold", "more", "warning", "drawnow" };
+      for (size_t i = 0; i < sizeof(pCommands) / sizeof(pCommands[0]); ++i)
+      {
+         if (text == pCommands[i])
+         {
+            return true;
+         }
+      }
+
+      return false;
+   }
+
+   class Lexer
+   {
+   public:
+      explicit Lexer(const std::string& source) :
+         mSource(source),
+         mPosition(0)
+      {}
+
+      std::vector<Token> tokenize()
+      {
+         std::vector<Token> tokens;
+         std::vector<char> brackets;
+         bool statementStart = true;
+         for (;;)
+         {
+            Token token;
+            token.mSpaceBefore = skipWhitespace();
+            token.mInMatrix = (brackets.empty() == false && brackets.back() != '(');
+            if (mPosition >= mSource.size())
+            {
+               tokens.push_back(token);
+               return tokens;
+            }
+
+            const char c = mSource[mPosition];
+            if (c == '\n')
+            {
+               // Newlines separate rows inside of brackets.
+               token.mType = SEPARATOR;
+               token.mText = (token.mInMatrix ? ";" : "\n");
+               ++mPosition;
+               statementStart = brackets.empty();
+               tokens.push_back(token);
+               continue;
+            }
+
+            if (isdigit(c) || (c == '.' && isdigit(peek(1))))
+            {
+               token.mType = NUMBER;
+               token.mNumber = readNumber();
+            }
+            else if (isalpha(c) || c == '_')
+            {
+               token.mText = readIdentifier();
+               token.mType = isKeyword(token.mText) ? KEYWORD : IDENTIFIER;
+               if (statementStart == true && brackets.empty() == true && isCommandWord(token.mText) == true &&
+                  isCommandSyntax() == true)
+               {
+                  token.mType = COMMAND;
+                  token.mArguments = readCommandArguments();
+               }
+            }
+            else if (c == '\'' && isTranspose(tokens, token) == false)
+            {
+               token.mType = STRING;
+               token.mText = readString('\'');
+            }
+            else if (c == '"')
+            {
+               token.mType = STRING;
+               token.mText = readString('"');
+            }
+            else
+            {
+               token.mText = readOperator();
+               token.mType = (token.mText == "," || token.mText == ";") ? SEPARATOR : OPERATOR;
+               if (token.mText == "(" || token.mText == "[" || token.mText == "{")
+               {
+                  brackets.push_back(token.mText[0]);
+               }
+               else if ((token.mText == ")" || token.mText == "]" || token.mText == "}") && brackets.empty() == false)
+               {
+                  brackets.pop_back();
+               }
+            }
+
+            statementStart = (token.mType == SEPARATOR && brackets.empty() == true);
+            tokens.push_back(token);
+         }
+      }
+
+   private:
+      char peek(size_t offset) const
+      {
+         return mPosition + offset < mSource.size() ? mSource[mPosition + offset] : '\0';
+      }
+
+      // Skips spaces, comments, and line continuations, returning true if anything was skipped.
+      bool skipWhitespace()
+      {
+         bool skipped = false;
+         while (mPosition < mSource.size())
+         {
+            const char c = mSource[mPosition];
+            if (c == ' ' || c == '\t' || c == '\r')
+            {
+               ++mPosition;
+            }
+            else if (c == '%')
+            {
+               while (mPosition < mSource.size() && mSource[mPosition] != '\n')
+               {
+                  ++mPosition;
+               }
+            }
+            else if (mSource.compare(mPosition, 3, "...") == 0)
+            {
+               while (mPosition < mSource.size() && mSource[mPosition] != '\n')
+               {
+                  ++mPosition;
+               }
+
+               if (mPosition < mSource.size())
+               {
+                  ++mPosition;
+               }
+            }
+            else
+            {
+               break;
+            }
+
+            skipped = true;
+         }
+
+         return skipped;
+      }
+
+      double readNumber()
+      {
+         const size_t start = mPosition;
+         while (isdigit(peek(0)))
+         {
+            ++mPosition;
+         }
+
+         // A period is part of the number unless it begins an element-wise operator such as ".*".
+         if (peek(0) == '.' && strchr("*/\\^'", peek(1)) == NULL)
+         {
+            ++mPosition;
+            while (isdigit(peek(0)))
+            {
+               ++mPosition;
+            }
+         }
+
+         if ((peek(0) == 'e' || peek(0) == 'E') &&
+            (isdigit(peek(1)) || ((peek(1) == '+' || peek(1) == '-') && isdigit(peek(2)))))
+         {
+            mPosition += 2;
+            while (isdigit(peek(0)))
+            {
+               ++mPosition;
+            }
+         }
+
+         return strtod(mSource.substr(start, mPosition - start).c_str(), NULL);
+      }
+
+      std::string readIdentifier()
+      {
+         const size_t start = mPosition;
+         while (isalnum(peek(0)) || peek(0) == '_')
+         {
+            ++mPosition;
+         }
+
+         return mSource.substr(start, mPosition - start);
+      }
+
+      std::string readString(char quote)
+      {
+         std::string value;
+         for (++mPosition; ; ++mPosition)
+         {
+            if (mPosition >= mSource.size() || mSource[mPosition] == '\n')
+            {
+               throw EvaluationError("A MATLAB string constant is not terminated properly.");
+            }
+
+            if (mSource[mPosition] == quote)
+            {
+               if (peek(1) != quote)
+               {
+                  ++mPosition;
+                  return value;
+               }
+
+               ++mPosition;
+            }
+
+            value.push_back(mSource[mPosition]);
+         }
+      }
+
+      std::string readOperator()
+      {
+         const char* pOperators[] = { ".*", "./", ".\\", ".^", ".'", "==", "~=", "!=", "<=", ">=", "&&", "||" };
+         for (size_t i = 0; i < sizeof(pOperators) / sizeof(pOperators[0]); ++i)
+         {
+            if (mSource.compare(mPosition, 2, pOperators[i]) == 0)
+            {
+               mPosition += 2;
+               return pOperators[i];
+            }
+         }
+
+         const char c = mSource[mPosition];
+         if (strchr("+-*/\\^<>&|~!()[]{}=:.@,;'", c) == NULL)
+         {
+            throw EvaluationError(std::string("The input character '") + c + "' is not valid in MATLAB statements.");
+         }
+
+         ++mPosition;
+         return std::string(1, c);
+      }
+
+      // A quote which directly follows a value is the transpose operator rather than the start of a string.
+      bool isTranspose(const std::vector<Token>& tokens, const Token& token) const
+      {
+         if (tokens.empty() == true || (token.mSpaceBefore == true && token.mInMatrix == true))
+         {
+            return false;
+         }
+
+         const Token& previous = tokens.back();
+         return previous.mType == NUMBER || previous.mType == IDENTIFIER || previous.mType == STRING ||
+            (previous.mType == KEYWORD && previous.mText == "end") ||
+            (previous.mType == OPERATOR && (previous.mText == ")" || previous.mText == "]" ||
+            previous.mText == "}" || previous.mText == "'" || previous.mText == ".'"));
+      }
+
+      // Command syntax is a command word followed by whitespace and something other than an assignment,
+      // a parenthesized argument list, or the end of the statement.
+      bool isCommandSyntax() const
+      {
+         size_t position = mPosition;
+         if (position >= mSource.size() || (mSource[position] != ' ' && mSource[position] != '\t'))
+         {
+            return false;
+         }
+
+         while (position < mSource.size() && (mSource[position] == ' ' || mSource[position] == '\t'))
+         {
+            ++position;
+         }
+
+         return position < mSource.size() && strchr("=(;,\n%", mSource[position]) == NULL;
+      }
+
+      std::vector<std::string> readCommandArguments()
+      {
+         std::vector<std::string> arguments;
+         for (;;)
+         {
+            while (peek(0) == ' ' || peek(0) == '\t')
+            {
+               ++mPosition;
+            }
+
+            if (mPosition >= mSource.size() || strchr(";,\n%", mSource[mPosition]) != NULL)
+            {
+               return arguments;
+            }
+
+            const size_t start = mPosition;
+            while (mPosition < mSource.size() && strchr(" \t;,\n%", mSource[mPosition]) == NULL)
+            {
+               ++mPosition;
+            }
+
+            arguments.push_back(mSource.substr(start, mPosition - start));
+         }
+      }
+
+      const std::string& mSource;
+      size_t mPosition;
+   };
+
+   // Syntax tree
+
+   struct Expr
+   {
+      enum Kind
+      {
+         NUMBER_EXPR,
+         STRING_EXPR,
+         IDENT,
+         INDEX,
+         BRACE,
+         FIELD,
+         BINARY,
+         UNARY,
+         POSTFIX,
+         MATRIX,
+         CELL,
+         COLON,
+         END_EXPR,
+         RANGE
+      };
+
+      explicit Expr(Kind kind) :
+         mKind(kind),
+         mNumber(0.0)
+      {}
+
+      ~Expr()
+      {
+         for (std::vector<Expr*>::iterator iter = mChildren.begin(); iter != mChildren.end(); ++iter)
+         {
+            delete *iter;
+         }
+      }
+
+      Kind mKind;
+      double mNumber;
+      std::string mText;
+
+      // INDEX and BRACE hold the base followed by the arguments, FIELD holds the base, BINARY holds both operands,
+      // RANGE holds the start, step (or NULL), and stop, and MATRIX and CELL hold every element row by row.
+      std::vector<Expr*> mChildren;
+      std::vector<size_t> mRowLengths;
+
+   private:
+      Expr(const Expr& rhs);
+      Expr& operator=(const Expr& rhs);
+   };
+
+   struct Statement;
+   typedef std::vector<Statement*> Block;
+
+   void deleteBlock(Block& block);
+
+   struct Statement
+   {
+      enum Kind
+      {
+         EXPRESSION,
+         ASSIGN,
+         MULTI_ASSIGN,
+         COMMAND_STATEMENT,
+         IF,
+         FOR,
+         WHILE,
+         TRY,
+         BREAK,
+         CONTINUE,
+         RETURN
+      };
+
+      explicit Statement(Kind kind) :
+         mKind(kind),
+         mPrint(true),
+         mpExpr(NULL),
+         mpTarget(NULL)
+      {}
+
+      ~Statement()
+      {
+         delete mpExpr;
+         delete mpTarget;
+         for (std::vector<Expr*>::iterator iter = mTargets.begin(); iter != mTargets.end(); ++iter)
+         {
+            delete *iter;
+         }
+
+         for (std::vector<Expr*>::iterator iter = mConditions.begin(); iter != mConditions.end(); ++iter)
+         {
+            delete *iter;
+         }
+
+         for (std::vector<Block>::iterator iter = mBlocks.begin(); iter != mBlocks.end(); ++iter)
+         {
+            deleteBlock(*iter);
+         }
+      }
+
+      Kind mKind;
+      bool mPrint;
+
+      // The expression, assigned value, for loop range, or while condition.
+      Expr* mpExpr;
+
+      // The target of a single assignment, or the targets of a multiple assignment (NULL for ignored outputs).
+      Expr* mpTarget;
+      std::vector<Expr*> mTargets;
+
+      // The loop variable, catch identifier, or command name, and the command arguments.
+      std::string mName;
+      std::vector<std::string> mArguments;
+
+      // Each if and elseif condition with its block, followed by the else block when there is one. Loops and
+      // try statements use the first block for their body and the second for the catch block.
+      std::vector<Expr*> mConditions;
+      std::vector<Block> mBlocks;
+
+   private:
+      Statement(const Statement& rhs);
+      Statement& operator=(const Statement& rhs);
+   };
+
+   void deleteBlock(Block& block)
+   {
+      for (Block::iterator iter = block.begin(); iter != block.end(); ++iter)
+      {
+         delete *iter;
+      }
+
+      block.clear();
+   }
+
+   // Owns a block for the duration of a scope.
+   class BlockResource
+   {
+   public:
+      BlockResource()
+      {}
+
+      ~BlockResource()
+      {
+         deleteBlock(mBlock);
+      }
+
+      Block mBlock;
+
+   private:
+      BlockResource(const BlockResource& rhs);
+      BlockResource& operator=(const BlockResource& rhs);
+   };
+
+   class Parser
+   {
+   public:
+      explicit Parser(const std::vector<Token>& tokens) :
+         mTokens(tokens),
+         mPosition(0),
+         mIndexDepth(0)
+      {}
+
+      void parseProgram(Block& block)
+      {
+         parseBlock(block, std::vector<std::string>());
+         if (peek().mType != END_OF_INPUT)
+         {
+            throw EvaluationError("Illegal use of reserved keyword \"" + peek().mText + "\".");
+         }
+      }
+
+   private:
+      const Token& peek(size_t offset = 0) const
+      {
+         const size_t position = std::min(mPosition + offset, mTokens.size() - 1);
+         return mTokens[position];
+      }
+
+      const Token& next()
+      {
+         const Token& token = peek();
+         if (mPosition < mTokens.size() - 1)
+         {
+            ++mPosition;
+         }
+
+         return token;
+      }
+
+      bool isOperator(const std::string& text, size_t offset = 0) const
+      {
+         const Token& token = peek(offset);
+         return token.mType == OPERATOR && token.mText == text;
+      }
+
+      bool isKeyword(const std::string& text) const
+      {
+         return peek().mType == KEYWORD && peek().mText == text;
+      }
+
+      void expectOperator(const std::string& text)
+      {
+         if (isOperator(text) == false)
+         {
+            throw EvaluationError("Parse error: expected \"" + text + "\".");
+         }
+
+         next();
+      }
+
+      void expectKeyword(const std::string& text)
+      {
+         if (isKeyword(text) == false)
+         {
+            throw EvaluationError("Parse error: expected \"" + text + "\".");
+         }
+
+         next();
+      }
+
+      void skipSeparators()
+      {
+         while (peek().mType == SEPARATOR)
+         {
+            next();
+         }
+      }
+
+      // Parses statements until one of the terminating keywords, which is left for the caller to consume.
+      void parseBlock(Block& block, const std::vector<std::string>& terminators)
+      {
+         for (;;)
+         {
+            skipSeparators();
+            const Token& token = peek();
+            if (token.mType == END_OF_INPUT || (token.mType == KEYWORD &&
+               std::find(terminators.begin(), terminators.end(), token.mText) != terminators.end()))
+            {
+               return;
+            }
+
+            block.push_back(parseStatement());
+         }
+      }
+
+      Statement* parseStatement()
+      {
+         const Token& token = peek();
+         if (token.mType == COMMAND)
+         {
+            Statement* pStatement = new Statement(Statement::COMMAND_STATEMENT);
+            pStatement->mName = token.mText;
+            pStatement->mArguments = token.mArguments;
+            next();
+            return pStatement;
+         }
+
+         if (token.mType == KEYWORD)
+         {
+            return parseKeywordStatement();
+         }
+
+         if (isOperator("[") && isMultipleAssignment() == true)
+         {
+            return parseMultipleAssignment();
+         }
+
+         Statement* pStatement = new Statement(Statement::EXPRESSION);
+         try
+         {
+            pStatement->mpExpr = parseExpression();
+            if (isOperator("="))
+            {
+               next();
+               pStatement->mKind = Statement::ASSIGN;
+               pStatement->mpTarget = pStatement->mpExpr;
+               pStatement->mpExpr = NULL;
+               checkTarget(pStatement->mpTarget);
+               pStatement->mpExpr = parseExpression();
+            }
+
+            pStatement->mPrint = parseTerminator();
+         }
+         catch (...)
+         {
+            delete pStatement;
+            throw;
+         }
+
+         return pStatement;
+      }
+
+      // Consumes the end of a statement, returning false if the statement's output is suppressed.
+      bool parseTerminator()
+      {
+         const Token& token = peek();
+         if (token.mType == SEPARATOR)
+         {
+            next();
+            return token.mText != ";";
+         }
+
+         if (token.mType != END_OF_INPUT && token.mType != KEYWORD)
+         {
+            throw EvaluationError("Unexpected MATLAB expression.");
+         }
+
+         return true;
+      }
+
+      void checkTarget(const Expr* pExpr) const
+      {
+         while (pExpr->mKind == Expr::INDEX || pExpr->mKind == Expr::BRACE || pExpr->mKind == Expr::FIELD)
+         {
+            pExpr = pExpr->mChildren.front();
+         }
+
+         if (pExpr->mKind != Expr::IDENT)
+         {
+            throw EvaluationError("The expression to the left of the equals sign is not a valid target for an "
+               "assignment.");
+         }
+      }
+
+      bool isMultipleAssignment() const
+      {
+         size_t depth = 0;
+         for (size_t offset = 0; peek(offset).mType != END_OF_INPUT; ++offset)
+         {
+            const Token& token = peek(offset);
+            if (token.mType == OPERATOR && (token.mText == "[" || token.mText == "(" || token.mText == "{"))
+            {
+               ++depth;
+            }
+            else if (token.mType == OPERATOR && (token.mText == "]" || token.mText == ")" || token.mText == "}"))
+            {
+               if (--depth == 0)
+               {
+                  return isOperator("=", offset + 1);
+               }
+            }
+            else if (token.mType == SEPARATOR && token.mText == "\n")
+            {
+               return false;
+            }
+         }
+
+         return false;
+      }
+
+      Statement* parseMultipleAssignment()
+      {
+         Statement* pStatement = new Statement(Statement::MULTI_ASSIGN);
+         try
+         {
+            expectOperator("[");
+            while (isOperator("]") == false)
+            {
+               if (isOperator("~"))
+               {
+                  next();
+                  pStatement->mTargets.push_back(NULL);
+               }
+               else
+               {
+                  Expr* pTarget = parsePostfix();
+                  pStatement->mTargets.push_back(pTarget);
+                  checkTarget(pTarget);
+               }
+
+               if (peek().mType == SEPARATOR && peek().mText == ",")
+               {
+                  next();
+               }
+            }
+
+            expectOperator("]");
+            expectOperator("=");
+            pStatement->mpExpr = parseExpression();
+            pStatement->mPrint = parseTerminator();
+         }
+         catch (...)
+         {
+            delete pStatement;
+            throw;
+         }
+
+         return pStatement;
+      }
+
+      Statement* parseKeywordStatement()
+      {
+         const std::string keyword = next().mText;
+         Statement* pStatement = NULL;
+         try
+         {
+            if (keyword == "if")
+            {
+               pStatement = new Statement(Statement::IF);
+               std::vector<std::string> terminators;
+               terminators.push_back("elseif");
+               terminators.push_back("else");
+               terminators.push_back("end");
+               for (;;)
+               {
+                  pStatement->mConditions.push_back(parseExpression());
+                  pStatement->mBlocks.push_back(Block());
+                  parseBlock(pStatement->mBlocks.back(), terminators);
+                  if (isKeyword("elseif") == false)
+                  {
+                     break;
+                  }
+
+                  next();
+               }
+
+               if (isKeyword("else"))
+               {
+                  next();
+                  pStatement->mBlocks.push_back(Block());
+                  parseBlock(pStatement->mBlocks.back(), std::vector<std::string>(1, "end"));
+               }
+            }
+            else if (keyword == "for" || keyword == "while")
+            {
+               pStatement = new Statement(keyword == "for" ? Statement::FOR : Statement::WHILE);
+               const bool parenthesized = (keyword == "for" && isOperator("("));
+               if (keyword == "for")
+               {
+                  if (parenthesized)
+                  {
+                     next();
+                  }
+
+                  if (peek().mType != IDENTIFIER)
+                  {
+                     throw EvaluationError("Parse error: expected a loop variable.");
+                  }
+
+                  pStatement->mName = next().mText;
+                  expectOperator("=");
+               }
+
+               pStatement->mpExpr = parseExpression();
+               if (parenthesized)
+               {
+                  expectOperator(")");
+               }
+
+               pStatement->mBlocks.push_back(Block());
+               parseBlock(pStatement->mBlocks.back(), std::vector<std::string>(1, "end"));
+            }
+            else if (keyword == "try")
+            {
+               pStatement = new Statement(Statement::TRY);
+               std::vector<std::string> terminators;
+               terminators.push_back("catch");
+               terminators.push_back("end");
+               pStatement->mBlocks.push_back(Block());
+               parseBlock(pStatement->mBlocks.back(), terminators);
+               pStatement->mBlocks.push_back(Block());
+               if (isKeyword("catch"))
+               {
+                  next();
+                  if (peek().mType == IDENTIFIER && peek(1).mType == SEPARATOR)
+                  {
+                     pStatement->mName = next().mText;
+                  }
+
+                  parseBlock(pStatement->mBlocks.back(), std::vector<std::string>(1, "end"));
+               }
+            }
+            else if (keyword == "break" || keyword == "continue" || keyword == "return")
+            {
+               pStatement = new Statement(keyword == "break" ? Statement::BREAK :
+                  (keyword == "continue" ? Statement::CONTINUE : Statement::RETURN));
+               parseTerminator();
+               return pStatement;
+            }
+            else
+            {
+               throw EvaluationError("The \"" + keyword + "\" keyword is not supported.");
+            }
+
+            expectKeyword("end");
+            parseTerminator();
+            return pStatement;
+         }
+         catch (...)
+         {
+            delete pStatement;
+            throw;
+         }
+      }
+
+      // Binary operators from lowest to highest precedence. Ranges and unary operators are handled separately.
+      int getPrecedence(const Token& token) const
+      {
+         if (token.mType != OPERATOR)
+         {
+            return -1;
+         }
+
+         const std::string& op = token.mText;
+         if (op == "||")
+         {
+            return 1;
+         }
+
+         if (op == "&&")
+         {
+            return 2;
+         }
+
+         if (op == "|")
+         {
+            return 3;
+         }
+
+         if (op == "&")
+         {
+            return 4;
+         }
+
+         if (op == "==" || op == "~=" || op == "!=" || op == "<" || op == "<=" || op == ">" || op == ">=")
+         {
+            return 5;
+         }
+
+         if (op == "+" || op == "-")
+         {
+            // Inside brackets, "[a -b]" holds two elements while "[a - b]" and "[a-b]" hold one.
+            if (token.mInMatrix == true && token.mSpaceBefore == true && peek(1).mSpaceBefore == false)
+            {
+               return -1;
+            }
+
+            return 7;
+         }
+
+         if (op == "*" || op == "/" || op == ".*" || op == "./" || op == "\\" || op == ".\\")
+         {
+            return 8;
+         }
+
+         return -1;
+      }
+
+      Expr* parseExpression(int minimumPrecedence = 1)
+      {
+         Expr* pLeft = (minimumPrecedence <= 6 ? parseRange() : parseUnary());
+         for (;;)
+         {
+            const int precedence = getPrecedence(peek());
+            if (precedence < minimumPrecedence || (precedence == 6 && minimumPrecedence > 6))
+            {
+               return pLeft;
+            }
+
+            if (precedence < 6 && minimumPrecedence > 5)
+            {
+               return pLeft;
+            }
+
+            Expr* pBinary = new Expr(Expr::BINARY);
+            pBinary->mText = next().mText;
+            pBinary->mChildren.push_back(pLeft);
+            try
+            {
+               pBinary->mChildren.push_back(precedence > 6 ? parseArithmetic(precedence + 1) :
+                  parseExpression(precedence + 1));
+            }
+            catch (...)
+            {
+               delete pBinary;
+               throw;
+            }
+
+            pLeft = pBinary;
+         }
+      }
+
+      // Parses additive and multiplicative expressions, which bind more tightly than ranges.
+      Expr* parseArithmetic(int minimumPrecedence)
+      {
+         Expr* pLeft = parseUnary();
+         for (;;)
+         {
+            const int precedence = getPrecedence(peek());
+            if (precedence < minimumPrecedence || precedence < 7)
+            {
+               return pLeft;
+            }
+
+            Expr* pBinary = new Expr(Expr::BINARY);
+            pBinary->mText = next().mText;
+            pBinary->mChildren.push_back(pLeft);
+            try
+            {
+               pBinary->mChildren.push_back(parseArithmetic(precedence + 1));
+            }
+            catch (...)
+            {
+               delete pBinary;
+               throw;
+            }
+
+            pLeft = pBinary;
+         }
+      }
+
+      Expr* parseRange()
+      {
+         // A bare colon inside of an index selects everything.
+         if (mIndexDepth > 0 && isOperator(":") &&
+            (isOperator(")", 1) || isOperator("}", 1) || (peek(1).mType == SEPARATOR && peek(1).mText == ",")))
+         {
+            next();
+            return new Expr(Expr::COLON);
+         }
+
+         Expr* pStart = parseArithmetic(7);
+         if (isOperator(":") == false)
+         {
+            return pStart;
+         }
+
+         Expr* pRange = new Expr(Expr::RANGE);
+         pRange->mChildren.push_back(pStart);
+         try
+         {
+            next();
+            Expr* pSecond = parseArithmetic(7);
+            pRange->mChildren.push_back(pSecond);
+            if (isOperator(":"))
+            {
+               next();
+               pRange->mChildren.push_back(parseArithmetic(7));
+            }
+            else
+            {
+               pRange->mChildren.insert(pRange->mChildren.begin() + 1, static_cast<Expr*>(NULL));
+            }
+         }
+         catch (...)
+         {
+            delete pRange;
+            throw;
+         }
+
+         return pRange;
+      }
+
+      Expr* parseUnary()
+      {
+         if (isOperator("-") || isOperator("+") || isOperator("~") || isOperator("!"))
+         {
+            Expr* pUnary = new Expr(Expr::UNARY);
+            pUnary->mText = next().mText;
+            if (pUnary->mText == "!")
+            {
+               pUnary->mText = "~";
+            }
+
+            try
+            {
+               pUnary->mChildren.push_back(parseUnary());
+            }
+            catch (...)
+            {
+               delete pUnary;
+               throw;
+            }
+
+            return pUnary;
+         }
+
+         return parsePower();
+      }
+
+      Expr* parsePower()
+      {
+         Expr* pLeft = parsePostfix();
+         while (isOperator("^") || isOperator(".^"))
+         {
+            Expr* pBinary = new Expr(Expr::BINARY);
+            pBinary->mText = next().mText;
+            pBinary->mChildren.push_back(pLeft);
+            try
+            {
+               // Exponents may carry their own sign, as in 2^-1.
+               if (isOperator("-") || isOperator("+"))
+               {
+                  Expr* pUnary = new Expr(Expr::UNARY);
+                  pUnary->mText = next().mText;
+                  pBinary->mChildren.push_back(pUnary);
+                  pUnary->mChildren.push_back(parsePostfix());
+               }
+               else
+               {
+                  pBinary->mChildren.push_back(parsePostfix());
+               }
+            }
+            catch (...)
+            {
+               delete pBinary;
+               throw;
+            }
+
+            pLeft = pBinary;
+         }
+
+         return pLeft;
+      }
+
+      Expr* parsePostfix()
+      {
+         Expr* pExpr = parsePrimary();
+         try
+         {
+            for (;;)
+            {
+               const Token& token = peek();
+               if (token.mType != OPERATOR || (token.mInMatrix == true && token.mSpaceBefore == true))
+               {
+                  return pExpr;
+               }
+
+               if (token.mText == "(" || token.mText == "{")
+               {
+                  const bool brace = (token.mText == "{");
+                  next();
+                  Expr* pIndex = new Expr(brace ? Expr::BRACE : Expr::INDEX);
+                  pIndex->mChildren.push_back(pExpr);
+                  pExpr = pIndex;
+                  parseArguments(pIndex, brace ? "}" : ")");
+               }
+               else if (token.mText == "." && peek(1).mType == IDENTIFIER)
+               {
+                  next();
+                  Expr* pField = new Expr(Expr::FIELD);
+                  pField->mChildren.push_back(pExpr);
+                  pField->mText = next().mText;
+                  pExpr = pField;
+               }
+               else if (token.mText == "'" || token.mText == ".'")
+               {
+                  next();
+                  Expr* pTranspose = new Expr(Expr::POSTFIX);
+                  pTranspose->mText = "'";
+                  pTranspose->mChildren.push_back(pExpr);
+                  pExpr = pTranspose;
+               }
+               else
+               {
+                  return pExpr;
+               }
+            }
+         }
+         catch (...)
+         {
+            delete pExpr;
+            throw;
+         }
+      }
+
+      void parseArguments(Expr* pIndex, const std::string& close)
+      {
+         ++mIndexDepth;
+         while (isOperator(close) == false)
+         {
+            pIndex->mChildren.push_back(parseExpression());
+            if (peek().mType == SEPARATOR && peek().mText == ",")
+            {
+               next();
+            }
+            else if (isOperator(close) == false)
+            {
+               --mIndexDepth;
+               throw EvaluationError("Parse error: expected \"" + close + "\".");
+            }
+         }
+
+         --mIndexDepth;
+         next();
+      }
+
+      Expr* parsePrimary()
+      {
+         const Token& token = peek();
+         if (token.mType == NUMBER)
+         {
+            Expr* pNumber = new Expr(Expr::NUMBER_EXPR);
+            pNumber->mNumber = next().mNumber;
+            return pNumber;
+         }
+
+         if (token.mType == STRING)
+         {
+            Expr* pString = new Expr(Expr::STRING_EXPR);
+            pString->mText = next().mText;
+            return pString;
+         }
+
+         if (token.mType == IDENTIFIER)
+         {
+            Expr* pIdent = new Expr(Expr::IDENT);
+            pIdent->mText = next().mText;
+            return pIdent;
+         }
+
+         if (token.mType == KEYWORD && token.mText == "end" && mIndexDepth > 0)
+         {
+            next();
+            return new Expr(Expr::END_EXPR);
+         }
+
+         if (isOperator("("))
+         {
+            next();
+            const size_t indexDepth = mIndexDepth;
+            mIndexDepth = 0;
+            Expr* pExpr = parseExpression();
+            mIndexDepth = indexDepth;
+            try
+            {
+               expectOperator(")");
+            }
+            catch (...)
+            {
+               delete pExpr;
+               throw;
+            }
+
+            return pExpr;
+         }
+
+         if (isOperator("[") || isOperator("{"))
+         {
+            return parseMatrix();
+         }
+
+         if (isOperator("@"))
+         {
+            throw EvaluationError("Function handles are not supported.");
+         }
+
+         throw EvaluationError(token.mType == END_OF_INPUT ? "Expression or statement is incomplete." :
+            "Unexpected MATLAB operator.");
+      }
+
+      Expr* parseMatrix()
+      {
+         const bool cell = isOperator("{");
+         const std::string close = (cell ? "}" : "]");
+         next();
+         Expr* pMatrix = new Expr(cell ? Expr::CELL : Expr::MATRIX);
+         try
+         {
+            size_t rowLength = 0;
+            for (;;)
+            {
+               if (isOperator(close))
+               {
+                  next();
+                  break;
+               }
+
+               const Token& token = peek();
+               if (token.mType == SEPARATOR)
+               {
+                  next();
+                  if (token.mText == ";" && rowLength > 0)
+                  {
+                     pMatrix->mRowLengths.push_back(rowLength);
+                     rowLength = 0;
+                  }
+
+                  continue;
+               }
+
+               if (token.mType == END_OF_INPUT)
+               {
+                  throw EvaluationError("Parse error: expected \"" + close + "\".");
+               }
+
+               pMatrix->mChildren.push_back(parseExpression());
+               ++rowLength;
+            }
+
+            if (rowLength > 0)
+            {
+               pMatrix->mRowLengths.push_back(rowLength);
+            }
+         }
+         catch (...)
+         {
+            delete pMatrix;
+            throw;
+         }
+
+         return pMatrix;
+      }
+
+      const std::vector<Token>& mTokens;
+      size_t mPosition;
+      size_t mIndexDepth;
+   };
+
+   // Selected elements along one dimension of an index, or every element for a bare colon.
+   struct Subscript
+   {
+      Subscript() :
+         mAll(false)
+      {}
+
+      bool mAll;
+      std::vector<size_t> mIndices;
+      std::vector<mwSize> mShape;
+
+      size_t getCount(size_t extent) const
+      {
+         return mAll ? extent : mIndices.size();
+      }
+
+      size_t get(size_t i) const
+      {
+         return mAll ? i : mIndices[i];
+      }
+
+      size_t getMaximum() const
+      {
+         return mIndices.empty() ? 0 : *std::max_element(mIndices.begin(), mIndices.end()) + 1;
+      }
+   };
+
+   // Returns the extent of each of count dimensions, folding any remaining dimensions into the last one.
+   std::vector<mwSize> getIndexedExtents(const std::vector<mwSize>& dims, size_t count)
+   {
+      std::vector<mwSize> extents(count, 1);
+      for (size_t i = 0; i < dims.size(); ++i)
+      {
+         extents[std::min(i, count - 1)] *= dims[i];
+      }
+
+      return extents;
+   }
+
+   std::string formatNumber(double value, bool integral)
+   {
+      if (value != value)
+      {
+         return "NaN";
+      }
+
+      if (value == HUGE_VAL || value == -HUGE_VAL)
+      {
+         return value > 0.0 ? "Inf" : "-Inf";
+      }
+
+      char buffer[64];
+      if (integral == true)
+      {
+         sprintf(buffer, "%.0f", value);
+      }
+      else
+      {
+         sprintf(buffer, "%.4f", value);
+      }
+
+      return buffer;
+   }
+
+   bool isIntegral(const mxArray* pArray)
+   {
+      if (pArray->mClassId != mxDOUBLE_CLASS && pArray->mClassId != mxSINGLE_CLASS)
+      {
+         return true;
+      }
+
+      const size_t count = getCount(pArray);
+      for (size_t i = 0; i < count; ++i)
+      {
+         const double value = MockArray::getValue(pArray, i);
+         if (value == value && value != HUGE_VAL && value != -HUGE_VAL && value != floor(value))
+         {
+            return false;
+         }
+      }
+
+      return true;
+   }
+
+   std::string getSizeText(const mxArray* pArray)
+   {
+      std::string text;
+      for (size_t i = 0; i < pArray->mDims.size(); ++i)
+      {
+         char buffer[32];
+         sprintf(buffer, "%s%lu", i == 0 ? "" : "x", static_cast<unsigned long>(pArray->mDims[i]));
+         text += buffer;
+      }
+
+      return text;
+   }
+
+   // Returns the short form used for struct fields and cell elements, such as 'text', 5, or [2x3 double].
+   std::string getSummary(const mxArray* pArray, bool bracketScalars)
+   {
+      if (pArray == NULL)
+      {
+         return "[]";
+      }
+
+      if (mxIsChar(pArray) == true && pArray->mDims.size() == 2 && pArray->mDims[0] <= 1)
+      {
+         return "'" + MockArray::getString(pArray) + "'";
+      }
+
+      if (MockArray::isArithmetic(pArray->mClassId) == true && isScalar(pArray) == true)
+      {
+         const std::string text = formatNumber(MockArray::getValue(pArray, 0), isIntegral(pArray));
+         return bracketScalars ? "[" + text + "]" : text;
+      }
+
+      if (getCount(pArray) == 0 && pArray->mClassId == mxDOUBLE_CLASS)
+      {
+         return "[]";
+      }
+
+      return "[" + getSizeText(pArray) + " " + mxGetClassName(pArray) + "]";
+   }
+
+   // Formats the rows of a two-dimensional page of an arithmetic or character array.
+   std::string formatPage(const mxArray* pArray, size_t page)
+   {
+      const size_t rows = pArray->mDims[0];
+      const size_t columns = pArray->mDims[1];
+      const size_t offset = page * rows * columns;
+      std::string text;
+      if (pArray->mClassId == mxCHAR_CLASS)
+      {
+         for (size_t row = 0; row < rows; ++row)
+         {
+            for (size_t column = 0; column < columns; ++column)
+            {
+               text.push_back(static_cast<char>(MockArray::getValue(pArray, offset + column * rows + row)));
+            }
+
+            text.push_back('\n');
+         }
+
+         return text;
+      }
+
+      const bool integral = isIntegral(pArray);
+      std::vector<std::string> values(rows * columns);
+      size_t width = 0;
+      for (size_t i = 0; i < values.size(); ++i)
+      {
+         values[i] = formatNumber(MockArray::getValue(pArray, offset + i), integral);
+         width = std::max(width, values[i].size());
+      }
+
+      width = std::max(width + 3, static_cast<size_t>(6));
+      for (size_t row = 0; row < rows; ++row)
+      {
+         for (size_t column = 0; column < columns; ++column)
+         {
+            const std::string& value = values[column * rows + row];
+            text += std::string(width - value.size(), ' ') + value;
+         }
+
+         text.push_back('\n');
+      }
+
+      return text;
+   }
+
+   // Formats a value in the style of MATLAB's "format compact".
+   std::string formatValue(const std::string& name, const mxArray* pArray)
+   {
+      const size_t count = getCount(pArray);
+      if (pArray->mClassId == mxSTRUCT_CLASS)
+      {
+         if (count != 1)
+         {
+            std::string text = name + " = \n" + getSizeText(pArray) + " struct array with fields:\n";
+            for (size_t field = 0; field < pArray->mFieldNames.size(); ++field)
+            {
+               text += "    " + pArray->mFieldNames[field] + "\n";
+            }
+
+            return text;
+         }
+
+         size_t width = 0;
+         for (size_t field = 0; field < pArray->mFieldNames.size(); ++field)
+         {
+            width = std::max(width, pArray->mFieldNames[field].size());
+         }
+
+         std::string text = name + " = \n";
+         for (size_t field = 0; field < pArray->mFieldNames.size(); ++field)
+         {
+            const std::string& fieldName = pArray->mFieldNames[field];
+            text += std::string(width + 4 - fieldName.size(), ' ') + fieldName + ": " +
+               getSummary(pArray->mFields[field], false) + "\n";
+         }
+
+         return text;
+      }
+
+      if (pArray->mClassId == mxCELL_CLASS)
+      {
+         if (count == 0 || pArray->mDims.size() > 2)
+         {
+            return name + " = \n   {" + getSizeText(pArray) + " cell}\n";
+         }
+
+         std::string text = name + " = \n";
+         for (size_t row = 0; row < pArray->mDims[0]; ++row)
+         {
+            for (size_t column = 0; column < pArray->mDims[1]; ++column)
+            {
+               text += "    " + getSummary(pArray->mCells[column * pArray->mDims[0] + row], true);
+            }
+
+            text.push_back('\n');
+         }
+
+         return text;
+      }
+
+      if (count == 0)
+      {
+         return name + " =\n" + (pArray->mClassId == mxCHAR_CLASS ? "     ''\n" : "     []\n");
+      }
+
+      const size_t pageCount = count / (pArray->mDims[0] * pArray->mDims[1]);
+      if (pageCount == 1)
+      {
+         return name + " =\n" + formatPage(pArray, 0);
+      }
+
+      // Pages of arrays with more than two dimensions are labeled with their trailing subscripts.
+      std::string text;
+      for (size_t page = 0; page < pageCount; ++page)
+      {
+         std::string label = name + "(:,:";
+         size_t remainder = page;
+         for (size_t dim = 2; dim < pArray->mDims.size(); ++dim)
+         {
+            char buffer[32];
+            sprintf(buffer, ",%lu", static_cast<unsigned long>(remainder % pArray->mDims[dim] + 1));
+            label += buffer;
+            remainder /= pArray->mDims[dim];
+         }
+
+         text += label + ") =\n" + formatPage(pArray, page);
+      }
+
+      return text;
+   }
+
+   // Expands a printf-style format over the arguments, repeating the format until every argument is consumed.
+   std::string formatString(const std::string& format, const std::vector<Value>& arguments, size_t first)
+   {
+      // Character arrays are consumed whole by %s, while every other argument is consumed one element at a time.
+      std::vector<Value> strings;
+      std::vector<double> numbers;
+      std::vector<bool> isString;
+      for (size_t i = first; i < arguments.size(); ++i)
+      {
+         const mxArray* pArray = arguments[i].get();
+         if (mxIsChar(pArray) == true)
+         {
+            strings.push_back(arguments[i]);
+            isString.push_back(true);
+         }
+         else if (MockArray::isArithmetic(pArray->mClassId) == true)
+         {
+            for (size_t element = 0; element < getCount(pArray); ++element)
+            {
+               numbers.push_back(MockArray::getValue(pArray, element));
+               isString.push_back(false);
+            }
+         }
+         else
+         {
+            throw EvaluationError("Only numeric and character arguments can be formatted.");
+         }
+      }
+
+      std::string text;
+      size_t argument = 0;
+      size_t stringIndex = 0;
+      size_t numberIndex = 0;
+      do
+      {
+         bool consumed = false;
+         for (size_t i = 0; i < format.size(); ++i)
+         {
+            const char c = format[i];
+            if (c == '\\' && i + 1 < format.size())
+            {
+               const char escape = format[++i];
+               text.push_back(escape == 'n' ? '\n' : (escape == 't' ? '\t' : (escape == 'r' ? '\r' : escape)));
+               continue;
+            }
+
+            if (c != '%')
+            {
+               text.push_back(c);
+               continue;
+            }
+
+            if (i + 1 < format.size() && format[i + 1] == '%')
+            {
+               text.push_back('%');
+               ++i;
+               continue;
+            }
+
+            size_t end = i + 1;
+            while (end < format.size() && strchr("-+ #0123456789.", format[end]) != NULL)
+            {
+               ++end;
+            }
+
+            if (end >= format.size())
+            {
+               break;
+            }
+
+            std::string specifier = format.substr(i, end - i);
+            const char conversion = format[end];
+            i = end;
+            if (argument >= isString.size())
+            {
+               // Stop at the first conversion which has no argument left, as MATLAB does.
+               if (argument > 0 || isString.empty() == false)
+               {
+                  return text;
+               }
+
+               continue;
+            }
+
+            consumed = true;
+            char buffer[512];
+            if (isString[argument] == true)
+            {
+               const std::string value = MockArray::getString(strings[stringIndex++].get());
+               if (conversion == 's' || conversion == 'c')
+               {
+                  text += value;
+               }
+               else
+               {
+                  for (size_t character = 0; character < value.size(); ++character)
+                  {
+                     sprintf(buffer, (specifier + "d").c_str(), static_cast<int>(value[character]));
+                     text += buffer;
+                  }
+               }
+            }
+            else
+            {
+               const double value = numbers[numberIndex++];
+               if (conversion == 'd' || conversion == 'i' || conversion == 'u')
+               {
+                  if (value == floor(value) && fabs(value) < 9.0e15)
+                  {
+                     sprintf(buffer, (specifier + ".0f").c_str(), value);
+                  }
+                  else
+                  {
+                     sprintf(buffer, (specifier + "e").c_str(), value);
+                  }
+               }
+               else if (conversion == 'f' || conversion == 'e' || conversion == 'g' || conversion == 'E' ||
+                  conversion == 'G')
+               {
+                  sprintf(buffer, (specifier + conversion).c_str(), value);
+               }
+               else if (conversion == 'c')
+               {
+                  sprintf(buffer, "%c", static_cast<char>(value));
+               }
+               else
+               {
+                  sprintf(buffer, (specifier + "g").c_str(), value);
+               }
+
+               text += buffer;
+            }
+
+            ++argument;
+         }
+
+         if (consumed == false)
+         {
+            break;
+         }
+      }
+      while (argument < isString.size());
+
+      return text;
+   }
+
+   bool isValidName(const std::string& name)
+   {
+      if (name.empty() == true || isalpha(name[0]) == 0 || isKeyword(name) == true)
+      {
+         return false;
+      }
+
+      for (std::string::const_iterator iter = name.begin(); iter != name.end(); ++iter)
+      {
+         if (isalnum(*iter) == 0 && *iter != '_')
+         {
+            return false;
+         }
+      }
+
+      return true;
+   }
+
+   Value createError(const std::string& message, const std::string& identifier)
+   {
+      const char* pFields[] = { "message", "identifier", "stack" };
+      mxArray* pError = mxCreateStructMatrix(1, 1, 3, pFields);
+      mxSetField(pError, 0, "message", mxCreateString(message.c_str()));
+      mxSetField(pError, 0, "identifier", mxCreateString(identifier.c_str()));
+
+      const char* pStackFields[] = { "file", "name", "line" };
+      mxSetField(pError, 0, "stack", mxCreateStructMatrix(0, 1, 3, pStackFields));
+      return Value(pError);
+   }
+}
+
+struct MockEvaluator::Workspace
+{
+   Workspace() :
+      mLastError(createError(std::string(), std::string()))
+   {}
+
+   std::map<std::string, Value> mVariables;
+   Value mLastError;
+};
+
+namespace
+{
+   class Executor;
+   typedef void (Executor::*Builtin)(const std::vector<Value>& arguments, size_t outputCount,
+      std::vector<Value>& results);
+
+   // Signals a break, continue, or return statement to the enclosing loop or to the top level.
+   enum Flow
+   {
+      NORMAL_FLOW,
+      BREAK_FLOW,
+      CONTINUE_FLOW,
+      RETURN_FLOW
+   };
+
+   class Executor
+   {
+   public:
+      Executor(std::map<std::string, Value>& variables, Value& lastError, std::string& output) :
+         mVariables(variables),
+         mLastError(lastError),
+         mOutput(output)
+      {
+         registerBuiltins();
+      }
+
+      ~Executor()
+      {
+         for (std::map<int, FILE*>::iterator iter = mFiles.begin(); iter != mFiles.end(); ++iter)
+         {
+            fclose(iter->second);
+         }
+      }
+
+      void run(const std::string& code)
+      {
+         std::vector<Token> tokens = Lexer(code).tokenize();
+         BlockResource program;
+         Parser(tokens).parseProgram(program.mBlock);
+         execute(program.mBlock);
+      }
+
+      void setLastError(const EvaluationError& error)
+      {
+         mLastError = createError(error.what(), error.mIdentifier);
+      }
+
+   private:
+      Flow execute(const Block& block)
+      {
+         for (Block::const_iterator iter = block.begin(); iter != block.end(); ++iter)
+         {
+            const Flow flow = execute(**iter);
+            if (flow != NORMAL_FLOW)
+            {
+               return flow;
+            }
+         }
+
+         return NORMAL_FLOW;
+      }
+
+      Flow execute(const Statement& statement)
+      {
+         switch (statement.mKind)
+         {
+            case Statement::EXPRESSION:
+               executeExpression(statement);
+               break;
+            case Statement::ASSIGN:
+               executeAssignment(statement);
+               break;
+            case Statement::MULTI_ASSIGN:
+               executeMultipleAssignment(statement);
+               break;
+            case Statement::COMMAND_STATEMENT:
+            {
+               std::vector<Value> arguments;
+               for (std::vector<std::string>::const_iterator iter = statement.mArguments.begin();
+                  iter != statement.mArguments.end(); ++iter)
+               {
+                  arguments.push_back(makeString(*iter));
+               }
+
+               std::vector<Value> results;
+               callFunction(statement.mName, arguments, 0, results);
+               break;
+            }
+            case Statement::IF:
+               for (size_t i = 0; i < statement.mBlocks.size(); ++i)
+               {
+                  if (i >= statement.mConditions.size() || isTrue(evaluate(statement.mConditions[i])) == true)
+                  {
+                     return execute(statement.mBlocks[i]);
+                  }
+               }
+
+               break;
+            case Statement::FOR:
+               return executeFor(statement);
+            case Statement::WHILE:
+               while (isTrue(evaluate(statement.mpExpr)) == true)
+               {
+                  const Flow flow = execute(statement.mBlocks.front());
+                  if (flow == BREAK_FLOW)
+                  {
+                     break;
+                  }
+
+                  if (flow == RETURN_FLOW)
+                  {
+                     return flow;
+                  }
+               }
+
+               break;
+            case Statement::TRY:
+               try
+               {
+                  return execute(statement.mBlocks[0]);
+               }
+               catch (const EvaluationError& error)
+               {
+                  setLastError(error);
+                  if (statement.mName.empty() == false)
+                  {
+                     mVariables[statement.mName] = mLastError;
+                  }
+
+                  return execute(statement.mBlocks[1]);
+               }
+            case Statement::BREAK:
+               return BREAK_FLOW;
+            case Statement::CONTINUE:
+               return CONTINUE_FLOW;
+            case Statement::RETURN:
+               return RETURN_FLOW;
+            default:
+               break;
+         }
+
+         return NORMAL_FLOW;
+      }
+
+      void executeExpression(const Statement& statement)
+      {
+         const Expr* pExpr = statement.mpExpr;
+         if (pExpr->mKind == Expr::IDENT && mVariables.find(pExpr->mText) != mVariables.end())
+         {
+            if (statement.mPrint == true)
+            {
+               mOutput += formatValue(pExpr->mText, mVariables[pExpr->mText].get());
+            }
+
+            return;
+         }
+
+         // Function calls are made without requesting an output, so functions such as disp do not fail.
+         std::vector<Value> results;
+         evaluateMultiple(pExpr, 0, results);
+         if (results.empty() == false && results.front().isNull() == false)
+         {
+            mVariables["ans"] = results.front();
+            if (statement.mPrint == true)
+            {
+               mOutput += formatValue("ans", results.front().get());
+            }
+         }
+      }
+
+      void executeAssignment(const Statement& statement)
+      {
+         const Value value = evaluate(statement.mpExpr);
+         const std::string name = assign(statement.mpTarget, value);
+         if (statement.mPrint == true)
+         {
+            mOutput += formatValue(name, mVariables[name].get());
+         }
+      }
+
+      void executeMultipleAssignment(const Statement& statement)
+      {
+         std::vector<Value> results;
+         evaluateMultiple(statement.mpExpr, statement.mTargets.size(), results);
+         if (results.size() < statement.mTargets.size())
+         {
+            throw EvaluationError("Too many output arguments.");
+         }
+
+         for (size_t i = 0; i < statement.mTargets.size(); ++i)
+         {
+            if (statement.mTargets[i] != NULL)
+            {
+               const std::string name = assign(statement.mTargets[i], results[i]);
+               if (statement.mPrint == true)
+               {
+                  mOutput += formatValue(name, mVariables[name].get());
+               }
+            }
+         }
+      }
+
+      Flow executeFor(const Statement& statement)
+      {
+         const Value range = evaluate(statement.mpExpr);
+         const mxArray* pRange = range.get();
+
+         // Each iteration assigns one column of the range.
+         const size_t rows = pRange->mDims[0];
+         const size_t columns = (rows == 0 ? 0 : getCount(pRange) / rows);
+         for (size_t column = 0; column < columns; ++column)
+         {
+            mxArray* pColumn = createLike(pRange, pRange->mClassId, makeDims(rows, 1));
+            for (size_t row = 0; row < rows; ++row)
+            {
+               copyElement(pRange, column * rows + row, pColumn, row);
+            }
+
+            mVariables[statement.mName] = Value(pColumn);
+            const Flow flow = execute(statement.mBlocks.front());
+            if (flow == BREAK_FLOW)
+            {
+               break;
+            }
+
+            if (flow == RETURN_FLOW)
+            {
+               return flow;
+            }
+         }
+
+         return NORMAL_FLOW;
+      }
+
+      // Evaluates an expression which must produce exactly one value.
+      Value evaluate(const Expr* pExpr)
+      {
+         std::vector<Value> results;
+         evaluateMultiple(pExpr, 1, results);
+         if (results.empty() == true || results.front().isNull() == true)
+         {
+            throw EvaluationError("Too many output arguments.");
+         }
+
+         return results.front();
+      }
+
+      // Evaluates an expression which may be a function call producing any number of values.
+      void evaluateMultiple(const Expr* pExpr, size_t outputCount, std::vector<Value>& results)
+      {
+         switch (pExpr->mKind)
+         {
+            case Expr::IDENT:
+            {
+               std::map<std::string, Value>::const_iterator iter = mVariables.find(pExpr->mText);
+               if (iter != mVariables.end())
+               {
+                  results.push_back(iter->second);
+                  return;
+               }
+
+               callFunction(pExpr->mText, std::vector<Value>(), outputCount, results);
+               return;
+            }
+            case Expr::INDEX:
+            {
+               const Expr* pBase = pExpr->mChildren.front();
+               if (pBase->mKind == Expr::IDENT && mVariables.find(pBase->mText) == mVariables.end())
+               {
+                  std::vector<Value> arguments;
+                  for (size_t i = 1; i < pExpr->mChildren.size(); ++i)
+                  {
+                     if (pExpr->mChildren[i]->mKind == Expr::COLON)
+                     {
+                        arguments.push_back(makeString(":"));
+                     }
+                     else
+                     {
+                        arguments.push_back(evaluate(pExpr->mChildren[i]));
+                     }
+                  }
+
+                  callFunction(pBase->mText, arguments, outputCount, results);
+                  return;
+               }
+
+               const Value base = evaluate(pBase);
+               std::vector<Subscript> subscripts = evaluateSubscripts(pExpr, base.get());
+               results.push_back(index(base, subscripts));
+               return;
+            }
+            default:
+               results.push_back(evaluateValue(pExpr));
+               return;
+         }
+      }
+
+      Value evaluateValue(const Expr* pExpr)
+      {
+         switch (pExpr->mKind)
+         {
+            case Expr::NUMBER_EXPR:
+               return makeScalar(pExpr->mNumber);
+            case Expr::STRING_EXPR:
+               return makeString(pExpr->mText);
+            case Expr::BRACE:
+            {
+               const Value base = evaluate(pExpr->mChildren.front());
+               if (mxIsCell(base.get()) == false)
+               {
+                  throw EvaluationError("Cell contents reference from a non-cell array object.");
+               }
+
+               std::vector<Subscript> subscripts = evaluateSubscripts(pExpr, base.get());
+               const Value cells = index(base, subscripts);
+               if (getCount(cells.get()) != 1)
+               {
+                  throw EvaluationError("Only a single cell can be referenced at a time.");
+               }
+
+               return Value(mxDuplicateArray(cells.get()->mCells.front()));
+            }
+            case Expr::FIELD:
+            {
+               const Value base = evaluate(pExpr->mChildren.front());
+               if (mxIsStruct(base.get()) == false || getCount(base.get()) != 1)
+               {
+                  throw EvaluationError("Attempt to reference field of non-structure array.");
+               }
+
+               if (mxGetFieldNumber(base.get(), pExpr->mText.c_str()) < 0)
+               {
+                  throw EvaluationError("Reference to non-existent field '" + pExpr->mText + "'.");
+               }
+
+               const mxArray* pField = mxGetField(base.get(), 0, pExpr->mText.c_str());
+               return pField == NULL ? makeEmpty() : Value(mxDuplicateArray(pField));
+            }
+            case Expr::BINARY:
+               return evaluateBinary(pExpr);
+            case Expr::UNARY:
+               return evaluateUnary(pExpr->mText, evaluate(pExpr->mChildren.front()));
+            case Expr::POSTFIX:
+               return transpose(evaluate(pExpr->mChildren.front()));
+            case Expr::MATRIX:
+            case Expr::CELL:
+               return evaluateMatrix(pExpr);
+            case Expr::END_EXPR:
+               return evaluateEnd();
+            case Expr::RANGE:
+            {
+               const double start = getScalar(evaluate(pExpr->mChildren[0]), "The range start");
+               const double step = pExpr->mChildren[1] == NULL ? 1.0 :
+                  getScalar(evaluate(pExpr->mChildren[1]), "The range step");
+               const double stop = getScalar(evaluate(pExpr->mChildren[2]), "The range stop");
+               return makeRange(start, step, stop);
+            }
+            case Expr::COLON:
+               throw EvaluationError("A colon may only be used as an index.");
+            default:
+               throw EvaluationError("Unsupported expression.");
+         }
+      }
+
+      Value makeRange(double start, double step, double stop)
+      {
+         size_t count = 0;
+         if (step != 0.0 && ((step > 0.0 && start <= stop) || (step < 0.0 && start >= stop)))
+         {
+            count = static_cast<size_t>(floor((stop - start) / step + 1e-10)) + 1;
+         }
+
+         mxArray* pRange = MockArray::create(mxDOUBLE_CLASS, makeDims(1, count));
+         for (size_t i = 0; i < count; ++i)
+         {
+            MockArray::setValue(pRange, i, start + step * static_cast<double>(i));
+         }
+
+         return Value(pRange);
+      }
+
+      // The end keyword evaluates to the extent of the dimension being indexed.
+      Value evaluateEnd()
+      {
+         if (mEndContexts.empty() == true)
+         {
+            throw EvaluationError("The end operator must be used within an array index expression.");
+         }
+
+         const EndContext& context = mEndContexts.back();
+         const std::vector<mwSize> extents = getIndexedExtents(context.mpArray->mDims, context.mCount);
+         return makeScalar(static_cast<double>(extents[context.mPosition]));
+      }
+
+      std::vector<Subscript> evaluateSubscripts(const Expr* pExpr, const mxArray* pArray)
+      {
+         std::vector<Subscript> subscripts;
+         const size_t count = pExpr->mChildren.size() - 1;
+         for (size_t i = 0; i < count; ++i)
+         {
+            const Expr* pArgument = pExpr->mChildren[i + 1];
+            Subscript subscript;
+            if (pArgument->mKind == Expr::COLON)
+            {
+               subscript.mAll = true;
+               subscripts.push_back(subscript);
+               continue;
+            }
+
+            EndContext context;
+            context.mpArray = pArray;
+            context.mPosition = i;
+            context.mCount = count;
+            mEndContexts.push_back(context);
+            Value value;
+            try
+            {
+               value = evaluate(pArgument);
+            }
+            catch (...)
+            {
+               mEndContexts.pop_back();
+               throw;
+            }
+
+            mEndContexts.pop_back();
+            subscripts.push_back(toSubscript(value));
+         }
+
+         return subscripts;
+      }
+
+      Subscript toSubscript(const Value& value)
+      {
+         const mxArray* pIndex = value.get();
+         Subscript subscript;
+         subscript.mShape = pIndex->mDims;
+         const size_t count = getCount(pIndex);
+         if (pIndex->mClassId == mxLOGICAL_CLASS)
+         {
+            for (size_t i = 0; i < count; ++i)
+            {
+               if (MockArray::getValue(pIndex, i) != 0.0)
+               {
+                  subscript.mIndices.push_back(i);
+               }
+            }
+
+            subscript.mShape = makeDims(subscript.mIndices.size(), 1);
+            return subscript;
+         }
+
+         if (mxIsChar(pIndex) == true && MockArray::getString(pIndex) == ":")
+         {
+            subscript.mAll = true;
+            return subscript;
+         }
+
+         if (MockArray::isArithmetic(pIndex->mClassId) == false)
+         {
+            throw EvaluationError("Subscript indices must either be real positive integers or logicals.");
+         }
+
+         subscript.mIndices.reserve(count);
+         for (size_t i = 0; i < count; ++i)
+         {
+            const double index = MockArray::getValue(pIndex, i);
+            if (index < 1.0 || index != floor(index))
+            {
+               throw EvaluationError("Subscript indices must either be real positive integers or logicals.");
+            }
+
+            subscript.mIndices.push_back(static_cast<size_t>(index) - 1);
+         }
+
+         return subscript;
+      }
+
+      Value index(const Value& base, const std::vector<Subscript>& subscripts)
+      {
+         const mxArray* pSource = base.get();
+         if (subscripts.empty() == true)
+         {
+            return base;
+         }
+
+         const std::vector<mwSize> extents = getIndexedExtents(pSource->mDims, subscripts.size());
+         std::vector<mwSize> dims;
+         for (size_t i = 0; i < subscripts.size(); ++i)
+         {
+            const Subscript& subscript = subscripts[i];
+            if (subscript.mAll == false && subscript.getMaximum() > extents[i])
+            {
+               throw EvaluationError("Index exceeds matrix dimensions.");
+            }
+
+            dims.push_back(subscript.getCount(extents[i]));
+         }
+
+         // A linear index takes the shape of the index, except that indexing a vector with a vector keeps the
+         // orientation of the source, and a bare colon produces a column.
+         if (subscripts.size() == 1)
+         {
+            const Subscript& subscript = subscripts.front();
+            if (subscript.mAll == true)
+            {
+               dims = makeDims(extents[0], 1);
+            }
+            else if (isVector(subscript.mShape) == true && isVector(pSource->mDims) == true)
+            {
+               dims = (pSource->mDims[0] == 1 ? makeDims(1, dims[0]) : makeDims(dims[0], 1));
+            }
+            else
+            {
+               dims = subscript.mShape;
+            }
+         }
+
+         mxArray* pResult = createLike(pSource, pSource->mClassId, dims);
+         const size_t count = getCount(pResult);
+         std::vector<size_t> counter(subscripts.size(), 0);
+         for (size_t i = 0; i < count; ++i)
+         {
+            size_t sourceIndex = 0;
+            size_t stride = 1;
+            for (size_t dim = 0; dim < subscripts.size(); ++dim)
+            {
+               sourceIndex += subscripts[dim].get(counter[dim]) * stride;
+               stride *= extents[dim];
+            }
+
+            copyElement(pSource, sourceIndex, pResult, i);
+            for (size_t dim = 0; dim < subscripts.size(); ++dim)
+            {
+               if (++counter[dim] < subscripts[dim].getCount(extents[dim]))
+               {
+                  break;
+               }
+
+               counter[dim] = 0;
+            }
+         }
+
+         return Value(pResult);
+      }
+
+      // Assigns value to a target such as x, x(2, :), x{3}, or x.field, returning the name of the variable.
+      std::string assign(const Expr* pTarget, const Value& value)
+      {
+         std::vector<const Expr*> path;
+         for (const Expr* pExpr = pTarget; ; pExpr = pExpr->mChildren.front())
+         {
+            path.insert(path.begin(), pExpr);
+            if (pExpr->mKind == Expr::IDENT)
+            {
+               break;
+            }
+         }
+
+         const std::string& name = path.front()->mText;
+         if (path.size() == 1)
+         {
+            mVariables[name] = value;
+            return name;
+         }
+
+         Value current;
+         std::map<std::string, Value>::iterator iter = mVariables.find(name);
+         if (iter != mVariables.end())
+         {
+            current = iter->second;
+            mVariables.erase(iter);
+         }
+
+         try
+         {
+            assignPath(current, path, 1, value);
+         }
+         catch (...)
+         {
+            if (current.isNull() == false)
+            {
+               mVariables[name] = current;
+            }
+
+            throw;
+         }
+
+         mVariables[name] = current;
+         return name;
+      }
+
+      void assignPath(Value& current, const std::vector<const Expr*>& path, size_t position, const Value& value)
+      {
+         if (position == path.size())
+         {
+            current = value;
+            return;
+         }
+
+         const Expr* pExpr = path[position];
+         if (pExpr->mKind == Expr::FIELD)
+         {
+            if (current.isNull() == true || (getCount(current.get()) == 0 && mxIsStruct(current.get()) == false))
+            {
+               current = Value(mxCreateStructMatrix(1, 1, 0, NULL));
+            }
+
+            if (mxIsStruct(current.get()) == false || getCount(current.get()) != 1)
+            {
+               throw EvaluationError("Field assignment to a non-structure array object.");
+            }
+
+            mxArray* pStruct = current.edit();
+            const int field = mxAddField(pStruct, pExpr->mText.c_str());
+            Value child(pStruct->mFields[field]);
+            pStruct->mFields[field] = NULL;
+            try
+            {
+               assignPath(child, path, position + 1, value);
+            }
+            catch (...)
+            {
+               pStruct->mFields[field] = child.release();
+               throw;
+            }
+
+            pStruct->mFields[field] = child.release();
+            return;
+         }
+
+         if (pExpr->mKind == Expr::BRACE)
+         {
+            if (current.isNull() == true || (getCount(current.get()) == 0 && mxIsCell(current.get()) == false))
+            {
+               current = Value(mxCreateCellMatrix(0, 0));
+            }
+
+            if (mxIsCell(current.get()) == false)
+            {
+               throw EvaluationError("Cell contents assignment to a non-cell array object.");
+            }
+
+            std::vector<Subscript> subscripts = evaluateSubscripts(pExpr, current.get());
+            const size_t cell = prepareAssignment(current, subscripts, mxCELL_CLASS, makeDims(1, 1));
+            mxArray* pCells = current.edit();
+            Value child(pCells->mCells[cell]);
+            pCells->mCells[cell] = NULL;
+            try
+            {
+               assignPath(child, path, position + 1, value);
+            }
+            catch (...)
+            {
+               pCells->mCells[cell] = child.release();
+               throw;
+            }
+
+            pCells->mCells[cell] = child.release();
+            return;
+         }
+
+         if (position + 1 != path.size())
+         {
+            throw EvaluationError("Only the last level of an assignment may be indexed with parentheses.");
+         }
+
+         assignIndexed(current, evaluateSubscripts(pExpr, current.isNull() ? NULL : current.get()), value);
+      }
+
+      // Grows current so that every subscript is in range and returns the linear index of the first element
+      // which is addressed. The array is created with classId if it does not yet exist.
+      size_t prepareAssignment(Value& current, std::vector<Subscript>& subscripts, mxClassID classId,
+         const std::vector<mwSize>& valueDims)
+      {
+         if (current.isNull() == true)
+         {
+            current = makeEmpty(classId);
+         }
+
+         const mxArray* pArray = current.get();
+         std::vector<mwSize> dims = pArray->mDims;
+         std::vector<mwSize> newDims = dims;
+         if (subscripts.size() == 1)
+         {
+            const Subscript& subscript = subscripts.front();
+            const size_t count = getCount(pArray);
+            const size_t required = subscript.mAll ? count : subscript.getMaximum();
+            if (required > count)
+            {
+               if (count == 0)
+               {
+                  newDims = makeDims(1, required);
+               }
+               else if (isVector(dims) == true)
+               {
+                  newDims = (dims[0] == 1 ? makeDims(1, required) : makeDims(required, 1));
+               }
+               else
+               {
+                  throw EvaluationError("In an assignment A(I) = B, a matrix A cannot be resized.");
+               }
+            }
+         }
+         else
+         {
+            newDims.resize(std::max(newDims.size(), subscripts.size()), 1);
+            const std::vector<mwSize> extents = getIndexedExtents(dims, subscripts.size());
+            for (size_t i = 0; i < subscripts.size(); ++i)
+            {
+               size_t required = subscripts[i].getMaximum();
+               if (subscripts[i].mAll == true)
+               {
+                  // A colon into an empty dimension takes its extent from the value being assigned.
+                  required = (extents[i] > 0 || getCount(pArray) > 0) ? extents[i] :
+                     (i < valueDims.size() ? valueDims[i] : 1);
+                  if (extents[i] == 0)
+                  {
+                     subscripts[i].mAll = false;
+                     for (size_t j = 0; j < required; ++j)
+                     {
+                        subscripts[i].mIndices.push_back(j);
+                     }
+                  }
+               }
+
+               if (required > extents[i])
+               {
+                  if (i + 1 == subscripts.size() && dims.size() > subscripts.size() && getCount(pArray) > 0)
+                  {
+                     throw EvaluationError("Attempt to grow array along ambiguous dimension.");
+                  }
+
+                  newDims[i] = required;
+               }
+            }
+         }
+
+         if (newDims != dims)
+         {
+            grow(current, newDims);
+         }
+
+         const std::vector<mwSize> extents = getIndexedExtents(current.get()->mDims, subscripts.size());
+         size_t first = 0;
+         size_t stride = 1;
+         for (size_t i = 0; i < subscripts.size(); ++i)
+         {
+            first += (subscripts[i].getCount(extents[i]) == 0 ? 0 : subscripts[i].get(0)) * stride;
+            stride *= extents[i];
+         }
+
+         return first;
+      }
+
+      // Resizes an array, keeping each existing element at the same subscripts and zero-filling the rest.
+      void grow(Value& current, const std::vector<mwSize>& newDims)
+      {
+         const mxArray* pOld = current.get();
+         mxArray* pNew = createLike(pOld, pOld->mClassId, newDims);
+         const size_t count = getCount(pOld);
+         std::vector<mwSize> oldDims = pOld->mDims;
+         oldDims.resize(std::max(oldDims.size(), pNew->mDims.size()), 1);
+         for (size_t i = 0; i < count; ++i)
+         {
+            size_t remainder = i;
+            size_t newIndex = 0;
+            size_t stride = 1;
+            for (size_t dim = 0; dim < oldDims.size(); ++dim)
+            {
+               newIndex += (remainder % oldDims[dim]) * stride;
+               remainder /= oldDims[dim];
+               stride *= (dim < pNew->mDims.size() ? pNew->mDims[dim] : 1);
+            }
+
+            copyElement(pOld, i, pNew, newIndex);
+         }
+
+         current = Value(pNew);
+      }
+
+      void assignIndexed(Value& current, std::vector<Subscript> subscripts, const Value& value)
+      {
+         const mxArray* pValue = value.get();
+         if (current.isNull() == false && getCount(current.get()) == 0 && current.get()->mClassId != pValue->mClassId)
+         {
+            current = Value();
+         }
+
+         if (current.isNull() == false)
+         {
+            const mxClassID targetClass = current.get()->mClassId;
+            if ((targetClass == mxCELL_CLASS) != (pValue->mClassId == mxCELL_CLASS) ||
+               (targetClass == mxSTRUCT_CLASS) != (pValue->mClassId == mxSTRUCT_CLASS))
+            {
+               throw EvaluationError(std::string("Conversion to ") + mxGetClassName(current.get()) + " from " +
+                  mxGetClassName(pValue) + " is not possible.");
+            }
+
+            if (targetClass == mxSTRUCT_CLASS && current.get()->mFieldNames != pValue->mFieldNames)
+            {
+               throw EvaluationError("Subscripted assignment between dissimilar structures.");
+            }
+         }
+         else if (pValue->mClassId == mxSTRUCT_CLASS)
+         {
+            current = Value(createLike(pValue, mxSTRUCT_CLASS, makeDims(0, 0)));
+         }
+
+         prepareAssignment(current, subscripts, pValue->mClassId, pValue->mDims);
+         mxArray* pTarget = current.edit();
+         const std::vector<mwSize> extents = getIndexedExtents(pTarget->mDims, subscripts.size());
+         size_t count = 1;
+         for (size_t dim = 0; dim < subscripts.size(); ++dim)
+         {
+            count *= subscripts[dim].getCount(extents[dim]);
+         }
+
+         const size_t valueCount = getCount(pValue);
+         if (valueCount != 1 && valueCount != count)
+         {
+            throw EvaluationError("Subscripted assignment dimension mismatch.");
+         }
+
+         std::vector<size_t> counter(subscripts.size(), 0);
+         for (size_t i = 0; i < count; ++i)
+         {
+            size_t targetIndex = 0;
+            size_t stride = 1;
+            for (size_t dim = 0; dim < subscripts.size(); ++dim)
+            {
+               targetIndex += subscripts[dim].get(counter[dim]) * stride;
+               stride *= extents[dim];
+            }
+
+            copyElement(pValue, valueCount == 1 ? 0 : i, pTarget, targetIndex);
+            for (size_t dim = 0; dim < subscripts.size(); ++dim)
+            {
+               if (++counter[dim] < subscripts[dim].getCount(extents[dim]))
+               {
+                  break;
+               }
+
+               counter[dim] = 0;
+            }
+         }
+      }
+
+      Value evaluateBinary(const Expr* pExpr)
+      {
+         const std::string& op = pExpr->mText;
+         if (op == "&&" || op == "||")
+         {
+            const bool left = isTrue(evaluate(pExpr->mChildren[0]));
+            if ((op == "&&" && left == false) || (op == "||" && left == true))
+            {
+               return makeScalar(left ? 1.0 : 0.0, mxLOGICAL_CLASS);
+            }
+
+            return makeScalar(isTrue(evaluate(pExpr->mChildren[1])) ? 1.0 : 0.0, mxLOGICAL_CLASS);
+         }
+
+         return binary(op, evaluate(pExpr->mChildren[0]), evaluate(pExpr->mChildren[1]));
+      }
+
+      static mxClassID getResultClass(const std::string& op, mxClassID left, mxClassID right)
+      {
+         if (op == "==" || op == "~=" || op == "!=" || op == "<" || op == "<=" || op == ">" || op == ">=" ||
+            op == "&" || op == "|")
+         {
+            return mxLOGICAL_CLASS;
+         }
+
+         if (MockArray::isInteger(left) == true && MockArray::isInteger(right) == true && left != right)
+         {
+            throw EvaluationError("Integers can only be combined with integers of the same class, or scalar "
+               "doubles.");
+         }
+
+         if (MockArray::isInteger(left) == true)
+         {
+            return left;
+         }
+
+         if (MockArray::isInteger(right) == true)
+         {
+            return right;
+         }
+
+         return (left == mxSINGLE_CLASS || right == mxSINGLE_CLASS) ? mxSINGLE_CLASS : mxDOUBLE_CLASS;
+      }
+
+      static double apply(const std::string& op, double left, double right)
+      {
+         if (op == "+")
+         {
+            return left + right;
+         }
+
+         if (op == "-")
+         {
+            return left - right;
+         }
+
+         if (op == "*" || op == ".*")
+         {
+            return left * right;
+         }
+
+         if (op == "/" || op == "./")
+         {
+            return left / right;
+         }
+
+         if (op == "\\" || op == ".\\")
+         {
+            return right / left;
+         }
+
+         if (op == "^" || op == ".^")
+         {
+            return pow(left, right);
+         }
+
+         if (op == "==")
+         {
+            return left == right;
+         }
+
+         if (op == "~=" || op == "!=")
+         {
+            return left != right;
+         }
+
+         if (op == "<")
+         {
+            return left < right;
+         }
+
+         if (op == "<=")
+         {
+            return left <= right;
+         }
+
+         if (op == ">")
+         {
+            return left > right;
+         }
+
+         if (op == ">=")
+         {
+            return left >= right;
+         }
+
+         if (op == "&")
+         {
+            return left != 0.0 && right != 0.0;
+         }
+
+         if (op == "|")
+         {
+            return left != 0.0 || right != 0.0;
+         }
+
+         throw EvaluationError("Unsupported operator \"" + op + "\".");
+      }
+
+      Value binary(const std::string& op, const Value& left, const Value& right)
+      {
+         const mxArray* pLeft = left.get();
+         const mxArray* pRight = right.get();
+         if (MockArray::isArithmetic(pLeft->mClassId) == false || MockArray::isArithmetic(pRight->mClassId) == false)
+         {
+            throw EvaluationError("Undefined function or method '" + op + "' for input arguments of type '" +
+               (MockArray::isArithmetic(pLeft->mClassId) ? mxGetClassName(pRight) : mxGetClassName(pLeft)) + "'.");
+         }
+
+         const bool leftScalar = isScalar(pLeft);
+         const bool rightScalar = isScalar(pRight);
+         if ((op == "*" || op == "/" || op == "\\" || op == "^") && leftScalar == false && rightScalar == false)
+         {
+            if (op != "*")
+            {
+               throw EvaluationError("Matrix division and powers are not supported.");
+            }
+
+            return multiply(pLeft, pRight);
+         }
+
+         if (op == "^" && rightScalar == false)
+         {
+            throw EvaluationError("Matrix powers are not supported.");
+         }
+
+         if (leftScalar == false && rightScalar == false && pLeft->mDims != pRight->mDims)
+         {
+            throw EvaluationError("Matrix dimensions must agree.");
+         }
+
+         const mxClassID resultClass = getResultClass(op, pLeft->mClassId, pRight->mClassId);
+         mxArray* pResult = MockArray::create(resultClass, leftScalar ? pRight->mDims : pLeft->mDims);
+         const size_t count = getCount(pResult);
+         for (size_t i = 0; i < count; ++i)
+         {
+            MockArray::setValue(pResult, i, apply(op, MockArray::getValue(pLeft, leftScalar ? 0 : i),
+               MockArray::getValue(pRight, rightScalar ? 0 : i)));
+         }
+
+         return Value(pResult);
+      }
+
+      Value multiply(const mxArray* pLeft, const mxArray* pRight)
+      {
+         if (pLeft->mDims.size() != 2 || pRight->mDims.size() != 2 || pLeft->mDims[1] != pRight->mDims[0])
+         {
+            throw EvaluationError("Inner matrix dimensions must agree.");
+         }
+
+         const size_t rows = pLeft->mDims[0];
+         const size_t inner = pLeft->mDims[1];
+         const size_t columns = pRight->mDims[1];
+         mxArray* pResult = MockArray::create(getResultClass("*", pLeft->mClassId, pRight->mClassId),
+            makeDims(rows, columns));
+         for (size_t column = 0; column < columns; ++column)
+         {
+            for (size_t row = 0; row < rows; ++row)
+            {
+               double sum = 0.0;
+               for (size_t k = 0; k < inner; ++k)
+               {
+                  sum += MockArray::getValue(pLeft, k * rows + row) * MockArray::getValue(pRight, column * inner + k);
+               }
+
+               MockArray::setValue(pResult, column * rows + row, sum);
+            }
+         }
+
+         return Value(pResult);
+      }
+
+      Value evaluateUnary(const std::string& op, const Value& operand)
+      {
+         const mxArray* pOperand = operand.get();
+         if (MockArray::isArithmetic(pOperand->mClassId) == false)
+         {
+            throw EvaluationError("Undefined function or method '" + op + "' for input arguments of type '" +
+               mxGetClassName(pOperand) + "'.");
+         }
+
+         mxClassID resultClass = pOperand->mClassId;
+         if (op == "~")
+         {
+            resultClass = mxLOGICAL_CLASS;
+         }
+         else if (resultClass == mxLOGICAL_CLASS || resultClass == mxCHAR_CLASS)
+         {
+            resultClass = mxDOUBLE_CLASS;
+         }
+
+         mxArray* pResult = MockArray::create(resultClass, pOperand->mDims);
+         const size_t count = getCount(pResult);
+         for (size_t i = 0; i < count; ++i)
+         {
+            const double value = MockArray::getValue(pOperand, i);
+            MockArray::setValue(pResult, i, op == "-" ? -value : (op == "~" ? (value == 0.0) : value));
+         }
+
+         return Value(pResult);
+      }
+
+      Value transpose(const Value& value)
+      {
+         const mxArray* pSource = value.get();
+         if (pSource->mDims.size() != 2)
+         {
+            throw EvaluationError("Transpose on N-D array is not defined.");
+         }
+
+         const size_t rows = pSource->mDims[0];
+         const size_t columns = pSource->mDims[1];
+         mxArray* pResult = createLike(pSource, pSource->mClassId, makeDims(columns, rows));
+         for (size_t column = 0; column < columns; ++column)
+         {
+            for (size_t row = 0; row < rows; ++row)
+            {
+               copyElement(pSource, column * rows + row, pResult, row * columns + column);
+            }
+         }
+
+         return Value(pResult);
+      }
+
+      Value evaluateMatrix(const Expr* pExpr)
+      {
+         const bool cell = (pExpr->mKind == Expr::CELL);
+         std::vector<Value> rows;
+         size_t element = 0;
+         for (std::vector<size_t>::const_iterator iter = pExpr->mRowLengths.begin();
+            iter != pExpr->mRowLengths.end(); ++iter)
+         {
+            std::vector<Value> values;
+            for (size_t i = 0; i < *iter; ++i)
+            {
+               Value value = evaluate(pExpr->mChildren[element++]);
+               if (cell == true)
+               {
+                  // Each element of a cell literal becomes a single cell, even if it is itself a cell.
+                  mxArray* pCell = mxCreateCellMatrix(1, 1);
+                  pCell->mCells.front() = mxDuplicateArray(value.get());
+                  value = Value(pCell);
+               }
+
+               values.push_back(value);
+            }
+
+            rows.push_back(concatenate(values, 1));
+         }
+
+         if (rows.empty() == true)
+         {
+            return cell ? Value(mxCreateCellMatrix(0, 0)) : makeEmpty();
+         }
+
+         return concatenate(rows, 0);
+      }
+
+      // Concatenates values along dimension dim, skipping empty arrays and converting to a common class.
+      Value concatenate(const std::vector<Value>& values, size_t dim)
+      {
+         std::vector<const mxArray*> parts;
+         mxClassID resultClass = mxUNKNOWN_CLASS;
+         bool anyChar = false;
+         bool allLogical = true;
+         for (std::vector<Value>::const_iterator iter = values.begin(); iter != values.end(); ++iter)
+         {
+            const mxArray* pArray = iter->get();
+            if (getCount(pArray) == 0 && values.size() > 1)
+            {
+               continue;
+            }
+
+            parts.push_back(pArray);
+            const mxClassID classId = pArray->mClassId;
+            anyChar = anyChar || classId == mxCHAR_CLASS;
+            allLogical = allLogical && classId == mxLOGICAL_CLASS;
+            if (resultClass == mxUNKNOWN_CLASS || MockArray::isInteger(classId) ||
+               (classId == mxSINGLE_CLASS && MockArray::isInteger(resultClass) == false))
+            {
+               resultClass = classId;
+            }
+
+            if ((classId == mxCELL_CLASS || classId == mxSTRUCT_CLASS || resultClass == mxCELL_CLASS ||
+               resultClass == mxSTRUCT_CLASS) && classId != resultClass)
+            {
+               throw EvaluationError("Concatenation of cell, struct, and numeric arrays is not supported.");
+            }
+         }
+
+         if (parts.empty() == true)
+         {
+            return values.empty() ? makeEmpty() : values.front();
+         }
+
+         if (parts.size() == 1)
+         {
+            return Value(mxDuplicateArray(parts.front()));
+         }
+
+         if (anyChar == true)
+         {
+            resultClass = mxCHAR_CLASS;
+         }
+         else if (allLogical == false && (resultClass == mxLOGICAL_CLASS || resultClass == mxCHAR_CLASS))
+         {
+            resultClass = mxDOUBLE_CLASS;
+         }
+
+         // Every dimension other than dim must agree.
+         std::vector<mwSize> dims = parts.front()->mDims;
+         dims.resize(std::max(dims.size(), dim + 1), 1);
+         dims[dim] = 0;
+         for (std::vector<const mxArray*>::const_iterator iter = parts.begin(); iter != parts.end(); ++iter)
+         {
+            std::vector<mwSize> partDims = (*iter)->mDims;
+            partDims.resize(std::max(partDims.size(), dims.size()), 1);
+            dims.resize(partDims.size(), 1);
+            for (size_t i = 0; i < dims.size(); ++i)
+            {
+               if (i != dim && partDims[i] != dims[i] && iter != parts.begin())
+               {
+                  throw EvaluationError(dim == 0 ? "Vertical dimensions mismatch." :
+                     "Horizontal dimensions mismatch.");
+               }
+
+               if (i != dim)
+               {
+                  dims[i] = partDims[i];
+               }
+            }
+
+            dims[dim] += partDims[dim];
+         }
+
+         mxArray* pResult = createLike(parts.front(), resultClass, dims);
+
+         // For each combination of the trailing dimensions, every part contributes one contiguous block.
+         size_t inner = 1;
+         for (size_t i = 0; i < dim; ++i)
+         {
+            inner *= dims[i];
+         }
+
+         const size_t outer = getCount(pResult) / (inner * dims[dim]);
+         size_t destIndex = 0;
+         for (size_t block = 0; block < outer; ++block)
+         {
+            for (std::vector<const mxArray*>::const_iterator iter = parts.begin(); iter != parts.end(); ++iter)
+            {
+               const size_t blockSize = inner * (dim < (*iter)->mDims.size() ? (*iter)->mDims[dim] : 1);
+               for (size_t i = 0; i < blockSize; ++i)
+               {
+                  copyElement(*iter, block * blockSize + i, pResult, destIndex++);
+               }
+            }
+         }
+
+         return Value(pResult);
+      }
+
+      // Functions
+
+      void callFunction(const std::string& name, const std::vector<Value>& arguments, size_t outputCount,
+         std::vector<Value>& results)
+      {
+         std::map<std::string, Builtin>::const_iterator iter = mBuiltins.find(name);
+         if (iter == mBuiltins.end())
+         {
+            throw EvaluationError("Undefined function or variable '" + name + "'.",
+               "MATLAB:UndefinedFunction");
+         }
+
+         const std::string previous = mCurrentFunction;
+         mCurrentFunction = name;
+         try
+         {
+            (this->*(iter->second))(arguments, outputCount, results);
+         }
+         catch (...)
+         {
+            mCurrentFunction = previous;
+            throw;
+         }
+
+         mCurrentFunction = previous;
+      }
+
+      void registerBuiltins()
+      {
+         mBuiltins["abs"] = &Executor::builtinAbs;
+         mBuiltins["addpath"] = &Executor::builtinPath;
+         mBuiltins["all"] = &Executor::builtinAll;
+         mBuiltins["any"] = &Executor::builtinAny;
+         mBuiltins["assignin"] = &Executor::builtinAssignin;
+         mBuiltins["ceil"] = &Executor::builtinCeil;
+         mBuiltins["cell"] = &Executor::builtinCell;
+         mBuiltins["char"] = &Executor::builtinConvert;
+         mBuiltins["class"] = &Executor::builtinClass;
+         mBuiltins["clc"] = &Executor::builtinNothing;
+         mBuiltins["clear"] = &Executor::builtinClear;
+         mBuiltins["close"] = &Executor::builtinNothing;
+         mBuiltins["disp"] = &Executor::builtinDisp;
+         mBuiltins["double"] = &Executor::builtinConvert;
+         mBuiltins["drawnow"] = &Executor::builtinNothing;
+         mBuiltins["error"] = &Executor::builtinError;
+         mBuiltins["eval"] = &Executor::builtinEval;
+         mBuiltins["evalc"] = &Executor::builtinEvalc;
+         mBuiltins["evalin"] = &Executor::builtinEvalin;
+         mBuiltins["exist"] = &Executor::builtinExist;
+         mBuiltins["eye"] = &Executor::builtinEye;
+         mBuiltins["false"] = &Executor::builtinFalse;
+         mBuiltins["feval"] = &Executor::builtinFeval;
+         mBuiltins["fieldnames"] = &Executor::builtinFieldnames;
+         mBuiltins["find"] = &Executor::builtinFind;
+         mBuiltins["floor"] = &Executor::builtinFloor;
+         mBuiltins["format"] = &Executor::builtinNothing;
+         mBuiltins["fclose"] = &Executor::builtinFclose;
+         mBuiltins["fopen"] = &Executor::builtinFopen;
+         mBuiltins["fprintf"] = &Executor::builtinFprintf;
+         mBuiltins["fwrite"] = &Executor::builtinFwrite;
+         mBuiltins["hold"] = &Executor::builtinNothing;
+         mBuiltins["Inf"] = &Executor::builtinInf;
+         mBuiltins["inf"] = &Executor::builtinInf;
+         mBuiltins["int16"] = &Executor::builtinConvert;
+         mBuiltins["int32"] = &Executor::builtinConvert;
+         mBuiltins["int64"] = &Executor::builtinConvert;
+         mBuiltins["int8"] = &Executor::builtinConvert;
+         mBuiltins["isa"] = &Executor::builtinIsa;
+         mBuiltins["iscell"] = &Executor::builtinIscell;
+         mBuiltins["ischar"] = &Executor::builtinIschar;
+         mBuiltins["isempty"] = &Executor::builtinIsempty;
+         mBuiltins["isequal"] = &Executor::builtinIsequal;
+         mBuiltins["isfield"] = &Executor::builtinIsfield;
+         mBuiltins["islogical"] = &Executor::builtinIslogical;
+         mBuiltins["isnumeric"] = &Executor::builtinIsnumeric;
+         mBuiltins["isreal"] = &Executor::builtinIsreal;
+         mBuiltins["isstruct"] = &Executor::builtinIsstruct;
+         mBuiltins["lasterr"] = &Executor::builtinLasterr;
+         mBuiltins["lasterror"] = &Executor::builtinLasterror;
+         mBuiltins["length"] = &Executor::builtinLength;
+         mBuiltins["logical"] = &Executor::builtinConvert;
+         mBuiltins["lower"] = &Executor::builtinLower;
+         mBuiltins["max"] = &Executor::builtinMax;
+         mBuiltins["memmapfile"] = &Executor::builtinMemmapfile;
+         mBuiltins["min"] = &Executor::builtinMin;
+         mBuiltins["mod"] = &Executor::builtinMod;
+         mBuiltins["more"] = &Executor::builtinNothing;
+         mBuiltins["NaN"] = &Executor::builtinNan;
+         mBuiltins["nan"] = &Executor::builtinNan;
+         mBuiltins["ndims"] = &Executor::builtinNdims;
+         mBuiltins["num2str"] = &Executor::builtinNum2str;
+         mBuiltins["numel"] = &Executor::builtinNumel;
+         mBuiltins["ones"] = &Executor::builtinOnes;
+         mBuiltins["path"] = &Executor::builtinPath;
+         mBuiltins["pi"] = &Executor::builtinPi;
+         mBuiltins["rem"] = &Executor::builtinRem;
+         mBuiltins["reshape"] = &Executor::builtinReshape;
+         mBuiltins["rethrow"] = &Executor::builtinRethrow;
+         mBuiltins["rmfield"] = &Executor::builtinRmfield;
+         mBuiltins["rmpath"] = &Executor::builtinPath;
+         mBuiltins["round"] = &Executor::builtinRound;
+         mBuiltins["single"] = &Executor::builtinConvert;
+         mBuiltins["size"] = &Executor::builtinSize;
+         mBuiltins["sprintf"] = &Executor::builtinSprintf;
+         mBuiltins["sqrt"] = &Executor::builtinSqrt;
+         mBuiltins["strcmp"] = &Executor::builtinStrcmp;
+         mBuiltins["strcmpi"] = &Executor::builtinStrcmpi;
+         mBuiltins["struct"] = &Executor::builtinStruct;
+         mBuiltins["sum"] = &Executor::builtinSum;
+         mBuiltins["true"] = &Executor::builtinTrue;
+         mBuiltins["uint16"] = &Executor::builtinConvert;
+         mBuiltins["uint32"] = &Executor::builtinConvert;
+         mBuiltins["uint64"] = &Executor::builtinConvert;
+         mBuiltins["uint8"] = &Executor::builtinConvert;
+         mBuiltins["upper"] = &Executor::builtinUpper;
+         mBuiltins["version"] = &Executor::builtinVersion;
+         mBuiltins["warning"] = &Executor::builtinWarning;
+         mBuiltins["zeros"] = &Executor::builtinZeros;
+      }
+
+      static void checkArguments(const std::vector<Value>& arguments, size_t minimum, size_t maximum)
+      {
+         if (arguments.size() < minimum)
+         {
+            throw EvaluationError("Not enough input arguments.");
+         }
+
+         if (arguments.size() > maximum)
+         {
+            throw EvaluationError("Too many input arguments.");
+         }
+      }
+
+      void builtinNothing(const std::vector<Value>&, size_t, std::vector<Value>&)
+      {}
+
+      void builtinPath(const std::vector<Value>&, size_t outputCount, std::vector<Value>& results)
+      {
+         if (outputCount > 0)
+         {
+            results.push_back(makeString(std::string()));
+         }
+      }
+
+      void builtinVersion(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 0, 0);
+         results.push_back(makeString("0.0.0.0 (Mock)"));
+      }
+
+      void builtinClear(const std::vector<Value>& arguments, size_t, std::vector<Value>&)
+      {
+         if (arguments.empty() == true)
+         {
+            mVariables.clear();
+            return;
+         }
+
+         for (std::vector<Value>::const_iterator iter = arguments.begin(); iter != arguments.end(); ++iter)
+         {
+            const std::string name = getString(*iter, "The variable name");
+            if (name == "all" || name == "variables")
+            {
+               mVariables.clear();
+            }
+            else
+            {
+               mVariables.erase(name);
+            }
+         }
+      }
+
+      // Creates an array from dimension arguments such as (n), (m, n, p), or ([m n p]), with an optional class.
+      mxArray* createFromDimensions(const std::vector<Value>& arguments, mxClassID defaultClass)
+      {
+         std::vector<Value> dimensionArguments = arguments;
+         mxClassID classId = defaultClass;
+         if (dimensionArguments.empty() == false && mxIsChar(dimensionArguments.back().get()) == true)
+         {
+            classId = MockArray::getClassByName(MockArray::getString(dimensionArguments.back().get()));
+            if (MockArray::isArithmetic(classId) == false || classId == mxCHAR_CLASS)
+            {
+               throw EvaluationError("Unsupported class.");
+            }
+
+            dimensionArguments.pop_back();
+         }
+
+         std::vector<mwSize> dims;
+         for (std::vector<Value>::const_iterator iter = dimensionArguments.begin();
+            iter != dimensionArguments.end(); ++iter)
+         {
+            const mxArray* pArray = iter->get();
+            for (size_t i = 0; i < getCount(pArray); ++i)
+            {
+               dims.push_back(static_cast<mwSize>(std::max(MockArray::getValue(pArray, i), 0.0)));
+            }
+         }
+
+         if (dims.empty() == true)
+         {
+            dims.push_back(1);
+         }
+
+         if (dims.size() == 1)
+         {
+            dims.push_back(dims.front());
+         }
+
+         return MockArray::create(classId, dims);
+      }
+
+      void fill(const std::vector<Value>& arguments, mxClassID defaultClass, double value,
+         std::vector<Value>& results)
+      {
+         mxArray* pArray = createFromDimensions(arguments, defaultClass);
+         const size_t count = getCount(pArray);
+         for (size_t i = 0; i < count && value != 0.0; ++i)
+         {
+            MockArray::setValue(pArray, i, value);
+         }
+
+         results.push_back(Value(pArray));
+      }
+
+      void builtinZeros(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         fill(arguments, mxDOUBLE_CLASS, 0.0, results);
+      }
+
+      void builtinOnes(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         fill(arguments, mxDOUBLE_CLASS, 1.0, results);
+      }
+
+      void builtinTrue(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         fill(arguments, mxLOGICAL_CLASS, 1.0, results);
+      }
+
+      void builtinFalse(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         fill(arguments, mxLOGICAL_CLASS, 0.0, results);
+      }
+
+      void builtinNan(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         fill(arguments, mxDOUBLE_CLASS, HUGE_VAL - HUGE_VAL, results);
+      }
+
+      void builtinInf(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         fill(arguments, mxDOUBLE_CLASS, HUGE_VAL, results);
+      }
+
+      void builtinPi(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         fill(arguments, mxDOUBLE_CLASS, 3.14159265358979323846, results);
+      }
+
+      void builtinEye(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         mxArray* pArray = createFromDimensions(arguments, mxDOUBLE_CLASS);
+         if (pArray->mDims.size() != 2)
+         {
+            mxDestroyArray(pArray);
+            throw EvaluationError("N-dimensional arrays are not supported.");
+         }
+
+         for (size_t i = 0; i < std::min(pArray->mDims[0], pArray->mDims[1]); ++i)
+         {
+            MockArray::setValue(pArray, i * pArray->mDims[0] + i, 1.0);
+         }
+
+         results.push_back(Value(pArray));
+      }
+
+      void builtinCell(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         mxArray* pDims = createFromDimensions(arguments, mxDOUBLE_CLASS);
+         results.push_back(Value(MockArray::create(mxCELL_CLASS, pDims->mDims)));
+         mxDestroyArray(pDims);
+      }
+
+      void builtinSize(const std::vector<Value>& arguments, size_t outputCount, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 1, 2);
+         const std::vector<mwSize>& dims = arguments[0].get()->mDims;
+         if (arguments.size() == 2)
+         {
+            const double dim = getScalar(arguments[1], "The dimension");
+            if (dim < 1.0)
+            {
+               throw EvaluationError("Dimension argument must be a positive integer scalar.");
+            }
+
+            const size_t index = static_cast<size_t>(dim) - 1;
+            results.push_back(makeScalar(index < dims.size() ? static_cast<double>(dims[index]) : 1.0));
+            return;
+         }
+
+         if (outputCount <= 1)
+         {
+            mxArray* pSize = MockArray::create(mxDOUBLE_CLASS, makeDims(1, dims.size()));
+            for (size_t i = 0; i < dims.size(); ++i)
+            {
+               MockArray::setValue(pSize, i, static_cast<double>(dims[i]));
+            }
+
+            results.push_back(Value(pSize));
+            return;
+         }
+
+         const std::vector<mwSize> extents = getIndexedExtents(dims, outputCount);
+         for (size_t i = 0; i < outputCount; ++i)
+         {
+            results.push_back(makeScalar(static_cast<double>(extents[i])));
+         }
+      }
+
+      void builtinNumel(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 1, 1);
+         results.push_back(makeScalar(static_cast<double>(getCount(arguments[0].get()))));
+      }
+
+      void builtinLength(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 1, 1);
+         const std::vector<mwSize>& dims = arguments[0].get()->mDims;
+         const size_t length = (getCount(arguments[0].get()) == 0 ? 0 : *std::max_element(dims.begin(), dims.end()));
+         results.push_back(makeScalar(static_cast<double>(length)));
+      }
+
+      void builtinNdims(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 1, 1);
+         results.push_back(makeScalar(static_cast<double>(arguments[0].get()->mDims.size())));
+      }
+
+      void builtinReshape(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         if (arguments.size() < 2)
+         {
+            throw EvaluationError("Not enough input arguments.");
+         }
+
+         mxArray* pDims = createFromDimensions(std::vector<Value>(arguments.begin() + 1, arguments.end()),
+            mxDOUBLE_CLASS);
+         const std::vector<mwSize> dims = pDims->mDims;
+         mxDestroyArray(pDims);
+         if (MockArray::getCount(dims) != getCount(arguments[0].get()))
+         {
+            throw EvaluationError("To RESHAPE the number of elements must not change.");
+         }
+
+         mxArray* pResult = mxDuplicateArray(arguments[0].get());
+         pResult->mDims = MockArray::create(mxDOUBLE_CLASS, dims)->mDims;
+         results.push_back(Value(pResult));
+      }
+
+      void builtinClass(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 1, 1);
+         results.push_back(makeString(mxGetClassName(arguments[0].get())));
+      }
+
+      void pushLogical(bool value, std::vector<Value>& results)
+      {
+         results.push_back(makeScalar(value ? 1.0 : 0.0, mxLOGICAL_CLASS));
+      }
+
+      void builtinIsa(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 2, 2);
+         const mxClassID classId = arguments[0].get()->mClassId;
+         const std::string name = getString(arguments[1], "The class name");
+         const bool numeric = mxIsNumeric(arguments[0].get());
+         pushLogical(name == MockArray::getClassName(classId) || (name == "numeric" && numeric) ||
+            (name == "float" && (classId == mxDOUBLE_CLASS || classId == mxSINGLE_CLASS)) ||
+            (name == "integer" && MockArray::isInteger(classId)), results);
+      }
+
+      void builtinIschar(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 1, 1);
+         pushLogical(mxIsChar(arguments[0].get()), results);
+      }
+
+      void builtinIscell(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 1, 1);
+         pushLogical(mxIsCell(arguments[0].get()), results);
+      }
+
+      void builtinIsstruct(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 1, 1);
+         pushLogical(mxIsStruct(arguments[0].get()), results);
+      }
+
+      void builtinIsnumeric(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 1, 1);
+         pushLogical(mxIsNumeric(arguments[0].get()), results);
+      }
+
+      void builtinIsreal(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 1, 1);
+         pushLogical(mxIsComplex(arguments[0].get()) == false, results);
+      }
+
+      void builtinIslogical(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 1, 1);
+         pushLogical(mxIsLogical(arguments[0].get()), results);
+      }
+
+      void builtinIsempty(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 1, 1);
+         pushLogical(getCount(arguments[0].get()) == 0, results);
+      }
+
+      void builtinIsfield(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 2, 2);
+         pushLogical(mxIsStruct(arguments[0].get()) && mxIsChar(arguments[1].get()) &&
+            mxGetFieldNumber(arguments[0].get(), MockArray::getString(arguments[1].get()).c_str()) >= 0, results);
+      }
+
+      static bool isEqual(const mxArray* pLeft, const mxArray* pRight)
+      {
+         if (pLeft == NULL || pRight == NULL)
+         {
+            return pLeft == pRight || getCount(pLeft == NULL ? pRight : pLeft) == 0;
+         }
+
+         if (pLeft->mDims != pRight->mDims)
+         {
+            return false;
+         }
+
+         const size_t count = getCount(pLeft);
+         if (MockArray::isArithmetic(pLeft->mClassId) == true && MockArray::isArithmetic(pRight->mClassId) == true)
+         {
+            for (size_t i = 0; i < count; ++i)
+            {
+               if (MockArray::getValue(pLeft, i) != MockArray::getValue(pRight, i))
+               {
+                  return false;
+               }
+            }
+
+            return true;
+         }
+
+         if (pLeft->mClassId != pRight->mClassId)
+         {
+            return false;
+         }
+
+         if (pLeft->mClassId == mxCELL_CLASS)
+         {
+            for (size_t i = 0; i < count; ++i)
+            {
+               if (isEqual(pLeft->mCells[i], pRight->mCells[i]) == false)
+               {
+                  return false;
+               }
+            }
+
+            return true;
+         }
+
+         if (pLeft->mClassId == mxSTRUCT_CLASS && pLeft->mFieldNames == pRight->mFieldNames)
+         {
+            for (size_t i = 0; i < pLeft->mFields.size(); ++i)
+            {
+               if (isEqual(pLeft->mFields[i], pRight->mFields[i]) == false)
+               {
+                  return false;
+               }
+            }
+
+            return true;
+         }
+
+         return false;
+      }
+
+      void builtinIsequal(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         if (arguments.size() < 2)
+         {
+            throw EvaluationError("Not enough input arguments.");
+         }
+
+         bool equal = true;
+         for (size_t i = 1; i < arguments.size() && equal == true; ++i)
+         {
+            equal = isEqual(arguments[0].get(), arguments[i].get());
+         }
+
+         pushLogical(equal, results);
+      }
+
+      void builtinConvert(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 1, 1);
+         results.push_back(convert(arguments[0], MockArray::getClassByName(mCurrentFunction)));
+      }
+
+      // Applies a function to every element, producing an array of the same class except for logical and
+      // character input, which produce double.
+      void map(const std::vector<Value>& arguments, double (*pFunction)(double), std::vector<Value>& results)
+      {
+         checkArguments(arguments, 1, 1);
+         const mxArray* pSource = arguments[0].get();
+         if (MockArray::isArithmetic(pSource->mClassId) == false)
+         {
+            throw EvaluationError("Undefined function or method '" + mCurrentFunction +
+               "' for input arguments of type '" + mxGetClassName(pSource) + "'.");
+         }
+
+         const mxClassID classId = (pSource->mClassId == mxLOGICAL_CLASS || pSource->mClassId == mxCHAR_CLASS) ?
+            mxDOUBLE_CLASS : pSource->mClassId;
+         mxArray* pResult = MockArray::create(classId, pSource->mDims);
+         for (size_t i = 0; i < getCount(pSource); ++i)
+         {
+            MockArray::setValue(pResult, i, pFunction(MockArray::getValue(pSource, i)));
+         }
+
+         results.push_back(Value(pResult));
+      }
+
+      static double roundValue(double value)
+      {
+         return value < 0.0 ? ceil(value - 0.5) : floor(value + 0.5);
+      }
+
+      static double absValue(double value)
+      {
+         return fabs(value);
+      }
+
+      static double floorValue(double value)
+      {
+         return floor(value);
+      }
+
+      static double ceilValue(double value)
+      {
+         return ceil(value);
+      }
+
+      static double sqrtValue(double value)
+      {
+         return sqrt(value);
+      }
+
+      void builtinAbs(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         map(arguments, &Executor::absValue, results);
+      }
+
+      void builtinFloor(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         map(arguments, &Executor::floorValue, results);
+      }
+
+      void builtinCeil(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         map(arguments, &Executor::ceilValue, results);
+      }
+
+      void builtinRound(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         map(arguments, &Executor::roundValue, results);
+      }
+
+      void builtinSqrt(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         map(arguments, &Executor::sqrtValue, results);
+      }
+
+      void builtinMod(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 2, 2);
+         const Value quotient = binary("./", arguments[0], arguments[1]);
+         std::vector<Value> floored;
+         map(std::vector<Value>(1, convert(quotient, mxDOUBLE_CLASS)), &Executor::floorValue, floored);
+         results.push_back(binary("-", arguments[0], binary(".*", floored.front(), arguments[1])));
+      }
+
+      void builtinRem(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 2, 2);
+         const Value quotient = convert(binary("./", arguments[0], arguments[1]), mxDOUBLE_CLASS);
+         mxArray* pTruncated = mxDuplicateArray(quotient.get());
+         for (size_t i = 0; i < getCount(pTruncated); ++i)
+         {
+            const double value = MockArray::getValue(pTruncated, i);
+            MockArray::setValue(pTruncated, i, value < 0.0 ? ceil(value) : floor(value));
+         }
+
+         results.push_back(binary("-", arguments[0], binary(".*", Value(pTruncated), arguments[1])));
+      }
+
+      // Reduces along the first non-singleton dimension with the given function.
+      void reduce(const std::vector<Value>& arguments, double initial, double (*pFunction)(double, double),
+         mxClassID classId, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 1, 1);
+         const mxArray* pSource = arguments[0].get();
+         if (MockArray::isArithmetic(pSource->mClassId) == false)
+         {
+            throw EvaluationError("Undefined function or method '" + mCurrentFunction +
+               "' for input arguments of type '" + mxGetClassName(pSource) + "'.");
+         }
+
+         std::vector<mwSize> dims = pSource->mDims;
+         size_t dim = 0;
+         while (dim < dims.size() && dims[dim] == 1)
+         {
+            ++dim;
+         }
+
+         if (dim == dims.size())
+         {
+            dim = 0;
+         }
+
+         size_t inner = 1;
+         for (size_t i = 0; i < dim; ++i)
+         {
+            inner *= dims[i];
+         }
+
+         const size_t extent = dims[dim];
+         dims[dim] = 1;
+         if (classId == mxUNKNOWN_CLASS)
+         {
+            classId = pSource->mClassId;
+            if (classId == mxLOGICAL_CLASS || classId == mxCHAR_CLASS)
+            {
+               classId = mxDOUBLE_CLASS;
+            }
+         }
+
+         mxArray* pResult = MockArray::create(classId, dims);
+         const size_t count = getCount(pResult);
+         for (size_t i = 0; i < count; ++i)
+         {
+            const size_t base = (i / inner) * inner * extent + i % inner;
+            double value = initial;
+            for (size_t k = 0; k < extent; ++k)
+            {
+               value = pFunction(value, MockArray::getValue(pSource, base + k * inner));
+            }
+
+            MockArray::setValue(pResult, i, value);
+         }
+
+         results.push_back(Value(pResult));
+      }
+
+      static double addValues(double left, double right)
+      {
+         return left + right;
+      }
+
+      static double andValues(double left, double right)
+      {
+         return (left != 0.0 && right != 0.0) ? 1.0 : 0.0;
+      }
+
+      static double orValues(double left, double right)
+      {
+         return (left != 0.0 || right != 0.0) ? 1.0 : 0.0;
+      }
+
+      static double minValues(double left, double right)
+      {
+         return (right < left || left != left) ? right : left;
+      }
+
+      static double maxValues(double left, double right)
+      {
+         return (right > left || left != left) ? right : left;
+      }
+
+      void builtinSum(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         reduce(arguments, 0.0, &Executor::addValues, mxDOUBLE_CLASS, results);
+      }
+
+      void builtinAll(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         reduce(arguments, 1.0, &Executor::andValues, mxLOGICAL_CLASS, results);
+      }
+
+      void builtinAny(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         reduce(arguments, 0.0, &Executor::orValues, mxLOGICAL_CLASS, results);
+      }
+
+      void builtinMin(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         if (arguments.size() == 2)
+         {
+            elementwise(arguments, &Executor::minValues, results);
+            return;
+         }
+
+         reduce(arguments, HUGE_VAL - HUGE_VAL, &Executor::minValues, mxUNKNOWN_CLASS, results);
+      }
+
+      void builtinMax(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         if (arguments.size() == 2)
+         {
+            elementwise(arguments, &Executor::maxValues, results);
+            return;
+         }
+
+         reduce(arguments, HUGE_VAL - HUGE_VAL, &Executor::maxValues, mxUNKNOWN_CLASS, results);
+      }
+
+      void elementwise(const std::vector<Value>& arguments, double (*pFunction)(double, double),
+         std::vector<Value>& results)
+      {
+         const mxArray* pLeft = arguments[0].get();
+         const mxArray* pRight = arguments[1].get();
+         const bool leftScalar = isScalar(pLeft);
+         const bool rightScalar = isScalar(pRight);
+         if (leftScalar == false && rightScalar == false && pLeft->mDims != pRight->mDims)
+         {
+            throw EvaluationError("Matrix dimensions must agree.");
+         }
+
+         mxArray* pResult = MockArray::create(getResultClass("+", pLeft->mClassId, pRight->mClassId),
+            leftScalar ? pRight->mDims : pLeft->mDims);
+         for (size_t i = 0; i < getCount(pResult); ++i)
+         {
+            MockArray::setValue(pResult, i, pFunction(MockArray::getValue(pLeft, leftScalar ? 0 : i),
+               MockArray::getValue(pRight, rightScalar ? 0 : i)));
+         }
+
+         results.push_back(Value(pResult));
+      }
+
+      void builtinFind(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 1, 1);
+         const mxArray* pSource = arguments[0].get();
+         std::vector<double> indices;
+         for (size_t i = 0; i < getCount(pSource); ++i)
+         {
+            if (MockArray::getValue(pSource, i) != 0.0)
+            {
+               indices.push_back(static_cast<double>(i + 1));
+            }
+         }
+
+         const bool row = (pSource->mDims.size() == 2 && pSource->mDims[0] == 1);
+         mxArray* pResult = MockArray::create(mxDOUBLE_CLASS,
+            row ? makeDims(1, indices.size()) : makeDims(indices.size(), 1));
+         for (size_t i = 0; i < indices.size(); ++i)
+         {
+            MockArray::setValue(pResult, i, indices[i]);
+         }
+
+         results.push_back(Value(pResult));
+      }
+
+      void builtinUpper(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 1, 1);
+         std::string value = getString(arguments[0], "The input");
+         std::transform(value.begin(), value.end(), value.begin(), toupper);
+         results.push_back(makeString(value));
+      }
+
+      void builtinLower(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 1, 1);
+         std::string value = getString(arguments[0], "The input");
+         std::transform(value.begin(), value.end(), value.begin(), tolower);
+         results.push_back(makeString(value));
+      }
+
+      void compareStrings(const std::vector<Value>& arguments, bool ignoreCase, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 2, 2);
+         if (mxIsChar(arguments[0].get()) == false || mxIsChar(arguments[1].get()) == false ||
+            arguments[0].get()->mDims != arguments[1].get()->mDims)
+         {
+            pushLogical(false, results);
+            return;
+         }
+
+         std::string left = MockArray::getString(arguments[0].get());
+         std::string right = MockArray::getString(arguments[1].get());
+         if (ignoreCase == true)
+         {
+            std::transform(left.begin(), left.end(), left.begin(), tolower);
+            std::transform(right.begin(), right.end(), right.begin(), tolower);
+         }
+
+         pushLogical(left == right, results);
+      }
+
+      void builtinStrcmp(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         compareStrings(arguments, false, results);
+      }
+
+      void builtinStrcmpi(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         compareStrings(arguments, true, results);
+      }
+
+      void builtinNum2str(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 1, 2);
+         const mxArray* pSource = arguments[0].get();
+         if (mxIsChar(pSource) == true)
+         {
+            results.push_back(arguments[0]);
+            return;
+         }
+
+         if (MockArray::isArithmetic(pSource->mClassId) == false)
+         {
+            throw EvaluationError("Input to num2str must be numeric.");
+         }
+
+         std::string text;
+         for (size_t i = 0; i < getCount(pSource); ++i)
+         {
+            const double value = MockArray::getValue(pSource, i);
+            char buffer[64];
+            if (value == floor(value) && fabs(value) < 1.0e15)
+            {
+               sprintf(buffer, "%.0f", value);
+            }
+            else
+            {
+               sprintf(buffer, "%.5g", value);
+            }
+
+            text += (i == 0 ? "" : "  ") + std::string(buffer);
+         }
+
+         results.push_back(makeString(text));
+      }
+
+      void builtinSprintf(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         if (arguments.empty() == true)
+         {
+            throw EvaluationError("Not enough input arguments.");
+         }
+
+         results.push_back(makeString(formatString(getString(arguments[0], "The format"), arguments, 1)));
+      }
+
+      void builtinFprintf(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         if (arguments.empty() == true)
+         {
+            throw EvaluationError("Not enough input arguments.");
+         }
+
+         // Output to standard output or standard error (file identifiers 1 and 2) goes to the output buffer.
+         size_t first = 0;
+         if (mxIsChar(arguments[0].get()) == false)
+         {
+            const double file = getScalar(arguments[0], "The file identifier");
+            if (file != 1.0 && file != 2.0)
+            {
+               throw EvaluationError("Only standard output and standard error are supported.");
+            }
+
+            first = 1;
+         }
+
+         if (first >= arguments.size())
+         {
+            throw EvaluationError("Not enough input arguments.");
+         }
+
+         const std::string text = formatString(getString(arguments[first], "The format"), arguments, first + 1);
+         mOutput += text;
+         (void)results;
+      }
+
+      // Files opened with fopen are numbered from 3, after standard output and standard error, and are only
+      // available until the end of the evaluation which opened them.
+      void builtinFopen(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 1, 2);
+         const std::string filename = getString(arguments[0], "The file name");
+         std::string mode = (arguments.size() > 1 ? getString(arguments[1], "The permission") : "r");
+         if (mode.find('b') == std::string::npos)
+         {
+            mode += 'b';
+         }
+
+         FILE* pFile = fopen(filename.c_str(), mode.c_str());
+         if (pFile == NULL)
+         {
+            results.push_back(makeScalar(-1.0));
+            return;
+         }
+
+         const int file = (mFiles.empty() ? 3 : mFiles.rbegin()->first + 1);
+         mFiles[file] = pFile;
+         results.push_back(makeScalar(file));
+      }
+
+      // Only character data can be written, one byte per character.
+      void builtinFwrite(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 2, 3);
+         FILE* pFile = getFile(arguments[0]);
+         const std::string precision = (arguments.size() > 2 ? getString(arguments[2], "The precision") : "uchar");
+         if (mxIsChar(arguments[1].get()) == false || (precision != "char" && precision != "uchar"))
+         {
+            throw EvaluationError("Only character data is supported.");
+         }
+
+         const std::string text = MockArray::getString(arguments[1].get());
+         results.push_back(makeScalar(static_cast<double>(fwrite(text.data(), 1, text.size(), pFile))));
+      }
+
+      void builtinFclose(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 1, 1);
+         FILE* pFile = getFile(arguments[0]);
+         mFiles.erase(static_cast<int>(getScalar(arguments[0], "The file identifier")));
+         results.push_back(makeScalar(fclose(pFile) == 0 ? 0.0 : -1.0));
+      }
+
+      FILE* getFile(const Value& value)
+      {
+         std::map<int, FILE*>::const_iterator iter =
+            mFiles.find(static_cast<int>(getScalar(value, "The file identifier")));
+         if (iter == mFiles.end())
+         {
+            throw EvaluationError("Invalid file identifier.  Use fopen to generate a valid file identifier.");
+         }
+
+         return iter->second;
+      }
+
+      void builtinDisp(const std::vector<Value>& arguments, size_t, std::vector<Value>&)
+      {
+         checkArguments(arguments, 1, 1);
+         const mxArray* pArray = arguments[0].get();
+         if (getCount(pArray) == 0)
+         {
+            return;
+         }
+
+         // Display the value without its name.
+         const std::string text = formatValue(std::string(), pArray);
+         const std::string::size_type start = text.find('\n');
+         mOutput += text.substr(start + 1);
+      }
+
+      void builtinWarning(const std::vector<Value>& arguments, size_t, std::vector<Value>&)
+      {
+         if (arguments.empty() == true || mxIsChar(arguments[0].get()) == false)
+         {
+            return;
+         }
+
+         const std::string first = MockArray::getString(arguments[0].get());
+         if (first == "on" || first == "off" || first == "query")
+         {
+            return;
+         }
+
+         mOutput += "Warning: " + formatString(first, arguments, 1) + "\n";
+      }
+
+      void builtinError(const std::vector<Value>& arguments, size_t, std::vector<Value>&)
+      {
+         if (arguments.empty() == true)
+         {
+            throw EvaluationError("Not enough input arguments.");
+         }
+
+         if (mxIsStruct(arguments[0].get()) == true)
+         {
+            std::vector<Value> results;
+            builtinRethrow(arguments, 0, results);
+            return;
+         }
+
+         // An identifier is only recognized when there are further arguments, as in error('a:b', 'message').
+         std::string identifier;
+         size_t first = 0;
+         const std::string text = getString(arguments[0], "The message");
+         if (arguments.size() > 1 && text.find(':') != std::string::npos && text.find(' ') == std::string::npos)
+         {
+            identifier = text;
+            first = 1;
+         }
+
+         const std::string message = (arguments.size() > first + 1 || first > 0) ?
+            formatString(getString(arguments[first], "The message"), arguments, first + 1) :
+            getString(arguments[first], "The message");
+         if (message.empty() == false)
+         {
+            throw EvaluationError(message, identifier);
+         }
+      }
+
+      void builtinRethrow(const std::vector<Value>& arguments, size_t, std::vector<Value>&)
+      {
+         checkArguments(arguments, 1, 1);
+         const mxArray* pError = arguments[0].get();
+         const mxArray* pMessage = mxGetField(pError, 0, "message");
+         const mxArray* pIdentifier = mxGetField(pError, 0, "identifier");
+         if (mxIsChar(pMessage) == false)
+         {
+            throw EvaluationError("The error structure must have a message field.");
+         }
+
+         throw EvaluationError(MockArray::getString(pMessage), MockArray::getString(pIdentifier));
+      }
+
+      void builtinLasterror(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 0, 1);
+         if (arguments.empty() == false)
+         {
+            if (mxIsChar(arguments[0].get()) == true && MockArray::getString(arguments[0].get()) == "reset")
+            {
+               mLastError = createError(std::string(), std::string());
+            }
+            else if (mxIsStruct(arguments[0].get()) == true)
+            {
+               const mxArray* pMessage = mxGetField(arguments[0].get(), 0, "message");
+               const mxArray* pIdentifier = mxGetField(arguments[0].get(), 0, "identifier");
+               mLastError = createError(MockArray::getString(pMessage), MockArray::getString(pIdentifier));
+            }
+            else
+            {
+               throw EvaluationError("The input must be 'reset' or an error structure.");
+            }
+         }
+
+         results.push_back(mLastError);
+      }
+
+      void builtinLasterr(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 0, 2);
+         results.push_back(Value(mxDuplicateArray(mxGetField(mLastError.get(), 0, "message"))));
+         if (arguments.empty() == false)
+         {
+            mLastError = createError(getString(arguments[0], "The message"),
+               arguments.size() > 1 ? getString(arguments[1], "The identifier") : std::string());
+         }
+      }
+
+      void builtinExist(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 1, 2);
+         const std::string name = getString(arguments[0], "The name");
+         const std::string type = (arguments.size() > 1 ? getString(arguments[1], "The type") : std::string());
+         double result = 0.0;
+         if (mVariables.find(name) != mVariables.end() && (type.empty() || type == "var"))
+         {
+            result = 1.0;
+         }
+         else if (mBuiltins.find(name) != mBuiltins.end() && (type.empty() || type == "builtin"))
+         {
+            result = 5.0;
+         }
+
+         results.push_back(makeScalar(result));
+      }
+
+      void builtinEval(const std::vector<Value>& arguments, size_t, std::vector<Value>&)
+      {
+         checkArguments(arguments, 1, 2);
+         const std::string code = getString(arguments[0], "The expression");
+         if (arguments.size() == 1)
+         {
+            run(code);
+            return;
+         }
+
+         try
+         {
+            run(code);
+         }
+         catch (const EvaluationError& error)
+         {
+            setLastError(error);
+            run(getString(arguments[1], "The catch expression"));
+         }
+      }
+
+      // Output of the expression is returned instead of being added to the output buffer. Output written before an
+      // error is discarded along with the error.
+      void builtinEvalc(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 1, 1);
+         const std::string code = getString(arguments[0], "The expression");
+         const size_t start = mOutput.size();
+         try
+         {
+            run(code);
+         }
+         catch (...)
+         {
+            mOutput.erase(start);
+            throw;
+         }
+
+         const std::string text = mOutput.substr(start);
+         mOutput.erase(start);
+         results.push_back(makeString(text));
+      }
+
+      // There is only one workspace, so both 'base' and 'caller' refer to it.
+      void builtinEvalin(const std::vector<Value>& arguments, size_t outputCount, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 2, 3);
+         builtinEval(std::vector<Value>(arguments.begin() + 1, arguments.end()), outputCount, results);
+      }
+
+      void builtinAssignin(const std::vector<Value>& arguments, size_t, std::vector<Value>&)
+      {
+         checkArguments(arguments, 3, 3);
+         const std::string name = getString(arguments[1], "The variable name");
+         if (isValidName(name) == false)
+         {
+            throw EvaluationError("Invalid variable name \"" + name + "\" in ASSIGNIN.");
+         }
+
+         mVariables[name] = arguments[2];
+      }
+
+      void builtinFeval(const std::vector<Value>& arguments, size_t outputCount, std::vector<Value>& results)
+      {
+         if (arguments.empty() == true)
+         {
+            throw EvaluationError("Not enough input arguments.");
+         }
+
+         callFunction(getString(arguments[0], "The function name"),
+            std::vector<Value>(arguments.begin() + 1, arguments.end()), outputCount, results);
+      }
+
+      void builtinStruct(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         if (arguments.size() % 2 != 0)
+         {
+            throw EvaluationError("Field and value input arguments must come in pairs.");
+         }
+
+         mxArray* pStruct = mxCreateStructMatrix(1, 1, 0, NULL);
+         Value result(pStruct);
+         for (size_t i = 0; i < arguments.size(); i += 2)
+         {
+            const std::string name = getString(arguments[i], "The field name");
+            const mxArray* pValue = arguments[i + 1].get();
+
+            // A scalar cell supplies its contents as the value, as it does in MATLAB.
+            if (mxIsCell(pValue) == true && getCount(pValue) == 1)
+            {
+               pValue = pValue->mCells.front();
+            }
+
+            mxAddField(pStruct, name.c_str());
+            mxSetField(pStruct, 0, name.c_str(), pValue == NULL ? NULL : mxDuplicateArray(pValue));
+         }
+
+         results.push_back(result);
+      }
+
+      void builtinFieldnames(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 1, 1);
+         const mxArray* pStruct = arguments[0].get();
+         if (mxIsStruct(pStruct) == false)
+         {
+            throw EvaluationError("Invalid input argument of type '" + std::string(mxGetClassName(pStruct)) + "'.");
+         }
+
+         mxArray* pNames = mxCreateCellMatrix(pStruct->mFieldNames.size(), 1);
+         for (size_t i = 0; i < pStruct->mFieldNames.size(); ++i)
+         {
+            pNames->mCells[i] = mxCreateString(pStruct->mFieldNames[i].c_str());
+         }
+
+         results.push_back(Value(pNames));
+      }
+
+      void builtinRmfield(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         checkArguments(arguments, 2, 2);
+         const mxArray* pStruct = arguments[0].get();
+         if (mxIsStruct(pStruct) == false)
+         {
+            throw EvaluationError("Invalid input argument of type '" + std::string(mxGetClassName(pStruct)) + "'.");
+         }
+
+         const std::string name = getString(arguments[1], "The field name");
+         if (mxGetFieldNumber(pStruct, name.c_str()) < 0)
+         {
+            throw EvaluationError("A field named '" + name + "' doesn't exist.");
+         }
+
+         mxArray* pResult = mxDuplicateArray(pStruct);
+         mxRemoveField(pResult, mxGetFieldNumber(pResult, name.c_str()));
+         results.push_back(Value(pResult));
+      }
+
+      // Reads a file with the same Filename, Format, Offset, and Repeat arguments as MATLAB's memmapfile. The file
+      // is read into memory rather than mapped, and the result is a struct whose Data field holds the records, so
+      // expressions such as m.Data.x work as they do with a real memmapfile object. Writable maps are not supported.
+      void builtinMemmapfile(const std::vector<Value>& arguments, size_t, std::vector<Value>& results)
+      {
+         if (arguments.empty() == true || arguments.size() % 2 != 1)
+         {
+            throw EvaluationError("Parameter and value arguments must come in pairs.");
+         }
+
+         const std::string filename = getString(arguments[0], "The file name");
+         Value format = makeString("uint8");
+         double offset = 0.0;
+         double repeat = HUGE_VAL;
+         bool writable = false;
+         for (size_t i = 1; i < arguments.size(); i += 2)
+         {
+            const std::string parameter = getString(arguments[i], "The parameter name");
+            if (parameter == "Format")
+            {
+               format = arguments[i + 1];
+            }
+            else if (parameter == "Offset")
+            {
+               offset = getScalar(arguments[i + 1], "The offset");
+            }
+            else if (parameter == "Repeat")
+            {
+               repeat = getScalar(arguments[i + 1], "The repeat count");
+            }
+            else if (parameter == "Writable")
+            {
+               writable = isTrue(arguments[i + 1]);
+            }
+            else
+            {
+               throw EvaluationError("Unknown parameter \"" + parameter + "\".");
+            }
+         }
+
+         if (writable == true)
+         {
+            throw EvaluationError("Writable memory maps are not supported.");
+         }
+
+         // A single class reads the whole file as a column, while {class, dims, name} reads named records.
+         mxClassID classId = mxUNKNOWN_CLASS;
+         std::vector<mwSize> dims;
+         std::string fieldName;
+         const mxArray* pFormat = format.get();
+         if (mxIsChar(pFormat) == true)
+         {
+            classId = MockArray::getClassByName(MockArray::getString(pFormat));
+         }
+         else if (mxIsCell(pFormat) == true && getCount(pFormat) == 3 && mxIsChar(pFormat->mCells[0]) == true &&
+            mxIsChar(pFormat->mCells[2]) == true)
+         {
+            classId = MockArray::getClassByName(MockArray::getString(pFormat->mCells[0]));
+            const mxArray* pDims = pFormat->mCells[1];
+            for (size_t i = 0; pDims != NULL && i < getCount(pDims); ++i)
+            {
+               dims.push_back(static_cast<mwSize>(MockArray::getValue(pDims, i)));
+            }
+
+            fieldName = MockArray::getString(pFormat->mCells[2]);
+         }
+
+         if (MockArray::isArithmetic(classId) == false || classId == mxCHAR_CLASS || classId == mxLOGICAL_CLASS)
+         {
+            throw EvaluationError("Unsupported Format.");
+         }
+
+         FILE* pFile = fopen(filename.c_str(), "rb");
+         if (pFile == NULL)
+         {
+            throw EvaluationError("Cannot open file \"" + filename + "\".");
+         }
+
+         fseek(pFile, 0, SEEK_END);
+         const double fileSize = static_cast<double>(ftell(pFile));
+         fseek(pFile, static_cast<long>(offset), SEEK_SET);
+
+         const size_t elementSize = MockArray::getElementSize(classId);
+         const size_t recordCount = (fieldName.empty() ? 1 : MockArray::getCount(dims));
+         const size_t recordSize = recordCount * elementSize;
+         size_t records = static_cast<size_t>(repeat == HUGE_VAL ?
+            floor((fileSize - offset) / static_cast<double>(recordSize)) : repeat);
+         if (fieldName.empty() == true)
+         {
+            dims = makeDims(records, 1);
+            records = 1;
+         }
+
+         if (static_cast<double>(records * MockArray::getCount(dims) * elementSize) > fileSize - offset)
+         {
+            fclose(pFile);
+            throw EvaluationError("File \"" + filename + "\" is not large enough to map.");
+         }
+
+         const char* pFields[] = { "Filename", "Writable", "Offset", "Format", "Repeat", "Data" };
+         mxArray* pMap = mxCreateStructMatrix(1, 1, 6, pFields);
+         Value result(pMap);
+         mxSetField(pMap, 0, "Filename", mxCreateString(filename.c_str()));
+         mxSetField(pMap, 0, "Writable", mxCreateLogicalScalar(false));
+         mxSetField(pMap, 0, "Offset", mxCreateDoubleScalar(offset));
+         mxSetField(pMap, 0, "Format", mxDuplicateArray(pFormat));
+         mxSetField(pMap, 0, "Repeat", mxCreateDoubleScalar(repeat));
+
+         std::vector<mxArray*> data;
+         bool readError = false;
+         for (size_t record = 0; record < records; ++record)
+         {
+            mxArray* pData = MockArray::create(classId, dims);
+            data.push_back(pData);
+            const size_t bytes = getCount(pData) * elementSize;
+            if (bytes > 0 && fread(&pData->mData[0], 1, bytes, pFile) != bytes)
+            {
+               readError = true;
+               break;
+            }
+         }
+
+         fclose(pFile);
+         if (fieldName.empty() == true)
+         {
+            mxSetField(pMap, 0, "Data", data.front());
+         }
+         else
+         {
+            const char* pName = fieldName.c_str();
+            mxArray* pRecords = mxCreateStructMatrix(data.size(), 1, 1, &pName);
+            for (size_t record = 0; record < data.size(); ++record)
+            {
+               mxSetField(pRecords, record, pName, data[record]);
+            }
+
+            mxSetField(pMap, 0, "Data", pRecords);
+         }
+
+         if (readError == true)
+         {
+            throw EvaluationError("Unable to read file \"" + filename + "\".");
+         }
+
+         results.push_back(result);
+      }
+
+      struct EndContext
+      {
+         const mxArray* mpArray;
+         size_t mPosition;
+         size_t mCount;
+      };
+
+      std::map<std::string, Value>& mVariables;
+      Value& mLastError;
+      std::string& mOutput;
+      std::map<int, FILE*> mFiles;
+      std::map<std::string, Builtin> mBuiltins;
+      std::vector<EndContext> mEndContexts;
+
+      // The name of the builtin being called, which is needed by builtins registered under several names.
+      std::string mCurrentFunction;
+   };
+}
+
+MockEvaluator::MockEvaluator() :
+   mpWorkspace(new Workspace)
+{}
+
+MockEvaluator::~MockEvaluator()
+{
+   delete mpWorkspace;
+}
+
+void MockEvaluator::evaluate(const std::string& code, std::string& output)
+{
+   Executor executor(mpWorkspace->mVariables, mpWorkspace->mLastError, output);
+   try
+   {
+      executor.run(code);
+   }
+   catch (const EvaluationError& error)
+   {
+      executor.setLastError(error);
+      output += std::string("??? ") + error.what() + "\n";
+   }
+}
+
+mxArray* MockEvaluator::getVariable(const std::string& name) const
+{
+   std::map<std::string, Value>::const_iterator iter = mpWorkspace->mVariables.find(name);
+   if (iter == mpWorkspace->mVariables.end())
+   {
+      return NULL;
+   }
+
+   return mxDuplicateArray(iter->second.get());
+}
+
+bool MockEvaluator::setVariable(const std::string& name, const mxArray* pArray)
+{
+   if (pArray == NULL || isValidName(name) == false)
+   {
+      return false;
+   }
+
+   mpWorkspace->mVariables[name] = Value(mxDuplicateArray(pArray));
+   return true;
+}
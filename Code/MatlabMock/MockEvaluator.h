@@ -0,0 +1,50 @@
+/*
+ * The information in this file is
+ * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
+ * and is subject to the terms and conditions of the
+ * GNU Lesser General Public License Version 2.1
+ * The license text is available from   
+ * http://www.gnu.org/licenses/lgpl.html
+ */
+
+#ifndef MOCKEVALUATOR_H
+#define MOCKEVALUATOR_H
+
+#include "matrix.h"
+
+#include <string>
+
+/**
+ * Evaluates a small subset of the MATLAB language in-process.
+ *
+ * The evaluator supports numeric, logical, character, cell, and struct arrays; indexing and indexed assignment;
+ * element-wise arithmetic and comparisons; if, for, while, and try/catch blocks; and the built-in functions which
+ * are used by the MATLAB scripting extension and its tests, including lasterror and memmapfile. Results are
+ * displayed in the same compact format as MATLAB's "format compact", so output parsing can be exercised without a
+ * licensed copy of MATLAB.
+ */
+class MockEvaluator
+{
+public:
+   MockEvaluator();
+   ~MockEvaluator();
+
+   // Evaluates one or more statements, appending displayed results and error messages to output. Evaluation stops
+   // at the first uncaught error, which is written to output and stored in lasterror just as MATLAB does.
+   void evaluate(const std::string& code, std::string& output);
+
+   // Returns a copy of a workspace variable which the caller must destroy, or NULL if the variable does not exist.
+   mxArray* getVariable(const std::string& name) const;
+
+   // Stores a copy of pArray in the workspace, returning false if name is not a valid variable name.
+   bool setVariable(const std::string& name, const mxArray* pArray);
+
+private:
+   MockEvaluator(const MockEvaluator& rhs);
+   MockEvaluator& operator=(const MockEvaluator& rhs);
+
+   struct Workspace;
+   Workspace* mpWorkspace;
+};
+
+#endif
@@ -0,0 +1,38 @@
+/*
+ * The information in this file is
+ * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
+ * and is subject to the terms and conditions of the
+ * GNU Lesser General Public License Version 2.1
+ * The license text is available from   
+ * http://www.gnu.org/licenses/lgpl.html
+ */
+
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include "matrix.h"
+
+/**
+ * Stand-in for the engine.h header of the MATLAB Engine API.
+ *
+ * Instead of starting a separate MATLAB process, each engine evaluates commands in-process with MockEvaluator.
+ * Evaluation errors are reported the same way MATLAB reports them: the error text is written to the output buffer,
+ * lasterror is updated, and engEvalString still returns zero.
+ */
+
+typedef struct engine Engine;
+
+extern "C"
+{
+   Engine* engOpen(const char* startcmd);
+   Engine* engOpenSingleUse(const char* startcmd, void* reserved, int* retstatus);
+   int engClose(Engine* ep);
+   int engEvalString(Engine* ep, const char* string);
+   int engOutputBuffer(Engine* ep, char* buffer, int buflen);
+   mxArray* engGetVariable(Engine* ep, const char* name);
+   int engPutVariable(Engine* ep, const char* var_name, const mxArray* ap);
+   int engSetVisible(Engine* ep, bool newVal);
+   int engGetVisible(Engine* ep, bool* bVal);
+}
+
+#endif
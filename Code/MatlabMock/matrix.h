@@ -0,0 +1,116 @@
+/*
+ * The information in this file is
+ * Copyright(c) 2013 Ball Aerospace & Technologies Corporation
+ * and is subject to the terms and conditions of the
+ * GNU Lesser General Public License Version 2.1
+ * The license text is available from   
+ * http://www.gnu.org/licenses/lgpl.html
+ */
+
+#ifndef MATRIX_H
+#define MATRIX_H
+
+#include <stddef.h>
+
+/**
+ * Stand-in for the matrix.h header of the MATLAB External Interfaces API.
+ *
+ * Only the portion of the API which is used by the MATLAB scripting extension is declared. The names, types, and
+ * semantics match MATLAB's own header so that the extension can be compiled against either one without changes.
+ * Arrays are always stored in column-major order, and only real data is supported.
+ */
+
+typedef size_t mwSize;
+typedef size_t mwIndex;
+typedef bool mxLogical;
+typedef unsigned short mxChar;
+
+typedef enum
+{
+   mxUNKNOWN_CLASS = 0,
+   mxCELL_CLASS,
+   mxSTRUCT_CLASS,
+   mxLOGICAL_CLASS,
+   mxCHAR_CLASS,
+   mxVOID_CLASS,
+   mxDOUBLE_CLASS,
+   mxSINGLE_CLASS,
+   mxINT8_CLASS,
+   mxUINT8_CLASS,
+   mxINT16_CLASS,
+   mxUINT16_CLASS,
+   mxINT32_CLASS,
+   mxUINT32_CLASS,
+   mxINT64_CLASS,
+   mxUINT64_CLASS,
+   mxFUNCTION_CLASS
+} mxClassID;
+
+typedef enum
+{
+   mxREAL,
+   mxCOMPLEX
+} mxComplexity;
+
+struct mxArray_tag;
+typedef struct mxArray_tag mxArray;
+
+extern "C"
+{
+   mxArray* mxCreateNumericArray(mwSize ndim, const mwSize* dims, mxClassID classid, mxComplexity flag);
+   mxArray* mxCreateNumericMatrix(mwSize m, mwSize n, mxClassID classid, mxComplexity flag);
+   mxArray* mxCreateDoubleMatrix(mwSize m, mwSize n, mxComplexity flag);
+   mxArray* mxCreateDoubleScalar(double value);
+   mxArray* mxCreateLogicalScalar(mxLogical value);
+   mxArray* mxCreateString(const char* str);
+   mxArray* mxCreateCharMatrixFromStrings(mwSize m, const char** str);
+   mxArray* mxCreateCellMatrix(mwSize m, mwSize n);
+   mxArray* mxCreateStructMatrix(mwSize m, mwSize n, int nfields, const char** fieldnames);
+   mxArray* mxDuplicateArray(const mxArray* pa);
+   void mxDestroyArray(mxArray* pa);
+
+   mxClassID mxGetClassID(const mxArray* pa);
+   const char* mxGetClassName(const mxArray* pa);
+   mwSize mxGetNumberOfDimensions(const mxArray* pa);
+   const mwSize* mxGetDimensions(const mxArray* pa);
+   size_t mxGetM(const mxArray* pa);
+   size_t mxGetN(const mxArray* pa);
+   size_t mxGetNumberOfElements(const mxArray* pa);
+   size_t mxGetElementSize(const mxArray* pa);
+
+   void* mxGetData(const mxArray* pa);
+   double* mxGetPr(const mxArray* pa);
+   mxLogical* mxGetLogicals(const mxArray* pa);
+   mxChar* mxGetChars(const mxArray* pa);
+   double mxGetScalar(const mxArray* pa);
+
+   bool mxIsNumeric(const mxArray* pa);
+   bool mxIsChar(const mxArray* pa);
+   bool mxIsLogical(const mxArray* pa);
+   bool mxIsCell(const mxArray* pa);
+   bool mxIsStruct(const mxArray* pa);
+   bool mxIsDouble(const mxArray* pa);
+   bool mxIsComplex(const mxArray* pa);
+   bool mxIsEmpty(const mxArray* pa);
+   bool mxIsLogicalScalarTrue(const mxArray* pa);
+
+   mxArray* mxGetCell(const mxArray* pa, mwIndex i);
+   void mxSetCell(mxArray* pa, mwIndex i, mxArray* value);
+
+   int mxGetNumberOfFields(const mxArray* pa);
+   const char* mxGetFieldNameByNumber(const mxArray* pa, int n);
+   int mxGetFieldNumber(const mxArray* pa, const char* name);
+   int mxAddField(mxArray* pa, const char* fieldname);
+   void mxRemoveField(mxArray* pa, int fieldnumber);
+   mxArray* mxGetField(const mxArray* pa, mwIndex i, const char* fieldname);
+   void mxSetField(mxArray* pa, mwIndex i, const char* fieldname, mxArray* value);
+
+   int mxGetString(const mxArray* pa, char* buf, mwSize buflen);
+   char* mxArrayToString(const mxArray* pa);
+
+   void* mxMalloc(size_t n);
+   void* mxCalloc(size_t n, size_t size);
+   void mxFree(void* ptr);
+}
+
+#endif
@@ -0,0 +1,27 @@
+% ARRAY_AOI_TO_MATLAB Copies the spectra of the pixels selected by an Opticks AOI into MATLAB.
+%   [S, L] = ARRAY_AOI_TO_MATLAB(A) copies the spectrum of every pixel selected
+%   by the AOI element A into S, and the location of each pixel into L. A is
+%   resolved in the same way as a raster element name, so a parent can be
+%   given with 'parent=>child'. The spectra are read from the raster element
+%   which A belongs to. If no output variables are given, S is called
+%   spectra and L is called locations.
+%
+%   [S, L] = ARRAY_AOI_TO_MATLAB(A, X, B0, B1) reads a range of bands where
+%      X is the name of the raster element to read. The default is the parent
+%         of A, or the primary raster element of the active window if A has no
+%         raster parent.
+%      B0 is the first band to copy. The default is 0.
+%      B1 is the last band to copy. The default is 0, which is the last band.
+%
+%   S is an N x (B1 - B0 + 1) matrix with the same class as X, where N is the
+%   number of selected pixels which lie inside X. Row i of S is the spectrum of
+%   the pixel in row i of L. L is an N x 2 double matrix holding the zero-based
+%   row and column of each pixel, ordered by row and then by column.
+%
+%   Only the selected pixels are read from X, so this is much faster than
+%   copying a whole subcube with ARRAY_TO_MATLAB and masking it in MATLAB.
+%
+%   Example:
+%      >> [S, L] = array_aoi_to_matlab('AOI 1');
+%      >> plot(mean(S, 1))
+lasterr('This command must be executed from Opticks.')
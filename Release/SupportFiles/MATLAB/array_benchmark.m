@@ -0,0 +1,34 @@
+% ARRAY_BENCHMARK Measures the throughput of array transfers between MATLAB and Opticks.
+%   ARRAY_BENCHMARK() times ARRAY_TO_OPTICKS and ARRAY_TO_MATLAB for every
+%   supported data type, every interleave, in-memory and on-disk raster
+%   elements, and three cube shapes, and displays the results as
+%   comma-separated values.
+%
+%   RESULTS = ARRAY_BENCHMARK(FILE, N, SCALE) returns the results instead of
+%   displaying them where
+%      FILE is the name of a file to which the comma-separated values are
+%         also written. The default is '', which does not write a file.
+%      N is the number of times each transfer is repeated. The default is 3.
+%      SCALE multiplies the number of rows in each cube shape. The default
+%         is 1, which transfers 2097152 elements per cube.
+%
+%   RESULTS is an N-by-1 structure array with one element per transfer and
+%   the fields operation, encoding, interleave, storage, shape, rows,
+%   columns, bands, bytes, repetitions, best_seconds, mean_seconds,
+%   gigabytes_per_second, and allocations. The same fields are used as the
+%   columns of the comma-separated values, so results can be compared
+%   between releases. The throughput is computed from the fastest
+%   repetition, and allocations is the mean number of heap allocations made
+%   by the MATLAB scripting extension during each transfer. Allocations are
+%   only counted when the extension is built with MATLAB_COUNT_ALLOCATIONS
+%   defined, and are NaN otherwise. The MatlabInterpreterMock build defines
+%   it, and its counts include the arrays allocated by the mock engine.
+%
+%   The array_to_opticks timings include creating the raster element. The
+%   data is copied back and compared after every repetition, and the raster
+%   element is destroyed afterwards. No layers or windows are created.
+%
+%   Example:
+%      >> results = array_benchmark('transfers.csv', 5);
+%      >> [results.gigabytes_per_second]
+lasterr('This command must be executed from Opticks.')
@@ -0,0 +1,27 @@
+% ARRAY_COVARIANCE Computes the band covariance of an Opticks raster element.
+%   C = ARRAY_COVARIANCE() computes the bands x bands covariance matrix of the
+%   primary raster element of the active window, treating each pixel as an
+%   observation. If no output variable is given, C is called covariance.
+%
+%   [C, M, V, D] = ARRAY_COVARIANCE(...) also returns M, the 1 x bands mean of
+%   each band, and the eigenvectors V and eigenvalues D of C. The columns of V
+%   are unit vectors sorted by decreasing eigenvalue in the column vector D, so
+%   V(:, 1) is the first principal component. The eigenvectors are only
+%   computed when V or D is requested.
+%
+%   C = ARRAY_COVARIANCE(C0, C1, R0, R1, B0, B1, X, RS, CS, BS, MODE) uses the
+%   same subset of X that ARRAY_TO_MATLAB would copy with these arguments,
+%   including the strides and decimation mode.
+%
+%   C = ARRAY_COVARIANCE(C0, C1, R0, R1, B0, B1, X, 1, 1, 1, 'sample', A) only
+%   uses the pixels selected by the AOI A which lie inside the subset. The
+%   strides must be 1 when an AOI is given.
+%
+%   C is normalized by N - 1 as COV does, where N is the number of pixels. The
+%   covariance is computed inside Opticks by several threads while the data is
+%   read, and only the results are copied to MATLAB.
+%
+%   Example:
+%      >> [C, M, V, D] = array_covariance();
+%      >> plot(cumsum(D) / sum(D))
+lasterr('This command must be executed from Opticks.')
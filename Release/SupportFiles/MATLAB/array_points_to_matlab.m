@@ -0,0 +1,22 @@
+% ARRAY_POINTS_TO_MATLAB Copies the spectra at a list of pixels from Opticks into MATLAB.
+%   S = ARRAY_POINTS_TO_MATLAB('P') copies the spectrum of each pixel listed in
+%   the MATLAB variable P from the primary raster element of the active window
+%   into S. P is an N x 2 double matrix where each row holds the zero-based row
+%   and column of a pixel. If no output variable is given, S is called spectra.
+%
+%   S = ARRAY_POINTS_TO_MATLAB('P', X, B0, B1) reads a range of bands where
+%      X is the name of the raster element to read. The default is the
+%         primary raster element of the active window.
+%      B0 is the first band to copy. The default is 0.
+%      B1 is the last band to copy. The default is 0, which is the last band.
+%
+%   S is an N x (B1 - B0 + 1) matrix with the same class as X, and row i of S
+%   is the spectrum of the pixel in row i of P. The pixels are sorted before
+%   they are read so that X is read in a single pass, which is much faster than
+%   calling ARRAY_TO_MATLAB once for each pixel. Pixels may be repeated.
+%
+%   Example:
+%      >> P = [10, 20; 0, 0; 10, 21];
+%      >> S = array_points_to_matlab('P');
+%      >> plot(S')
+lasterr('This command must be executed from Opticks.')
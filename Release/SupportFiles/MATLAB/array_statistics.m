@@ -0,0 +1,31 @@
+% ARRAY_STATISTICS Computes band statistics of an Opticks raster element.
+%   S = ARRAY_STATISTICS() computes the statistics of each band of the primary
+%   raster element of the active window and returns them in the struct S. If no
+%   output variable is given, S is called statistics.
+%
+%   S = ARRAY_STATISTICS(C0, C1, R0, R1, B0, B1, X, RS, CS, BS, MODE) computes
+%   the statistics of the same subset of X that ARRAY_TO_MATLAB would copy with
+%   these arguments, including the strides and decimation mode.
+%
+%   S = ARRAY_STATISTICS(C0, C1, R0, R1, B0, B1, X, RS, CS, BS, MODE, N) also
+%   sets the number of histogram bins where
+%      N is the number of bins in each histogram. The default is 256. A value
+%         of 0 skips the histograms, which avoids a second pass over the data.
+%
+%   Each field of S has one column for each band in the subset:
+%      count is the number of values which are not NaN.
+%      min and max are the smallest and largest values.
+%      mean is the mean value.
+%      std is the standard deviation, normalized by count - 1 as STD does.
+%      histogram is an N x bands matrix of the number of values in each bin.
+%      edges is an (N + 1) x bands matrix of the bin edges. The bins are
+%         equally spaced between min and max, and the last bin includes max.
+%
+%   NaN values are ignored. The statistics are computed inside Opticks by
+%   several threads, and only the results are copied to MATLAB, so the subset
+%   never needs to fit in MATLAB's memory.
+%
+%   Example:
+%      >> S = array_statistics(0, 0, 0, 0, 0, 0, '', 1, 1, 1, 'sample', 64);
+%      >> bar(S.edges(1:end-1, 1), S.histogram(:, 1))
+lasterr('This command must be executed from Opticks.')
@@ -0,0 +1,36 @@
+% ARRAY_STREAM_TO_MATLAB Copies data from an Opticks raster element to MATLAB in tiles.
+%   ARRAY_STREAM_TO_MATLAB(F) copies the entire primary raster element of the
+%   active window into the MATLAB workspace one tile at a time, calling F for
+%   each tile. F is either the name of a function or a function handle.
+%
+%   ARRAY_STREAM_TO_MATLAB(F, C0, C1, R0, R1, B0, B1, X, D, M) copies a subset
+%   of X where
+%      C0, C1, R0, R1, B0, and B1 are the same as for ARRAY_TO_MATLAB.
+%      X is the primary raster element of the active window.
+%      D is the type of tile to copy, either 'rows' or 'bands'.
+%         'rows' tiles contain complete rows of every band.
+%         'bands' tiles contain complete bands.
+%      M is the memory budget in megabytes for each tile.
+%
+%   By default D = 'rows' and M = 256.
+%
+%   For each tile, F is called as F(T, R, C, B) where
+%      T is the tile, which has the same layout as the output of ARRAY_TO_MATLAB.
+%      R is the zero-based row in X of the first row of T.
+%      C is the zero-based column in X of the first column of T.
+%      B is the zero-based band in X of the first band of T.
+%
+%   Only one tile is held in memory at a time. The tile variable is cleared
+%   from the MATLAB workspace after F returns, so F must store anything it
+%   needs to keep. If F fails, no further tiles are copied.
+%
+%   If no variable name is assigned, each tile will be stored in a variable
+%   in the MATLAB workspace called 'tile' while F is running.
+%
+%   Example:
+%      >> bands_seen = 0;
+%      >> f = @(t, r, c, b) assignin('base', 'bands_seen', evalin('base', 'bands_seen') + size(t, 3));
+%      >> array_stream_to_matlab(f, 0, 0, 0, 0, 0, 0, '', 'bands', 64)
+%
+% See also ARRAY_TO_MATLAB.
+lasterr('This command must be executed from Opticks.')
@@ -1,50 +1,94 @@
-% ARRAY_TO_MATLAB Copies data from an Opticks raster element to MATLAB.
-%   ARRAY_TO_MATLAB() copies the entire primary raster element of the active
-%   window into the MATLAB workspace.
-%
-%   ARRAY_TO_MATLAB(C0, C1, R0, R1, B0, B1, X) copies a subset of X where
-%      C0 is the first column of data to copy.
-%      C1 is the last column of data to copy.
-%      R0 is the first row of data to copy.
-%      R1 is the last row of data to copy.
-%      B0 is the first band of data to copy.
-%      B1 is the last band of data to copy.
-%      X is the primary raster element of the active window.
-%
-%      C1, R1, and/or B1 can be assigned the sentinel value of 0 to copy all
-%      available data if the actual size is not known.
-%
-%   If no variable name is assigned, the output of this function will be stored
-%   in a variable in the MATLAB workspace called 'raster'.
-%
-%   The size of the copy will be M-by-N for single band data.
-%   The size of the copy will be M-by-N-by-B for multi-band data.
-%
-%   Data type will be preserved during the copy. See CLASS.
-%
-%   This function supports data up to 2 GB in size.
-%   To determine the size of the data, use the the following formula:
-%      total_size = row_count * column_count * band_count * data_size_in_bytes
-%
-%   Example:
-%      >> B = zeros(2, 3, 4);
-%      >> B(:,:,1) = [1, 2 , 3; 4 , 5, 6];
-%      >> B(:,:,2) = [7, 8 , 9; 10, 11, 12];
-%      >> B(:,:,3) = [13, 14, 15; 16, 17, 18];
-%      >> B(:,:,4) = [19, 20, 21; 22, 23, 24];
-%      >> array_to_opticks('B', '', 1, 1, 'bip')
-%      >> array_to_matlab()
-%      >> raster
-%      raster(:,:,1) =
-%           1     2     3
-%           4     5     6
-%      raster(:,:,2) =
-%           7     8     9
-%          10    11    12
-%      raster(:,:,3) =
-%          13    14    15
-%          16    17    18
-%      raster(:,:,4) =
-%          19    20    21
-%          22    23    24
-lasterr('This command must be executed from Opticks.')
+% ARRAY_TO_MATLAB Copies data from an Opticks raster element to MATLAB.
+%   ARRAY_TO_MATLAB() copies the entire primary raster element of the active
+%   window into the MATLAB workspace.
+%
+%   ARRAY_TO_MATLAB(C0, C1, R0, R1, B0, B1, X) copies a subset of X where
+%      C0 is the first column of data to copy.
+%      C1 is the last column of data to copy.
+%      R0 is the first row of data to copy.
+%      R1 is the last row of data to copy.
+%      B0 is the first band of data to copy.
+%      B1 is the last band of data to copy.
+%      X is the primary raster element of the active window.
+%
+%      C1, R1, and/or B1 can be assigned the sentinel value of 0 to copy all
+%      available data if the actual size is not known.
+%
+%   ARRAY_TO_MATLAB(C0, C1, R0, R1, B0, B1, X, RS, CS, BS, MODE) copies every
+%   RS-th row, CS-th column, and BS-th band of the subset where
+%      RS is the row stride. The default is 1.
+%      CS is the column stride. The default is 1.
+%      BS is the band stride. The default is 1.
+%      MODE is 'sample' to copy the first element of each stride block or
+%         'average' to copy the mean of each stride block. The default is
+%         'sample'. Averages of integer data are rounded to the nearest
+%         integer. Blocks at the edges of the subset may be partial.
+%
+%      Only the decimated data is copied to MATLAB, so a stride of 4 in rows
+%      and columns moves 1/16th of the data.
+%
+%   ARRAY_TO_MATLAB(C0, C1, R0, R1, B0, B1, X, RS, CS, BS, MODE, CLASS, SCALE)
+%   also converts the copy where
+%      CLASS is the class of the copy ('int8', 'uint8', 'int16', 'uint16',
+%         'int32', 'uint32', 'single', or 'double'). An empty string keeps the
+%         class of X.
+%      SCALE multiplies each value by the scale factor of the units of X when
+%         it indicates 't', 'true', 1, or a similar value. The default is 0.
+%         Scaled data is copied as 'double' unless CLASS is given.
+%
+%      The conversion is done while the data is copied, so it does not need a
+%      second full-size copy in MATLAB as calling SINGLE or DOUBLE would.
+%
+%   If no variable name is assigned, the output of this function will be stored
+%   in a variable in the MATLAB workspace called 'raster'.
+%
+%   The size of the copy will be M-by-N for single band data.
+%   The size of the copy will be M-by-N-by-B for multi-band data.
+%   When strides are given, M, N, and B are ceil(count / stride).
+%
+%   Data type will be preserved during the copy unless CLASS or SCALE is given.
+%   See CLASS.
+%
+%   With 64-bit versions of MATLAB and Opticks, this function supports data
+%   larger than 4 GB, limited only by available memory. Each of the row,
+%   column, and band counts must still be less than 2^32. With 32-bit versions,
+%   this function supports data up to 2 GB in size.
+%   To determine the size of the data, use the the following formula:
+%      total_size = row_count * column_count * band_count * data_size_in_bytes
+%
+%   Copies at least as large as the SharedMemoryThreshold setting are written
+%   into a temporary file which MATLAB reads with MEMMAPFILE, instead of being
+%   sent through the MATLAB engine. The file is reused for later copies and
+%   deleted when Opticks exits.
+%
+%   When the TransferCache setting is enabled, MATLAB keeps a reference to each
+%   copy. Repeating a call with the same arguments reuses that copy instead of
+%   transferring the data again, unless the dataset has been modified since.
+%   As with any copy, changes made to the variable in MATLAB are replaced. Copies
+%   are kept in the OPTICKS_TRANSFER_CACHE__ variable, so clearing the variable
+%   itself does not release the memory, and changing it makes a second copy.
+%   Clear OPTICKS_TRANSFER_CACHE__ to release their memory. The setting is
+%   disabled by default.
+%
+%   Example:
+%      >> B = zeros(2, 3, 4);
+%      >> B(:,:,1) = [1, 2 , 3; 4 , 5, 6];
+%      >> B(:,:,2) = [7, 8 , 9; 10, 11, 12];
+%      >> B(:,:,3) = [13, 14, 15; 16, 17, 18];
+%      >> B(:,:,4) = [19, 20, 21; 22, 23, 24];
+%      >> array_to_opticks('B', '', 1, 1, 'bip')
+%      >> array_to_matlab()
+%      >> raster
+%      raster(:,:,1) =
+%           1     2     3
+%           4     5     6
+%      raster(:,:,2) =
+%           7     8     9
+%          10    11    12
+%      raster(:,:,3) =
+%          13    14    15
+%          16    17    18
+%      raster(:,:,4) =
+%          19    20    21
+%          22    23    24
+lasterr('This command must be executed from Opticks.')
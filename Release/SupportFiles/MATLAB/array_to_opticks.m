@@ -1,35 +1,45 @@
-% ARRAY_TO_OPTICKS Copies data from MATLAB to an Opticks raster element.
-%   ARRAY_TO_OPTICKS('M') copies the variable M from the MATLAB workspace to
-%      a new Opticks raster element X such that
-%         X has no parent.
-%         X will be displayed as the primary raster element in a new view.
-%         X will have band sequential (BSQ) interleave.
-%         X will not have units defined (Digital Number).
-%
-%   ARRAY_TO_OPTICKS('M', 'P', D, W, 'I', 'U') copies the variable M from the
-%      MATLAB workspace to a new Opticks raster element X such that
-%        X will have parent P if P exists.
-%        X will be displayed if D indicates 't', 'true', 1, or a similar value.
-%        X will be displayed as the primary raster element in a new view if W
-%            indicates 't', 'true', 1, or a similar value.
-%        X will have interleave specified by I ('BIP', 'BIL', or 'BSQ').
-%        X will have units specified by 'U' if U is not an empty string.
-%
-%   The size of the copy will always match the output from SIZE(M).
-%   If subsetting is required, it must be done in MATLAB before calling ARRAY_TO_OPTICKS.
-%
-%   Data type will be preserved during the copy. See CLASS.
-%
-%   This function supports data up to 2 GB in size.
-%   To determine the size of the data, use the the following formula:
-%      total_size = row_count * column_count * band_count * data_size_in_bytes
-%
-%   Example:
-%      >> B = zeros(2, 3, 4);
-%      >> B(:,:,1) = [1, 2 , 3; 4 , 5, 6];
-%      >> B(:,:,2) = [7, 8 , 9; 10, 11, 12];
-%      >> B(:,:,3) = [13, 14, 15; 16, 17, 18];
-%      >> B(:,:,4) = [19, 20, 21; 22, 23, 24];
-%      >> array_to_opticks('B', '', 1, 1, 'bip')
-%      >> array_to_matlab()
-lasterr('This command must be executed from Opticks.')
+% ARRAY_TO_OPTICKS Copies data from MATLAB to an Opticks raster element.
+%   ARRAY_TO_OPTICKS('M') copies the variable M from the MATLAB workspace to
+%      a new Opticks raster element X such that
+%         X has no parent.
+%         X will be displayed as the primary raster element in a new view.
+%         X will have band sequential (BSQ) interleave.
+%         X will not have units defined (Digital Number).
+%
+%   ARRAY_TO_OPTICKS('M', 'P', D, W, 'I', 'U') copies the variable M from the
+%      MATLAB workspace to a new Opticks raster element X such that
+%        X will have parent P if P exists.
+%        X will be displayed if D indicates 't', 'true', 1, or a similar value.
+%        X will be displayed as the primary raster element in a new view if W
+%            indicates 't', 'true', 1, or a similar value.
+%        X will have interleave specified by I ('BIP', 'BIL', or 'BSQ').
+%        X will have units specified by 'U' if U is not an empty string.
+%
+%   ARRAY_TO_OPTICKS('M', 'P', D, W, 'I', 'U', 'C') also converts the data to
+%      class C ('int8', 'uint8', 'int16', 'uint16', 'int32', 'uint32',
+%      'single', or 'double') while it is copied. Conversions to integer
+%      classes round and saturate in the same way as MATLAB's own casts, so
+%      double results can be stored as float or integer data without first
+%      making a converted copy in MATLAB.
+%
+%   The size of the copy will always match the output from SIZE(M).
+%   If subsetting is required, it must be done in MATLAB before calling ARRAY_TO_OPTICKS.
+%
+%   Data type will be preserved during the copy unless C is given. See CLASS.
+%
+%   With 64-bit versions of MATLAB and Opticks, this function supports data
+%   larger than 4 GB, limited only by available memory. Each of the row,
+%   column, and band counts must still be less than 2^32. With 32-bit versions,
+%   this function supports data up to 2 GB in size.
+%   To determine the size of the data, use the the following formula:
+%      total_size = row_count * column_count * band_count * data_size_in_bytes
+%
+%   Example:
+%      >> B = zeros(2, 3, 4);
+%      >> B(:,:,1) = [1, 2 , 3; 4 , 5, 6];
+%      >> B(:,:,2) = [7, 8 , 9; 10, 11, 12];
+%      >> B(:,:,3) = [13, 14, 15; 16, 17, 18];
+%      >> B(:,:,4) = [19, 20, 21; 22, 23, 24];
+%      >> array_to_opticks('B', '', 1, 1, 'bip')
+%      >> array_to_matlab()
+lasterr('This command must be executed from Opticks.')
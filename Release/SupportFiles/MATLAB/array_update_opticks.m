@@ -0,0 +1,28 @@
+% ARRAY_UPDATE_OPTICKS Copies data from MATLAB into an existing Opticks raster element.
+%   ARRAY_UPDATE_OPTICKS('M') copies the variable M from the MATLAB workspace
+%   into the primary raster element of the active window, starting at the
+%   first row, column, and band.
+%
+%   ARRAY_UPDATE_OPTICKS('M', X, C0, R0, B0) copies M into a subregion of X where
+%      X is the name of the raster element to update. The default is the
+%         primary raster element of the active window.
+%      C0 is the first column to write. The default is 0.
+%      R0 is the first row to write. The default is 0.
+%      B0 is the first band to write. The default is 0.
+%
+%   The size of the subregion matches the output from SIZE(M), and it must lie
+%   entirely within X. The data is converted to the data type of X while it is
+%   copied, rounding and saturating in the same way as MATLAB's own casts, and
+%   X keeps its interleave. No new raster element, layer, or window is created.
+%
+%   All Opticks references to X are notified of the change once, after the
+%   whole subregion has been written, so REFRESH_DISPLAY does not need to be
+%   called afterwards.
+%
+%   Example:
+%      >> B = zeros(4, 5, 3);
+%      >> array_to_opticks('B', '', 1, 1, 'bip')
+%      >> P = ones(2, 2, 3);
+%      >> array_update_opticks('P', 'B', 1, 2, 0)
+%      >> array_to_matlab()
+lasterr('This command must be executed from Opticks.')
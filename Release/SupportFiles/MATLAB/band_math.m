@@ -0,0 +1,31 @@
+% BAND_MATH Evaluates an expression over the bands of an Opticks raster element.
+%   BAND_MATH(E, Y) evaluates the expression E for every pixel of the primary
+%   raster element of the active window and stores the result in a new single
+%   band raster element called Y, which is displayed in a new window. If a
+%   raster element called Y already exists, the result is written into its
+%   first band instead and no window is created.
+%
+%   BAND_MATH(E, Y, X, CLASS, B, DISPLAY, NEWWINDOW) where
+%      X is the name of the raster element to read. The default is the
+%         primary raster element of the active window.
+%      CLASS is the class of a new Y ('int8', 'uint8', 'int16', 'uint16',
+%         'int32', 'uint32', 'single', or 'double'). The default is 'single'.
+%      B is the zero-based band of an existing Y to write. The default is 0.
+%      DISPLAY displays a new Y when it indicates 't', 'true', 1, or a similar
+%         value. The default is 1.
+%      NEWWINDOW displays a new Y in a new window instead of the active window.
+%         The default is the value of DISPLAY.
+%
+%   E refers to the bands of X as b0, b1, and so on, with zero-based band
+%   numbers. It may use numbers, the operators + - * / ^ (or .* ./ .^), unary
+%   minus, parentheses, pi, and the functions abs, sqrt, exp, log, log10, sin,
+%   cos, tan, floor, ceil, round, min, max, and atan2. The expression is
+%   evaluated in double precision with MATLAB's operator precedence and
+%   element-wise rules, and only the result is converted to the class of Y.
+%
+%   The expression is evaluated inside Opticks by several threads, and only
+%   the bands which it uses are read, so no pixel data is copied to MATLAB.
+%
+%   Example:
+%      >> band_math('(b3 - b2) ./ (b3 + b2)', 'NDVI')
+lasterr('This command must be executed from Opticks.')
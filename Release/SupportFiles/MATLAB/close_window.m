@@ -1,14 +1,14 @@
-% CLOSE_WINDOW Closes the specified Opticks window.
-%   CLOSE_WINDOW(X, Y) closes the window named X which should be of type Y.
-%
-%   The default values are
-%      X = the name of the active workspace window
-%      Y = 'SpatialDataWindow' but other valid values are:
-%        'WorkspaceWindow'
-%        'ProductWindow'
-%        'DockWindow'
-%        'PlotWindow'
-%
-%   The value of X is case sensitive.
-%   The value of Y is not case sensitive.
-lasterr('This command must be executed from Opticks.')
+% CLOSE_WINDOW Closes the specified Opticks window.
+%   CLOSE_WINDOW(X, Y) closes the window named X which should be of type Y.
+%
+%   The default values are
+%      X = the name of the active workspace window
+%      Y = 'SpatialDataWindow' but other valid values are:
+%        'WorkspaceWindow'
+%        'ProductWindow'
+%        'DockWindow'
+%        'PlotWindow'
+%
+%   The value of X is case sensitive.
+%   The value of Y is not case sensitive.
+lasterr('This command must be executed from Opticks.')
@@ -1,5 +1,5 @@
-% COPY_METADATA copies metadata from one Opticks data element to another.
-%   COPY_METADATA(X, Y) copies metadata from data element X to data element Y.
-%   The original contents of the metadata of data element Y are preserved
-%   unless they are also present in X, in which case the values in X are used.
-lasterr('This command must be executed from Opticks.')
+% COPY_METADATA copies metadata from one Opticks data element to another.
+%   COPY_METADATA(X, Y) copies metadata from data element X to data element Y.
+%   The original contents of the metadata of data element Y are preserved
+%   unless they are also present in X, in which case the values in X are used.
+lasterr('This command must be executed from Opticks.')
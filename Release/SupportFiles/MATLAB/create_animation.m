@@ -1,16 +1,16 @@
-% CREATE_ANIMATION creates an animation for an Opticks raster element.
-%   CREATE_ANIMATION() creates an animation controller for the active window.
-%
-%   Example:
-%      >> B = zeros(2, 3, 4);
-%      >> B(:,:,1) = [1, 2 , 3; 4 , 5, 6];
-%      >> B(:,:,2) = [7, 8 , 9; 10, 11, 12];
-%      >> B(:,:,3) = [13, 14, 15; 16, 17, 18];
-%      >> B(:,:,4) = [19, 20, 21; 22, 23, 24];
-%      >> array_to_opticks('B')
-%      >> create_animation()
-%      >> set_interval_multiplier(3)
-%      >> set_animation_cycle('repeat')
-%      >> set_animation_state('play_forward')
-%      >> set_animation_state('stop')
-lasterr('This command must be executed from Opticks.')
+% CREATE_ANIMATION creates an animation for an Opticks raster element.
+%   CREATE_ANIMATION() creates an animation controller for the active window.
+%
+%   Example:
+%      >> B = zeros(2, 3, 4);
+%      >> B(:,:,1) = [1, 2 , 3; 4 , 5, 6];
+%      >> B(:,:,2) = [7, 8 , 9; 10, 11, 12];
+%      >> B(:,:,3) = [13, 14, 15; 16, 17, 18];
+%      >> B(:,:,4) = [19, 20, 21; 22, 23, 24];
+%      >> array_to_opticks('B')
+%      >> create_animation()
+%      >> set_interval_multiplier(3)
+%      >> set_animation_cycle('repeat')
+%      >> set_animation_state('play_forward')
+%      >> set_animation_state('stop')
+lasterr('This command must be executed from Opticks.')
@@ -1,7 +1,7 @@
-% GET_ANIMATION_CONTROLLER_NAMES lists Opticks animation controllers.
-%   GET_ANIMATION_CONTROLLER_NAMES(X) displays the name of the animation
-%   controller in window X.
-%
-%   The default value is X = empty string, which lists all Opticks animation
-%   controllers in the current session.
-lasterr('This command must be executed from Opticks.')
+% GET_ANIMATION_CONTROLLER_NAMES lists Opticks animation controllers.
+%   GET_ANIMATION_CONTROLLER_NAMES(X) displays the name of the animation
+%   controller in window X.
+%
+%   The default value is X = empty string, which lists all Opticks animation
+%   controllers in the current session.
+lasterr('This command must be executed from Opticks.')
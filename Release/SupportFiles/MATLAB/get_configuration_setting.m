@@ -1,5 +1,5 @@
-% GET_CONFIGURATION_SETTING returns the value of an Opticks setting.
-%   GET_CONFIGURATION_SETTING(X) returns the value of the setting named X.
-%   Setting names can be determined by looking at the Opticks configuration
-%   files, e.g.: 1-ApplicationDefaults.cfg.
-lasterr('This command must be executed from Opticks.')
+% GET_CONFIGURATION_SETTING returns the value of an Opticks setting.
+%   GET_CONFIGURATION_SETTING(X) returns the value of the setting named X.
+%   Setting names can be determined by looking at the Opticks configuration
+%   files, e.g.: 1-ApplicationDefaults.cfg.
+lasterr('This command must be executed from Opticks.')
@@ -1,2 +1,2 @@
-% GET_CURRENT_NAME is the displayed name of the current data element.
-lasterr('This command must be executed from Opticks.')
+% GET_CURRENT_NAME is the displayed name of the current data element.
+lasterr('This command must be executed from Opticks.')
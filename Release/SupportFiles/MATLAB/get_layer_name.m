@@ -1,6 +1,6 @@
-% GET_LAYER_NAME is the name of a layer in the specified window.
-%   GET_LAYER_NAME(X, Y) is the name of the layer at index X being displayed in
-%   the window named Y.
-%
-%   The default is Y = empty string, indicating the active window.
-lasterr('This command must be executed from Opticks.')
+% GET_LAYER_NAME is the name of a layer in the specified window.
+%   GET_LAYER_NAME(X, Y) is the name of the layer at index X being displayed in
+%   the window named Y.
+%
+%   The default is Y = empty string, indicating the active window.
+lasterr('This command must be executed from Opticks.')
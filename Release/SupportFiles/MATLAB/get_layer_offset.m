@@ -1,8 +1,8 @@
-% GET_LAYER_OFFSET is the specified layer's offset in the scene.
-%   GET_LAYER_OFFSET(Z, W) is the offset of the layer named Z which
-%   should exist in the spatial data window named W to the value (X, Y) where
-%   (0, 0) is defined by the origin of the view.
-%
-%   The default is Z = empty string, indicating the topmost layer.
-%   The default is W = empty string, indicating the active window.
-lasterr('This command must be executed from Opticks.')
+% GET_LAYER_OFFSET is the specified layer's offset in the scene.
+%   GET_LAYER_OFFSET(Z, W) is the offset of the layer named Z which
+%   should exist in the spatial data window named W to the value (X, Y) where
+%   (0, 0) is defined by the origin of the view.
+%
+%   The default is Z = empty string, indicating the topmost layer.
+%   The default is W = empty string, indicating the active window.
+lasterr('This command must be executed from Opticks.')
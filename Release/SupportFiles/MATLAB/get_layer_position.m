@@ -1,8 +1,8 @@
-% GET_LAYER_POSITION is the specified layer's index in the layer list.
-%   GET_LAYER_POSITION(Z, W) is the position of the layer named Z which
-%   should exist in the spatial data window named W. The index of the layer
-%   determines whether it is displayed above or below other layers in the view.
-%
-%   The default is Z = empty string, indicating the topmost layer.
-%   The default is W = empty string, indicating the active window.
-lasterr('This command must be executed from Opticks.')
+% GET_LAYER_POSITION is the specified layer's index in the layer list.
+%   GET_LAYER_POSITION(Z, W) is the position of the layer named Z which
+%   should exist in the spatial data window named W. The index of the layer
+%   determines whether it is displayed above or below other layers in the view.
+%
+%   The default is Z = empty string, indicating the topmost layer.
+%   The default is W = empty string, indicating the active window.
+lasterr('This command must be executed from Opticks.')
@@ -1,6 +1,6 @@
-% GET_NUM_LAYERS is the number of layers present in a window.
-%   GET_NUM_LAYERS(X) is the number of layers in window X.
-%   This includes both hidden and displayed layers.
-%
-%   The default is X = the name of the active spatial data window.
-lasterr('This command must be executed from Opticks.')
+% GET_NUM_LAYERS is the number of layers present in a window.
+%   GET_NUM_LAYERS(X) is the number of layers in window X.
+%   This includes both hidden and displayed layers.
+%
+%   The default is X = the name of the active spatial data window.
+lasterr('This command must be executed from Opticks.')
@@ -1,17 +1,17 @@
-% GET_WINDOW_LABEL shows the displayed name of the specified window.
-%   GET_WINDOW_LABEL(X, Y) shows the displayed name of the window named X
-%   which should be of type Y.
-%
-%   The default values are
-%      X = the name of the active workspace window
-%      Y = 'SpatialDataWindow' but other valid values are:
-%        'WorkspaceWindow'
-%        'ProductWindow'
-%        'DockWindow'
-%        'PlotWindow'
-%
-%   The value of X is case sensitive.
-%   The value of Y is not case sensitive.
-%
-%   See also GET_WINDOW_NAME.
-lasterr('This command must be executed from Opticks.')
+% GET_WINDOW_LABEL shows the displayed name of the specified window.
+%   GET_WINDOW_LABEL(X, Y) shows the displayed name of the window named X
+%   which should be of type Y.
+%
+%   The default values are
+%      X = the name of the active workspace window
+%      Y = 'SpatialDataWindow' but other valid values are:
+%        'WorkspaceWindow'
+%        'ProductWindow'
+%        'DockWindow'
+%        'PlotWindow'
+%
+%   The value of X is case sensitive.
+%   The value of Y is not case sensitive.
+%
+%   See also GET_WINDOW_NAME.
+lasterr('This command must be executed from Opticks.')
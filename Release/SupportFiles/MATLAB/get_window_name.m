@@ -1,6 +1,6 @@
-% GET_WINDOW_NAME shows the full name of the specified window.
-%   GET_WINDOW_NAME(X) shows the full name of the window displaying the raster
-%   element whose name is X.
-%
-%   See also GET_WINDOW_LABEL.
-lasterr('This command must be executed from Opticks.')
+% GET_WINDOW_NAME shows the full name of the specified window.
+%   GET_WINDOW_NAME(X) shows the full name of the window displaying the raster
+%   element whose name is X.
+%
+%   See also GET_WINDOW_LABEL.
+lasterr('This command must be executed from Opticks.')
@@ -1,5 +1,5 @@
-% HIDE_COMMAND_WINDOW suppresses the MATLAB command window.
-%   HIDE_COMMAND_WINDOW must always be called from Opticks.
-%
-%   See also SHOW_COMMAND_WINDOW.
-lasterr('This command must be executed from Opticks.')
+% HIDE_COMMAND_WINDOW suppresses the MATLAB command window.
+%   HIDE_COMMAND_WINDOW must always be called from Opticks.
+%
+%   See also SHOW_COMMAND_WINDOW.
+lasterr('This command must be executed from Opticks.')
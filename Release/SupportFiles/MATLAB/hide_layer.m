@@ -1,7 +1,7 @@
-% HIDE_LAYER hides the specified layer from the user.
-%   HIDE_LAYER(X, Y) hides the layer named X which should exist in the spatial
-%   data window named Y.
-%
-%   The default is X = empty string, indicating the topmost layer.
-%   The default is Y = empty string, indicating the active window.
-lasterr('This command must be executed from Opticks.')
+% HIDE_LAYER hides the specified layer from the user.
+%   HIDE_LAYER(X, Y) hides the layer named X which should exist in the spatial
+%   data window named Y.
+%
+%   The default is X = empty string, indicating the topmost layer.
+%   The default is Y = empty string, indicating the active window.
+lasterr('This command must be executed from Opticks.')
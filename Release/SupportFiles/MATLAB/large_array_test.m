@@ -0,0 +1,47 @@
+% Tests transfers of arrays with more than 2^32 elements in each direction.
+% This script needs roughly 16 GB of free memory and a 64-bit version of MATLAB and Opticks,
+% so it is not run as part of opticks_test.
+fprintf('Running large_array_test. . .\n');
+fprintf('   Several windows should appear and disappear during the course of this test.\n');
+
+% 65536 x 32769 x 2 is just over 2^32 elements, so any index which is truncated to 32 bits will wrap
+% around into the first band.
+rows = 65536;
+cols = 32769;
+bands = 2;
+interleaves = {'bsq', 'bil', 'bip'};
+for i = 1:length(interleaves)
+   large_array = zeros(rows, cols, bands, 'uint8');
+   large_array(2, 2, 1) = 1;
+   large_array(rows, cols, 1) = 2;
+   large_array(2, 2, bands) = 3;
+   large_array(rows, cols, bands) = 4;
+   large_array(rows, 2, bands) = 5;
+   array_to_opticks('large_array', '', 1, 1, interleaves{i});
+
+   % Copy back only a few elements so that the check itself does not need another full copy.
+   % Stop values of 0 select everything, so the first row and column are not used here.
+   corner = array_to_matlab(cols - 1, cols - 1, rows - 1, rows - 1, bands - 1, bands - 1);
+   if corner ~= 4
+      fprintf('   The last element of a %s array does not match after being passed to Opticks\n', interleaves{i})
+   end
+   corner = array_to_matlab(1, 1, rows - 1, rows - 1, bands - 1, bands - 1);
+   if corner ~= 5
+      fprintf('   The last row of a %s array does not match after being passed to Opticks\n', interleaves{i})
+   end
+   corner = array_to_matlab(1, 1, 1, 1, 0, 0);
+   if ~isequal(squeeze(corner), uint8([1; 3]))
+      fprintf('   The second row of a %s array was overwritten after being passed to Opticks\n', interleaves{i})
+   end
+
+   % Copy the whole array back to check the other direction.
+   clear corner;
+   array_to_matlab();
+   if ~isequal(raster, large_array)
+      fprintf('   A %s array does not match after a full copy from Opticks\n', interleaves{i})
+   end
+   clear raster large_array;
+   close_window();
+end
+
+fprintf('Finished running large_array_test.')
@@ -0,0 +1,61 @@
+% Test suite of Opticks/MATLAB interface commands for the mock MATLAB engine
+% This suite does not create any windows or use function handles, so it can be run against
+% MatlabInterpreterMock without a licensed copy of MATLAB or an interactive session.
+fprintf('Testing MATLAB/Opticks Interface against the mock MATLAB engine. . .\n')
+
+% Test ArrayFromMatlabCommand and ArrayToMatlabCommand
+A = zeros(2, 3, 4);
+A(:,:,1) = [1, 2, 3; 4, 5, 6];
+A(:,:,2) = [7, 8, 9; 10, 11, 12];
+A(:,:,3) = [13, 14, 15; 16, 17, 18];
+A(:,:,4) = [19, 20, 21; 22, 23, 24];
+array_to_opticks('A', '', 0);
+array_to_matlab(0, 0, 0, 0, 0, 0, 'A');
+if ~isequal(raster, A)
+   fprintf('   Error with array_to_matlab command.\n')
+end
+
+% Test strided ArrayToMatlabCommand
+array_to_matlab(0, 0, 0, 0, 0, 0, 'A', 1, 2, 3);
+if ~isequal(raster, A(:, 1:2:end, 1:3:end))
+   fprintf('   Error with strided array_to_matlab command.\n')
+end
+
+% Test class conversion in ArrayToOpticksCommand
+D = [0.4, 1.5; -3, 300];
+array_to_opticks('D', '', 0, 0, 'bsq', '', 'uint8');
+array_to_matlab(0, 0, 0, 0, 0, 0, 'D');
+if ~isa(raster, 'uint8') || ~isequal(raster, uint8(D))
+   fprintf('   Error with converted array_to_opticks command.\n')
+end
+
+% Test ArrayUpdateOpticksCommand
+U = [7.2, 8.6];
+array_update_opticks('U', 'D', 0, 1, 0);
+array_to_matlab(0, 0, 0, 0, 0, 0, 'D');
+if ~isequal(raster, [uint8(D(1,:)); uint8(U)])
+   fprintf('   Error with array_update_opticks command.\n')
+end
+clear raster D U;
+
+% Test ArraySizeCommand with arguments passed as variables and expressions
+name = 'A';
+sz = array_size(name);
+if ~isequal(sz, size(A))
+   fprintf('   Error with array_size command.\n')
+end
+
+% Test internal commands inside loops and conditionals
+total = 0;
+for i = 1:3
+   sz = array_size(name);
+   if sz(3) == size(A, 3)
+      total = total + sz(3);
+   end
+end
+if total ~= 3 * size(A, 3)
+   fprintf('   Error with array_size command inside a for loop.\n')
+end
+clear A name sz total i;
+
+fprintf('Finished running opticks_mock_test.')
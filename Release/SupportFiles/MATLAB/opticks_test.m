@@ -1,134 +1,295 @@
-% Test suite of Opticks/MATLAB interface commands
-fprintf('Testing MATLAB/Opticks Interface. . .\n')
-fprintf('Several windows should appear and disappear during the course of this test.\n')
-
-% Assumes that the "Confirm Close" Workspace Window option is NOT set (i.e.: windows will close without a prompt).
-cc = get_configuration_setting('WorkspaceWindow/ConfirmClose');
-if strcmp(cc, 'False') ~= 1
-   fprintf('   The WorkspaceWindow/ConfirmClose option is set to true.\nPlease disable it and try again.\n')
-end
-
-% Basic Tests
-A = zeros(2, 2, 2);
-A(:,:,1) = [1, 2; 3, 4];
-A(:,:,2) = [5, 6; 7, 8];
-array_to_opticks('A')
-array_to_matlab()
-if raster ~= A
-   fprintf('   Array A does not match after being passed to Opticks\n')
-end
-close_window()
-
-% Test interleave conversion for BIP.
-B = zeros(2, 3, 4);
-B(:,:,1) = [1, 2 , 3; 4 , 5, 6];
-B(:,:,2) = [7, 8 , 9; 10, 11, 12];
-B(:,:,3) = [13, 14, 15; 16, 17, 18];
-B(:,:,4) = [19, 20, 21; 22, 23, 24];
-array_to_opticks('B', '', 1, 1, 'bip')
-array_to_matlab()
-if raster ~= B
-   fprintf('   Array B does not match after being passed to Opticks\n')
-end
-close_window()
-
-% Test interleave conversion for BIL.
-C = B;
-array_to_opticks('C', '', 1, 1, 'bil')
-array_to_matlab()
-if raster ~= C
-   fprintf('   Array C does not match after being passed to Opticks\n')
-end
-close_window()
-
-% Most of the other internal commands require a dataset to be present in Opticks, so create one now.
-% This is a larger version of the same data used for diag_test (a diagonal line animating across the image from the top left to the bottom right).
-rows = 256;
-cols = 256;
-bands = 256;
-test = zeros(rows, cols, bands);
-for z = 1:bands
-   test(:,:,z) = [eye(z, cols); zeros(rows - z, cols)];
-end
-
-% Test ArrayFromMatlabCommand
-array_to_opticks('test');
-
-% Test ArraySizeCommand
-sz = array_size();
-if sz ~= size(test)
-   fprintf('   Error with array_size command.\n')
-end
-
-% Test Animation Commands.
-% CreateAnimationCommand
-create_animation();
-
-% GetAnimationCycleCommand
-% SetAnimationCycleCommand
-x = 'play once';
-set_animation_cycle(x);
-y = get_animation_cycle();
-if strcmpi(x, y) ~= 1
-   fprintf('   Error with get_animation_cycle command for value %s.\n', x)
-end
-
-x = 'BOUNCE';
-set_animation_cycle(x);
-y = get_animation_cycle();
-if strcmpi(x, y) ~= 1
-   fprintf('   Error with get_animation_cycle command for value %s.\n', x)
-end
-
-x = 'rePeAt';
-set_animation_cycle(x);
-y = get_animation_cycle();
-if strcmpi(x, y) ~= 1
-   fprintf('   Error with get_animation_cycle command for value %s.\n', x)
-end
-
-% GetIntervalMultiplierCommand
-% SetIntervalMultiplierCommand
-x = 30;
-set_interval_multiplier(x);
-y = get_interval_multiplier();
-if x ~= y
-   fprintf('   Error with get_interval_multiplier or set_interval_multiplier command.\n')
-end
-
-% Test LayerCommands.
-% Test GetLayerNameCommand
-x = get_layer_name(-1);
-if strcmp('test', x) ~= 1
-   fprintf('   Error with get_layer_name(-1) command.\n')
-end
-
-x = get_layer_name(0);
-if strcmp('test', x) ~= 1
-   fprintf('   Error with get_layer_name(0) command.\n')
-end
-
-% Test GetNumLayersCommand
-x = get_num_layers();
-if x ~= 1
-   fprintf('   Error with get_num_layers command. x == %d\n', x)
-end
-
-% Test GetWindowLabelCommand
-x = get_window_label();
-if strcmp('test', x) ~= 1
-   fprintf('   Error with get_window_label command.\n')
-end
-
-% Test SetWindowLabelCommand
-x = 'another test';
-set_window_label(x);
-y = get_window_label();
-if strcmp(x, y) ~= 1
-   fprintf('   Error with get_window_label or set_window_label command.\n')
-end
-
-% Close the window.
-close_window();
-
-fprintf('Finished running opticks_test.')
+% Test suite of Opticks/MATLAB interface commands
+fprintf('Testing MATLAB/Opticks Interface. . .\n')
+fprintf('Several windows should appear and disappear during the course of this test.\n')
+
+% Assumes that the "Confirm Close" Workspace Window option is NOT set (i.e.: windows will close without a prompt).
+cc = get_configuration_setting('WorkspaceWindow/ConfirmClose');
+if strcmp(cc, 'False') ~= 1
+   fprintf('   The WorkspaceWindow/ConfirmClose option is set to true.\nPlease disable it and try again.\n')
+end
+
+% Basic Tests
+A = zeros(2, 2, 2);
+A(:,:,1) = [1, 2; 3, 4];
+A(:,:,2) = [5, 6; 7, 8];
+array_to_opticks('A')
+array_to_matlab()
+if raster ~= A
+   fprintf('   Array A does not match after being passed to Opticks\n')
+end
+close_window()
+
+% Test interleave conversion for BIP.
+B = zeros(2, 3, 4);
+B(:,:,1) = [1, 2 , 3; 4 , 5, 6];
+B(:,:,2) = [7, 8 , 9; 10, 11, 12];
+B(:,:,3) = [13, 14, 15; 16, 17, 18];
+B(:,:,4) = [19, 20, 21; 22, 23, 24];
+array_to_opticks('B', '', 1, 1, 'bip')
+array_to_matlab()
+if raster ~= B
+   fprintf('   Array B does not match after being passed to Opticks\n')
+end
+array_to_matlab(0, 0, 0, 0, 0, 0, '', 1, 2, 3)
+if ~isequal(raster, B(:, 1:2:end, 1:3:end))
+   fprintf('   Array B does not match after a strided copy from Opticks\n')
+end
+close_window()
+
+% Test interleave conversion for BIL.
+C = B;
+array_to_opticks('C', '', 1, 1, 'bil')
+array_to_matlab()
+if raster ~= C
+   fprintf('   Array C does not match after being passed to Opticks\n')
+end
+close_window()
+
+% Most of the other internal commands require a dataset to be present in Opticks, so create one now.
+% This is a larger version of the same data used for diag_test (a diagonal line animating across the image from the top left to the bottom right).
+rows = 256;
+cols = 256;
+bands = 256;
+test = zeros(rows, cols, bands);
+for z = 1:bands
+   test(:,:,z) = [eye(z, cols); zeros(rows - z, cols)];
+end
+
+% Test ArrayFromMatlabCommand
+array_to_opticks('test');
+
+% Test ArraySizeCommand
+sz = array_size();
+if sz ~= size(test)
+   fprintf('   Error with array_size command.\n')
+end
+
+% Test ArrayStreamToMatlabCommand
+bands_seen = 0;
+f = @(t, r, c, b) assignin('base', 'bands_seen', evalin('base', 'bands_seen') + size(t, 3));
+array_stream_to_matlab(f, 0, 0, 0, 0, 0, 0, '', 'bands', 1);
+if bands_seen ~= size(test, 3)
+   fprintf('   Error with array_stream_to_matlab command.\n')
+end
+
+% Test strided and averaged ArrayToMatlabCommand
+array_to_matlab(0, 0, 0, 0, 0, 0, '', 4, 4, 2);
+if ~isequal(raster, test(1:4:end, 1:4:end, 1:2:end))
+   fprintf('   Error with strided array_to_matlab command.\n')
+end
+array_to_matlab(0, 0, 0, 0, 0, 0, '', 2, 2, 1, 'average');
+expected = (test(1:2:end, 1:2:end, :) + test(2:2:end, 1:2:end, :) + test(1:2:end, 2:2:end, :) + test(2:2:end, 2:2:end, :)) / 4;
+if ~isequal(raster, expected)
+   fprintf('   Error with averaged array_to_matlab command.\n')
+end
+clear raster expected;
+
+% Test class conversion in ArrayToMatlabCommand and ArrayToOpticksCommand
+array_to_matlab(0, 0, 0, 0, 0, 0, '', 1, 1, 1, 'sample', 'single');
+if ~isa(raster, 'single') || ~isequal(raster, single(test))
+   fprintf('   Error with converted array_to_matlab command.\n')
+end
+D = [0.4, 1.5; -3, 300];
+array_to_opticks('D', '', 0, 0, 'bsq', '', 'uint8');
+array_to_matlab(0, 0, 0, 0, 0, 0, 'D');
+if ~isa(raster, 'uint8') || ~isequal(raster, uint8(D))
+   fprintf('   Error with converted array_to_opticks command.\n')
+end
+
+% Test ArrayUpdateOpticksCommand
+U = [7.2, 8.6];
+array_update_opticks('U', 'D', 0, 1, 0);
+array_to_matlab(0, 0, 0, 0, 0, 0, 'D');
+if ~isequal(raster, [uint8(D(1,:)); uint8(U)])
+   fprintf('   Error with array_update_opticks command.\n')
+end
+clear raster D U;
+
+% Test ArrayPointsToMatlabCommand
+P = [3, 3; 0, 0; 200, 10; 3, 3];
+S = array_points_to_matlab('P', '', 2, 5);
+expected = zeros(size(P, 1), 4);
+for i = 1:size(P, 1)
+   expected(i, :) = reshape(test(P(i, 1) + 1, P(i, 2) + 1, 3:6), 1, 4);
+end
+if ~isequal(S, expected)
+   fprintf('   Error with array_points_to_matlab command.\n')
+end
+clear P S expected;
+
+% Test ArrayStatisticsCommand
+S = array_statistics(0, 0, 0, 0, 0, 0, '', 2, 2, 1, 'sample', 4);
+values = reshape(test(1:2:end, 1:2:end, :), [], size(test, 3));
+if ~isequal(S.count, repmat(size(values, 1), 1, size(test, 3))) || ~isequal(S.min, min(values)) || ...
+   ~isequal(S.max, max(values)) || max(abs(S.mean - mean(values))) > 1e-12 || ...
+   max(abs(S.std - std(values))) > 1e-12 || ~isequal(sum(S.histogram), S.count)
+   fprintf('   Error with array_statistics command.\n')
+end
+clear S values;
+
+% Test ArrayCovarianceCommand
+[C, M, V, E] = array_covariance(0, 0, 0, 0, 0, 15, '', 4, 4, 1);
+values = reshape(test(1:4:end, 1:4:end, 1:16), [], 16);
+if max(max(abs(C - cov(values)))) > 1e-12 || max(abs(M - mean(values))) > 1e-12 || ...
+   max(max(abs(C * V - V * diag(E)))) > 1e-10 || any(diff(E) > 0)
+   fprintf('   Error with array_covariance command.\n')
+end
+clear C M V E values;
+
+% Test BandMathCommand
+band_math('b5 - 2 * b3 + 0.5', 'band_math_test', '', 'double', 0, 0);
+array_to_matlab(0, 0, 0, 0, 0, 0, 'band_math_test');
+if ~isequal(raster, test(:, :, 6) - 2 * test(:, :, 4) + 0.5)
+   fprintf('   Error with band_math command.\n')
+end
+band_math('max(b0, b7) .^ 2', 'band_math_test');
+array_to_matlab(0, 0, 0, 0, 0, 0, 'band_math_test');
+if ~isequal(raster, max(test(:, :, 1), test(:, :, 8)) .^ 2)
+   fprintf('   Error with band_math command writing into an existing raster.\n')
+end
+clear raster;
+
+% Test the ArrayToMatlabCommand transfer cache, which is off by default
+transfer_cache = get_configuration_setting('MatlabInterpreter/TransferCache');
+set_configuration_setting('MatlabInterpreter/TransferCache', 'true');
+array_to_matlab(0, 0, 0, 0, 0, 0, '', 2, 2, 1);
+if ~exist('opticks_transfer_cache__', 'var') || ~isfield(opticks_transfer_cache__, 'raster')
+   fprintf('   Error with recording a cached array_to_matlab command.\n')
+end
+expected = raster;
+raster(1, 1, 1) = raster(1, 1, 1) + 1;
+array_to_matlab(0, 0, 0, 0, 0, 0, '', 2, 2, 1);
+if ~isequal(raster, expected)
+   fprintf('   Error with cached array_to_matlab command.\n')
+end
+
+% Modifying the raster in Opticks must replace the cached copy rather than restore it.
+E = [1, 2, 3; 4, 5, 6];
+array_to_opticks('E', '', 0);
+array_to_matlab(0, 0, 0, 0, 0, 0, 'E');
+U = [7, 8, 9];
+array_update_opticks('U', 'E', 0, 1, 0);
+array_to_matlab(0, 0, 0, 0, 0, 0, 'E');
+if ~isequal(raster, [E(1, :); U])
+   fprintf('   Error with cached array_to_matlab command after the raster was modified.\n')
+end
+set_configuration_setting('MatlabInterpreter/TransferCache', transfer_cache);
+clear raster expected transfer_cache E U;
+
+% Test internal commands inside loops and conditionals
+total = 0;
+for i = 1:3
+   sz = array_size();
+   if sz(3) == size(test, 3)
+      total = total + sz(3);
+   end
+end
+if total ~= 3 * size(test, 3)
+   fprintf('   Error with array_size command inside a for loop.\n')
+end
+n = 0;
+while n < 2
+   n = n + 1;
+   sz = array_size();
+   if n == 2
+      break;
+   end
+end
+if n ~= 2 || ~isequal(sz, size(test))
+   fprintf('   Error with array_size command inside a while loop.\n')
+end
+clear total n sz;
+
+% Test that output printed before an error is kept when errors are not checked.
+% The line which errors prints "Output printed before an expected error." and that line should appear in the output.
+check_errors = get_configuration_setting('MatlabInterpreter/CheckErrors');
+set_configuration_setting('MatlabInterpreter/CheckErrors', 'false');
+lasterr('');
+printed = 0;
+printed = 1; fprintf('Output printed before an expected error.\n'); error('Expected error.');
+if printed ~= 1 || ~strcmp(lasterr, 'Expected error.')
+   fprintf('   Error with output printed before an error.\n')
+end
+set_configuration_setting('MatlabInterpreter/CheckErrors', check_errors);
+lasterr('');
+clear check_errors printed;
+
+% Test ArrayBenchmarkCommand
+bench = array_benchmark('', 1, 0.0625);
+if numel(bench) ~= 288 || ~isfield(bench, 'gigabytes_per_second')
+   fprintf('   Error with array_benchmark command.\n')
+end
+clear bench;
+
+% Test Animation Commands.
+% CreateAnimationCommand
+create_animation();
+
+% GetAnimationCycleCommand
+% SetAnimationCycleCommand
+x = 'play once';
+set_animation_cycle(x);
+y = get_animation_cycle();
+if strcmpi(x, y) ~= 1
+   fprintf('   Error with get_animation_cycle command for value %s.\n', x)
+end
+
+x = 'BOUNCE';
+set_animation_cycle(x);
+y = get_animation_cycle();
+if strcmpi(x, y) ~= 1
+   fprintf('   Error with get_animation_cycle command for value %s.\n', x)
+end
+
+x = 'rePeAt';
+set_animation_cycle(x);
+y = get_animation_cycle();
+if strcmpi(x, y) ~= 1
+   fprintf('   Error with get_animation_cycle command for value %s.\n', x)
+end
+
+% GetIntervalMultiplierCommand
+% SetIntervalMultiplierCommand
+x = 30;
+set_interval_multiplier(x);
+y = get_interval_multiplier();
+if x ~= y
+   fprintf('   Error with get_interval_multiplier or set_interval_multiplier command.\n')
+end
+
+% Test LayerCommands.
+% Test GetLayerNameCommand
+x = get_layer_name(-1);
+if strcmp('test', x) ~= 1
+   fprintf('   Error with get_layer_name(-1) command.\n')
+end
+
+x = get_layer_name(0);
+if strcmp('test', x) ~= 1
+   fprintf('   Error with get_layer_name(0) command.\n')
+end
+
+% Test GetNumLayersCommand
+x = get_num_layers();
+if x ~= 1
+   fprintf('   Error with get_num_layers command. x == %d\n', x)
+end
+
+% Test GetWindowLabelCommand
+x = get_window_label();
+if strcmp('test', x) ~= 1
+   fprintf('   Error with get_window_label command.\n')
+end
+
+% Test SetWindowLabelCommand
+x = 'another test';
+set_window_label(x);
+y = get_window_label();
+if strcmp(x, y) ~= 1
+   fprintf('   Error with get_window_label or set_window_label command.\n')
+end
+
+% Close the window.
+close_window();
+
+fprintf('Finished running opticks_test.')
@@ -1,6 +1,6 @@
-% REFRESH_DISPLAY notifies Opticks of a possible change for a raster element.
-%   REFRESH_DISPLAY(X) updates all Opticks references to X. This is used
-%   to indicate that data has changed, possibly as the result of an algorithm.
-%
-%   The default value is X = the primary raster element of the active window.
-lasterr('This command must be executed from Opticks.')
+% REFRESH_DISPLAY notifies Opticks of a possible change for a raster element.
+%   REFRESH_DISPLAY(X) updates all Opticks references to X. This is used
+%   to indicate that data has changed, possibly as the result of an algorithm.
+%
+%   The default value is X = the primary raster element of the active window.
+lasterr('This command must be executed from Opticks.')
@@ -1,8 +1,8 @@
-% RUN runs a script, similar to the built-in MATLAB RUN command.
-%   RUN(X) runs script X in the Opticks environment. To use the standard MATLAB
-%   RUN command, execute the RUN command from the MATLAB command window.
-%
-%   To display help for the built-in MATLAB RUN command, use 'doc run'.
-%
-%   See also SHOW_COMMAND_WINDOW, HIDE_COMMAND_WINDOW.
-lasterr('This command must be executed from Opticks.')
+% RUN runs a script, similar to the built-in MATLAB RUN command.
+%   RUN(X) runs script X in the Opticks environment. To use the standard MATLAB
+%   RUN command, execute the RUN command from the MATLAB command window.
+%
+%   To display help for the built-in MATLAB RUN command, use 'doc run'.
+%
+%   See also SHOW_COMMAND_WINDOW, HIDE_COMMAND_WINDOW.
+lasterr('This command must be executed from Opticks.')
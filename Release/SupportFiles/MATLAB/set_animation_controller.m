@@ -1,4 +1,4 @@
-% SET_ANIMATION_CONTROLLER sets the active animation controller in the toolbar.
-%   SET_ANIMATION_CONTROLLER(X) changes the animation toolbar's active
-%   animation controller to the animation controller named X.
-lasterr('This command must be executed from Opticks.')
+% SET_ANIMATION_CONTROLLER sets the active animation controller in the toolbar.
+%   SET_ANIMATION_CONTROLLER(X) changes the animation toolbar's active
+%   animation controller to the animation controller named X.
+lasterr('This command must be executed from Opticks.')
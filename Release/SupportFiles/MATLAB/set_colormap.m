@@ -1,7 +1,7 @@
-% SET_COLORMAP sets the active colormap for a raster layer.
-%   SET_COLORMAP(X, Y, Z) loads a colormap from file X and changes the raster
-%   layer named Y being displayed in window Z to use that colormap.
-%
-%   The default is Y = empty string, indicating the topmost raster layer.
-%   The default is Z = empty string, indicating the active window.
-lasterr('This command must be executed from Opticks.')
+% SET_COLORMAP sets the active colormap for a raster layer.
+%   SET_COLORMAP(X, Y, Z) loads a colormap from file X and changes the raster
+%   layer named Y being displayed in window Z to use that colormap.
+%
+%   The default is Y = empty string, indicating the topmost raster layer.
+%   The default is Z = empty string, indicating the active window.
+lasterr('This command must be executed from Opticks.')
@@ -0,0 +1,10 @@
+% SET_CONFIGURATION_SETTING sets the value of an Opticks setting.
+%   SET_CONFIGURATION_SETTING(X, Y) sets the value of the setting named X
+%   to Y, which is converted to the type of the current value of the setting.
+%   Setting names can be determined by looking at the Opticks configuration
+%   files, e.g.: 1-ApplicationDefaults.cfg.
+%
+%   The new value lasts until Opticks exits and is not saved.
+%
+%   See also GET_CONFIGURATION_SETTING.
+lasterr('This command must be executed from Opticks.')
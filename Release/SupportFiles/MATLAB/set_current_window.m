@@ -1,4 +1,4 @@
-% SET_CURRENT_WINDOW activates the window for the specified raster element.
-%   SET_CURRENT_WINDOW(X) activates the spatial data window for the Opticks
-%   raster element named X if such an element exists.
-lasterr('This command must be executed from Opticks.')
+% SET_CURRENT_WINDOW activates the window for the specified raster element.
+%   SET_CURRENT_WINDOW(X) activates the spatial data window for the Opticks
+%   raster element named X if such an element exists.
+lasterr('This command must be executed from Opticks.')
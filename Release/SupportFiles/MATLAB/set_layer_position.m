@@ -1,8 +1,8 @@
-% SET_LAYER_POSITION sets the specified layer's index in the layer list.
-%   SET_LAYER_POSITION(X, Y, Z) sets the position of the layer named X which
-%   should exist in the spatial data window named Z to the value in Y. The
-%   index of the layer determines whether it is displayed above or below other
-%   layers in the view.
-%
-%   The default is Z = empty string, indicating the active window.
-lasterr('This command must be executed from Opticks.')
+% SET_LAYER_POSITION sets the specified layer's index in the layer list.
+%   SET_LAYER_POSITION(X, Y, Z) sets the position of the layer named X which
+%   should exist in the spatial data window named Z to the value in Y. The
+%   index of the layer determines whether it is displayed above or below other
+%   layers in the view.
+%
+%   The default is Z = empty string, indicating the active window.
+lasterr('This command must be executed from Opticks.')
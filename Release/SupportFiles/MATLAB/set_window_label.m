@@ -1,15 +1,15 @@
-% SET_WINDOW_LABEL sets the displayed name of the specified window.
-%   SET_WINDOW_LABEL(X, Y, Z) sets the displayed name of the window named Y
-%   which should be of type Z to the value of X.
-%
-%   The default values are
-%      Y = the name of the active workspace window
-%      Z = 'SpatialDataWindow' but other valid values are:
-%        'WorkspaceWindow'
-%        'ProductWindow'
-%        'DockWindow'
-%        'PlotWindow'
-%
-%   The value of Y is case sensitive.
-%   The value of Z is not case sensitive.
-lasterr('This command must be executed from Opticks.')
+% SET_WINDOW_LABEL sets the displayed name of the specified window.
+%   SET_WINDOW_LABEL(X, Y, Z) sets the displayed name of the window named Y
+%   which should be of type Z to the value of X.
+%
+%   The default values are
+%      Y = the name of the active workspace window
+%      Z = 'SpatialDataWindow' but other valid values are:
+%        'WorkspaceWindow'
+%        'ProductWindow'
+%        'DockWindow'
+%        'PlotWindow'
+%
+%   The value of Y is case sensitive.
+%   The value of Z is not case sensitive.
+lasterr('This command must be executed from Opticks.')
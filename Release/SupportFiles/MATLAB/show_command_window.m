@@ -1,8 +1,8 @@
-% SHOW_COMMAND_WINDOW displays the MATLAB command window.
-%   SHOW_COMMAND_WINDOW allows the user to enter commands at the MATLAB
-%   window instead of through the Opticks interface.
-%
-%   Note that no commands specific to Opticks can be entered from this window.
-%
-%   See also OPTICKS, HIDE_COMMAND_WINDOW.
-lasterr('This command must be executed from Opticks.')
+% SHOW_COMMAND_WINDOW displays the MATLAB command window.
+%   SHOW_COMMAND_WINDOW allows the user to enter commands at the MATLAB
+%   window instead of through the Opticks interface.
+%
+%   Note that no commands specific to Opticks can be entered from this window.
+%
+%   See also OPTICKS, HIDE_COMMAND_WINDOW.
+lasterr('This command must be executed from Opticks.')
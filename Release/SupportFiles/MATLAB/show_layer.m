@@ -1,6 +1,6 @@
-% SHOW_LAYER shows the specified layer to the user.
-%   SHOW_LAYER(X, Y) shows the layer named X which should exist in the spatial
-%   data window named Y.
-%
-%   The default is Y = empty string, indicating the active window.
-lasterr('This command must be executed from Opticks.')
+% SHOW_LAYER shows the specified layer to the user.
+%   SHOW_LAYER(X, Y) shows the layer named X which should exist in the spatial
+%   data window named Y.
+%
+%   The default is Y = empty string, indicating the active window.
+lasterr('This command must be executed from Opticks.')